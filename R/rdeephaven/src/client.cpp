@@ -539,16 +539,11 @@ public:
     */
     SEXP GetArrowArrayStreamPtr() {
 
-        // Fetch the table fully decoded ("cooked"): the C++ client expands any RunEndEncoded and
-        // Dictionary columns to their plain value types, so R always receives decoded columns
-        // (including doubly-encoded RunEndEncoded<Dictionary<...>>). The record batches share the
-        // decoded table's column data, so they remain valid after arrow_table goes out of scope.
-        std::shared_ptr<arrow::Table> arrow_table = internal_tbl_hdl.ToArrowTable(true);
-
-        arrow::TableBatchReader table_batch_reader(*arrow_table);
-        arrow::Result<arrow::RecordBatchVector> record_batches = table_batch_reader.ToRecordBatches();
-
-        std::shared_ptr<arrow::RecordBatchReader> record_batch_reader = arrow::RecordBatchReader::Make(std::move(*record_batches)).ValueOrDie();
+        // Stream the table decoded ("cooked"): the C++ client expands any RunEndEncoded and
+        // Dictionary columns to their plain value types one batch at a time, as R pulls the
+        // batches, so R always receives decoded columns (including doubly-encoded
+        // RunEndEncoded<Dictionary<...>>) without the whole table being materialized first.
+        std::shared_ptr<arrow::RecordBatchReader> record_batch_reader = internal_tbl_hdl.GetRecordBatchReader(true);
         ArrowArrayStream* stream_ptr = new ArrowArrayStream();
         deephaven::client::utility::OkOrThrow(DEEPHAVEN_LOCATION_EXPR(arrow::ExportRecordBatchReader(record_batch_reader, stream_ptr)));
 
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace deephaven::benchmarks {
+/**
+ * Runs 'setup' followed by 'body' 'repetitions' times, timing only 'body', and returns the median
+ * time in microseconds. 'setup' returns whatever state 'body' needs, which is passed by reference.
+ */
+template<typename Setup, typename Body>
+double MedianMicros(size_t repetitions, const Setup &setup, const Body &body) {
+  using clock = std::chrono::steady_clock;
+  std::vector<double> samples;
+  samples.reserve(repetitions);
+  for (size_t i = 0; i != repetitions; ++i) {
+    auto state = setup();
+    auto start = clock::now();
+    body(state);
+    auto end = clock::now();
+    samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+/**
+ * Parses argv[index] as a size_t, or returns 'default_value' if there is no such argument.
+ */
+inline size_t ArgOrDefault(int argc, char *argv[], int index, size_t default_value) {
+  if (index >= argc) {
+    return default_value;
+  }
+  return std::stoull(argv[index]);
+}
+
+/**
+ * Prints a row of right-aligned columns.
+ */
+inline void PrintRow(const std::vector<std::string> &cells) {
+  for (const auto &cell : cells) {
+    std::cout << std::setw(14) << cell;
+  }
+  std::cout << '\n';
+}
+
+inline std::string FormatMicros(double micros) {
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(1) << micros;
+  return ss.str();
+}
+}  // namespace deephaven::benchmarks
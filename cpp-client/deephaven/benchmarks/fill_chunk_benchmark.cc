@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+
+/*
+ * Measures the cost of walking a RowSequence with many small intervals, as FillChunk does for
+ * scattered rows. The "function" column copies through the virtual ForEachInterval (one
+ * std::function call per interval, which is how FillChunk used to iterate) and the "inline"
+ * column does the identical copy through ForEachIntervalInline. The last two columns are the real
+ * FillChunk of a buffer-backed and an Immer-backed column source, which now use the inline path.
+ *
+ * Usage: fill_chunk_benchmark [num_rows] [repetitions]
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/buffer_column_source.h"
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/immer_table_state.h"
+#include "deephaven/dhcore/types.h"
+
+using deephaven::benchmarks::ArgOrDefault;
+using deephaven::benchmarks::FormatMicros;
+using deephaven::benchmarks::MedianMicros;
+using deephaven::benchmarks::PrintRow;
+using deephaven::dhcore::ElementType;
+using deephaven::dhcore::ElementTypeId;
+using deephaven::dhcore::chunk::Int64Chunk;
+using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::column::ColumnSource;
+using deephaven::dhcore::column::NumericBufferColumnSource;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::ticking::ImmerTableState;
+
+namespace {
+struct Shape {
+  std::string name_;
+  // Runs of selected rows have lengths uniform in [1, max_run_]; the gaps between them have
+  // lengths uniform in [1, max_gap_].
+  uint64_t max_run_ = 1;
+  uint64_t max_gap_ = 1;
+};
+
+std::shared_ptr<RowSequence> MakeRows(const Shape &shape, uint64_t num_rows);
+std::shared_ptr<ColumnSource> MakeImmerColumn(const std::vector<int64_t> &data);
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  try {
+    auto num_rows = ArgOrDefault(argc, argv, 1, 4'000'000);
+    auto repetitions = ArgOrDefault(argc, argv, 2, 5);
+
+    std::cout << "rows=" << num_rows << " repetitions=" << repetitions
+        << " (times are median microseconds)\n";
+    PrintRow({"shape", "selected", "intervals", "function", "inline", "buffer", "immer"});
+
+    std::vector<int64_t> data(num_rows);
+    for (size_t i = 0; i != num_rows; ++i) {
+      data[i] = static_cast<int64_t>(i);
+    }
+    auto buffer_column = NumericBufferColumnSource<int64_t>::Create(
+        ElementType::Of(ElementTypeId::kInt64), data.data(), data.size());
+    auto immer_column = MakeImmerColumn(data);
+
+    std::vector<Shape> shapes = {
+        {"every-other", 1, 1},
+        {"short-runs", 4, 4},
+        {"sparse", 1, 64},
+        {"dense", num_rows, 1},
+    };
+    for (const auto &shape : shapes) {
+      auto rows = MakeRows(shape, num_rows);
+      size_t num_intervals = 0;
+      rows->ForEachIntervalInline([&num_intervals](uint64_t, uint64_t) { ++num_intervals; });
+      auto dest = Int64Chunk::Create(rows->Size());
+      const auto *src = data.data();
+
+      auto nothing = []() { return 0; };
+      auto function = MedianMicros(repetitions, nothing, [&](int) {
+        auto *destp = dest.data();
+        rows->ForEachInterval([&destp, src](uint64_t begin, uint64_t end) {
+          destp = std::copy(src + begin, src + end, destp);
+        });
+      });
+      auto inlined = MedianMicros(repetitions, nothing, [&](int) {
+        auto *destp = dest.data();
+        rows->ForEachIntervalInline([&destp, src](uint64_t begin, uint64_t end) {
+          destp = std::copy(src + begin, src + end, destp);
+        });
+      });
+      auto buffer = MedianMicros(repetitions, nothing, [&](int) {
+        buffer_column->FillChunk(*rows, &dest, nullptr);
+      });
+      auto immer = MedianMicros(repetitions, nothing, [&](int) {
+        immer_column->FillChunk(*rows, &dest, nullptr);
+      });
+
+      // Sanity check the last fill.
+      size_t i = 0;
+      bool same = true;
+      rows->ForEachIntervalInline([&](uint64_t begin, uint64_t end) {
+        for (auto key = begin; key != end; ++key) {
+          same = same && dest.data()[i++] == data[key];
+        }
+      });
+      if (!same) {
+        throw std::runtime_error("FillChunk produced the wrong data for shape " + shape.name_);
+      }
+
+      PrintRow({shape.name_, std::to_string(rows->Size()), std::to_string(num_intervals),
+          FormatMicros(function), FormatMicros(inlined), FormatMicros(buffer),
+          FormatMicros(immer)});
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Caught exception: " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
+
+namespace {
+std::shared_ptr<RowSequence> MakeRows(const Shape &shape, uint64_t num_rows) {
+  std::mt19937_64 rng(12345);
+  std::uniform_int_distribution<uint64_t> run(1, shape.max_run_);
+  std::uniform_int_distribution<uint64_t> gap(1, shape.max_gap_);
+  RowSequenceBuilder builder;
+  uint64_t next = 0;
+  while (next < num_rows) {
+    auto end = std::min(next + run(rng), num_rows);
+    builder.AddInterval(next, end);
+    next = end + gap(rng);
+  }
+  return builder.Build();
+}
+
+std::shared_ptr<ColumnSource> MakeImmerColumn(const std::vector<int64_t> &data) {
+  auto schema = Schema::Create({"C"}, {ElementType::Of(ElementTypeId::kInt64)});
+  ImmerTableState state(std::move(schema));
+  auto keys = state.AddKeys(*RowSequence::CreateSequential(0, data.size()));
+  std::vector<std::shared_ptr<ColumnSource>> sources = {
+      NumericBufferColumnSource<int64_t>::Create(ElementType::Of(ElementTypeId::kInt64),
+          data.data(), data.size())};
+  state.AddData(sources, {0}, {data.size()}, *keys);
+  return state.Snapshot()->GetColumn(0);
+}
+}  // namespace
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+
+/*
+ * Compares the two ImmerTableState splice strategies (per-interval take/drop/concat versus a
+ * single-pass rebuild) for AddData, Erase and ModifyData as the number of intervals in the
+ * update grows, and finds the crossover: the number of intervals at which rebuilding becomes the
+ * faster of the two. It does this for several table sizes and ends by printing the values of
+ * kRowsPerIntervalSplice and kMinIntervalsForRebuild (in immer_table_state.cc) that those
+ * crossovers imply.
+ *
+ * Usage: immer_table_state_benchmark [num_rows] [num_columns] [repetitions]
+ * With no num_rows, it runs 10'000, 100'000 and 1'000'000 rows.
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/buffer_column_source.h"
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/immer_table_state.h"
+#include "deephaven/dhcore/types.h"
+
+using deephaven::benchmarks::ArgOrDefault;
+using deephaven::benchmarks::FormatMicros;
+using deephaven::benchmarks::MedianMicros;
+using deephaven::benchmarks::PrintRow;
+using deephaven::dhcore::ElementType;
+using deephaven::dhcore::ElementTypeId;
+using deephaven::dhcore::chunk::Int64Chunk;
+using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::column::ColumnSource;
+using deephaven::dhcore::column::NumericBufferColumnSource;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::ticking::ImmerTableState;
+
+namespace {
+using SpliceMode = ImmerTableState::SpliceMode;
+
+struct Fixture {
+  Fixture(size_t num_rows, size_t num_columns);
+
+  // Makes a table holding the even keys [0, 2, 4, ..., 2 * (num_rows - 1)].
+  [[nodiscard]]
+  std::unique_ptr<ImmerTableState> MakeTable(SpliceMode mode) const;
+
+  // 'count' odd keys (not in the table), spread evenly.
+  [[nodiscard]]
+  std::shared_ptr<RowSequence> KeysToAdd(size_t count) const;
+  // 'count' even keys (in the table), spread evenly.
+  [[nodiscard]]
+  std::shared_ptr<RowSequence> KeysInTable(size_t count) const;
+
+  size_t num_rows_ = 0;
+  std::shared_ptr<Schema> schema_;
+  std::vector<int64_t> data_;
+  std::shared_ptr<ColumnSource> source_;
+  std::vector<std::shared_ptr<ColumnSource>> sources_;
+  std::vector<size_t> begins_;
+  std::vector<size_t> ends_;
+};
+
+/**
+ * The number of intervals at which rebuilding first beat splicing, per operation, or nullopt if
+ * it never did.
+ */
+struct Crossovers {
+  std::optional<size_t> add;
+  std::optional<size_t> erase;
+  std::optional<size_t> modify;
+};
+
+/**
+ * Times the three operations for one interval count, prints a row, and records in 'crossovers'
+ * the operations for which rebuilding is faster for the first time.
+ */
+void RunOne(const Fixture &fixture, size_t num_intervals, size_t repetitions,
+    Crossovers *crossovers);
+void CheckSame(const ImmerTableState &lhs, const ImmerTableState &rhs, size_t num_columns);
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  try {
+    std::vector<size_t> row_counts = {10'000, 100'000, 1'000'000};
+    if (argc > 1) {
+      row_counts = {ArgOrDefault(argc, argv, 1, 0)};
+    }
+    auto num_columns = ArgOrDefault(argc, argv, 2, 8);
+    auto repetitions = ArgOrDefault(argc, argv, 3, 5);
+
+    // Over all table sizes and operations: rows / intervals at each crossover, and the smallest
+    // crossover interval count.
+    std::vector<size_t> rows_per_interval;
+    std::optional<size_t> min_intervals;
+    for (auto num_rows : row_counts) {
+      std::cout << "rows=" << num_rows << " columns=" << num_columns
+          << " repetitions=" << repetitions << " (times are median microseconds)\n";
+      PrintRow({"intervals", "add/splice", "add/rebuild", "erase/splice", "erase/rebuild",
+          "mod/splice", "mod/rebuild"});
+
+      Fixture fixture(num_rows, num_columns);
+      Crossovers crossovers;
+      for (size_t num_intervals = 1; num_intervals <= num_rows / 2; num_intervals *= 2) {
+        RunOne(fixture, num_intervals, repetitions, &crossovers);
+      }
+      for (const auto &crossover : {crossovers.add, crossovers.erase, crossovers.modify}) {
+        if (!crossover.has_value()) {
+          continue;
+        }
+        rows_per_interval.push_back(num_rows / *crossover);
+        min_intervals = std::min(min_intervals.value_or(*crossover), *crossover);
+      }
+      std::cout << '\n';
+    }
+
+    if (rows_per_interval.empty()) {
+      std::cout << "Splicing always won; there is no crossover to tune to.\n";
+      return 0;
+    }
+    std::sort(rows_per_interval.begin(), rows_per_interval.end());
+    std::cout << "Implied constants: kRowsPerIntervalSplice = "
+        << rows_per_interval[rows_per_interval.size() / 2]
+        << " (median of " << rows_per_interval.size() << " crossovers), "
+        << "kMinIntervalsForRebuild = " << *min_intervals << '\n';
+  } catch (const std::exception &e) {
+    std::cerr << "Caught exception: " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
+
+namespace {
+Fixture::Fixture(size_t num_rows, size_t num_columns) : num_rows_(num_rows) {
+  std::vector<std::string> names;
+  std::vector<ElementType> types;
+  for (size_t i = 0; i != num_columns; ++i) {
+    names.push_back("C" + std::to_string(i));
+    types.push_back(ElementType::Of(ElementTypeId::kInt64));
+  }
+  schema_ = Schema::Create(std::move(names), std::move(types));
+
+  data_.reserve(num_rows);
+  for (size_t i = 0; i != num_rows; ++i) {
+    data_.push_back(static_cast<int64_t>(i));
+  }
+  source_ = NumericBufferColumnSource<int64_t>::Create(ElementType::Of(ElementTypeId::kInt64),
+      data_.data(), data_.size());
+  sources_.assign(num_columns, source_);
+  begins_.assign(num_columns, 0);
+  ends_.assign(num_columns, num_rows);
+}
+
+std::unique_ptr<ImmerTableState> Fixture::MakeTable(SpliceMode mode) const {
+  auto result = std::make_unique<ImmerTableState>(schema_);
+  RowSequenceBuilder builder;
+  for (size_t i = 0; i != num_rows_; ++i) {
+    builder.Add(2 * i);
+  }
+  auto keys = builder.Build();
+  auto indices = result->AddKeys(*keys);
+  result->AddData(sources_, begins_, ends_, *indices);
+  result->SetSpliceMode(mode);
+  return result;
+}
+
+std::shared_ptr<RowSequence> Fixture::KeysToAdd(size_t count) const {
+  RowSequenceBuilder builder;
+  auto stride = num_rows_ / count;
+  for (size_t i = 0; i != count; ++i) {
+    builder.Add(2 * i * stride + 1);
+  }
+  return builder.Build();
+}
+
+std::shared_ptr<RowSequence> Fixture::KeysInTable(size_t count) const {
+  RowSequenceBuilder builder;
+  auto stride = num_rows_ / count;
+  for (size_t i = 0; i != count; ++i) {
+    builder.Add(2 * i * stride);
+  }
+  return builder.Build();
+}
+
+void RunOne(const Fixture &fixture, size_t num_intervals, size_t repetitions,
+    Crossovers *crossovers) {
+  auto keys_to_add = fixture.KeysToAdd(num_intervals);
+  auto keys_in_table = fixture.KeysInTable(num_intervals);
+  std::vector<size_t> ends(fixture.ends_.size(), num_intervals);
+
+  auto add = [&](SpliceMode mode) {
+    return MedianMicros(repetitions,
+        [&]() {
+          auto table = fixture.MakeTable(mode);
+          auto indices = table->AddKeys(*keys_to_add);
+          return std::make_pair(std::move(table), std::move(indices));
+        },
+        [&](auto &state) {
+          state.first->AddData(fixture.sources_, fixture.begins_, ends, *state.second);
+        });
+  };
+
+  auto erase = [&](SpliceMode mode) {
+    return MedianMicros(repetitions,
+        [&]() { return fixture.MakeTable(mode); },
+        [&](auto &table) { (void)table->Erase(*keys_in_table); });
+  };
+
+  auto modify = [&](SpliceMode mode) {
+    return MedianMicros(repetitions,
+        [&]() {
+          auto table = fixture.MakeTable(mode);
+          auto indices = table->ConvertKeysToIndices(*keys_in_table);
+          return std::make_pair(std::move(table), std::move(indices));
+        },
+        [&](auto &state) {
+          for (size_t i = 0; i != fixture.sources_.size(); ++i) {
+            state.first->ModifyData(i, *fixture.source_, 0, num_intervals, *state.second);
+          }
+        });
+  };
+
+  // Sanity check that the two strategies agree before timing them.
+  {
+    auto splice = fixture.MakeTable(SpliceMode::kPerInterval);
+    auto rebuild = fixture.MakeTable(SpliceMode::kRebuild);
+    for (auto *table : {splice.get(), rebuild.get()}) {
+      auto indices = table->AddKeys(*keys_to_add);
+      table->AddData(fixture.sources_, fixture.begins_, ends, *indices);
+      (void)table->Erase(*keys_in_table);
+    }
+    CheckSame(*splice, *rebuild, fixture.sources_.size());
+  }
+
+  auto add_splice = add(SpliceMode::kPerInterval);
+  auto add_rebuild = add(SpliceMode::kRebuild);
+  auto erase_splice = erase(SpliceMode::kPerInterval);
+  auto erase_rebuild = erase(SpliceMode::kRebuild);
+  auto modify_splice = modify(SpliceMode::kPerInterval);
+  auto modify_rebuild = modify(SpliceMode::kRebuild);
+  PrintRow({std::to_string(num_intervals),
+      FormatMicros(add_splice), FormatMicros(add_rebuild),
+      FormatMicros(erase_splice), FormatMicros(erase_rebuild),
+      FormatMicros(modify_splice), FormatMicros(modify_rebuild)});
+
+  auto note = [num_intervals](std::optional<size_t> *crossover, double splice, double rebuild) {
+    if (!crossover->has_value() && rebuild < splice) {
+      *crossover = num_intervals;
+    }
+  };
+  note(&crossovers->add, add_splice, add_rebuild);
+  note(&crossovers->erase, erase_splice, erase_rebuild);
+  note(&crossovers->modify, modify_splice, modify_rebuild);
+}
+
+void CheckSame(const ImmerTableState &lhs, const ImmerTableState &rhs, size_t num_columns) {
+  auto lhs_table = lhs.Snapshot();
+  auto rhs_table = rhs.Snapshot();
+  if (lhs_table->NumRows() != rhs_table->NumRows()) {
+    throw std::runtime_error("Splice strategies disagree on the number of rows");
+  }
+  auto rows = lhs_table->GetRowSequence();
+  auto lhs_chunk = Int64Chunk::Create(rows->Size());
+  auto rhs_chunk = Int64Chunk::Create(rows->Size());
+  for (size_t i = 0; i != num_columns; ++i) {
+    lhs_table->GetColumn(i)->FillChunk(*rows, &lhs_chunk, nullptr);
+    rhs_table->GetColumn(i)->FillChunk(*rows, &rhs_chunk, nullptr);
+    if (!std::equal(lhs_chunk.begin(), lhs_chunk.end(), rhs_chunk.begin())) {
+      throw std::runtime_error("Splice strategies disagree on the data");
+    }
+  }
+}
+}  // namespace
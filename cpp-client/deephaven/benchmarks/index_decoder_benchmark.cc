@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+
+/*
+ * Measures IndexDecoder::ReadExternalCompressedDelta throughput on a few index shapes, each encoded
+ * with IndexEncoder. The "builder" column is the previous decoder (one value at a time into a
+ * RowSequenceBuilder), kept here as a baseline; the "flat" column is the current decoder. Each
+ * shape also checks that the two agree.
+ *
+ * Usage: index_decoder_benchmark [num_intervals] [repetitions]
+ */
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/index_decoder.h"
+
+using deephaven::benchmarks::ArgOrDefault;
+using deephaven::benchmarks::FormatMicros;
+using deephaven::benchmarks::MedianMicros;
+using deephaven::benchmarks::PrintRow;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::ticking::DataInput;
+using deephaven::dhcore::ticking::DataOutput;
+using deephaven::dhcore::ticking::IndexDecoder;
+using deephaven::dhcore::ticking::IndexEncoder;
+
+namespace {
+struct Shape {
+  std::string name_;
+  // Lengths of the ranges are uniform in [1, max_length_]; gaps between them are uniform in
+  // [1, max_gap_].
+  uint64_t max_length_ = 1;
+  uint64_t max_gap_ = 1;
+};
+
+std::shared_ptr<RowSequence> LegacyDecode(DataInput *in);
+void RunOne(const Shape &shape, size_t num_intervals, size_t repetitions);
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  try {
+    auto num_intervals = ArgOrDefault(argc, argv, 1, 1'000'000);
+    auto repetitions = ArgOrDefault(argc, argv, 2, 5);
+
+    std::cout << "intervals=" << num_intervals << " repetitions=" << repetitions
+        << " (times are median microseconds)\n";
+    PrintRow({"shape", "bytes", "keys", "builder", "flat", "flat MB/s"});
+    std::vector<Shape> shapes = {
+        // Mostly byte arrays.
+        {"singletons", 1, 2},
+        {"short-runs", 100, 100},
+        // Mostly short arrays.
+        {"sparse", 1, 20'000},
+        // Individual int and long offsets.
+        {"wide", 1'000, uint64_t(1) << 36},
+    };
+    for (const auto &shape : shapes) {
+      RunOne(shape, num_intervals, repetitions);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Caught exception: " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
+
+namespace {
+std::vector<std::pair<uint64_t, uint64_t>> Flatten(const RowSequence &rows) {
+  std::vector<std::pair<uint64_t, uint64_t>> result;
+  rows.ForEachInterval([&result](uint64_t begin, uint64_t end) {
+    result.emplace_back(begin, end);
+  });
+  return result;
+}
+
+void RunOne(const Shape &shape, size_t num_intervals, size_t repetitions) {
+  std::mt19937_64 rng(12345);
+  std::uniform_int_distribution<uint64_t> length(1, shape.max_length_);
+  std::uniform_int_distribution<uint64_t> gap(1, shape.max_gap_);
+  std::vector<std::pair<uint64_t, uint64_t>> intervals;
+  uint64_t next = 0;
+  for (size_t i = 0; i != num_intervals; ++i) {
+    auto begin = next;
+    auto end = begin + length(rng);
+    intervals.emplace_back(begin, end);
+    next = end + gap(rng);
+  }
+  auto rows = RowSequence::CreateFromIntervals(std::move(intervals));
+
+  std::vector<int8_t> encoded;
+  DataOutput out(&encoded);
+  IndexEncoder::WriteExternalCompressedDelta(*rows, &out);
+
+  auto decode = [&encoded](const auto &decoder) {
+    DataInput in(encoded.data(), encoded.size());
+    return decoder(&in);
+  };
+
+  // Sanity check that both decoders reproduce the original.
+  auto expected = Flatten(*rows);
+  if (Flatten(*decode(LegacyDecode)) != expected ||
+      Flatten(*decode(IndexDecoder::ReadExternalCompressedDelta)) != expected) {
+    throw std::runtime_error("Decoders disagree for shape " + shape.name_);
+  }
+
+  auto nothing = []() { return 0; };
+  auto builder = MedianMicros(repetitions, nothing, [&](int) {
+    (void)decode(LegacyDecode);
+  });
+  auto flat = MedianMicros(repetitions, nothing, [&](int) {
+    (void)decode(IndexDecoder::ReadExternalCompressedDelta);
+  });
+  auto megabytes_per_second = static_cast<double>(encoded.size()) / flat;
+  PrintRow({shape.name_, std::to_string(encoded.size()), std::to_string(rows->Size()),
+      FormatMicros(builder), FormatMicros(flat), FormatMicros(megabytes_per_second)});
+}
+
+/**
+ * The previous IndexDecoder::ReadExternalCompressedDelta.
+ */
+std::shared_ptr<RowSequence> LegacyDecode(DataInput *in) {
+  constexpr int8_t kCmdMask = 0x78;
+  constexpr int8_t kOffset = 8;
+  constexpr int8_t kShortArray = 16;
+  constexpr int8_t kByteArray = 24;
+  constexpr int8_t kEnd = 32;
+
+  RowSequenceBuilder builder;
+  int64_t offset = 0;
+  int64_t pending = -1;
+  auto consume = [&pending, &builder](int64_t v) {
+    auto s = pending;
+    if (s == -1) {
+      pending = v;
+    } else if (v < 0) {
+      builder.AddInterval(static_cast<uint64_t>(s), static_cast<uint64_t>(-v) + 1);
+      pending = -1;
+    } else {
+      builder.Add(s);
+      pending = v;
+    }
+  };
+  auto consume_delta = [&offset, &consume](int64_t value) {
+    auto actual_value = offset + (value < 0 ? -value : value);
+    consume(value < 0 ? -actual_value : actual_value);
+    offset = actual_value;
+  };
+
+  while (true) {
+    int command = in->ReadByte();
+    switch (command & kCmdMask) {
+      case kOffset: {
+        consume_delta(in->ReadValue(command));
+        break;
+      }
+      case kShortArray: {
+        auto count = in->ReadValue(command);
+        for (int64_t i = 0; i != count; ++i) {
+          consume_delta(in->ReadShort());
+        }
+        break;
+      }
+      case kByteArray: {
+        auto count = in->ReadValue(command);
+        for (int64_t i = 0; i != count; ++i) {
+          consume_delta(in->ReadByte());
+        }
+        break;
+      }
+      case kEnd: {
+        if (pending >= 0) {
+          builder.Add(pending);
+        }
+        return builder.Build();
+      }
+      default: {
+        throw std::runtime_error("Bad command: " + std::to_string(command));
+      }
+    }
+  }
+}
+}  // namespace
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+
+/*
+ * Times SpaceMapper::ApplyShift, driven through ShiftProcessor::ApplyShiftData, for a few shift
+ * patterns resembling what the server sends. The "per-key" column is the previous algorithm (walk
+ * every key in the shifted range, then remove and re-add the resulting ranges in a Roaring64Map),
+ * kept here as a baseline; the "bucketed" column is the current SpaceMapper. Each pattern also
+ * checks that the two agree.
+ *
+ * Usage: space_mapper_shift_benchmark [num_keys] [repetitions]
+ */
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/shift_processor.h"
+#include "deephaven/dhcore/ticking/space_mapper.h"
+#include "roaring/roaring.hh"
+
+using deephaven::benchmarks::ArgOrDefault;
+using deephaven::benchmarks::FormatMicros;
+using deephaven::benchmarks::MedianMicros;
+using deephaven::benchmarks::PrintRow;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::subscription::ShiftProcessor;
+using deephaven::dhcore::ticking::SpaceMapper;
+
+namespace {
+/**
+ * The shift data for one update, in the transposed form Barrage uses: closed source ranges
+ * [first, last] moving to start at dest.
+ */
+struct Shifts {
+  std::shared_ptr<RowSequence> first_;
+  std::shared_ptr<RowSequence> last_;
+  std::shared_ptr<RowSequence> dest_;
+};
+
+struct Pattern {
+  std::string name_;
+  // Every 'stride'th key in [0, num_keys * stride) is present.
+  uint64_t stride_ = 1;
+  std::function<Shifts(uint64_t num_keys)> make_shifts_;
+};
+
+std::vector<Pattern> MakePatterns();
+void RunOne(const Pattern &pattern, uint64_t num_keys, size_t repetitions);
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  try {
+    auto num_keys = ArgOrDefault(argc, argv, 1, 4'000'000);
+    auto repetitions = ArgOrDefault(argc, argv, 2, 5);
+
+    std::cout << "keys=" << num_keys << " repetitions=" << repetitions
+        << " (times are median microseconds)\n";
+    PrintRow({"pattern", "per-key", "bucketed"});
+    for (const auto &pattern : MakePatterns()) {
+      RunOne(pattern, num_keys, repetitions);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Caught exception: " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
+
+namespace {
+Shifts MakeShifts(const std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> &tuples) {
+  RowSequenceBuilder first;
+  RowSequenceBuilder last;
+  RowSequenceBuilder dest;
+  for (const auto &[f, l, d] : tuples) {
+    first.Add(f);
+    last.Add(l);
+    dest.Add(d);
+  }
+  return {first.Build(), last.Build(), dest.Build()};
+}
+
+/**
+ * Splits [0, key_space) into 'num_blocks' blocks and moves block i by i * step (which may be
+ * negative).
+ */
+Shifts BlockShifts(uint64_t key_space, uint64_t num_blocks, int64_t step) {
+  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> tuples;
+  auto block_size = key_space / num_blocks;
+  for (uint64_t i = 1; i != num_blocks; ++i) {
+    auto first = i * block_size;
+    auto dest = static_cast<uint64_t>(static_cast<int64_t>(first) +
+        static_cast<int64_t>(i) * step);
+    tuples.emplace_back(first, first + block_size - 1, dest);
+  }
+  return MakeShifts(tuples);
+}
+
+std::vector<Pattern> MakePatterns() {
+  std::vector<Pattern> result;
+  // Rows inserted in the middle of a dense table: the back half moves up a little.
+  result.push_back({"insert-mid", 1, [](uint64_t n) {
+    return MakeShifts({{n / 2, n - 1, n / 2 + 1000}});
+  }});
+  // The server often opens up room in power-of-two sized slots.
+  result.push_back({"aligned", 1, [](uint64_t n) {
+    return MakeShifts({{n / 2, n - 1, n / 2 + (uint64_t(1) << 20)}});
+  }});
+  // Room opened up between many blocks at once.
+  result.push_back({"spread-up", 1, [](uint64_t n) { return BlockShifts(n, 64, 64); }});
+  // A sparse table being compacted.
+  result.push_back({"compact-down", 3, [](uint64_t n) { return BlockShifts(3 * n, 64, -16); }});
+  return result;
+}
+
+/**
+ * The previous SpaceMapper::ApplyShift, which visits every key in the shifted range.
+ */
+void PerKeyShift(roaring::Roaring64Map *set, uint64_t begin_key, uint64_t end_key,
+    uint64_t dest_key) {
+  std::vector<std::pair<uint64_t, uint64_t>> new_ranges;
+  auto it = set->begin();
+  if (!it.move(begin_key)) {
+    return;
+  }
+  while (it != set->end() && *it < end_key) {
+    auto new_key = *it - begin_key + dest_key;
+    if (!new_ranges.empty() && new_ranges.back().second == new_key) {
+      ++new_ranges.back().second;
+    } else {
+      new_ranges.emplace_back(new_key, new_key + 1);
+    }
+    ++it;
+  }
+  set->removeRange(begin_key, end_key);
+  for (const auto &range : new_ranges) {
+    set->addRange(range.first, range.second);
+  }
+}
+
+void ApplyShifts(const Shifts &shifts,
+    const std::function<void(uint64_t, uint64_t, uint64_t)> &apply_shift) {
+  ShiftProcessor::ApplyShiftData(*shifts.first_, *shifts.last_, *shifts.dest_,
+      [&apply_shift](uint64_t first, uint64_t last, uint64_t dest) {
+        apply_shift(first, last + 1, dest);
+      });
+}
+
+void RunOne(const Pattern &pattern, uint64_t num_keys, size_t repetitions) {
+  auto shifts = pattern.make_shifts_(num_keys);
+
+  auto make_roaring = [&]() {
+    roaring::Roaring64Map result;
+    for (uint64_t i = 0; i != num_keys; ++i) {
+      result.add(i * pattern.stride_);
+    }
+    return result;
+  };
+  auto make_mapper = [&]() {
+    auto result = std::make_unique<SpaceMapper>();
+    RowSequenceBuilder builder;
+    for (uint64_t i = 0; i != num_keys; ++i) {
+      builder.Add(i * pattern.stride_);
+    }
+    (void)result->AddKeys(*builder.Build());
+    return result;
+  };
+
+  // Sanity check that the two agree before timing them.
+  {
+    auto expected = make_roaring();
+    ApplyShifts(shifts, [&expected](uint64_t begin, uint64_t end, uint64_t dest) {
+      PerKeyShift(&expected, begin, end, dest);
+    });
+    auto actual = make_mapper();
+    ApplyShifts(shifts, [&actual](uint64_t begin, uint64_t end, uint64_t dest) {
+      actual->ApplyShift(begin, end, dest);
+    });
+    auto keys = actual->Keys();
+    auto it = expected.begin();
+    bool same = keys->Size() == expected.cardinality();
+    keys->ForEachInterval([&](uint64_t begin, uint64_t end) {
+      for (auto key = begin; same && key != end; ++key, ++it) {
+        same = *it == key;
+      }
+    });
+    if (!same) {
+      throw std::runtime_error("Shift implementations disagree for pattern " + pattern.name_);
+    }
+  }
+
+  auto per_key = MedianMicros(repetitions, make_roaring, [&](auto &set) {
+    ApplyShifts(shifts, [&set](uint64_t begin, uint64_t end, uint64_t dest) {
+      PerKeyShift(&set, begin, end, dest);
+    });
+  });
+  auto bucketed = MedianMicros(repetitions, make_mapper, [&](auto &mapper) {
+    ApplyShifts(shifts, [&mapper](uint64_t begin, uint64_t end, uint64_t dest) {
+      mapper->ApplyShift(begin, end, dest);
+    });
+  });
+  PrintRow({pattern.name_, FormatMicros(per_key), FormatMicros(bucketed)});
+}
+}  // namespace
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+
+/*
+ * Measures the per-tick cost of producing a TickingUpdate for a wide table receiving tiny updates,
+ * which is where snapshotting used to dominate: every snapshot made a new ColumnSource for every
+ * column and a new ClientTable, whether or not anyone looked at it. Each tick does what
+ * BarrageProcessor does (snapshot, apply the change, snapshot again, build the TickingUpdate) for
+ * three shapes of update:
+ *   append:     one row added at the end
+ *   modify:     one cell of one column changed
+ *   remove+add: one row removed from the front and one added at the end
+ * The columns are:
+ *   eager:     the old behavior: all columns rebuilt and ClientTables made at every snapshot
+ *   lazy/read: unchanged columns reused, ClientTables built because the callback calls Current()
+ *   lazy:      unchanged columns reused, ClientTables never built (e.g. the callback only looks at
+ *              the row sequences)
+ *
+ * Usage: ticking_update_benchmark [num_columns] [num_rows] [ticks] [repetitions]
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark_util.h"
+#include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/clienttable/client_table.h"
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/buffer_column_source.h"
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/immer_table_state.h"
+#include "deephaven/dhcore/ticking/ticking.h"
+#include "deephaven/dhcore/types.h"
+
+using deephaven::benchmarks::ArgOrDefault;
+using deephaven::benchmarks::FormatMicros;
+using deephaven::benchmarks::MedianMicros;
+using deephaven::benchmarks::PrintRow;
+using deephaven::dhcore::ElementType;
+using deephaven::dhcore::ElementTypeId;
+using deephaven::dhcore::chunk::Int64Chunk;
+using deephaven::dhcore::clienttable::ClientTable;
+using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::column::ColumnSource;
+using deephaven::dhcore::column::NumericBufferColumnSource;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::ticking::ImmerTableState;
+using deephaven::dhcore::ticking::TickingUpdate;
+
+namespace {
+enum class Shape { kAppend, kModify, kRemoveAndAdd };
+enum class Mode { kEager, kLazyRead, kLazy };
+
+struct Fixture {
+  Fixture(size_t num_columns, size_t num_rows, size_t num_ticks);
+
+  [[nodiscard]]
+  std::unique_ptr<ImmerTableState> MakeTable(Mode mode) const;
+
+  size_t num_columns_ = 0;
+  size_t num_rows_ = 0;
+  std::shared_ptr<Schema> schema_;
+  std::vector<int64_t> data_;
+  std::shared_ptr<ColumnSource> source_;
+  std::vector<std::shared_ptr<ColumnSource>> sources_;
+};
+
+/**
+ * A table plus the bookkeeping needed to keep ticking it.
+ */
+struct Ticker {
+  Ticker(const Fixture *fixture, Mode mode);
+
+  /**
+   * Applies tick number 'tick' of the given shape and returns the resulting TickingUpdate.
+   */
+  TickingUpdate Tick(Shape shape, size_t tick);
+
+  const Fixture *fixture_ = nullptr;
+  Mode mode_ = Mode::kEager;
+  std::unique_ptr<ImmerTableState> table_;
+  uint64_t first_key_ = 0;
+  uint64_t next_key_ = 0;
+};
+
+double Run(const Fixture &fixture, Shape shape, Mode mode, size_t num_ticks, size_t repetitions);
+void CheckSame(const ClientTable &lhs, const ClientTable &rhs);
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  try {
+    auto num_columns = ArgOrDefault(argc, argv, 1, 500);
+    auto num_rows = ArgOrDefault(argc, argv, 2, 10'000);
+    auto num_ticks = ArgOrDefault(argc, argv, 3, 1'000);
+    auto repetitions = ArgOrDefault(argc, argv, 4, 5);
+
+    std::cout << "columns=" << num_columns << " rows=" << num_rows << " ticks=" << num_ticks
+        << " repetitions=" << repetitions << " (times are median microseconds per tick)\n";
+    PrintRow({"update", "eager", "lazy/read", "lazy"});
+
+    Fixture fixture(num_columns, num_rows, num_ticks);
+    for (auto [shape, name] : {std::make_pair(Shape::kAppend, "append"),
+        std::make_pair(Shape::kModify, "modify"),
+        std::make_pair(Shape::kRemoveAndAdd, "remove+add")}) {
+      // Sanity check that the strategies end up with the same table before timing them.
+      {
+        Ticker eager(&fixture, Mode::kEager);
+        Ticker lazy(&fixture, Mode::kLazy);
+        for (size_t tick = 0; tick != num_ticks; ++tick) {
+          auto eager_update = eager.Tick(shape, tick);
+          auto lazy_update = lazy.Tick(shape, tick);
+          if (tick % 97 == 0 || tick + 1 == num_ticks) {
+            CheckSame(*eager_update.Prev(), *lazy_update.Prev());
+            CheckSame(*eager_update.Current(), *lazy_update.Current());
+          }
+        }
+      }
+
+      std::vector<std::string> row = {name};
+      for (auto mode : {Mode::kEager, Mode::kLazyRead, Mode::kLazy}) {
+        auto micros = Run(fixture, shape, mode, num_ticks, repetitions);
+        row.push_back(FormatMicros(micros / static_cast<double>(num_ticks)));
+      }
+      PrintRow(row);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Caught exception: " << e.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
+
+namespace {
+Fixture::Fixture(size_t num_columns, size_t num_rows, size_t num_ticks) :
+    num_columns_(num_columns), num_rows_(num_rows) {
+  std::vector<std::string> names;
+  std::vector<ElementType> types;
+  for (size_t i = 0; i != num_columns; ++i) {
+    names.push_back("C" + std::to_string(i));
+    types.push_back(ElementType::Of(ElementTypeId::kInt64));
+  }
+  schema_ = Schema::Create(std::move(names), std::move(types));
+
+  // Enough data for the initial rows plus one new row per tick.
+  auto size = num_rows + num_ticks;
+  data_.reserve(size);
+  for (size_t i = 0; i != size; ++i) {
+    data_.push_back(static_cast<int64_t>(i));
+  }
+  source_ = NumericBufferColumnSource<int64_t>::Create(ElementType::Of(ElementTypeId::kInt64),
+      data_.data(), data_.size());
+  sources_.assign(num_columns, source_);
+}
+
+std::unique_ptr<ImmerTableState> Fixture::MakeTable(Mode mode) const {
+  auto result = std::make_unique<ImmerTableState>(schema_);
+  result->SetReuseUnchangedColumns(mode != Mode::kEager);
+  auto indices = result->AddKeys(*RowSequence::CreateSequential(0, num_rows_));
+  std::vector<size_t> begins(num_columns_, 0);
+  std::vector<size_t> ends(num_columns_, num_rows_);
+  result->AddData(sources_, begins, ends, *indices);
+  return result;
+}
+
+Ticker::Ticker(const Fixture *fixture, Mode mode) : fixture_(fixture), mode_(mode),
+    table_(fixture->MakeTable(mode)), first_key_(0), next_key_(fixture->num_rows_) {
+  // Start from the state the processor would be in after the initial snapshot.
+  (void)table_->LazySnapshot();
+}
+
+TickingUpdate Ticker::Tick(Shape shape, size_t tick) {
+  // Mirrors the snapshots that BarrageProcessor takes, and (by reusing the previous one) its way
+  // of marking a phase that changed nothing.
+  auto snapshot = [this]() {
+    return table_->LazySnapshot();
+  };
+  auto prev = snapshot();
+  auto after_removes = prev;
+  auto removed = RowSequence::CreateEmpty();
+  if (shape == Shape::kRemoveAndAdd) {
+    removed = table_->Erase(*RowSequence::CreateSequential(first_key_, first_key_ + 1));
+    ++first_key_;
+    after_removes = snapshot();
+  }
+
+  auto after_adds = after_removes;
+  auto added = RowSequence::CreateEmpty();
+  if (shape != Shape::kModify) {
+    added = table_->AddKeys(*RowSequence::CreateSequential(next_key_, next_key_ + 1));
+    auto data_row = fixture_->num_rows_ + tick;
+    std::vector<size_t> begins(fixture_->num_columns_, data_row);
+    std::vector<size_t> ends(fixture_->num_columns_, data_row + 1);
+    table_->AddData(fixture_->sources_, begins, ends, *added);
+    ++next_key_;
+    after_adds = snapshot();
+  }
+
+  auto after_modifies = after_adds;
+  std::vector<std::shared_ptr<RowSequence>> modified;
+  if (shape == Shape::kModify) {
+    auto col = tick % fixture_->num_columns_;
+    modified.assign(fixture_->num_columns_, RowSequence::CreateEmpty());
+    auto key = first_key_ + tick % fixture_->num_rows_;
+    modified[col] = table_->ConvertKeysToIndices(*RowSequence::CreateSequential(key, key + 1));
+    table_->ModifyData(col, *fixture_->source_, tick, tick + 1, *modified[col]);
+    after_modifies = snapshot();
+  }
+
+  if (mode_ != Mode::kEager) {
+    return TickingUpdate(std::move(prev), std::move(removed), std::move(after_removes),
+        std::move(added), std::move(after_adds), std::move(modified), std::move(after_modifies));
+  }
+  // What Snapshot() did before the column cache: every column rebuilt, and a ClientTable made
+  // for every distinct snapshot.
+  auto build = [](const auto &lazy) {
+    return deephaven::dhcore::ticking::internal::MakeClientTable(lazy.schema_, lazy.columns_,
+        lazy.num_rows_);
+  };
+  auto prev_table = build(prev);
+  auto after_removes_table = after_removes.columns_ == prev.columns_ ? prev_table :
+      build(after_removes);
+  auto after_adds_table = after_adds.columns_ == after_removes.columns_ ? after_removes_table :
+      build(after_adds);
+  auto after_modifies_table = after_modifies.columns_ == after_adds.columns_ ? after_adds_table :
+      build(after_modifies);
+  return TickingUpdate(std::move(prev_table), std::move(removed), std::move(after_removes_table),
+      std::move(added), std::move(after_adds_table), std::move(modified),
+      std::move(after_modifies_table));
+}
+
+double Run(const Fixture &fixture, Shape shape, Mode mode, size_t num_ticks, size_t repetitions) {
+  auto read = mode == Mode::kLazyRead;
+  return MedianMicros(repetitions,
+      [&]() { return std::make_unique<Ticker>(&fixture, mode); },
+      [&](auto &ticker) {
+        for (size_t tick = 0; tick != num_ticks; ++tick) {
+          auto update = ticker->Tick(shape, tick);
+          if (read && update.Current()->NumRows() == 0) {
+            throw std::runtime_error("Table unexpectedly empty");
+          }
+        }
+      });
+}
+
+void CheckSame(const ClientTable &lhs, const ClientTable &rhs) {
+  if (lhs.NumRows() != rhs.NumRows() || lhs.NumColumns() != rhs.NumColumns()) {
+    throw std::runtime_error("Strategies disagree on the shape of the table");
+  }
+  auto rows = lhs.GetRowSequence();
+  auto lhs_chunk = Int64Chunk::Create(rows->Size());
+  auto rhs_chunk = Int64Chunk::Create(rows->Size());
+  for (size_t i = 0; i != lhs.NumColumns(); ++i) {
+    lhs.GetColumn(i)->FillChunk(*rows, &lhs_chunk, nullptr);
+    rhs.GetColumn(i)->FillChunk(*rows, &rhs_chunk, nullptr);
+    if (!std::equal(lhs_chunk.begin(), lhs_chunk.end(), rhs_chunk.begin())) {
+      throw std::runtime_error("Strategies disagree on the data");
+    }
+  }
+}
+}  // namespace
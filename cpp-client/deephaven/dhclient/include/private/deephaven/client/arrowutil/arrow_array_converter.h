@@ -21,6 +21,17 @@ public:
   static std::shared_ptr<ColumnSource> ChunkedArrayToColumnSource(
       std::shared_ptr<arrow::ChunkedArray> chunked_array);
 
+  /**
+   * If 'array' is Dictionary or RunEndEncoded (including RunEndEncoded<Dictionary<...>>), decodes
+   * it into a plain array of its value type. Otherwise returns 'array' unchanged.
+   */
+  static std::shared_ptr<arrow::Array> DecodeArray(std::shared_ptr<arrow::Array> array);
+
+  /**
+   * The type of the arrays that DecodeArray() makes from arrays of type 'type'.
+   */
+  static std::shared_ptr<arrow::DataType> DecodedType(const std::shared_ptr<arrow::DataType> &type);
+
   static std::shared_ptr<arrow::Array> ColumnSourceToArray(const ColumnSource &column_source,
       size_t num_rows);
 };
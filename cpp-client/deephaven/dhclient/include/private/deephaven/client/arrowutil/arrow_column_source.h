@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 #include <arrow/array.h>
 #include <arrow/type.h>
@@ -55,6 +56,7 @@ class GenericArrowColumnSource final : public TColumnSourceBase {
   using LocalTime = deephaven::dhcore::LocalTime;
   using RowSequence = deephaven::dhcore::container::RowSequence;
   using UInt64Chunk = deephaven::dhcore::chunk::UInt64Chunk;
+  using value_type = typename TChunk::value_type;
 
 public:
   static std::shared_ptr<GenericArrowColumnSource> OfArrowArrayVec(
@@ -94,7 +96,7 @@ public:
     auto *null_destp =
         optional_dest_null_flags != nullptr ? optional_dest_null_flags->data() : nullptr;
 
-    rows.ForEachInterval([&](uint64_t requested_segment_begin, uint64_t requested_segment_end) {
+    rows.ForEachIntervalInline([&](uint64_t requested_segment_begin, uint64_t requested_segment_end) {
       while (true) {
         if (requested_segment_begin == requested_segment_end) {
           return;
@@ -223,6 +225,27 @@ public:
     throw std::runtime_error(DEEPHAVEN_LOCATION_STR("Not implemented"));
   }
 
+  [[nodiscard]]
+  const value_type *ContiguousData(size_t begin, size_t end, size_t *available) const final {
+    *available = 0;
+    // Only the kNormal style stores its data in the Deephaven representation, and only when the
+    // Arrow element type is the same as ours (e.g. not for char16_t, which Arrow stores as uint16).
+    if constexpr (Style == ArrowProcessingStyle::kNormal) {
+      if constexpr (std::is_same_v<typename TArrowArray::value_type, value_type>) {
+        size_t src_segment_begin = 0;
+        for (const auto &array : arrays_) {
+          size_t src_segment_end = src_segment_begin + array->length();
+          if (begin < src_segment_end) {
+            *available = std::min<size_t>(end, src_segment_end) - begin;
+            return array->raw_values() + (begin - src_segment_begin);
+          }
+          src_segment_begin = src_segment_end;
+        }
+      }
+    }
+    return nullptr;
+  }
+
   void AcceptVisitor(ColumnSourceVisitor *visitor) const final {
     visitor->Visit(*this);
   }
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <memory>
+#include <arrow/record_batch.h>
+#include <arrow/status.h>
+#include <arrow/type.h>
+#include <arrow/flight/client.h>
+
+namespace deephaven::client::arrowutil {
+/**
+ * Adapts a FlightStreamReader to an arrow::RecordBatchReader, pulling each RecordBatch off the
+ * stream only when it is asked for. Only the batch being read (plus whatever gRPC has buffered) is
+ * held in memory, rather than the whole table.
+ *
+ * If 'decode' is set, Dictionary and RunEndEncoded columns are decoded batch by batch into plain
+ * arrays of their value types (see ArrowArrayConverter::DecodeArray), and schema() reports those
+ * value types. Each batch is decoded against its own dictionary, so dictionaries that change
+ * between batches are handled.
+ */
+class FlightRecordBatchReader final : public arrow::RecordBatchReader {
+  struct Private {};
+  using FlightStreamReader = arrow::flight::FlightStreamReader;
+
+public:
+  [[nodiscard]]
+  static std::shared_ptr<FlightRecordBatchReader> Create(
+      std::unique_ptr<FlightStreamReader> flight_stream_reader, bool decode);
+
+  FlightRecordBatchReader(Private, std::unique_ptr<FlightStreamReader> flight_stream_reader,
+      std::shared_ptr<arrow::Schema> schema, bool decode);
+  ~FlightRecordBatchReader() final;
+
+  [[nodiscard]]
+  std::shared_ptr<arrow::Schema> schema() const final { return schema_; }
+
+  arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch> *batch) final;
+
+  /**
+   * Cancels the rest of the stream.
+   */
+  arrow::Status Close() final;
+
+private:
+  std::unique_ptr<FlightStreamReader> flightStreamReader_;
+  std::shared_ptr<arrow::Schema> schema_;
+  bool decode_ = false;
+};
+}  // namespace deephaven::client::arrowutil
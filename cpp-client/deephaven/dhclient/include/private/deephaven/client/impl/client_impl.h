@@ -8,6 +8,7 @@
 #include "deephaven/client/utility/misc_types.h"
 #include "deephaven/client/impl/table_handle_manager_impl.h"
 #include "deephaven/client/server/server.h"
+#include "deephaven/client/subscription/subscription_scheduler.h"
 #include "deephaven/client/utility/executor.h"
 
 namespace deephaven::client::impl {
@@ -16,12 +17,13 @@ class ClientImpl {
   };
   using Server = deephaven::client::server::Server;
   using Executor = deephaven::client::utility::Executor;
+  using SubscriptionScheduler = deephaven::client::subscription::SubscriptionScheduler;
 
 public:
   [[nodiscard]]
   static std::shared_ptr<ClientImpl> Create(std::shared_ptr<Server> server,
       std::shared_ptr<Executor> executor, std::shared_ptr<Executor> flight_executor,
-      std::string session_type);
+      std::shared_ptr<SubscriptionScheduler> subscription_scheduler, std::string session_type);
 
   ClientImpl(Private, std::shared_ptr<TableHandleManagerImpl> &&manager_impl);
   ~ClientImpl();
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "deephaven/client/client.h"
+#include "deephaven_core/proto/table.pb.h"
+#include "deephaven_core/proto/ticket.pb.h"
+
+namespace deephaven::client::impl {
+class TableHandleImpl;
+class TableHandleManagerImpl;
+
+/**
+ * Records the operations of a QueryBuilder in a BatchTableRequest. Each operation is known by its
+ * offset in the request, which is what the operations that consume it use as their source. The
+ * recording methods are thread safe.
+ */
+class QueryBuilderImpl final {
+  struct Private {};
+  using BatchTableRequest = io::deephaven::proto::backplane::grpc::BatchTableRequest;
+  using Operation = io::deephaven::proto::backplane::grpc::BatchTableRequest::Operation;
+  using Ticket = io::deephaven::proto::backplane::grpc::Ticket;
+  using SortPair = deephaven::client::SortPair;
+
+public:
+  [[nodiscard]]
+  static std::shared_ptr<QueryBuilderImpl> Create(std::shared_ptr<TableHandleManagerImpl> manager);
+
+  QueryBuilderImpl(Private, std::shared_ptr<TableHandleManagerImpl> &&manager);
+  QueryBuilderImpl(const QueryBuilderImpl &other) = delete;
+  QueryBuilderImpl &operator=(const QueryBuilderImpl &other) = delete;
+  ~QueryBuilderImpl();
+
+  // Each of these records an operation and returns its offset.
+  [[nodiscard]]
+  int32_t EmptyTable(int64_t size);
+  [[nodiscard]]
+  int32_t FetchTable(std::string table_name);
+  /**
+   * The table is brought into the batch with a FetchTableRequest on its ticket. We hold on to it
+   * so the ticket is still good whenever the batch is sent.
+   */
+  [[nodiscard]]
+  int32_t FromTableHandle(std::shared_ptr<TableHandleImpl> table);
+  [[nodiscard]]
+  int32_t Select(int32_t source, std::vector<std::string> column_specs);
+  [[nodiscard]]
+  int32_t Update(int32_t source, std::vector<std::string> column_specs);
+  [[nodiscard]]
+  int32_t LazyUpdate(int32_t source, std::vector<std::string> column_specs);
+  [[nodiscard]]
+  int32_t View(int32_t source, std::vector<std::string> column_specs);
+  [[nodiscard]]
+  int32_t UpdateView(int32_t source, std::vector<std::string> column_specs);
+  [[nodiscard]]
+  int32_t DropColumns(int32_t source, std::vector<std::string> column_specs);
+  [[nodiscard]]
+  int32_t Where(int32_t source, std::string condition);
+  [[nodiscard]]
+  int32_t Sort(int32_t source, std::vector<SortPair> sort_pairs);
+  [[nodiscard]]
+  int32_t Head(int32_t source, int64_t n);
+  [[nodiscard]]
+  int32_t Tail(int32_t source, int64_t n);
+  [[nodiscard]]
+  int32_t Slice(int32_t source, int64_t first_position_inclusive, int64_t last_position_exclusive);
+  [[nodiscard]]
+  int32_t CrossJoin(int32_t left, int32_t right, std::vector<std::string> columns_to_match,
+      std::vector<std::string> columns_to_add);
+  [[nodiscard]]
+  int32_t NaturalJoin(int32_t left, int32_t right, std::vector<std::string> columns_to_match,
+      std::vector<std::string> columns_to_add);
+  [[nodiscard]]
+  int32_t ExactJoin(int32_t left, int32_t right, std::vector<std::string> columns_to_match,
+      std::vector<std::string> columns_to_add);
+
+  /**
+   * Sends everything recorded so far in one Batch call, exporting only the operations at
+   * 'offsets'. An offset may appear more than once, in which case the same table is returned for
+   * each. The builder is not changed, so it can be added to and submitted again.
+   * @return The exported tables, in the order of 'offsets'
+   */
+  [[nodiscard]]
+  std::vector<std::shared_ptr<TableHandleImpl>> Submit(const std::vector<int32_t> &offsets);
+
+private:
+  /**
+   * Returns the result_id of the request held by an Operation.
+   */
+  using resultId_t = Ticket *(*)(Operation *);
+
+  /**
+   * Records 'op' and returns its offset. Its sources are offsets that Add() returned earlier,
+   * since the only way to get an offset is from a QueryTable this builder made, so every
+   * operation reads from operations before it, as the server requires.
+   */
+  [[nodiscard]]
+  int32_t Add(Operation op, resultId_t result_id);
+
+  std::shared_ptr<TableHandleManagerImpl> manager_;
+
+  // Protects the below.
+  std::mutex mutex_;
+  BatchTableRequest request_;
+  // Parallel to request_.ops().
+  std::vector<resultId_t> resultIds_;
+  std::vector<std::shared_ptr<TableHandleImpl>> tableHandles_;
+};
+}  // namespace deephaven::client::impl
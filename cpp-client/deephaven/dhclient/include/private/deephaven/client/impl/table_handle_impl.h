@@ -3,8 +3,11 @@
  */
 #pragma once
 
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include "deephaven/client/client.h"
@@ -12,7 +15,9 @@
 #include "deephaven/client/subscription/subscription_handle.h"
 #include "deephaven/client/update_by.h"
 #include "deephaven/client/utility/executor.h"
+#include "deephaven/dhcore/clienttable/client_table.h"
 #include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/ticking/subscription_options.h"
 #include "deephaven/dhcore/ticking/ticking.h"
 #include "deephaven/dhcore/types.h"
 #include "deephaven_core/proto/session.pb.h"
@@ -29,10 +34,14 @@ class TableHandleImpl : public std::enable_shared_from_this<TableHandleImpl> {
   struct Private {
   };
   using SortPair = deephaven::client::SortPair;
+  using ClientTable = deephaven::dhcore::clienttable::ClientTable;
+  using RowSequence = deephaven::dhcore::container::RowSequence;
   using SubscriptionHandle = deephaven::client::subscription::SubscriptionHandle;
   using Executor = deephaven::client::utility::Executor;
   using SchemaType = deephaven::dhcore::clienttable::Schema;
   using TickingCallback = deephaven::dhcore::ticking::TickingCallback;
+  using SubscriptionOptions = deephaven::dhcore::ticking::SubscriptionOptions;
+  using SubscriptionMetrics = deephaven::dhcore::ticking::SubscriptionMetrics;
   using ElementTypeId = deephaven::dhcore::ElementTypeId;
   using AsOfJoinTablesRequest = io::deephaven::proto::backplane::grpc::AsOfJoinTablesRequest;
   using ComboAggregateRequest = io::deephaven::proto::backplane::grpc::ComboAggregateRequest;
@@ -45,7 +54,7 @@ public:
   static std::shared_ptr<TableHandleImpl> Create(std::shared_ptr<TableHandleManagerImpl> thm,
       ExportedTableCreationResponse response);
   TableHandleImpl(Private, std::shared_ptr<TableHandleManagerImpl> &&thm, TicketType &&ticket,
-      int64_t num_rows, bool is_static);
+      int64_t num_rows, bool is_static, std::string &&schema_header);
   ~TableHandleImpl();
 
   [[nodiscard]]
@@ -109,6 +118,9 @@ public:
   [[nodiscard]]
   std::shared_ptr<TableHandleImpl> Head(int64_t n);
   [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> Slice(int64_t first_position_inclusive,
+      int64_t last_position_exclusive);
+  [[nodiscard]]
   std::shared_ptr<TableHandleImpl> Ungroup(bool null_fill, std::vector<std::string> group_by_columns);
   [[nodiscard]]
   std::shared_ptr<TableHandleImpl> Merge(std::string key_column, std::vector<TicketType> source_tickets);
@@ -148,6 +160,47 @@ public:
   std::shared_ptr<TableHandleImpl> WhereIn(const TableHandleImpl &filter_table,
       std::vector<std::string> columns);
 
+  // The asynchronous forms of the above. See TableHandle::SelectAsync(). The result is made at
+  // once from its ticket, and is pending until the server replies.
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> SelectAsync(std::vector<std::string> column_specs);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> UpdateAsync(std::vector<std::string> column_specs);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> LazyUpdateAsync(std::vector<std::string> column_specs);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> ViewAsync(std::vector<std::string> column_specs);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> UpdateViewAsync(std::vector<std::string> column_specs);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> DropColumnsAsync(std::vector<std::string> column_specs);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> WhereAsync(std::string condition);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> SortAsync(std::vector<SortPair> sort_pairs);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> HeadAsync(int64_t n);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> TailAsync(int64_t n);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> SliceAsync(int64_t first_position_inclusive,
+      int64_t last_position_exclusive);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> CrossJoinAsync(const TableHandleImpl &right_side,
+      std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> NaturalJoinAsync(const TableHandleImpl &right_side,
+      std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> ExactJoinAsync(const TableHandleImpl &right_side,
+      std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> AjAsync(const TableHandleImpl &right_side,
+      std::vector<std::string> on, std::vector<std::string> joins);
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> RajAsync(const TableHandleImpl &right_side,
+      std::vector<std::string> on, std::vector<std::string> joins);
+
   void AddTable(const TableHandleImpl &table_to_add);
   void RemoveTable(const TableHandleImpl &table_to_remove);
 
@@ -155,15 +208,53 @@ public:
 
   [[nodiscard]]
   std::shared_ptr<SubscriptionHandle> Subscribe(std::shared_ptr<TickingCallback> callback);
+  /**
+   * @param columns The names of the columns to subscribe to, or nullptr for all columns
+   * @param viewport The row positions to subscribe to, or nullptr for the whole table
+   */
+  [[nodiscard]]
+  std::shared_ptr<SubscriptionHandle> Subscribe(std::shared_ptr<TickingCallback> callback,
+      const std::vector<std::string> *columns, const RowSequence *viewport,
+      bool reverse_viewport, const SubscriptionOptions &options);
   [[nodiscard]]
   std::shared_ptr<SubscriptionHandle> Subscribe(TableHandle::onTickCallback_t on_tick,
       void *on_tick_user_data, TableHandle::onErrorCallback_t on_error, void *on_error_user_data);
   void Unsubscribe(const std::shared_ptr<SubscriptionHandle> &handle);
+  void SetViewport(const std::shared_ptr<SubscriptionHandle> &handle, const RowSequence *viewport,
+      bool reverse_viewport);
+  [[nodiscard]]
+  SubscriptionMetrics GetSubscriptionMetrics(const std::shared_ptr<SubscriptionHandle> &handle) const;
 
+  /**
+   * @param rows The row positions to fetch, or nullptr for the whole table
+   * @param columns The names of the columns to fetch, or nullptr for all columns
+   */
+  [[nodiscard]]
+  std::shared_ptr<ClientTable> Snapshot(const RowSequence *rows,
+      const std::vector<std::string> *columns, bool reverse_viewport,
+      const SubscriptionOptions &options);
+
+  /**
+   * Splits the table into 'num_streams' contiguous row ranges, made on the server as Slices in
+   * one batch, and reads them with concurrent DoGets on the Flight channels of
+   * Server::FlightClients, one worker per channel. The batches are put back together in row order.
+   */
+  [[nodiscard]]
+  std::shared_ptr<arrow::Table> ToArrowTableParallel(size_t num_streams, bool cooked);
+
+  /**
+   * Waits for the server to create a table made by one of the ...Async operations, and throws if
+   * it could not. Returns at once for any other table.
+   */
+  void Await() const;
   [[nodiscard]]
-  int64_t NumRows() const { return num_rows_; }
+  int64_t NumRows() const;
   [[nodiscard]]
-  bool IsStatic() const { return is_static_; }
+  bool IsStatic() const;
+  /**
+   * Decodes the schema the server sent along with the table, or if it sent none, fetches it with
+   * a Flight GetSchema call. Either way it is done once, on first use.
+   */
   [[nodiscard]]
   std::shared_ptr<SchemaType> Schema();
 
@@ -180,6 +271,22 @@ private:
   std::shared_ptr<TableHandleImpl>
   SelectOrUpdateHelper(std::vector<std::string> column_specs, selectOrUpdateMethod_t which_method);
 
+  // A pointer to member of the stub's callback API, taking (context, request, resp, on_done).
+  template<typename Request>
+  using asyncMethod_t = void(TableService::Stub::async::*)(grpc::ClientContext *context,
+      const Request *request, ExportedTableCreationResponse *resp,
+      std::function<void(grpc::Status)> on_done);
+
+  /**
+   * Sends 'request' with 'method' and returns at once with the new table, made from the request's
+   * result ticket. The table can be used right away, including as the source of more requests,
+   * which the server holds until it exists. It is pending until the server replies; Await()
+   * and the accessors that need the reply wait for it.
+   */
+  template<typename Request>
+  [[nodiscard]]
+  std::shared_ptr<TableHandleImpl> SendAsync(Request request, asyncMethod_t<Request> method);
+
   [[nodiscard]]
   std::shared_ptr<TableHandleImpl> DefaultAggregateByDescriptor(
       ComboAggregateRequest::Aggregate descriptor, std::vector<std::string> group_by_columns);
@@ -188,6 +295,9 @@ private:
   DefaultAggregateByType(ComboAggregateRequest::AggType aggregate_type,
       std::vector<std::string> group_by_columns);
 
+  [[nodiscard]]
+  std::shared_ptr<SchemaType> FetchSchema();
+
   [[nodiscard]]
   std::shared_ptr<TableHandleImpl> HeadOrTailHelper(bool head, int64_t n);
   [[nodiscard]]
@@ -198,7 +308,26 @@ private:
   TicketType ticket_;
   int64_t num_rows_ = 0;
   bool is_static_ = false;
+  // Valid only for a table made by SendAsync. It becomes ready, or holds the error, when the
+  // server's reply has arrived, by which time num_rows_, is_static_ and schemaHeader_ are filled
+  // in from it.
+  std::shared_future<void> created_;
+  /**
+   * Shared between a table made by SendAsync and the completion of its request. If the table is
+   * destroyed before the server has replied, the destructor leaves the ticket here for the
+   * completion to release, so that the Release can't reach the server ahead of the request that
+   * creates the export.
+   */
+  struct Creation {
+    std::mutex mutex_;
+    bool done_ = false;
+    std::optional<TicketType> orphan_;
+  };
+  std::shared_ptr<Creation> creation_;
   std::mutex mutex_;
+  // The schema_header of the ExportedTableCreationResponse that created this table: an Arrow IPC
+  // Schema message, or empty. Schema() consumes it.
+  std::string schemaHeader_;
   bool schema_request_sent_ = false;
   std::shared_future<std::shared_ptr<SchemaType>> schema_future_;
 };
@@ -7,6 +7,7 @@
 #include <optional>
 #include "deephaven/client/server/server.h"
 #include "deephaven/client/subscription/subscription_handle.h"
+#include "deephaven/client/subscription/subscription_scheduler.h"
 #include "deephaven/client/utility/executor.h"
 
 namespace deephaven::client::impl {
@@ -17,6 +18,7 @@ class TableHandleManagerImpl final : public std::enable_shared_from_this<TableHa
   using ServerType = deephaven::client::server::Server;
   using SubscriptionHandle = deephaven::client::subscription::SubscriptionHandle;
   using ExecutorType = deephaven::client::utility::Executor;
+  using SubscriptionSchedulerType = deephaven::client::subscription::SubscriptionScheduler;
   using AsOfJoinTablesRequest = io::deephaven::proto::backplane::grpc::AsOfJoinTablesRequest;
   using ComboAggregateRequest = io::deephaven::proto::backplane::grpc::ComboAggregateRequest;
   using ExportedTableCreationResponse = io::deephaven::proto::backplane::grpc::ExportedTableCreationResponse;
@@ -30,11 +32,13 @@ public:
   [[nodiscard]]
   static std::shared_ptr<TableHandleManagerImpl> Create(std::optional<Ticket> console_id,
       std::shared_ptr<ServerType> server, std::shared_ptr<ExecutorType> executor,
-      std::shared_ptr<ExecutorType> flight_executor);
+      std::shared_ptr<ExecutorType> flight_executor,
+      std::shared_ptr<SubscriptionSchedulerType> subscription_scheduler);
 
   TableHandleManagerImpl(Private, std::optional<Ticket> &&console_id,
       std::shared_ptr<ServerType> &&server, std::shared_ptr<ExecutorType> &&executor,
-      std::shared_ptr<ExecutorType> &&flight_executor);
+      std::shared_ptr<ExecutorType> &&flight_executor,
+      std::shared_ptr<SubscriptionSchedulerType> &&subscription_scheduler);
   TableHandleManagerImpl(const TableHandleManagerImpl &other) = delete;
   TableHandleManagerImpl &operator=(const TableHandleManagerImpl &other) = delete;
   ~TableHandleManagerImpl();
@@ -76,6 +80,14 @@ public:
   const std::shared_ptr<ExecutorType> &Executor() const { return executor_; }
   [[nodiscard]]
   const std::shared_ptr<ExecutorType> &FlightExecutor() const { return flightExecutor_; }
+  /**
+   * The scheduler that multiplexes subscriptions (see ClientOptions::SetSubscriptionThreads), or
+   * null if each subscription gets threads of its own.
+   */
+  [[nodiscard]]
+  const std::shared_ptr<SubscriptionSchedulerType> &SubscriptionScheduler() const {
+    return subscriptionScheduler_;
+  }
 
 private:
   const std::string me_;  // useful printable object name for logging
@@ -83,6 +95,7 @@ private:
   std::shared_ptr<ServerType> server_;
   std::shared_ptr<ExecutorType> executor_;
   std::shared_ptr<ExecutorType> flightExecutor_;
+  std::shared_ptr<SubscriptionSchedulerType> subscriptionScheduler_;
   // Protects the below for concurrent access.
   std::mutex mutex_;
   // The SubscriptionHandles for the tables we have subscribed to. We keep these at the TableHandleManagerImpl level
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "deephaven/client/client.h"
+#include "deephaven/client/impl/util.h"
+#include "deephaven_core/proto/table.pb.h"
+#include "deephaven_core/proto/ticket.pb.h"
+
+/**
+ * Builders for the requests of the table operations. They are shared by the synchronous and
+ * asynchronous operations of TableHandleImpl, which refer to their sources by ticket, and by
+ * QueryBuilderImpl, which mostly refers to them by their offset in a BatchTableRequest. The
+ * 'result' ticket is left empty for the operations in a batch that are not exported.
+ */
+namespace deephaven::client::impl {
+/**
+ * Makes a TableReference that refers to 'ticket'.
+ */
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::TableReference MakeTicketReference(
+    io::deephaven::proto::backplane::grpc::Ticket ticket);
+/**
+ * Makes the ticket that refers to the variable 'table_name' in the server's scope.
+ */
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::Ticket MakeScopeReference(std::string_view table_name);
+
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::EmptyTableRequest MakeEmptyTableRequest(int64_t size,
+    io::deephaven::proto::backplane::grpc::Ticket result);
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::FetchTableRequest MakeFetchTableRequest(
+    io::deephaven::proto::backplane::grpc::TableReference source,
+    io::deephaven::proto::backplane::grpc::Ticket result);
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::SelectOrUpdateRequest MakeSelectOrUpdateRequest(
+    io::deephaven::proto::backplane::grpc::TableReference source,
+    std::vector<std::string> column_specs, io::deephaven::proto::backplane::grpc::Ticket result);
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::DropColumnsRequest MakeDropColumnsRequest(
+    io::deephaven::proto::backplane::grpc::TableReference source,
+    std::vector<std::string> column_specs, io::deephaven::proto::backplane::grpc::Ticket result);
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::UnstructuredFilterTableRequest MakeWhereRequest(
+    io::deephaven::proto::backplane::grpc::TableReference source, std::string condition,
+    io::deephaven::proto::backplane::grpc::Ticket result);
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::SortTableRequest MakeSortRequest(
+    io::deephaven::proto::backplane::grpc::TableReference source,
+    std::vector<SortPair> sort_pairs, io::deephaven::proto::backplane::grpc::Ticket result);
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::HeadOrTailRequest MakeHeadOrTailRequest(
+    io::deephaven::proto::backplane::grpc::TableReference source, int64_t n,
+    io::deephaven::proto::backplane::grpc::Ticket result);
+[[nodiscard]]
+io::deephaven::proto::backplane::grpc::SliceRequest MakeSliceRequest(
+    io::deephaven::proto::backplane::grpc::TableReference source, int64_t first_position_inclusive,
+    int64_t last_position_exclusive, io::deephaven::proto::backplane::grpc::Ticket result);
+
+/**
+ * CrossJoinTablesRequest, NaturalJoinTablesRequest and ExactJoinTablesRequest have the same fields.
+ */
+template<typename Request>
+[[nodiscard]]
+Request MakeJoinRequest(io::deephaven::proto::backplane::grpc::TableReference left,
+    io::deephaven::proto::backplane::grpc::TableReference right,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add,
+    io::deephaven::proto::backplane::grpc::Ticket result) {
+  Request req;
+  *req.mutable_result_id() = std::move(result);
+  *req.mutable_left_id() = std::move(left);
+  *req.mutable_right_id() = std::move(right);
+  MoveVectorData(std::move(columns_to_match), req.mutable_columns_to_match());
+  MoveVectorData(std::move(columns_to_add), req.mutable_columns_to_add());
+  return req;
+}
+}  // namespace deephaven::client::impl
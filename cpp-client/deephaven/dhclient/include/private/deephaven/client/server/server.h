@@ -4,14 +4,20 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 #include <string>
 #include <cstring>
 #include <cstdint>
+#include <exception>
 #include <arrow/flight/client.h>
+#include <grpcpp/generic/generic_stub.h>
 
 #include "deephaven/client/client_options.h"
 #include "deephaven/client/server/server_shared_state.h"
@@ -79,7 +85,10 @@ public:
       std::unique_ptr<TableService::Stub> table_stub,
       std::unique_ptr<ConfigService::Stub> config_stub,
       std::unique_ptr<InputTableService::Stub> input_table_stub,
+      std::unique_ptr<grpc::GenericStub> generic_stub,
       std::unique_ptr<arrow::flight::FlightClient> flight_client,
+      arrow::flight::Location flight_location,
+      arrow::flight::FlightClientOptions flight_options,
       std::shared_ptr<ServerSharedState> shared_state);
   ~Server();
 
@@ -101,10 +110,32 @@ public:
   [[nodiscard]]
   TableService::Stub *TableStub() const { return tableStub_.get(); }
 
+  /**
+   * For calls that have no generated stub, such as the asynchronous DoExchange sessions of the
+   * SubscriptionScheduler. Shares the channel of the other stubs.
+   */
+  [[nodiscard]]
+  grpc::GenericStub *GenericStub() const { return genericStub_.get(); }
+
   // TODO(kosak): decide on the multithreaded story here
   [[nodiscard]]
   arrow::flight::FlightClient *FlightClient() const { return flightClient_.get(); }
 
+  /**
+   * The most FlightClients (and so connections) FlightClients() hands out.
+   */
+  static constexpr size_t kMaxFlightClients = 8;
+
+  /**
+   * Returns min(n, kMaxFlightClients) FlightClients, each on a channel (and so a connection) of
+   * its own, for transfers that should run side by side rather than share one HTTP/2 connection.
+   * The first is FlightClient(). The others are created the first time they are asked for, with
+   * the same options and authentication, and are kept for the life of the Server. Shutdown()
+   * closes them.
+   */
+  [[nodiscard]]
+  std::vector<arrow::flight::FlightClient *> FlightClients(size_t n);
+
   void Shutdown();
 
   /**
@@ -113,12 +144,26 @@ public:
   [[nodiscard]]
   Ticket NewTicket();
 
+  /**
+   * Queues 'ticket' to be released by the release thread, and returns without waiting for the
+   * server. Only blocks if the queue is full. Shutdown() sends whatever is still queued.
+   */
   void Release(Ticket ticket);
 
   void SendRpc(const std::function<grpc::Status(grpc::ClientContext*)> &callback) {
     SendRpc(callback, false);
   }
 
+  /**
+   * The asynchronous counterpart of SendRpc. 'callback' starts the call, typically through the
+   * stub's callback API, handing gRPC the completion function it is given. When the call
+   * finishes, 'on_done' is invoked on a gRPC thread, with null on success or else the error that
+   * SendRpc would have thrown. Throws right away if the server has been cancelled.
+   */
+  void SendRpcAsync(
+      const std::function<void(grpc::ClientContext*, std::function<void(grpc::Status)>)> &callback,
+      std::function<void(std::exception_ptr)> on_done);
+
   void ForEachHeaderNameAndValue(
       const std::function<void(const std::string &, const std::string &)> &fun);
 
@@ -131,13 +176,36 @@ public:
 private:
   void SendRpc(const std::function<grpc::Status(grpc::ClientContext*)> &callback,
       bool disregard_cancellation_state);
-  void ReleaseUnchecked(Ticket ticket);
+  void SendRpcAsync(
+      const std::function<void(grpc::ClientContext*, std::function<void(grpc::Status)>)> &callback,
+      std::function<void(std::exception_ptr)> on_done, bool disregard_cancellation_state);
+  /**
+   * Adds our headers to 'ctx', and throws if we have been cancelled (unless told not to).
+   */
+  void PrepareContext(grpc::ClientContext *ctx, bool disregard_cancellation_state);
+  /**
+   * Throws if 'status' is an error. Otherwise picks up any refreshed session token and pushes
+   * back the next handshake.
+   */
+  static void ProcessResponse(ServerSharedState *shared_state, const grpc::ClientContext &ctx,
+      const grpc::Status &status, std::chrono::system_clock::time_point send_time);
 
 
   static void SendKeepaliveMessages(const std::shared_ptr<Server> &self);
   [[nodiscard]]
   bool KeepaliveHelper();
 
+  /**
+   * The body of the release thread. Takes up to kMaxReleasesInFlight tickets off the queue at a
+   * time and releases them with ReleaseBatch, until Shutdown() and the queue is empty.
+   */
+  static void ReleaseTickets(const std::shared_ptr<Server> &self);
+  /**
+   * SessionService has no call that releases several tickets, so we send the Release calls for
+   * 'tickets' all at once through the callback API and wait for them together.
+   */
+  void ReleaseBatch(std::vector<Ticket> tickets);
+
   const std::string me_;  // useful printable object name for logging
   std::unique_ptr<ApplicationService::Stub> applicationStub_;
   std::unique_ptr<ConsoleService::Stub> consoleStub_;
@@ -145,8 +213,28 @@ private:
   std::unique_ptr<TableService::Stub> tableStub_;
   std::unique_ptr<ConfigService::Stub> configStub_;
   std::unique_ptr<InputTableService::Stub> input_table_stub_;
+  std::unique_ptr<grpc::GenericStub> genericStub_;
   std::unique_ptr<arrow::flight::FlightClient> flightClient_;
+  // For making more FlightClients like flightClient_.
+  arrow::flight::Location flightLocation_;
+  arrow::flight::FlightClientOptions flightOptions_;
+  // Protects extraFlightClients_.
+  std::mutex flightClientsMutex_;
+  std::vector<std::unique_ptr<arrow::flight::FlightClient>> extraFlightClients_;
 
   std::shared_ptr<ServerSharedState> shared_state_;
+
+  // Ticket bookkeeping and the release queue. Protects the below.
+  std::mutex ticketMutex_;
+  // Signalled when there are tickets to release, when there is room in the queue, and on Shutdown.
+  std::condition_variable ticketCondVar_;
+  int32_t nextFreeTicketId_ = 1;
+  // Set by Shutdown(). After this, Release() is a no-op.
+  bool ticketsClosed_ = false;
+  // The tickets we have handed out and not yet been asked to release, by their bytes.
+  std::unordered_set<std::string> outstandingTickets_;
+  // The tickets waiting for the release thread.
+  std::vector<Ticket> releaseQueue_;
+  std::thread releaseThread_;
 };
 }  // namespace deephaven::client::server
@@ -15,22 +15,11 @@
 
 namespace deephaven::client::server {
 
-namespace internal {
-struct TicketLess {
-  using Ticket = io::deephaven::proto::backplane::grpc::Ticket;
-
-  bool operator()(const Ticket &lhs, const Ticket &rhs) const {
-    return lhs.ticket() < rhs.ticket();
-  }
-};
-}  // namespace internal
-
 /**
- * This struct is shared between Server, BearerMiddleware, and BearerMiddlewareFactory.
+ * This struct is shared between Server, BearerMiddleware, and BearerMiddlewareFactory. The
+ * middleware takes mutex_ on every call, so the Server keeps its ticket bookkeeping elsewhere.
  */
 struct ServerSharedState {
-  using Ticket = io::deephaven::proto::backplane::grpc::Ticket;
-
   ServerSharedState(ClientOptions::extra_headers_t extra_headers,
       std::string session_token,
       std::chrono::milliseconds expiration_interval,
@@ -41,9 +30,7 @@ struct ServerSharedState {
   const ClientOptions::extra_headers_t extraHeaders_;
   std::mutex mutex_;
   std::condition_variable condVar_;
-  int32_t nextFreeTicketId_ = 1;
   bool cancelled_ = false;
-  std::set<Ticket, internal::TicketLess> outstanding_tickets_;
   std::string sessionToken_;
   std::chrono::milliseconds expirationInterval_;
   std::chrono::system_clock::time_point nextHandshakeTime_;
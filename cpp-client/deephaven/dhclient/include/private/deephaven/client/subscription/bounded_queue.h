@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace deephaven::client::subscription {
+/**
+ * A blocking queue holding at most 'capacity' items, which connects two stages of a pipelined
+ * subscription. The producer either closes it, when it has nothing more to send (perhaps because
+ * of an error, which the consumer can pick up once it has drained the queue), or aborts it, which
+ * wakes everyone up and throws away whatever is queued.
+ */
+template<typename T>
+class BoundedQueue {
+public:
+  explicit BoundedQueue(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+  /**
+   * Adds 'item' to the back of the queue, waiting while the queue is full.
+   * @return false if the queue was closed or aborted, in which case 'item' is dropped
+   */
+  bool Push(T item) {
+    std::unique_lock guard(mutex_);
+    notFull_.wait(guard, [this]() { return items_.size() < capacity_ || closed_; });
+    if (closed_) {
+      return false;
+    }
+    PushLocked(std::move(item));
+    return true;
+  }
+
+  /**
+   * Adds 'item' to the back of the queue. If the queue is full, does not wait, but instead
+   * replaces all the queued items and 'item' with the single item
+   * fold(...fold(fold(items[0], items[1]), items[2])..., item).
+   * The queued items are taken out of the queue before folding and the lock is not held while
+   * 'fold' runs, so the consumer and the metrics are not held up by it. If 'fold' throws, the
+   * taken items and 'item' are dropped and the exception propagates.
+   * @param num_folded Set to the number of items that were absorbed into others: 0 if the queue
+   *   was not full, otherwise the number of items that were queued.
+   * @return false if the queue was closed or aborted, in which case 'item' is dropped
+   */
+  template<typename Fold>
+  bool PushOrFold(T item, const Fold &fold, size_t *num_folded) {
+    *num_folded = 0;
+    std::unique_lock guard(mutex_);
+    if (closed_) {
+      return false;
+    }
+    if (items_.size() < capacity_) {
+      PushLocked(std::move(item));
+      return true;
+    }
+
+    std::deque<T> taken;
+    taken.swap(items_);
+    guard.unlock();
+    notFull_.notify_all();
+
+    // If 'fold' throws, 'taken' goes away with everything in it, so nothing moved-from can reach
+    // the consumer.
+    T combined = std::move(taken.front());
+    for (size_t i = 1; i != taken.size(); ++i) {
+      combined = fold(combined, taken[i]);
+    }
+    item = fold(combined, item);
+    auto num_taken = taken.size();
+    taken.clear();
+
+    guard.lock();
+    if (closed_) {
+      return false;
+    }
+    // Anything pushed while we were folding came later than what we took, so the folded item
+    // goes in front of it.
+    items_.push_front(std::move(item));
+    highWater_ = std::max(highWater_, items_.size());
+    guard.unlock();
+    notEmpty_.notify_one();
+    *num_folded = num_taken;
+    return true;
+  }
+
+  /**
+   * Removes the item at the front of the queue, waiting while the queue is empty.
+   * @return The item, or an empty optional if the queue has been closed and drained, or aborted
+   */
+  std::optional<T> Pop() {
+    std::unique_lock guard(mutex_);
+    notEmpty_.wait(guard, [this]() { return !items_.empty() || closed_; });
+    if (items_.empty()) {
+      return {};
+    }
+    auto result = std::move(items_.front());
+    items_.pop_front();
+    guard.unlock();
+    notFull_.notify_one();
+    return result;
+  }
+
+  /**
+   * Refuses further items. Pop() returns the items already queued and then an empty optional.
+   * Has no effect on a queue that is already closed or aborted.
+   * @param error Why the producer stopped, or null if it just finished
+   */
+  void Close(std::exception_ptr error) {
+    std::unique_lock guard(mutex_);
+    if (closed_) {
+      return;
+    }
+    closed_ = true;
+    error_ = std::move(error);
+    guard.unlock();
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  /**
+   * Closes the queue and discards its contents.
+   */
+  void Abort() {
+    std::unique_lock guard(mutex_);
+    closed_ = true;
+    items_.clear();
+    guard.unlock();
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  /**
+   * The error the queue was closed with, if any.
+   */
+  [[nodiscard]]
+  std::exception_ptr Error() const {
+    std::unique_lock guard(mutex_);
+    return error_;
+  }
+
+  [[nodiscard]]
+  size_t Capacity() const { return capacity_; }
+
+  [[nodiscard]]
+  size_t Size() const {
+    std::unique_lock guard(mutex_);
+    return items_.size();
+  }
+
+  /**
+   * The most items the queue has held at once.
+   */
+  [[nodiscard]]
+  size_t HighWater() const {
+    std::unique_lock guard(mutex_);
+    return highWater_;
+  }
+
+private:
+  void PushLocked(T item) {
+    items_.push_back(std::move(item));
+    highWater_ = std::max(highWater_, items_.size());
+    notEmpty_.notify_one();
+  }
+
+  size_t capacity_ = 0;
+  mutable std::mutex mutex_;
+  std::condition_variable notEmpty_;
+  std::condition_variable notFull_;
+  std::deque<T> items_;
+  bool closed_ = false;
+  std::exception_ptr error_;
+  size_t highWater_ = 0;
+};
+}  // namespace deephaven::client::subscription
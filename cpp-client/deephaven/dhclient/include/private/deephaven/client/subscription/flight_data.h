@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <arrow/buffer.h>
+#include <grpcpp/support/byte_buffer.h>
+
+namespace deephaven::client::subscription {
+/**
+ * The fields of an arrow.flight.protocol.FlightData message that matter to Barrage. The
+ * SubscriptionScheduler speaks DoExchange through gRPC's generic API, so it encodes and decodes
+ * these messages by hand rather than through Arrow Flight. A field that is absent is nullptr.
+ */
+struct FlightData {
+  std::shared_ptr<arrow::Buffer> dataHeader_;
+  std::shared_ptr<arrow::Buffer> appMetadata_;
+  std::shared_ptr<arrow::Buffer> dataBody_;
+};
+
+/**
+ * Decodes the FlightData message in 'buffer', skipping the fields we don't use. Throws if the
+ * message is malformed or truncated.
+ */
+[[nodiscard]]
+FlightData ParseFlightData(grpc::ByteBuffer *buffer);
+/**
+ * Encodes a FlightData message carrying 'app_metadata'. The first message of the exchange also
+ * carries the FlightDescriptor that tells the server this is a Barrage exchange.
+ */
+[[nodiscard]]
+grpc::ByteBuffer MakeFlightData(bool with_descriptor, const std::vector<uint8_t> &app_metadata);
+}  // namespace deephaven::client::subscription
@@ -3,10 +3,17 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <vector>
+#include <arrow/flight/types.h>
 #include "deephaven/client/server/server.h"
 #include "deephaven/client/subscription/subscription_handle.h"
 #include "deephaven/dhcore/clienttable/client_table.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/barrage_processor.h"
+#include "deephaven/dhcore/ticking/subscription_options.h"
 #include "deephaven/dhcore/ticking/ticking.h"
 #include "deephaven_core/proto/ticket.pb.h"
 
@@ -14,14 +21,52 @@ namespace deephaven::client::subscription {
 class SubscriptionThread {
   using Server = deephaven::client::server::Server;
   using Executor = deephaven::client::utility::Executor;
+  using RowSequence = deephaven::dhcore::container::RowSequence;
+  using ClientTable = deephaven::dhcore::clienttable::ClientTable;
   using Schema = deephaven::dhcore::clienttable::Schema;
+  using BarrageProcessor = deephaven::dhcore::ticking::BarrageProcessor;
+  using SubscriptionOptions = deephaven::dhcore::ticking::SubscriptionOptions;
   using Ticket = io::deephaven::proto::backplane::grpc::Ticket;
   using TickingCallback = deephaven::dhcore::ticking::TickingCallback;
+  using TickingUpdate = deephaven::dhcore::ticking::TickingUpdate;
 
 public:
+  /**
+   * Starts a subscription.
+   * @param column_indices The indices of the columns to subscribe to, or nullptr for all columns
+   * @param viewport The row positions to subscribe to, or nullptr for the whole table
+   * @param reverse_viewport If true, the positions in 'viewport' are counted backwards from the
+   *   end of the table
+   * @param options Settings for the BarrageSubscriptionOptions sent to the server
+   */
   [[nodiscard]]
   static std::shared_ptr<SubscriptionHandle> Start(std::shared_ptr<Server> server,
       Executor *flight_executor, std::shared_ptr<Schema> schema,
-      const Ticket &ticket, std::shared_ptr<TickingCallback> callback);
+      const Ticket &ticket, std::shared_ptr<TickingCallback> callback,
+      const std::vector<size_t> *column_indices, const RowSequence *viewport,
+      bool reverse_viewport, const SubscriptionOptions &options);
+
+  /**
+   * Fetches a one-time snapshot of the table with a BarrageSnapshotRequest. This runs on the
+   * caller's thread and returns once the server's snapshot message has been processed.
+   * @param column_indices The indices of the columns to fetch, or nullptr for all columns
+   * @param viewport The row positions to fetch, or nullptr for the whole table
+   * @param reverse_viewport If true, the positions in 'viewport' are counted backwards from the
+   *   end of the table
+   * @param options Settings for the BarrageSnapshotOptions sent to the server
+   */
+  [[nodiscard]]
+  static std::shared_ptr<ClientTable> Snapshot(std::shared_ptr<Server> server,
+      std::shared_ptr<Schema> schema, const Ticket &ticket,
+      const std::vector<size_t> *column_indices, const RowSequence *viewport,
+      bool reverse_viewport, const SubscriptionOptions &options);
+
+  /**
+   * Feeds one Flight message of a Barrage stream to 'bp'.
+   * @return The update that the message completes, if any
+   */
+  [[nodiscard]]
+  static std::optional<TickingUpdate> ProcessChunk(BarrageProcessor *bp,
+      const arrow::flight::FlightStreamChunk &chunk);
 };
 }  // namespace deephaven::client::subscription
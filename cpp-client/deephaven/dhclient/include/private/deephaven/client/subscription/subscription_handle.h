@@ -3,13 +3,35 @@
  */
 #pragma once
 
+#include <memory>
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/subscription_options.h"
+
 namespace deephaven::client::subscription {
 class SubscriptionHandle {
+protected:
+  using RowSequence = deephaven::dhcore::container::RowSequence;
+  using SubscriptionMetrics = deephaven::dhcore::ticking::SubscriptionMetrics;
+
 public:
   virtual ~SubscriptionHandle() = default;
   /**
    * Cancels the subscription and waits for the corresponding thread to die.
    */
   virtual void Cancel() = 0;
+  /**
+   * Asks the server to move the viewport of this subscription. The change takes effect
+   * asynchronously, with the next snapshot the server sends. Throws if this would switch the
+   * subscription between a viewport and the whole table, which the server does not allow.
+   * @param viewport The row positions to subscribe to, or nullptr for the whole table
+   * @param reverse_viewport If true, the positions in 'viewport' are counted backwards from the
+   *   end of the table
+   */
+  virtual void SetViewport(const RowSequence *viewport, bool reverse_viewport) = 0;
+  /**
+   * A snapshot of the subscription's counters.
+   */
+  [[nodiscard]]
+  virtual SubscriptionMetrics Metrics() const = 0;
 };
 }  // namespace deephaven::client::subscription
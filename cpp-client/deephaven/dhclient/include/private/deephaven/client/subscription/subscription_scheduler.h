@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <grpcpp/completion_queue.h>
+#include "deephaven/client/server/server.h"
+#include "deephaven/client/subscription/subscription_handle.h"
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/subscription_options.h"
+#include "deephaven/dhcore/ticking/ticking.h"
+#include "deephaven_core/proto/ticket.pb.h"
+
+namespace deephaven::client::subscription {
+namespace internal {
+class MultiplexedSubscription;
+}  // namespace internal
+
+/**
+ * Services all the Barrage subscriptions of a client with a fixed number of threads, however many
+ * subscriptions there are (see ClientOptions::SetSubscriptionThreads). Arrow Flight can only read
+ * a stream by blocking a thread on it, so the scheduler speaks DoExchange through gRPC's
+ * asynchronous API instead. One thread drives a completion queue on which the messages of every
+ * subscription arrive, and a pool of workers decodes them and invokes the TickingCallbacks.
+ *
+ * Each subscription with work waits in a single line. A worker takes the subscription at the
+ * front, processes one of its messages and, if it has more, sends it to the back, so a busy
+ * subscription cannot starve the others. A subscription is only ever in the line once, so its
+ * messages are processed in order and its callbacks are made one at a time. Each subscription
+ * reads ahead at most max(1, SubscriptionOptions::PipelineDepth()) messages; after that the
+ * scheduler stops asking gRPC for more until a worker catches up, and gRPC's flow control
+ * pushes back on the server.
+ */
+class SubscriptionScheduler final : public std::enable_shared_from_this<SubscriptionScheduler> {
+  struct Private {};
+  using Server = deephaven::client::server::Server;
+  using RowSequence = deephaven::dhcore::container::RowSequence;
+  using Schema = deephaven::dhcore::clienttable::Schema;
+  using SubscriptionOptions = deephaven::dhcore::ticking::SubscriptionOptions;
+  using Ticket = io::deephaven::proto::backplane::grpc::Ticket;
+  using TickingCallback = deephaven::dhcore::ticking::TickingCallback;
+  using MultiplexedSubscription = internal::MultiplexedSubscription;
+
+public:
+  /**
+   * Creates the scheduler and starts its threads.
+   * @param num_threads The number of worker threads, which must be positive
+   */
+  [[nodiscard]]
+  static std::shared_ptr<SubscriptionScheduler> Create(std::shared_ptr<Server> server,
+      size_t num_threads);
+
+  SubscriptionScheduler(Private, std::shared_ptr<Server> server);
+  SubscriptionScheduler(const SubscriptionScheduler &other) = delete;
+  SubscriptionScheduler &operator=(const SubscriptionScheduler &other) = delete;
+  ~SubscriptionScheduler();
+
+  /**
+   * Starts a subscription. Like SubscriptionThread::Start, this waits until the server has
+   * accepted the DoExchange call, and throws if it does not.
+   * @param column_indices The indices of the columns to subscribe to, or nullptr for all columns
+   * @param viewport The row positions to subscribe to, or nullptr for the whole table
+   * @param reverse_viewport If true, the positions in 'viewport' are counted backwards from the
+   *   end of the table
+   * @param options Settings for the BarrageSubscriptionOptions sent to the server
+   */
+  [[nodiscard]]
+  std::shared_ptr<SubscriptionHandle> Start(std::shared_ptr<Schema> schema, const Ticket &ticket,
+      std::shared_ptr<TickingCallback> callback, const std::vector<size_t> *column_indices,
+      const RowSequence *viewport, bool reverse_viewport, const SubscriptionOptions &options);
+
+  /**
+   * Cancels every subscription and stops the threads.
+   */
+  void Shutdown();
+
+private:
+  static void RunPoller(std::shared_ptr<SubscriptionScheduler> self);
+  static void RunWorker(std::shared_ptr<SubscriptionScheduler> self);
+
+  /**
+   * Puts 'subscription' at the back of the line for a worker.
+   */
+  void Enqueue(std::shared_ptr<MultiplexedSubscription> subscription);
+  /**
+   * Called by a subscription whose stream has ended and that has no more work to do. It is only
+   * called from the subscription's OnEvent(), when gRPC hands back its last operation.
+   */
+  void Forget(const std::shared_ptr<MultiplexedSubscription> &subscription);
+
+  const std::string me_;  // useful printable object name for logging
+  std::shared_ptr<Server> server_;
+  grpc::CompletionQueue completionQueue_;
+  std::thread pollerThread_;
+  std::vector<std::thread> workerThreads_;
+
+  // Protects the below.
+  std::mutex mutex_;
+  std::condition_variable condvar_;
+  bool shutdown_ = false;
+  // The number of Start() calls that have put a subscription in live_ but not yet started its
+  // gRPC call. Shutdown() waits for these to reach zero before it cancels anything.
+  size_t starting_ = 0;
+  // Subscriptions waiting for a worker, in the order they are to be served.
+  std::deque<std::shared_ptr<MultiplexedSubscription>> ready_;
+  // Subscriptions whose stream is still open, or that still have work. The scheduler keeps them
+  // alive, since the completion queue refers to them by raw pointer.
+  std::set<std::shared_ptr<MultiplexedSubscription>> live_;
+
+  friend class internal::MultiplexedSubscription;
+};
+}  // namespace deephaven::client::subscription
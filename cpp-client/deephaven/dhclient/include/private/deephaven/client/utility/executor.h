@@ -3,44 +3,109 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
+#include "deephaven/client/utility/misc_types.h"
 #include "deephaven/dhcore/utility/utility.h"
 
 namespace deephaven::client::utility {
+/**
+ * A pool of worker threads that run the callbacks given to Invoke(). Each worker has queues of its
+ * own, one per priority, and Invoke() deals the callbacks out to the workers round robin, so
+ * concurrent callers mostly contend on different locks. A worker runs the oldest callback in its
+ * own queues, and when those are empty it steals the newest callback from another worker's queue
+ * before it goes to sleep. High priority callbacks, from any worker, run before normal ones.
+ *
+ * With one worker (the default) callbacks of the same priority run one at a time, in the order
+ * they were given. With more than one, callbacks may run concurrently and in any order.
+ */
 class Executor {
   struct Private {
   };
 
 public:
+  enum class Priority { kHigh, kNormal };
+
   [[nodiscard]]
-  static std::shared_ptr<Executor> Create(std::string id);
+  static std::shared_ptr<Executor> Create(std::string id, size_t num_threads = 1);
 
-  Executor(Private, std::string id);
+  Executor(Private, std::string id, size_t num_threads);
   ~Executor();
 
   void Shutdown();
 
   /**
-   * Enqueues 'f' on the Executor's thread. If f throws, the exception will be logged but otherwise
-   * ignored.
+   * Enqueues 'f' on one of the Executor's threads. If f throws, the exception will be logged but
+   * otherwise ignored.
    */
-  void Invoke(std::function<void()> f);
+  void Invoke(std::function<void()> f, Priority priority = Priority::kNormal);
+
+  /**
+   * The counters of this Executor, as of now.
+   */
+  [[nodiscard]]
+  ExecutorMetrics Metrics() const;
 
 private:
-  static void ThreadStart(std::shared_ptr<Executor> self);
-  void RunUntilCancelled();
+  using clock_t = std::chrono::steady_clock;
+
+  struct Task {
+    std::function<void()> fun_;
+    clock_t::time_point enqueueTime_;
+  };
+
+  struct Worker {
+    // Protects queues_.
+    std::mutex mutex_;
+    // Indexed by Priority.
+    std::array<std::deque<Task>, 2> queues_;
+  };
+
+  static void ThreadStart(std::shared_ptr<Executor> self, size_t index);
+  void RunUntilCancelled(size_t index);
+  /**
+   * Takes a task for worker 'index' if there is one anywhere, preferring high priority tasks and,
+   * within a priority, the worker's own queue.
+   */
+  [[nodiscard]]
+  bool TryTake(size_t index, Task *task);
+  void RunTask(Task *task);
 
   // For debugging.
   std::string id_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Where Invoke() puts the next task.
+  std::atomic<size_t> nextWorker_ = 0;
+  // The number of tasks queued (not yet taken) across all the workers.
+  std::atomic<size_t> queued_ = 0;
+  // The number of workers waiting on condvar_. Invoke() only takes mutex_ when this is nonzero.
+  std::atomic<size_t> sleepers_ = 0;
+  std::atomic<bool> cancelled_ = false;
+
+  // Idle workers wait here.
   std::mutex mutex_;
   std::condition_variable condvar_;
-  bool cancelled_ = false;
-  std::vector<std::function<void()>> todo_;
-  std::thread executorThread_;
+
+  // Counters for Metrics(), all in nanoseconds where they are times.
+  std::atomic<size_t> queueHighWater_ = 0;
+  std::atomic<uint64_t> tasksRun_ = 0;
+  std::atomic<uint64_t> tasksStolen_ = 0;
+  std::atomic<uint64_t> totalWaitNanos_ = 0;
+  std::atomic<uint64_t> maxWaitNanos_ = 0;
+  std::atomic<uint64_t> totalRunNanos_ = 0;
+  std::atomic<uint64_t> maxRunNanos_ = 0;
+
+  std::vector<std::thread> threads_;
 };
 }  // namespace deephaven::client::utility
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -12,6 +13,7 @@
 #include "deephaven/client/utility/misc_types.h"
 #include "deephaven/dhcore/clienttable/client_table.h"
 #include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/ticking/subscription_options.h"
 #include "deephaven/dhcore/ticking/ticking.h"
 
 /**
@@ -23,6 +25,14 @@ namespace deephaven::client {
 class FlightWrapper;
 }  // namespace deephaven::client
 
+/**
+ * Used by TableHandleManager::CreateQueryBuilder(). Callers of that method need to include
+ * deephaven/client/query_builder.h
+ */
+namespace deephaven::client {
+class QueryBuilder;
+}  // namespace deephaven::client
+
 /**
  * Internal impl classes. Their definitions are opaque here.
  */
@@ -35,9 +45,11 @@ class TableHandleManagerImpl;
 }  // namespace deephaven::client::impl
 
 /**
- * Forward reference to arrow's Table
+ * Forward reference to arrow's Table, RecordBatch and RecordBatchReader
  */
 namespace arrow {
+class RecordBatch;
+class RecordBatchReader;
 class Table;
 }  // namespace arrow
 
@@ -198,6 +210,15 @@ public:
    */
   void RunScript(std::string code) const;
 
+  /**
+   * Gets the counters of the client's internal executors (see ClientOptions::SetExecutorThreads):
+   * how busy their threads are, how long work waits for them, and how often they steal work from
+   * each other.
+   * @return The counters of each executor, as of now
+   */
+  [[nodiscard]]
+  std::vector<utility::ExecutorMetrics> GetExecutorMetrics() const;
+
   /**
    * Creates a FlightWrapper that is used for Arrow Flight integration. Arrow Flight is the primary
    * way to push data into or pull data out of the system. The object returned is only
@@ -208,6 +229,15 @@ public:
   [[nodiscard]]
   FlightWrapper CreateFlightWrapper() const;
 
+  /**
+   * Creates a QueryBuilder, which records a whole query on the client and sends it to the server
+   * in a single round trip. The object returned is only forward-referenced in this file. If you
+   * want to use it, you will also need to include deephaven/client/query_builder.h.
+   * @return A QueryBuilder object.
+   */
+  [[nodiscard]]
+  QueryBuilder CreateQueryBuilder() const;
+
 private:
   std::shared_ptr<impl::TableHandleManagerImpl> impl_;
 };
@@ -890,9 +920,12 @@ inline AggregateCombo aggCombo(std::initializer_list<Aggregate> args) {
  */
 class TableHandle {
   using ClientTable = deephaven::dhcore::clienttable::ClientTable;
+  using RowSequence = deephaven::dhcore::container::RowSequence;
   using SchemaType = deephaven::dhcore::clienttable::Schema;
   using TickingCallback = deephaven::dhcore::ticking::TickingCallback;
   using TickingUpdate = deephaven::dhcore::ticking::TickingUpdate;
+  using SubscriptionOptions = deephaven::dhcore::ticking::SubscriptionOptions;
+  using SubscriptionMetrics = deephaven::dhcore::ticking::SubscriptionMetrics;
   using SubscriptionHandle = deephaven::client::subscription::SubscriptionHandle;
 
 public:
@@ -1508,6 +1541,16 @@ public:
    */
   [[nodiscard]]
   TableHandle Tail(int64_t n) const;
+  /**
+   * Creates a new table from this table containing the rows at positions
+   * [first_position_inclusive, last_position_exclusive). Negative positions count back from the
+   * end of the table.
+   * @param first_position_inclusive The position of the first row to include
+   * @param last_position_exclusive The position just past the last row to include
+   * @return A TableHandle referencing the new table
+   */
+  [[nodiscard]]
+  TableHandle Slice(int64_t first_position_inclusive, int64_t last_position_exclusive) const;
 
   //TODO(kosak): document nullFill
   /**
@@ -1659,6 +1702,106 @@ public:
   TableHandle ExactJoin(const TableHandle &right_side, std::vector<std::string> columns_to_match,
       std::vector<std::string> columns_to_add) const;
 
+  /**
+   * The asynchronous form of Select(std::vector<std::string>) const. The request is sent right
+   * away, and the call returns a TableHandle for the new table without waiting for the server.
+   * The new handle can be used at once, including as the source of further operations, which are
+   * also sent without waiting: the server holds each one until its sources exist. So a chain of
+   * ten dependent operations, like ten independent ones, costs about one round trip rather than
+   * ten. Await(), NumRows(), IsStatic() and Schema() wait for the server to create the table, and
+   * throw the exception that Select() would have thrown if it could not. Operations that depend
+   * on a table that could not be created fail as well.
+   *
+   * Only the operations from here to RajAsync() have asynchronous forms. The others, including
+   * the aggregations, HeadBy(), TailBy(), Ungroup(), Merge(), LeftOuterJoin(), UpdateBy(),
+   * SelectDistinct() and WhereIn(), always wait for the server, though they can be applied to a
+   * handle that is still pending.
+   * @param column_specs The columnSpecs
+   * @return A TableHandle referencing the new table
+   */
+  [[nodiscard]]
+  TableHandle SelectAsync(std::vector<std::string> column_specs) const;
+  /**
+   * The asynchronous form of Update(std::vector<std::string>) const. See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle UpdateAsync(std::vector<std::string> column_specs) const;
+  /**
+   * The asynchronous form of LazyUpdate(std::vector<std::string>) const. See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle LazyUpdateAsync(std::vector<std::string> column_specs) const;
+  /**
+   * The asynchronous form of View(std::vector<std::string>) const. See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle ViewAsync(std::vector<std::string> column_specs) const;
+  /**
+   * The asynchronous form of UpdateView(std::vector<std::string>) const. See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle UpdateViewAsync(std::vector<std::string> column_specs) const;
+  /**
+   * The asynchronous form of DropColumns(std::vector<std::string>) const. See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle DropColumnsAsync(std::vector<std::string> column_specs) const;
+  /**
+   * The asynchronous form of Where(std::string) const. See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle WhereAsync(std::string condition) const;
+  /**
+   * The asynchronous form of Sort(std::vector<SortPair>) const. See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle SortAsync(std::vector<SortPair> sort_pairs) const;
+  /**
+   * The asynchronous form of Head(int64_t) const. See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle HeadAsync(int64_t n) const;
+  /**
+   * The asynchronous form of Tail(int64_t) const. See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle TailAsync(int64_t n) const;
+  /**
+   * The asynchronous form of CrossJoin(). See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle CrossJoinAsync(const TableHandle &right_side,
+      std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) const;
+  /**
+   * The asynchronous form of NaturalJoin(). See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle NaturalJoinAsync(const TableHandle &right_side,
+      std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) const;
+  /**
+   * The asynchronous form of ExactJoin(). See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle ExactJoinAsync(const TableHandle &right_side,
+      std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) const;
+  /**
+   * The asynchronous form of Slice(). See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle SliceAsync(int64_t first_position_inclusive, int64_t last_position_exclusive) const;
+  /**
+   * The asynchronous form of Aj(). See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle AjAsync(const TableHandle &right_side, std::vector<std::string> on,
+      std::vector<std::string> joins = {}) const;
+  /**
+   * The asynchronous form of Raj(). See SelectAsync().
+   */
+  [[nodiscard]]
+  TableHandle RajAsync(const TableHandle &right_side, std::vector<std::string> on,
+      std::vector<std::string> joins = {}) const;
+
   /**
    * Creates a new table containing all the rows and columns of the left table, plus additional
    * columns containing data from the right table. For columns appended to the left table (joins),
@@ -1831,6 +1974,13 @@ public:
     impl_.reset();
   }
 
+  /**
+   * Waits for the server to create a table made by one of the ...Async operations, such as
+   * SelectAsync(), and throws the operation's error if it could not. Returns at once for any
+   * other table.
+   */
+  void Await() const;
+
   /**
    * Number of rows in the table at the time this TableHandle was created.
    */
@@ -1878,12 +2028,126 @@ public:
   [[nodiscard]]
   std::shared_ptr<ClientTable> ToClientTable() const;
 
+  /**
+   * Reads the table as a stream of Arrow RecordBatches, fetching each batch from the server only
+   * when it is asked for. Unlike ToArrowTable(), the whole table never has to be in memory at
+   * once: only the batch being read, plus whatever the transport has buffered.
+   * @param cooked If true, RunEndEncoded and Dictionary columns are decoded one batch at a time
+   *   into plain arrays of their value types, and the reader's schema has those value types.
+   *   Otherwise the batches are as the server sent them.
+   * @return The reader. Closing it cancels the rest of the stream.
+   */
+  [[nodiscard]]
+  std::shared_ptr<arrow::RecordBatchReader> GetRecordBatchReader(bool cooked = true) const;
+
+  /**
+   * Reads the table one Arrow RecordBatch at a time, as the batches arrive, and calls 'callback'
+   * on each. See GetRecordBatchReader().
+   * @param callback Invoked on each batch, in order, on the calling thread
+   * @param cooked As for GetRecordBatchReader()
+   */
+  void ForEachBatch(const std::function<void(const std::shared_ptr<arrow::RecordBatch> &)> &callback,
+      bool cooked = true) const;
+
+  /**
+   * Reads in the entire table as an Arrow table, like ToArrowTable(), but over several streams at
+   * once. The table is split on the server into 'num_streams' contiguous row ranges, which are
+   * downloaded concurrently over up to 8 connections, and decoded on one thread per connection.
+   * The result is one table whose chunks are in row order. This helps when a single stream is
+   * limited by one connection or one core; for small tables it is just overhead.
+   * @param num_streams The number of row ranges. Fewer are used if the table has fewer rows. The
+   *   connections are made on first use and kept until the Client is closed.
+   * @param cooked As for GetRecordBatchReader()
+   * @return the Arrow table. Its schema is that of GetRecordBatchReader(cooked).
+   */
+  [[nodiscard]]
+  std::shared_ptr<arrow::Table> ToArrowTableParallel(size_t num_streams, bool cooked = true) const;
+
+  /**
+   * Fetches a snapshot of some of the rows and columns of the table, using a Barrage snapshot
+   * request. Unlike ToClientTable(), only the requested rows and columns are sent by the server,
+   * so this can be used to page through a very large table.
+   * @param rows The row positions to fetch
+   * @param columns The names of the columns to fetch. If empty, all columns are fetched.
+   * @param reverse_viewport If true, the positions in 'rows' are counted backwards from the end
+   *   of the table
+   * @return A ClientTable holding the requested rows in position order. It has every column of the
+   *   table's schema, but columns that were not requested are all null.
+   */
+  [[nodiscard]]
+  std::shared_ptr<ClientTable> Snapshot(const RowSequence &rows,
+      const std::vector<std::string> &columns = {}, bool reverse_viewport = false) const;
+
+  /**
+   * As above, with the batch size, message size and column conversion mode taken from 'options'.
+   * The other settings in 'options' apply only to subscriptions and are ignored.
+   */
+  [[nodiscard]]
+  std::shared_ptr<ClientTable> Snapshot(const RowSequence &rows,
+      const std::vector<std::string> &columns, bool reverse_viewport,
+      const SubscriptionOptions &options) const;
+
   /**
    * Subscribe to a ticking table.
    */
   [[nodiscard]]
   std::shared_ptr<SubscriptionHandle> Subscribe(std::shared_ptr<TickingCallback> callback);
 
+  /**
+   * Subscribe to a viewport of a ticking table. The server only sends the rows at the positions
+   * in 'viewport', and the ClientTables in the TickingUpdates delivered to the callback contain
+   * only those rows. Rows that scroll into or out of the viewport show up as adds and removes.
+   * @param callback The callback
+   * @param viewport The row positions to subscribe to
+   * @param reverse_viewport If true, the positions in 'viewport' are counted backwards from the
+   *   end of the table
+   * @param options The subscription options
+   */
+  [[nodiscard]]
+  std::shared_ptr<SubscriptionHandle> Subscribe(std::shared_ptr<TickingCallback> callback,
+      const RowSequence &viewport, bool reverse_viewport = false,
+      const SubscriptionOptions &options = SubscriptionOptions());
+
+  /**
+   * Subscribe to a subset of the columns of a ticking table. The server only sends data for the
+   * named columns, and the client keeps no state for the others. The ClientTables in the
+   * TickingUpdates delivered to the callback still have every column of the table's schema, but
+   * the unsubscribed columns are all null.
+   * @param callback The callback
+   * @param columns The names of the columns to subscribe to
+   * @param options The subscription options
+   */
+  [[nodiscard]]
+  std::shared_ptr<SubscriptionHandle> Subscribe(std::shared_ptr<TickingCallback> callback,
+      std::vector<std::string> columns,
+      const SubscriptionOptions &options = SubscriptionOptions());
+
+  /**
+   * Subscribe to a subset of the columns and a viewport of a ticking table. This combines the
+   * column-subset and viewport forms of Subscribe().
+   * @param callback The callback
+   * @param columns The names of the columns to subscribe to
+   * @param viewport The row positions to subscribe to
+   * @param reverse_viewport If true, the positions in 'viewport' are counted backwards from the
+   *   end of the table
+   * @param options The subscription options
+   */
+  [[nodiscard]]
+  std::shared_ptr<SubscriptionHandle> Subscribe(std::shared_ptr<TickingCallback> callback,
+      std::vector<std::string> columns, const RowSequence &viewport,
+      bool reverse_viewport = false, const SubscriptionOptions &options = SubscriptionOptions());
+
+  /**
+   * Subscribe to a ticking table, with tuning options such as the batch size and the minimum
+   * update interval. For tables that tick very quickly, a larger minimum update interval lets
+   * the server coalesce many small updates into one.
+   * @param callback The callback
+   * @param options The subscription options
+   */
+  [[nodiscard]]
+  std::shared_ptr<SubscriptionHandle> Subscribe(std::shared_ptr<TickingCallback> callback,
+      const SubscriptionOptions &options);
+
   using onTickCallback_t = void (*)(TickingUpdate, void *);
   using onErrorCallback_t = void (*)(std::string, void *);
   /**
@@ -1896,6 +2160,27 @@ public:
    * Unsubscribe from the table.
    */
   void Unsubscribe(const std::shared_ptr<SubscriptionHandle> &handle);
+  /**
+   * Moves the viewport of a subscription on the live connection, without resubscribing.
+   * The change takes effect asynchronously, when the server sends its next snapshot.
+   * Whether a subscription has a viewport is fixed when it is created: 'handle' must come from
+   * one of the viewport forms of Subscribe(). Calling this on a whole-table subscription throws.
+   * To switch between the two, unsubscribe and subscribe again.
+   * @param handle The subscription, as returned by Subscribe()
+   * @param viewport The new row positions to subscribe to
+   * @param reverse_viewport If true, the positions in 'viewport' are counted backwards from the
+   *   end of the table
+   */
+  void SetViewport(const std::shared_ptr<SubscriptionHandle> &handle, const RowSequence &viewport,
+      bool reverse_viewport = false);
+  /**
+   * Gets the counters of a subscription: how many messages and updates it has processed, and,
+   * if it is pipelined, how full its queues are and how many updates it has conflated.
+   * @param handle The subscription, as returned by Subscribe()
+   * @return The counters, as of now
+   */
+  [[nodiscard]]
+  SubscriptionMetrics GetSubscriptionMetrics(const std::shared_ptr<SubscriptionHandle> &handle) const;
 
   /**
    * Get access to the bytes of the Deephaven "Ticket" type (without having to reference the
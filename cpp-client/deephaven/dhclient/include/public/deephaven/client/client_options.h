@@ -3,6 +3,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -134,6 +135,32 @@ public:
    * @return *this, so that methods can be chained.
    */
   ClientOptions &AddExtraHeader(std::string header_name, std::string header_value);
+  /**
+   * Sets how the client services its subscriptions. By default each subscription gets a thread
+   * of its own (three, if pipelined), which spends most of its time waiting for the server. With
+   * 'num_threads' > 0, all the subscriptions of the client instead share one thread that
+   * receives their messages asynchronously plus 'num_threads' threads that decode them and
+   * invoke the TickingCallbacks, taking turns among the subscriptions that have work. The
+   * number of threads then no longer grows with the number of subscriptions. In this mode
+   * SubscriptionOptions::PipelineDepth() only sets how many messages a subscription may read
+   * ahead of its callback, and updates are never conflated.
+   *
+   * @param num_threads The number of decoding threads, or 0 (the default) for a thread per
+   *   subscription.
+   * @return *this, so that methods can be chained.
+   */
+  ClientOptions &SetSubscriptionThreads(int32_t num_threads);
+  /**
+   * Sets the number of threads in each of the client's internal executors, which complete
+   * asynchronous operations such as TableHandle::SelectAsync() and start subscriptions. The
+   * threads take work from each other when they fall idle. With the default of 1, this work is
+   * done one item at a time, in order; more threads help a client that keeps many operations or
+   * subscriptions in flight at once. See TableHandleManager::GetExecutorMetrics().
+   *
+   * @param num_threads The number of threads, which must be at least 1.
+   * @return *this, so that methods can be chained.
+   */
+  ClientOptions &SetExecutorThreads(int32_t num_threads);
   /**
    * Returns the value for the authorization header that will be sent to the server
    * on the first request; this value is a function of the
@@ -197,6 +224,21 @@ public:
    */
   [[nodiscard]]
   const extra_headers_t &ExtraHeaders() const { return extraHeaders_; }
+  /**
+   * The number of threads shared by the client's subscriptions, or 0 for a thread per
+   * subscription. See SetSubscriptionThreads().
+   *
+   * @return The number of threads
+   */
+  [[nodiscard]]
+  int32_t SubscriptionThreads() const { return subscriptionThreads_; }
+  /**
+   * The number of threads in each of the client's executors. See SetExecutorThreads().
+   *
+   * @return The number of threads
+   */
+  [[nodiscard]]
+  int32_t ExecutorThreads() const { return executorThreads_; }
 
 private:
   std::string authorizationValue_;
@@ -208,6 +250,8 @@ private:
   int_options_t intOptions_;
   string_options_t stringOptions_;
   extra_headers_t extraHeaders_;
+  int32_t subscriptionThreads_ = 0;
+  int32_t executorThreads_ = 1;
 
   friend class Client;
 };
@@ -387,6 +387,20 @@ void deephaven_client_TableHandle_Subscribe(
     deephaven::dhcore::interop::NativePtr<std::shared_ptr<deephaven::client::subscription::SubscriptionHandle>> *native_subscription_handle,
     deephaven::dhcore::interop::ErrorStatus *status);
 
+/**
+ * Like deephaven_client_TableHandle_Subscribe, but with the fields of a SubscriptionOptions.
+ * column_conversion_mode takes the numeric values of the ColumnConversionMode enum; any other
+ * value is reported as an error in 'status'.
+ */
+void deephaven_client_TableHandle_SubscribeWithOptions(
+    deephaven::dhcore::interop::NativePtr<deephaven::client::TableHandle> self,
+    deephaven::dhcore::interop::NativePtr<NativeOnUpdate> native_on_update,
+    deephaven::dhcore::interop::NativePtr<NativeOnFailure> native_on_failure,
+    int32_t batch_size, int32_t max_message_size, int32_t min_update_interval_ms,
+    int32_t column_conversion_mode,
+    deephaven::dhcore::interop::NativePtr<std::shared_ptr<deephaven::client::subscription::SubscriptionHandle>> *native_subscription_handle,
+    deephaven::dhcore::interop::ErrorStatus *status);
+
 void deephaven_client_TableHandle_Unsubscribe(
     deephaven::dhcore::interop::NativePtr<deephaven::client::TableHandle> self,
     deephaven::dhcore::interop::NativePtr<std::shared_ptr<deephaven::client::subscription::SubscriptionHandle>> native_subscription_handle,
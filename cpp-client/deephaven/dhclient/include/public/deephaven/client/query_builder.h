@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "deephaven/client/client.h"
+
+namespace deephaven::client::impl {
+class QueryBuilderImpl;
+}  // namespace deephaven::client::impl
+
+namespace deephaven::client {
+class QueryBuilder;
+
+/**
+ * A table in a query that is being recorded by a QueryBuilder. Nothing is sent to the server
+ * until QueryBuilder::Submit() is called. The operations have the same meaning as their
+ * counterparts on TableHandle.
+ */
+class QueryTable {
+public:
+  /**
+   * Default constructor. Creates an empty QueryTable, which is only good for assigning to. Its
+   * operations throw.
+   */
+  QueryTable();
+  /**
+   * Copy constructor.
+   */
+  QueryTable(const QueryTable &other);
+  /**
+   * Copy assignment.
+   */
+  QueryTable &operator=(const QueryTable &other);
+  /**
+   * Move constructor.
+   */
+  QueryTable(QueryTable &&other) noexcept;
+  /**
+   * Move assignment.
+   */
+  QueryTable &operator=(QueryTable &&other) noexcept;
+  /**
+   * Destructor.
+   */
+  ~QueryTable();
+
+  /**
+   * Records TableHandle::Select(std::vector<std::string>) const.
+   */
+  [[nodiscard]]
+  QueryTable Select(std::vector<std::string> column_specs) const;
+  /**
+   * A variadic form of Select(std::vector<std::string>) const.
+   */
+  template<typename ...Args>
+  [[nodiscard]]
+  QueryTable Select(Args &&...args) const {
+    std::vector<std::string> vec{internal::ConvertToString::ToString(std::forward<Args>(args))...};
+    return Select(std::move(vec));
+  }
+
+  /**
+   * Records TableHandle::Update(std::vector<std::string>) const.
+   */
+  [[nodiscard]]
+  QueryTable Update(std::vector<std::string> column_specs) const;
+  /**
+   * A variadic form of Update(std::vector<std::string>) const.
+   */
+  template<typename ...Args>
+  [[nodiscard]]
+  QueryTable Update(Args &&...args) const {
+    std::vector<std::string> vec{internal::ConvertToString::ToString(std::forward<Args>(args))...};
+    return Update(std::move(vec));
+  }
+
+  /**
+   * Records TableHandle::LazyUpdate(std::vector<std::string>) const.
+   */
+  [[nodiscard]]
+  QueryTable LazyUpdate(std::vector<std::string> column_specs) const;
+  /**
+   * A variadic form of LazyUpdate(std::vector<std::string>) const.
+   */
+  template<typename ...Args>
+  [[nodiscard]]
+  QueryTable LazyUpdate(Args &&...args) const {
+    std::vector<std::string> vec{internal::ConvertToString::ToString(std::forward<Args>(args))...};
+    return LazyUpdate(std::move(vec));
+  }
+
+  /**
+   * Records TableHandle::View(std::vector<std::string>) const.
+   */
+  [[nodiscard]]
+  QueryTable View(std::vector<std::string> column_specs) const;
+  /**
+   * A variadic form of View(std::vector<std::string>) const.
+   */
+  template<typename ...Args>
+  [[nodiscard]]
+  QueryTable View(Args &&...args) const {
+    std::vector<std::string> vec{internal::ConvertToString::ToString(std::forward<Args>(args))...};
+    return View(std::move(vec));
+  }
+
+  /**
+   * Records TableHandle::UpdateView(std::vector<std::string>) const.
+   */
+  [[nodiscard]]
+  QueryTable UpdateView(std::vector<std::string> column_specs) const;
+  /**
+   * A variadic form of UpdateView(std::vector<std::string>) const.
+   */
+  template<typename ...Args>
+  [[nodiscard]]
+  QueryTable UpdateView(Args &&...args) const {
+    std::vector<std::string> vec{internal::ConvertToString::ToString(std::forward<Args>(args))...};
+    return UpdateView(std::move(vec));
+  }
+
+  /**
+   * Records TableHandle::DropColumns(std::vector<std::string>) const.
+   */
+  [[nodiscard]]
+  QueryTable DropColumns(std::vector<std::string> column_specs) const;
+  /**
+   * A variadic form of DropColumns(std::vector<std::string>) const.
+   */
+  template<typename ...Args>
+  [[nodiscard]]
+  QueryTable DropColumns(Args &&...args) const {
+    std::vector<std::string> vec{internal::ConvertToString::ToString(std::forward<Args>(args))...};
+    return DropColumns(std::move(vec));
+  }
+
+  /**
+   * Records TableHandle::Where(std::string) const.
+   */
+  [[nodiscard]]
+  QueryTable Where(std::string condition) const;
+
+  /**
+   * Records TableHandle::Sort(std::vector<SortPair>) const.
+   */
+  [[nodiscard]]
+  QueryTable Sort(std::vector<SortPair> sort_pairs) const;
+  /**
+   * A variadic form of Sort(std::vector<SortPair>) const.
+   */
+  template<typename ...Args>
+  [[nodiscard]]
+  QueryTable Sort(Args &&...args) const {
+    std::vector<SortPair> vec{std::forward<Args>(args)...};
+    return Sort(std::move(vec));
+  }
+
+  /**
+   * Records TableHandle::Head(int64_t) const.
+   */
+  [[nodiscard]]
+  QueryTable Head(int64_t n) const;
+  /**
+   * Records TableHandle::Tail(int64_t) const.
+   */
+  [[nodiscard]]
+  QueryTable Tail(int64_t n) const;
+  /**
+   * Records TableHandle::Slice(int64_t, int64_t) const.
+   */
+  [[nodiscard]]
+  QueryTable Slice(int64_t first_position_inclusive, int64_t last_position_exclusive) const;
+
+  /**
+   * Records TableHandle::CrossJoin(). `right_side` must come from the same QueryBuilder.
+   */
+  [[nodiscard]]
+  QueryTable CrossJoin(const QueryTable &right_side, std::vector<std::string> columns_to_match,
+      std::vector<std::string> columns_to_add) const;
+  /**
+   * Records TableHandle::NaturalJoin(). `right_side` must come from the same QueryBuilder.
+   */
+  [[nodiscard]]
+  QueryTable NaturalJoin(const QueryTable &right_side, std::vector<std::string> columns_to_match,
+      std::vector<std::string> columns_to_add) const;
+  /**
+   * Records TableHandle::ExactJoin(). `right_side` must come from the same QueryBuilder.
+   */
+  [[nodiscard]]
+  QueryTable ExactJoin(const QueryTable &right_side, std::vector<std::string> columns_to_match,
+      std::vector<std::string> columns_to_add) const;
+
+private:
+  QueryTable(std::shared_ptr<impl::QueryBuilderImpl> builder, int32_t offset);
+
+  /**
+   * Returns our QueryBuilderImpl, or throws if we are empty.
+   */
+  [[nodiscard]]
+  impl::QueryBuilderImpl &Builder() const;
+  [[nodiscard]]
+  int32_t CheckSameBuilder(const QueryTable &other) const;
+
+  std::shared_ptr<impl::QueryBuilderImpl> builder_;
+  // The offset of the operation that makes this table in the builder's BatchTableRequest.
+  int32_t offset_ = -1;
+
+  friend class QueryBuilder;
+};
+
+/**
+ * Records a query as a graph of table operations on the client, and then sends the whole graph to
+ * the server in a single BatchTableRequest. Only the tables passed to Submit() are exported; the
+ * server releases the intermediate ones itself. Building a query of N operations this way costs
+ * one round trip instead of N. Example:
+ * @code
+ * auto qb = manager.CreateQueryBuilder();
+ * auto trades = qb.FetchTable("trades");
+ * auto big = trades.Where("Size > 1000");
+ * auto result = qb.Submit(big.Sort(SortPair::Descending("Size")).Head(10));
+ * @endcode
+ * A QueryBuilder is obtained with TableHandleManager::CreateQueryBuilder(). It is cheap to copy,
+ * and the copies share the same recording. A QueryBuilder can be submitted more than once, and
+ * can go on recording after a Submit().
+ */
+class QueryBuilder {
+public:
+  /**
+   * Default constructor. Creates an empty QueryBuilder, which is only good for assigning to. Its
+   * operations throw.
+   */
+  QueryBuilder();
+  /**
+   * Constructor. Used internally.
+   */
+  explicit QueryBuilder(std::shared_ptr<impl::QueryBuilderImpl> impl);
+  /**
+   * Copy constructor.
+   */
+  QueryBuilder(const QueryBuilder &other);
+  /**
+   * Copy assignment.
+   */
+  QueryBuilder &operator=(const QueryBuilder &other);
+  /**
+   * Move constructor.
+   */
+  QueryBuilder(QueryBuilder &&other) noexcept;
+  /**
+   * Move assignment.
+   */
+  QueryBuilder &operator=(QueryBuilder &&other) noexcept;
+  /**
+   * Destructor.
+   */
+  ~QueryBuilder();
+
+  /**
+   * Records TableHandleManager::EmptyTable(int64_t) const.
+   */
+  [[nodiscard]]
+  QueryTable EmptyTable(int64_t size) const;
+  /**
+   * Records TableHandleManager::FetchTable(std::string) const.
+   */
+  [[nodiscard]]
+  QueryTable FetchTable(std::string table_name) const;
+  /**
+   * Brings an existing table into the query. The QueryBuilder holds a reference to `table` so
+   * that it stays valid until the query is submitted.
+   */
+  [[nodiscard]]
+  QueryTable FromTableHandle(const TableHandle &table) const;
+
+  /**
+   * Sends the query to the server and exports `table`.
+   * @return A TableHandle referencing the exported table
+   */
+  [[nodiscard]]
+  TableHandle Submit(const QueryTable &table) const;
+  /**
+   * Sends the query to the server and exports `tables`. Throws if any operation in the query
+   * fails.
+   * @return TableHandles referencing the exported tables, in the same order as `tables`
+   */
+  [[nodiscard]]
+  std::vector<TableHandle> Submit(const std::vector<QueryTable> &tables) const;
+
+private:
+  /**
+   * Returns our QueryBuilderImpl, or throws if we are empty.
+   */
+  [[nodiscard]]
+  impl::QueryBuilderImpl &Builder() const;
+
+  std::shared_ptr<impl::QueryBuilderImpl> impl_;
+};
+}  // namespace deephaven::client
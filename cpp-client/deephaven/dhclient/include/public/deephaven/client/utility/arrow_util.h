@@ -6,6 +6,8 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
+#include <arrow/result.h>
 #include <arrow/type.h>
 #include <arrow/flight/types.h>
 
@@ -53,6 +55,14 @@ public:
    */
   static std::shared_ptr<Schema> MakeDeephavenSchema(const arrow::Schema &schema);
 
+  /**
+   * Decodes a serialized Arrow IPC Schema message, such as the schema_header the server sends
+   * when it creates a table.
+   * @param message The serialized message
+   * @return The Arrow Schema, or the error if the message can't be decoded
+   */
+  static arrow::Result<std::shared_ptr<arrow::Schema>> ReadSchemaMessage(std::string message);
+
   static std::shared_ptr<arrow::Table> MakeArrowTable(const ClientTable &client_table);
   static std::shared_ptr<arrow::Schema> MakeArrowSchema(
       const deephaven::dhcore::clienttable::Schema &dh_schema);
@@ -84,6 +94,6 @@ void OkOrThrow(const deephaven::dhcore::utility::DebugInfo &debug_info, const ar
 template<typename T>
 T ValueOrThrow(const deephaven::dhcore::utility::DebugInfo &debug_info, arrow::Result<T> result) {
   OkOrThrow(debug_info, result.status());
-  return result.ValueUnsafe();
+  return std::move(result).ValueUnsafe();
 }
 }  // namespace deephaven::client::utility
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -38,4 +39,40 @@ struct OnCloseCbId {
  */
 using OnCloseCb = std::function<void()>;
 
+/**
+ * Counters describing the work done by one of the client's internal thread pools, for monitoring.
+ * See TableHandleManager::GetExecutorMetrics().
+ */
+struct ExecutorMetrics {
+  /**
+   * The name of the pool.
+   */
+  std::string name;
+  /**
+   * The number of threads in the pool (see ClientOptions::SetExecutorThreads).
+   */
+  size_t num_threads = 0;
+  /**
+   * The number of tasks waiting for a thread, now and at most.
+   */
+  size_t queue_size = 0;
+  size_t queue_high_water = 0;
+  /**
+   * The number of tasks that have run, and how many of those were taken by a thread from another
+   * thread's queue.
+   */
+  uint64_t tasks_run = 0;
+  uint64_t tasks_stolen = 0;
+  /**
+   * How long tasks waited in the queue before they started, in total and at most.
+   */
+  std::chrono::nanoseconds total_queue_time{0};
+  std::chrono::nanoseconds max_queue_time{0};
+  /**
+   * How long tasks took to run, in total and at most.
+   */
+  std::chrono::nanoseconds total_run_time{0};
+  std::chrono::nanoseconds max_run_time{0};
+};
+
 } // namespace deephaven::client::utility
@@ -592,19 +592,9 @@ struct ChunkedArrayToColumnSourceVisitor final : public arrow::TypeVisitor {
    * rest of the converter sees only the logical value type.
    */
   arrow::Status Visit(const arrow::DictionaryType &type) final {
-    auto dict_arrays = DowncastChunks<arrow::DictionaryArray>(*chunked_array_);
-    std::vector<std::shared_ptr<arrow::Array>> plain_chunks;
-    plain_chunks.reserve(dict_arrays.size());
-    for (const auto &da : dict_arrays) {
-      // The dictionary (and in principle the index type) can differ per chunk, e.g. with
-      // delta dictionaries across Flight batches, so decode each chunk independently.
-      DictionaryChunkDecoder decoder(*da);
-      OkOrThrow(DEEPHAVEN_LOCATION_EXPR(type.value_type()->Accept(&decoder)));
-      plain_chunks.push_back(std::move(decoder.result_));
-    }
-    auto plain_ca = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
-        arrow::ChunkedArray::Make(std::move(plain_chunks), type.value_type())));
-    result_ = ArrowArrayConverter::ChunkedArrayToColumnSource(std::move(plain_ca));
+    // The dictionary (and in principle the index type) can differ per chunk, e.g. with
+    // delta dictionaries across Flight batches, so DecodeChunks decodes each chunk independently.
+    result_ = ArrowArrayConverter::ChunkedArrayToColumnSource(DecodeChunks(type.value_type()));
     return arrow::Status::OK();
   }
 
@@ -616,29 +606,20 @@ struct ChunkedArrayToColumnSourceVisitor final : public arrow::TypeVisitor {
     // The REE values child may itself be dictionary-encoded (a doubly-encoded
     // RunEndEncoded<Dictionary<...>> column). In that case the plain (decoded) value type is the
     // dictionary's value type, and each run is expanded through the dictionary.
-    const bool values_are_dictionary = type.value_type()->id() == arrow::Type::DICTIONARY;
-    auto plain_value_type = values_are_dictionary
-        ? static_cast<const arrow::DictionaryType &>(*type.value_type()).value_type()
-        : type.value_type();
+    auto plain_value_type = ArrowArrayConverter::DecodedType(type.value_type());
+    result_ = ArrowArrayConverter::ChunkedArrayToColumnSource(DecodeChunks(
+        std::move(plain_value_type)));
+    return arrow::Status::OK();
+  }
 
-    auto ree_arrays = DowncastChunks<arrow::RunEndEncodedArray>(*chunked_array_);
+  std::shared_ptr<arrow::ChunkedArray> DecodeChunks(std::shared_ptr<arrow::DataType> plain_type) {
     std::vector<std::shared_ptr<arrow::Array>> plain_chunks;
-    plain_chunks.reserve(ree_arrays.size());
-    for (const auto &ra : ree_arrays) {
-      if (values_are_dictionary) {
-        RunEndDictionaryChunkDecoder decoder(*ra);
-        OkOrThrow(DEEPHAVEN_LOCATION_EXPR(plain_value_type->Accept(&decoder)));
-        plain_chunks.push_back(std::move(decoder.result_));
-      } else {
-        RunEndChunkDecoder decoder(*ra);
-        OkOrThrow(DEEPHAVEN_LOCATION_EXPR(plain_value_type->Accept(&decoder)));
-        plain_chunks.push_back(std::move(decoder.result_));
-      }
+    plain_chunks.reserve(chunked_array_->num_chunks());
+    for (const auto &chunk : chunked_array_->chunks()) {
+      plain_chunks.push_back(ArrowArrayConverter::DecodeArray(chunk));
     }
-    auto plain_ca = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
-        arrow::ChunkedArray::Make(std::move(plain_chunks), plain_value_type)));
-    result_ = ArrowArrayConverter::ChunkedArrayToColumnSource(std::move(plain_ca));
-    return arrow::Status::OK();
+    return ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
+        arrow::ChunkedArray::Make(std::move(plain_chunks), std::move(plain_type))));
   }
 
   /**
@@ -746,6 +727,43 @@ std::shared_ptr<ColumnSource> ArrowArrayConverter::ArrayToColumnSource(
   return ChunkedArrayToColumnSource(std::move(chunked_array));
 }
 
+std::shared_ptr<arrow::Array> ArrowArrayConverter::DecodeArray(
+    std::shared_ptr<arrow::Array> array) {
+  switch (array->type_id()) {
+    case arrow::Type::DICTIONARY: {
+      const auto &dict_array = static_cast<const arrow::DictionaryArray &>(*array);
+      DictionaryChunkDecoder decoder(dict_array);
+      OkOrThrow(DEEPHAVEN_LOCATION_EXPR(decoder.ValueType()->Accept(&decoder)));
+      return std::move(decoder.result_);
+    }
+    case arrow::Type::RUN_END_ENCODED: {
+      const auto &ree_array = static_cast<const arrow::RunEndEncodedArray &>(*array);
+      if (ree_array.values()->type_id() == arrow::Type::DICTIONARY) {
+        RunEndDictionaryChunkDecoder decoder(ree_array);
+        OkOrThrow(DEEPHAVEN_LOCATION_EXPR(decoder.ValueType()->Accept(&decoder)));
+        return std::move(decoder.result_);
+      }
+      RunEndChunkDecoder decoder(ree_array);
+      OkOrThrow(DEEPHAVEN_LOCATION_EXPR(decoder.ValueType()->Accept(&decoder)));
+      return std::move(decoder.result_);
+    }
+    default:
+      return array;
+  }
+}
+
+std::shared_ptr<arrow::DataType> ArrowArrayConverter::DecodedType(
+    const std::shared_ptr<arrow::DataType> &type) {
+  switch (type->id()) {
+    case arrow::Type::DICTIONARY:
+      return static_cast<const arrow::DictionaryType &>(*type).value_type();
+    case arrow::Type::RUN_END_ENCODED:
+      return DecodedType(static_cast<const arrow::RunEndEncodedType &>(*type).value_type());
+    default:
+      return type;
+  }
+}
+
 std::shared_ptr<ColumnSource> ArrowArrayConverter::ChunkedArrayToColumnSource(
     std::shared_ptr<arrow::ChunkedArray> chunked_array) {
   ChunkedArrayToColumnSourceVisitor v(std::move(chunked_array));
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/client/arrowutil/flight_record_batch_reader.h"
+
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "deephaven/client/arrowutil/arrow_array_converter.h"
+#include "deephaven/client/utility/arrow_util.h"
+#include "deephaven/dhcore/utility/utility.h"
+
+using deephaven::client::utility::ValueOrThrow;
+using deephaven::dhcore::utility::GetWhat;
+using deephaven::dhcore::utility::MakeReservedVector;
+
+namespace deephaven::client::arrowutil {
+std::shared_ptr<FlightRecordBatchReader> FlightRecordBatchReader::Create(
+    std::unique_ptr<FlightStreamReader> flight_stream_reader, bool decode) {
+  auto schema = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(flight_stream_reader->GetSchema()));
+  if (decode) {
+    auto fields = MakeReservedVector<std::shared_ptr<arrow::Field>>(schema->num_fields());
+    for (const auto &field : schema->fields()) {
+      fields.push_back(field->WithType(ArrowArrayConverter::DecodedType(field->type())));
+    }
+    schema = arrow::schema(std::move(fields), schema->metadata());
+  }
+  return std::make_shared<FlightRecordBatchReader>(Private(), std::move(flight_stream_reader),
+      std::move(schema), decode);
+}
+
+FlightRecordBatchReader::FlightRecordBatchReader(Private,
+    std::unique_ptr<FlightStreamReader> flight_stream_reader,
+    std::shared_ptr<arrow::Schema> schema, bool decode) :
+    flightStreamReader_(std::move(flight_stream_reader)), schema_(std::move(schema)),
+    decode_(decode) {}
+
+FlightRecordBatchReader::~FlightRecordBatchReader() = default;
+
+arrow::Status FlightRecordBatchReader::ReadNext(std::shared_ptr<arrow::RecordBatch> *batch) {
+  while (true) {
+    ARROW_ASSIGN_OR_RAISE(auto chunk, flightStreamReader_->Next());
+    if (chunk.data == nullptr && chunk.app_metadata != nullptr) {
+      // A metadata-only message. Keep going.
+      continue;
+    }
+    if (chunk.data == nullptr || !decode_) {
+      // Either the end of the stream, or a batch that needs nothing done to it.
+      *batch = std::move(chunk.data);
+      return arrow::Status::OK();
+    }
+    // Callers may reach us through the Arrow C stream interface, so errors must come back as a
+    // Status rather than as an exception.
+    try {
+      const auto &raw = *chunk.data;
+      auto columns = MakeReservedVector<std::shared_ptr<arrow::Array>>(raw.num_columns());
+      for (int i = 0; i != raw.num_columns(); ++i) {
+        columns.push_back(ArrowArrayConverter::DecodeArray(raw.column(i)));
+      }
+      *batch = arrow::RecordBatch::Make(schema_, raw.num_rows(), std::move(columns));
+    } catch (...) {
+      return arrow::Status::Invalid(GetWhat(std::current_exception()));
+    }
+    return arrow::Status::OK();
+  }
+}
+
+arrow::Status FlightRecordBatchReader::Close() {
+  flightStreamReader_->Cancel();
+  return arrow::Status::OK();
+}
+}  // namespace deephaven::client::arrowutil
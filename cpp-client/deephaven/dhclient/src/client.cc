@@ -10,6 +10,7 @@
 #include <arrow/array.h>
 #include <arrow/scalar.h>
 #include "deephaven/client/arrowutil/arrow_client_table.h"
+#include "deephaven/client/arrowutil/flight_record_batch_reader.h"
 #include "deephaven/client/flight.h"
 #include "deephaven/client/impl/aggregate_impl.h"
 #include "deephaven/client/impl/client_impl.h"
@@ -17,6 +18,7 @@
 #include "deephaven/client/impl/table_handle_manager_impl.h"
 #include "deephaven/client/impl/update_by_operation_impl.h"
 #include "deephaven/client/subscription/subscription_handle.h"
+#include "deephaven/client/subscription/subscription_scheduler.h"
 #include "deephaven/client/utility/arrow_util.h"
 #include "deephaven/dhcore/clienttable/schema.h"
 #include "deephaven/dhcore/utility/utility.h"
@@ -24,13 +26,16 @@
 using io::deephaven::proto::backplane::grpc::ComboAggregateRequest;
 using io::deephaven::proto::backplane::grpc::Ticket;
 using deephaven::client::arrowutil::ArrowClientTable;
+using deephaven::client::arrowutil::FlightRecordBatchReader;
 using deephaven::client::impl::AggregateComboImpl;
 using deephaven::client::impl::AggregateImpl;
 using deephaven::client::impl::ClientImpl;
 using deephaven::client::impl::UpdateByOperationImpl;
 using deephaven::client::server::Server;
 using deephaven::client::subscription::SubscriptionHandle;
+using deephaven::client::subscription::SubscriptionScheduler;
 using deephaven::client::utility::Executor;
+using deephaven::client::utility::ExecutorMetrics;
 using deephaven::client::utility::OkOrThrow;
 using deephaven::client::utility::ArrowUtil;
 using deephaven::client::utility::ValueOrThrow;
@@ -50,10 +55,17 @@ void CheckNotClosedOrThrow(const std::shared_ptr<ClientImpl> &impl);
 
 Client Client::Connect(const std::string &target, const ClientOptions &options) {
   auto server = Server::CreateFromTarget(target, options);
-  auto executor = Executor::Create("Client executor for " + server->me());
-  auto flight_executor = Executor::Create("Flight executor for " + server->me());
+  auto executor_threads = static_cast<size_t>(options.ExecutorThreads());
+  auto executor = Executor::Create("Client executor for " + server->me(), executor_threads);
+  auto flight_executor = Executor::Create("Flight executor for " + server->me(),
+      executor_threads);
+  std::shared_ptr<SubscriptionScheduler> subscription_scheduler;
+  if (auto num_threads = options.SubscriptionThreads(); num_threads > 0) {
+    subscription_scheduler = SubscriptionScheduler::Create(server, num_threads);
+  }
   void *const server_for_logging = server.get();
-  auto impl = ClientImpl::Create(std::move(server), executor, flight_executor, options.sessionType_);
+  auto impl = ClientImpl::Create(std::move(server), executor, flight_executor,
+      std::move(subscription_scheduler), options.sessionType_);
   LOG(INFO) << "Client target=" << target << " created ClientImpl(" << static_cast<void*>(impl.get())
             << "), Server(" << server_for_logging << ").";
   return Client(std::move(impl));
@@ -145,6 +157,10 @@ void TableHandleManager::RunScript(std::string code) const {
   impl_->RunScript(std::move(code));
 }
 
+std::vector<ExecutorMetrics> TableHandleManager::GetExecutorMetrics() const {
+  return {impl_->Executor()->Metrics(), impl_->FlightExecutor()->Metrics()};
+}
+
 namespace {
 ComboAggregateRequest::Aggregate
 CreateDescForMatchPairs(ComboAggregateRequest::AggType aggregate_type,
@@ -434,6 +450,12 @@ TableHandle TableHandle::Tail(int64_t n) const {
   return TableHandle(std::move(qt_impl));
 }
 
+TableHandle TableHandle::Slice(int64_t first_position_inclusive,
+    int64_t last_position_exclusive) const {
+  auto qt_impl = impl_->Slice(first_position_inclusive, last_position_exclusive);
+  return TableHandle(std::move(qt_impl));
+}
+
 TableHandle TableHandle::Ungroup(bool null_fill, std::vector<std::string> group_by_columns) const {
   auto qt_impl = impl_->Ungroup(null_fill, std::move(group_by_columns));
   return TableHandle(std::move(qt_impl));
@@ -471,6 +493,79 @@ TableHandle TableHandle::ExactJoin(const TableHandle &right_side,
   return TableHandle(std::move(qt_impl));
 }
 
+TableHandle TableHandle::SelectAsync(std::vector<std::string> column_specs) const {
+  return TableHandle(impl_->SelectAsync(std::move(column_specs)));
+}
+
+TableHandle TableHandle::UpdateAsync(std::vector<std::string> column_specs) const {
+  return TableHandle(impl_->UpdateAsync(std::move(column_specs)));
+}
+
+TableHandle TableHandle::LazyUpdateAsync(std::vector<std::string> column_specs) const {
+  return TableHandle(impl_->LazyUpdateAsync(std::move(column_specs)));
+}
+
+TableHandle TableHandle::ViewAsync(std::vector<std::string> column_specs) const {
+  return TableHandle(impl_->ViewAsync(std::move(column_specs)));
+}
+
+TableHandle TableHandle::UpdateViewAsync(std::vector<std::string> column_specs) const {
+  return TableHandle(impl_->UpdateViewAsync(std::move(column_specs)));
+}
+
+TableHandle TableHandle::DropColumnsAsync(std::vector<std::string> column_specs) const {
+  return TableHandle(impl_->DropColumnsAsync(std::move(column_specs)));
+}
+
+TableHandle TableHandle::WhereAsync(std::string condition) const {
+  return TableHandle(impl_->WhereAsync(std::move(condition)));
+}
+
+TableHandle TableHandle::SortAsync(std::vector<SortPair> sort_pairs) const {
+  return TableHandle(impl_->SortAsync(std::move(sort_pairs)));
+}
+
+TableHandle TableHandle::HeadAsync(int64_t n) const {
+  return TableHandle(impl_->HeadAsync(n));
+}
+
+TableHandle TableHandle::TailAsync(int64_t n) const {
+  return TableHandle(impl_->TailAsync(n));
+}
+
+TableHandle TableHandle::CrossJoinAsync(const TableHandle &right_side,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) const {
+  return TableHandle(impl_->CrossJoinAsync(*right_side.impl_, std::move(columns_to_match),
+      std::move(columns_to_add)));
+}
+
+TableHandle TableHandle::NaturalJoinAsync(const TableHandle &right_side,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) const {
+  return TableHandle(impl_->NaturalJoinAsync(*right_side.impl_, std::move(columns_to_match),
+      std::move(columns_to_add)));
+}
+
+TableHandle TableHandle::ExactJoinAsync(const TableHandle &right_side,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) const {
+  return TableHandle(impl_->ExactJoinAsync(*right_side.impl_, std::move(columns_to_match),
+      std::move(columns_to_add)));
+}
+
+TableHandle TableHandle::SliceAsync(int64_t first_position_inclusive,
+    int64_t last_position_exclusive) const {
+  return TableHandle(impl_->SliceAsync(first_position_inclusive, last_position_exclusive));
+}
+
+TableHandle TableHandle::AjAsync(const TableHandle &right_side, std::vector<std::string> on,
+    std::vector<std::string> joins) const {
+  return TableHandle(impl_->AjAsync(*right_side.impl_, std::move(on), std::move(joins)));
+}
+
+TableHandle TableHandle::RajAsync(const TableHandle &right_side, std::vector<std::string> on,
+    std::vector<std::string> joins) const {
+  return TableHandle(impl_->RajAsync(*right_side.impl_, std::move(on), std::move(joins)));
+}
+
 TableHandle TableHandle::Aj(const TableHandle &right_side,
     std::vector<std::string> on, std::vector<std::string> joins) const {
   auto qt_impl = impl_->Aj(*right_side.impl_, std::move(on), std::move(joins));
@@ -529,6 +624,10 @@ int64_t TableHandle::NumRows() const {
   return impl_->NumRows();
 }
 
+void TableHandle::Await() const {
+  impl_->Await();
+}
+
 bool TableHandle::IsStatic() const {
   return impl_->IsStatic();
 }
@@ -547,6 +646,48 @@ std::shared_ptr<ClientTable> TableHandle::ToClientTable() const {
   return ArrowClientTable::Create(std::move(raw_at));
 }
 
+std::shared_ptr<arrow::RecordBatchReader> TableHandle::GetRecordBatchReader(bool cooked) const {
+  auto fsr = GetManager().CreateFlightWrapper().GetFlightStreamReader(*this);
+  return FlightRecordBatchReader::Create(std::move(fsr), cooked);
+}
+
+void TableHandle::ForEachBatch(
+    const std::function<void(const std::shared_ptr<arrow::RecordBatch> &)> &callback,
+    bool cooked) const {
+  auto reader = GetRecordBatchReader(cooked);
+  while (true) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    OkOrThrow(DEEPHAVEN_LOCATION_EXPR(reader->ReadNext(&batch)));
+    if (batch == nullptr) {
+      return;
+    }
+    try {
+      callback(batch);
+    } catch (...) {
+      // Don't leave the server streaming batches that nobody will read.
+      (void)reader->Close();
+      throw;
+    }
+  }
+}
+
+std::shared_ptr<arrow::Table> TableHandle::ToArrowTableParallel(size_t num_streams,
+    bool cooked) const {
+  return impl_->ToArrowTableParallel(num_streams, cooked);
+}
+
+std::shared_ptr<ClientTable> TableHandle::Snapshot(const RowSequence &rows,
+    const std::vector<std::string> &columns, bool reverse_viewport) const {
+  return impl_->Snapshot(&rows, columns.empty() ? nullptr : &columns, reverse_viewport,
+      SubscriptionOptions());
+}
+
+std::shared_ptr<ClientTable> TableHandle::Snapshot(const RowSequence &rows,
+    const std::vector<std::string> &columns, bool reverse_viewport,
+    const SubscriptionOptions &options) const {
+  return impl_->Snapshot(&rows, columns.empty() ? nullptr : &columns, reverse_viewport, options);
+}
+
 std::shared_ptr<arrow::Table> TableHandle::ToArrowTable(bool cooked) const {
   if (cooked) {
     // Roundtrip through ClientTable to remove RunEndEncoded and Dictionary arrow
@@ -571,10 +712,43 @@ TableHandle::Subscribe(onTickCallback_t on_tick, void *on_tick_user_data,
   return impl_->Subscribe(on_tick, on_tick_user_data, on_error, on_error_user_data);
 }
 
+std::shared_ptr<SubscriptionHandle> TableHandle::Subscribe(
+    std::shared_ptr<TickingCallback> callback, const RowSequence &viewport,
+    bool reverse_viewport, const SubscriptionOptions &options) {
+  return impl_->Subscribe(std::move(callback), nullptr, &viewport, reverse_viewport, options);
+}
+
+std::shared_ptr<SubscriptionHandle> TableHandle::Subscribe(
+    std::shared_ptr<TickingCallback> callback, std::vector<std::string> columns,
+    const SubscriptionOptions &options) {
+  return impl_->Subscribe(std::move(callback), &columns, nullptr, false, options);
+}
+
+std::shared_ptr<SubscriptionHandle> TableHandle::Subscribe(
+    std::shared_ptr<TickingCallback> callback, std::vector<std::string> columns,
+    const RowSequence &viewport, bool reverse_viewport, const SubscriptionOptions &options) {
+  return impl_->Subscribe(std::move(callback), &columns, &viewport, reverse_viewport, options);
+}
+
+std::shared_ptr<SubscriptionHandle> TableHandle::Subscribe(
+    std::shared_ptr<TickingCallback> callback, const SubscriptionOptions &options) {
+  return impl_->Subscribe(std::move(callback), nullptr, nullptr, false, options);
+}
+
 void TableHandle::Unsubscribe(const std::shared_ptr<SubscriptionHandle> &handle) {
   impl_->Unsubscribe(handle);
 }
 
+void TableHandle::SetViewport(const std::shared_ptr<SubscriptionHandle> &handle,
+    const RowSequence &viewport, bool reverse_viewport) {
+  impl_->SetViewport(handle, &viewport, reverse_viewport);
+}
+
+TableHandle::SubscriptionMetrics TableHandle::GetSubscriptionMetrics(
+    const std::shared_ptr<SubscriptionHandle> &handle) const {
+  return impl_->GetSubscriptionMetrics(handle);
+}
+
 const std::string &TableHandle::GetTicketAsString() const {
   return impl_->Ticket().ticket();
 }
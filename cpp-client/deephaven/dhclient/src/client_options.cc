@@ -2,7 +2,11 @@
  * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
  */
 #include "deephaven/client/client_options.h"
+
+#include <cstdint>
+#include <stdexcept>
 #include "deephaven/dhcore/utility/utility.h"
+#include "deephaven/third_party/fmt/core.h"
 
 using deephaven::dhcore::utility::Base64Encode;
 
@@ -77,4 +81,22 @@ ClientOptions &ClientOptions::AddExtraHeader(std::string header_name, std::strin
   return *this;
 }
 
+ClientOptions &ClientOptions::SetSubscriptionThreads(int32_t num_threads) {
+  if (num_threads < 0) {
+    auto message = fmt::format("num_threads must be non-negative, got {}", num_threads);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  subscriptionThreads_ = num_threads;
+  return *this;
+}
+
+ClientOptions &ClientOptions::SetExecutorThreads(int32_t num_threads) {
+  if (num_threads < 1) {
+    auto message = fmt::format("num_threads must be at least 1, got {}", num_threads);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  executorThreads_ = num_threads;
+  return *this;
+}
+
 }  // namespace deephaven::client
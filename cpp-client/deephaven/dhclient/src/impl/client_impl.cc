@@ -15,6 +15,7 @@ using io::deephaven::proto::backplane::script::grpc::StartConsoleResponse;
 
 using deephaven::client::impl::TableHandleManagerImpl;
 using deephaven::client::server::Server;
+using deephaven::client::subscription::SubscriptionScheduler;
 using deephaven::client::utility::Executor;
 
 namespace deephaven::client {
@@ -23,6 +24,7 @@ std::shared_ptr<ClientImpl> ClientImpl::Create(
     std::shared_ptr<Server> server,
     std::shared_ptr<Executor> executor,
     std::shared_ptr<Executor> flight_executor,
+    std::shared_ptr<SubscriptionScheduler> subscription_scheduler,
     std::string session_type) {
   std::optional<Ticket> console_ticket;
   if (!session_type.empty()) {
@@ -40,7 +42,8 @@ std::shared_ptr<ClientImpl> ClientImpl::Create(
           std::move(console_ticket),
           std::move(server),
           std::move(executor),
-          std::move(flight_executor));
+          std::move(flight_executor),
+          std::move(subscription_scheduler));
   return std::make_shared<ClientImpl>(Private(), std::move(thmi));
 }
 
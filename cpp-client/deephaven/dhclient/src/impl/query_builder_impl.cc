@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/client/impl/query_builder_impl.h"
+
+#include <exception>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include "deephaven/client/impl/table_handle_impl.h"
+#include "deephaven/client/impl/table_handle_manager_impl.h"
+#include "deephaven/client/impl/table_requests.h"
+#include "deephaven/dhcore/utility/utility.h"
+#include "deephaven/third_party/fmt/format.h"
+
+using io::deephaven::proto::backplane::grpc::BatchTableRequest;
+using io::deephaven::proto::backplane::grpc::CrossJoinTablesRequest;
+using io::deephaven::proto::backplane::grpc::ExactJoinTablesRequest;
+using io::deephaven::proto::backplane::grpc::ExportedTableCreationResponse;
+using io::deephaven::proto::backplane::grpc::NaturalJoinTablesRequest;
+using io::deephaven::proto::backplane::grpc::TableReference;
+using io::deephaven::proto::backplane::grpc::Ticket;
+
+using Operation = io::deephaven::proto::backplane::grpc::BatchTableRequest::Operation;
+
+namespace deephaven::client::impl {
+namespace {
+TableReference MakeOffsetReference(int32_t offset);
+}  // namespace
+
+std::shared_ptr<QueryBuilderImpl> QueryBuilderImpl::Create(
+    std::shared_ptr<TableHandleManagerImpl> manager) {
+  return std::make_shared<QueryBuilderImpl>(Private(), std::move(manager));
+}
+
+QueryBuilderImpl::QueryBuilderImpl(Private, std::shared_ptr<TableHandleManagerImpl> &&manager) :
+    manager_(std::move(manager)) {}
+
+QueryBuilderImpl::~QueryBuilderImpl() = default;
+
+int32_t QueryBuilderImpl::EmptyTable(int64_t size) {
+  Operation op;
+  *op.mutable_empty_table() = MakeEmptyTableRequest(size, {});
+  return Add(std::move(op),
+      [](Operation *o) { return o->mutable_empty_table()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::FetchTable(std::string table_name) {
+  Operation op;
+  *op.mutable_fetch_table() = MakeFetchTableRequest(
+      MakeTicketReference(MakeScopeReference(table_name)), {});
+  return Add(std::move(op),
+      [](Operation *o) { return o->mutable_fetch_table()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::FromTableHandle(std::shared_ptr<TableHandleImpl> table) {
+  Operation op;
+  *op.mutable_fetch_table() = MakeFetchTableRequest(MakeTicketReference(table->Ticket()), {});
+  auto result = Add(std::move(op),
+      [](Operation *o) { return o->mutable_fetch_table()->mutable_result_id(); });
+  std::unique_lock guard(mutex_);
+  tableHandles_.push_back(std::move(table));
+  return result;
+}
+
+int32_t QueryBuilderImpl::Select(int32_t source, std::vector<std::string> column_specs) {
+  Operation op;
+  *op.mutable_select() = MakeSelectOrUpdateRequest(MakeOffsetReference(source),
+      std::move(column_specs), {});
+  return Add(std::move(op), [](Operation *o) { return o->mutable_select()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::Update(int32_t source, std::vector<std::string> column_specs) {
+  Operation op;
+  *op.mutable_update() = MakeSelectOrUpdateRequest(MakeOffsetReference(source),
+      std::move(column_specs), {});
+  return Add(std::move(op), [](Operation *o) { return o->mutable_update()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::LazyUpdate(int32_t source, std::vector<std::string> column_specs) {
+  Operation op;
+  *op.mutable_lazy_update() = MakeSelectOrUpdateRequest(MakeOffsetReference(source),
+      std::move(column_specs), {});
+  return Add(std::move(op),
+      [](Operation *o) { return o->mutable_lazy_update()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::View(int32_t source, std::vector<std::string> column_specs) {
+  Operation op;
+  *op.mutable_view() = MakeSelectOrUpdateRequest(MakeOffsetReference(source),
+      std::move(column_specs), {});
+  return Add(std::move(op), [](Operation *o) { return o->mutable_view()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::UpdateView(int32_t source, std::vector<std::string> column_specs) {
+  Operation op;
+  *op.mutable_update_view() = MakeSelectOrUpdateRequest(MakeOffsetReference(source),
+      std::move(column_specs), {});
+  return Add(std::move(op),
+      [](Operation *o) { return o->mutable_update_view()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::DropColumns(int32_t source, std::vector<std::string> column_specs) {
+  Operation op;
+  *op.mutable_drop_columns() = MakeDropColumnsRequest(MakeOffsetReference(source),
+      std::move(column_specs), {});
+  return Add(std::move(op),
+      [](Operation *o) { return o->mutable_drop_columns()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::Where(int32_t source, std::string condition) {
+  Operation op;
+  *op.mutable_unstructured_filter() = MakeWhereRequest(MakeOffsetReference(source),
+      std::move(condition), {});
+  return Add(std::move(op),
+      [](Operation *o) { return o->mutable_unstructured_filter()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::Sort(int32_t source, std::vector<SortPair> sort_pairs) {
+  Operation op;
+  *op.mutable_sort() = MakeSortRequest(MakeOffsetReference(source), std::move(sort_pairs), {});
+  return Add(std::move(op), [](Operation *o) { return o->mutable_sort()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::Head(int32_t source, int64_t n) {
+  Operation op;
+  *op.mutable_head() = MakeHeadOrTailRequest(MakeOffsetReference(source), n, {});
+  return Add(std::move(op), [](Operation *o) { return o->mutable_head()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::Tail(int32_t source, int64_t n) {
+  Operation op;
+  *op.mutable_tail() = MakeHeadOrTailRequest(MakeOffsetReference(source), n, {});
+  return Add(std::move(op), [](Operation *o) { return o->mutable_tail()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::Slice(int32_t source, int64_t first_position_inclusive,
+    int64_t last_position_exclusive) {
+  Operation op;
+  *op.mutable_slice() = MakeSliceRequest(MakeOffsetReference(source), first_position_inclusive,
+      last_position_exclusive, {});
+  return Add(std::move(op), [](Operation *o) { return o->mutable_slice()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::CrossJoin(int32_t left, int32_t right,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) {
+  Operation op;
+  *op.mutable_cross_join() = MakeJoinRequest<CrossJoinTablesRequest>(MakeOffsetReference(left),
+      MakeOffsetReference(right), std::move(columns_to_match), std::move(columns_to_add), {});
+  return Add(std::move(op),
+      [](Operation *o) { return o->mutable_cross_join()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::NaturalJoin(int32_t left, int32_t right,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) {
+  Operation op;
+  *op.mutable_natural_join() = MakeJoinRequest<NaturalJoinTablesRequest>(MakeOffsetReference(left),
+      MakeOffsetReference(right), std::move(columns_to_match), std::move(columns_to_add), {});
+  return Add(std::move(op),
+      [](Operation *o) { return o->mutable_natural_join()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::ExactJoin(int32_t left, int32_t right,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) {
+  Operation op;
+  *op.mutable_exact_join() = MakeJoinRequest<ExactJoinTablesRequest>(MakeOffsetReference(left),
+      MakeOffsetReference(right), std::move(columns_to_match), std::move(columns_to_add), {});
+  return Add(std::move(op),
+      [](Operation *o) { return o->mutable_exact_join()->mutable_result_id(); });
+}
+
+int32_t QueryBuilderImpl::Add(Operation op, resultId_t result_id) {
+  std::unique_lock guard(mutex_);
+  auto result = static_cast<int32_t>(request_.ops_size());
+  *request_.mutable_ops()->Add() = std::move(op);
+  resultIds_.push_back(result_id);
+  return result;
+}
+
+std::vector<std::shared_ptr<TableHandleImpl>> QueryBuilderImpl::Submit(
+    const std::vector<int32_t> &offsets) {
+  auto *server = manager_->Server().get();
+
+  // Copy what has been recorded, so that the builder can go on being used while we wait.
+  BatchTableRequest req;
+  std::vector<resultId_t> result_ids;
+  {
+    std::unique_lock guard(mutex_);
+    req = request_;
+    result_ids = resultIds_;
+  }
+
+  // Give each operation we were asked for a ticket to export its result to. The other operations
+  // stay anonymous, and the server releases their results once the batch no longer needs them.
+  std::map<int32_t, Ticket> tickets;
+  for (auto offset : offsets) {
+    if (offset < 0 || offset >= req.ops_size()) {
+      auto message = fmt::format("Offset {} is not in the batch, which has {} operations", offset,
+          req.ops_size());
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    if (tickets.find(offset) != tickets.end()) {
+      continue;
+    }
+    auto ticket = server->NewTicket();
+    *result_ids[offset](req.mutable_ops(offset)) = ticket;
+    tickets[offset] = std::move(ticket);
+  }
+
+  std::vector<ExportedTableCreationResponse> responses;
+  std::exception_ptr eptr;
+  try {
+    server->SendRpc([&](grpc::ClientContext *ctx) {
+      responses.clear();
+      auto reader = server->TableStub()->Batch(ctx, req);
+      ExportedTableCreationResponse resp;
+      while (reader->Read(&resp)) {
+        responses.push_back(std::move(resp));
+      }
+      return reader->Finish();
+    });
+  } catch (...) {
+    eptr = std::current_exception();
+  }
+
+  // Take ownership of every table the server exported, even if the batch failed as a whole, so
+  // that the ones we don't return get released.
+  std::map<std::string, std::shared_ptr<TableHandleImpl>> exported;
+  std::string errors;
+  for (auto &resp : responses) {
+    if (!resp.success()) {
+      errors.append(errors.empty() ? "" : "; ");
+      errors.append(resp.error_info());
+      continue;
+    }
+    if (!resp.result_id().has_ticket()) {
+      continue;
+    }
+    auto key = resp.result_id().ticket().ticket();
+    exported[std::move(key)] = TableHandleImpl::Create(manager_, std::move(resp));
+  }
+
+  // The server may have made tables for tickets it didn't report as exported (say, because a later
+  // operation failed), so release every ticket we allocated that no TableHandleImpl now owns.
+  for (const auto &[offset, ticket] : tickets) {
+    if (exported.find(ticket.ticket()) == exported.end()) {
+      server->Release(ticket);
+    }
+  }
+
+  if (eptr != nullptr) {
+    std::rethrow_exception(eptr);
+  }
+  if (!errors.empty()) {
+    auto message = fmt::format("Batch failed: {}", errors);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+
+  std::vector<std::shared_ptr<TableHandleImpl>> result;
+  result.reserve(offsets.size());
+  for (auto offset : offsets) {
+    auto ip = exported.find(tickets[offset].ticket());
+    if (ip == exported.end()) {
+      auto message = fmt::format("Server did not export the result of operation {}", offset);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    result.push_back(ip->second);
+  }
+  return result;
+}
+
+namespace {
+TableReference MakeOffsetReference(int32_t offset) {
+  TableReference result;
+  result.set_batch_offset(offset);
+  return result;
+}
+}  // namespace
+}  // namespace deephaven::client::impl
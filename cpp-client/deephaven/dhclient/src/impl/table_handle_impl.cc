@@ -3,15 +3,28 @@
  */
 #include "deephaven/client/impl/table_handle_impl.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
 #include <stdexcept>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <utility>
 #include <absl/log/log.h>
 #include <arrow/flight/client.h>
 #include <arrow/flight/types.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
 #include <arrow/type.h>
+#include "deephaven/client/arrowutil/flight_record_batch_reader.h"
+#include "deephaven/client/flight.h"
+#include "deephaven/client/impl/query_builder_impl.h"
 #include "deephaven/client/impl/table_handle_manager_impl.h"
+#include "deephaven/client/impl/table_requests.h"
 #include "deephaven/client/impl/update_by_operation_impl.h"
 #include "deephaven/client/client.h"
 #include "deephaven/client/client_options.h"
@@ -32,29 +45,24 @@ using io::deephaven::proto::backplane::grpc::ComboAggregateRequest;
 using io::deephaven::proto::backplane::grpc::CrossJoinTablesRequest;
 using io::deephaven::proto::backplane::grpc::DeleteTableRequest;
 using io::deephaven::proto::backplane::grpc::DeleteTableResponse;
-using io::deephaven::proto::backplane::grpc::DropColumnsRequest;
 using io::deephaven::proto::backplane::grpc::ExactJoinTablesRequest;
 using io::deephaven::proto::backplane::grpc::ExportedTableCreationResponse;
 using io::deephaven::proto::backplane::grpc::HeadOrTailByRequest;
-using io::deephaven::proto::backplane::grpc::HeadOrTailRequest;
 using io::deephaven::proto::backplane::grpc::LeftJoinTablesRequest;
 using io::deephaven::proto::backplane::grpc::MergeTablesRequest;
 using io::deephaven::proto::backplane::grpc::NaturalJoinTablesRequest;
 using io::deephaven::proto::backplane::grpc::ReleaseRequest;
 using io::deephaven::proto::backplane::grpc::ReleaseResponse;
 using io::deephaven::proto::backplane::grpc::SelectDistinctRequest;
-using io::deephaven::proto::backplane::grpc::SelectOrUpdateRequest;
-using io::deephaven::proto::backplane::grpc::SortDescriptor;
-using io::deephaven::proto::backplane::grpc::SortTableRequest;
 using io::deephaven::proto::backplane::grpc::TableReference;
 using io::deephaven::proto::backplane::grpc::TableService;
 using io::deephaven::proto::backplane::grpc::Ticket;
 using io::deephaven::proto::backplane::grpc::UngroupRequest;
 using io::deephaven::proto::backplane::grpc::UpdateByRequest;
-using io::deephaven::proto::backplane::grpc::UnstructuredFilterTableRequest;
 using io::deephaven::proto::backplane::grpc::WhereInRequest;
 using io::deephaven::proto::backplane::script::grpc::BindTableToVariableRequest;
 using io::deephaven::proto::backplane::script::grpc::BindTableToVariableResponse;
+using deephaven::client::arrowutil::FlightRecordBatchReader;
 using deephaven::client::impl::MoveVectorData;
 using deephaven::client::server::Server;
 using deephaven::client::subscription::SubscriptionThread;
@@ -73,6 +81,7 @@ using deephaven::dhcore::container::RowSequenceIterator;
 using deephaven::dhcore::ElementTypeId;
 using deephaven::dhcore::clienttable::Schema;
 using deephaven::dhcore::clienttable::ClientTable;
+using deephaven::dhcore::ticking::SubscriptionMetrics;
 using deephaven::dhcore::ticking::TickingCallback;
 using deephaven::dhcore::ticking::TickingUpdate;
 using deephaven::dhcore::utility::GetWhat;
@@ -82,20 +91,37 @@ using deephaven::dhcore::utility::separatedList;
 using UpdateByOperationProto = io::deephaven::proto::backplane::grpc::UpdateByRequest::UpdateByOperation;
 
 namespace deephaven::client::impl {
+namespace {
+/**
+ * Decodes the Arrow IPC Schema message the server sends in an ExportedTableCreationResponse.
+ * Returns null if it can't be decoded, so the caller can fall back to asking for the schema.
+ */
+std::shared_ptr<Schema> DecodeSchemaHeader(std::string schema_header);
+}  // namespace
+
 std::shared_ptr<TableHandleImpl>
 TableHandleImpl::Create(std::shared_ptr<TableHandleManagerImpl> thm,
     ExportedTableCreationResponse response) {
   return std::make_shared<TableHandleImpl>(Private(), std::move(thm),
       std::move(*response.mutable_result_id()->mutable_ticket()), response.size(),
-      response.is_static());
+      response.is_static(), std::move(*response.mutable_schema_header()));
 }
 
 TableHandleImpl::TableHandleImpl(Private, std::shared_ptr<TableHandleManagerImpl> &&thm,
-    TicketType &&ticket, int64_t num_rows, bool is_static) : managerImpl_(std::move(thm)),
-    ticket_(std::move(ticket)), num_rows_(num_rows), is_static_(is_static) {}
+    TicketType &&ticket, int64_t num_rows, bool is_static, std::string &&schema_header) :
+    managerImpl_(std::move(thm)), ticket_(std::move(ticket)), num_rows_(num_rows),
+    is_static_(is_static), schemaHeader_(std::move(schema_header)) {}
 
 TableHandleImpl::~TableHandleImpl() {
   try {
+    if (creation_ != nullptr) {
+      std::unique_lock guard(creation_->mutex_);
+      if (!creation_->done_) {
+        // The completion of SendAsync releases it once the server has replied.
+        creation_->orphan_ = std::move(ticket_);
+        return;
+      }
+    }
     managerImpl_->Server()->Release(std::move(ticket_));
   } catch (...) {
     auto what = GetWhat(std::current_exception());
@@ -125,11 +151,7 @@ std::shared_ptr<TableHandleImpl> TableHandleImpl::UpdateView(std::vector<std::st
 
 std::shared_ptr<TableHandleImpl> TableHandleImpl::DropColumns(std::vector<std::string> column_specs) {
   auto *server = managerImpl_->Server().get();
-  DropColumnsRequest req;
-  *req.mutable_result_id() = server->NewTicket();
-  *req.mutable_source_id()->mutable_ticket() = ticket_;
-  MoveVectorData(std::move(column_specs), req.mutable_column_names());
-
+  auto req = MakeDropColumnsRequest(MakeTicketReference(ticket_), std::move(column_specs), server->NewTicket());
   ExportedTableCreationResponse resp;
   server->SendRpc([&](grpc::ClientContext *ctx) {
     return server->TableStub()->DropColumns(ctx, req, &resp);
@@ -141,12 +163,7 @@ std::shared_ptr<TableHandleImpl>
 TableHandleImpl::SelectOrUpdateHelper(std::vector<std::string> column_specs,
     selectOrUpdateMethod_t which_method) {
   auto *server = managerImpl_->Server().get();
-  SelectOrUpdateRequest req;
-  *req.mutable_result_id() = server->NewTicket();
-  *req.mutable_source_id()->mutable_ticket() = ticket_;
-  for (auto &cs: column_specs) {
-    *req.mutable_column_specs()->Add() = std::move(cs);
-  }
+  auto req = MakeSelectOrUpdateRequest(MakeTicketReference(ticket_), std::move(column_specs), server->NewTicket());
   ExportedTableCreationResponse resp;
   server->SendRpc([&](grpc::ClientContext *ctx) {
     return (server->TableStub()->*which_method)(ctx, req, &resp);
@@ -156,10 +173,7 @@ TableHandleImpl::SelectOrUpdateHelper(std::vector<std::string> column_specs,
 
 std::shared_ptr<TableHandleImpl> TableHandleImpl::Where(std::string condition) {
   auto *server = managerImpl_->Server().get();
-  UnstructuredFilterTableRequest req;
-  *req.mutable_result_id() = server->NewTicket();
-  *req.mutable_source_id()->mutable_ticket() = ticket_;
-  *req.mutable_filters()->Add() = std::move(condition);
+  auto req = MakeWhereRequest(MakeTicketReference(ticket_), std::move(condition), server->NewTicket());
   ExportedTableCreationResponse resp;
   server->SendRpc([&](grpc::ClientContext *ctx) {
     return server->TableStub()->UnstructuredFilter(ctx, req, &resp);
@@ -169,18 +183,7 @@ std::shared_ptr<TableHandleImpl> TableHandleImpl::Where(std::string condition) {
 
 std::shared_ptr<TableHandleImpl> TableHandleImpl::Sort(std::vector<SortPair> sort_pairs) {
   auto *server = managerImpl_->Server().get();
-  SortTableRequest req;
-  *req.mutable_result_id() = server->NewTicket();
-  *req.mutable_source_id()->mutable_ticket() = ticket_;
-  for (auto &sp: sort_pairs) {
-    auto which = sp.Direction() == SortDirection::kAscending ?
-        SortDescriptor::ASCENDING : SortDescriptor::DESCENDING;
-    SortDescriptor sd;
-    sd.set_column_name(std::move(sp.Column()));
-    sd.set_is_absolute(sp.Abs());
-    sd.set_direction(which);
-    *req.mutable_sorts()->Add() = std::move(sd);
-  }
+  auto req = MakeSortRequest(MakeTicketReference(ticket_), std::move(sort_pairs), server->NewTicket());
   ExportedTableCreationResponse resp;
   server->SendRpc([&](grpc::ClientContext *ctx) {
     return server->TableStub()->Sort(ctx, req, &resp);
@@ -329,12 +332,21 @@ std::shared_ptr<TableHandleImpl> TableHandleImpl::Head(int64_t n) {
   return HeadOrTailHelper(true, n);
 }
 
+std::shared_ptr<TableHandleImpl> TableHandleImpl::Slice(int64_t first_position_inclusive,
+    int64_t last_position_exclusive) {
+  auto *server = managerImpl_->Server().get();
+  auto req = MakeSliceRequest(MakeTicketReference(ticket_), first_position_inclusive,
+      last_position_exclusive, server->NewTicket());
+  ExportedTableCreationResponse resp;
+  server->SendRpc([&](grpc::ClientContext *ctx) {
+    return server->TableStub()->Slice(ctx, req, &resp);
+  });
+  return TableHandleImpl::Create(managerImpl_, std::move(resp));
+}
+
 std::shared_ptr<TableHandleImpl> TableHandleImpl::HeadOrTailHelper(bool head, int64_t n) {
   auto *server = managerImpl_->Server().get();
-  HeadOrTailRequest req;
-  *req.mutable_result_id() = server->NewTicket();
-  *req.mutable_source_id()->mutable_ticket() = ticket_;
-  req.set_num_rows(n);
+  auto req = MakeHeadOrTailRequest(MakeTicketReference(ticket_), n, server->NewTicket());
   ExportedTableCreationResponse resp;
   const auto &which = head ? &TableService::Stub::Head : &TableService::Stub::Tail;
   server->SendRpc([&](grpc::ClientContext *ctx) {
@@ -377,12 +389,9 @@ std::shared_ptr<TableHandleImpl> TableHandleImpl::Merge(std::string key_column,
 std::shared_ptr<TableHandleImpl> TableHandleImpl::CrossJoin(const TableHandleImpl &right_side,
     std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) {
   auto *server = managerImpl_->Server().get();
-  CrossJoinTablesRequest req;
-  *req.mutable_result_id() = server->NewTicket();
-  *req.mutable_left_id()->mutable_ticket() = ticket_;
-  *req.mutable_right_id()->mutable_ticket() = right_side.ticket_;
-  MoveVectorData(std::move(columns_to_match), req.mutable_columns_to_match());
-  MoveVectorData(std::move(columns_to_add), req.mutable_columns_to_add());
+  auto req = MakeJoinRequest<CrossJoinTablesRequest>(MakeTicketReference(ticket_),
+      MakeTicketReference(right_side.ticket_),
+      std::move(columns_to_match), std::move(columns_to_add), server->NewTicket());
   ExportedTableCreationResponse resp;
   server->SendRpc([&](grpc::ClientContext *ctx) {
     return server->TableStub()->CrossJoinTables(ctx, req, &resp);
@@ -393,12 +402,9 @@ std::shared_ptr<TableHandleImpl> TableHandleImpl::CrossJoin(const TableHandleImp
 std::shared_ptr<TableHandleImpl> TableHandleImpl::NaturalJoin(const TableHandleImpl &right_side,
     std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) {
   auto *server = managerImpl_->Server().get();
-  NaturalJoinTablesRequest req;
-  *req.mutable_result_id() = server->NewTicket();
-  *req.mutable_left_id()->mutable_ticket() = ticket_;
-  *req.mutable_right_id()->mutable_ticket() = right_side.ticket_;
-  MoveVectorData(std::move(columns_to_match), req.mutable_columns_to_match());
-  MoveVectorData(std::move(columns_to_add), req.mutable_columns_to_add());
+  auto req = MakeJoinRequest<NaturalJoinTablesRequest>(MakeTicketReference(ticket_),
+      MakeTicketReference(right_side.ticket_),
+      std::move(columns_to_match), std::move(columns_to_add), server->NewTicket());
   ExportedTableCreationResponse resp;
   server->SendRpc([&](grpc::ClientContext *ctx) {
     return server->TableStub()->NaturalJoinTables(ctx, req, &resp);
@@ -409,12 +415,9 @@ std::shared_ptr<TableHandleImpl> TableHandleImpl::NaturalJoin(const TableHandleI
 std::shared_ptr<TableHandleImpl> TableHandleImpl::ExactJoin(const TableHandleImpl &right_side,
     std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) {
   auto *server = managerImpl_->Server().get();
-  ExactJoinTablesRequest req;
-  *req.mutable_result_id() = server->NewTicket();
-  *req.mutable_left_id()->mutable_ticket() = ticket_;
-  *req.mutable_right_id()->mutable_ticket() = right_side.ticket_;
-  MoveVectorData(std::move(columns_to_match), req.mutable_columns_to_match());
-  MoveVectorData(std::move(columns_to_add), req.mutable_columns_to_add());
+  auto req = MakeJoinRequest<ExactJoinTablesRequest>(MakeTicketReference(ticket_),
+      MakeTicketReference(right_side.ticket_),
+      std::move(columns_to_match), std::move(columns_to_add), server->NewTicket());
   ExportedTableCreationResponse resp;
   server->SendRpc([&](grpc::ClientContext *ctx) {
     return server->TableStub()->ExactJoinTables(ctx, req, &resp);
@@ -422,6 +425,166 @@ std::shared_ptr<TableHandleImpl> TableHandleImpl::ExactJoin(const TableHandleImp
   return TableHandleImpl::Create(managerImpl_, std::move(resp));
 }
 
+std::shared_ptr<TableHandleImpl> TableHandleImpl::SelectAsync(std::vector<std::string> column_specs) {
+  auto req = MakeSelectOrUpdateRequest(MakeTicketReference(ticket_), std::move(column_specs),
+      managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::Select);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::UpdateAsync(std::vector<std::string> column_specs) {
+  auto req = MakeSelectOrUpdateRequest(MakeTicketReference(ticket_), std::move(column_specs),
+      managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::Update);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::LazyUpdateAsync(std::vector<std::string> column_specs) {
+  auto req = MakeSelectOrUpdateRequest(MakeTicketReference(ticket_), std::move(column_specs),
+      managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::LazyUpdate);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::ViewAsync(std::vector<std::string> column_specs) {
+  auto req = MakeSelectOrUpdateRequest(MakeTicketReference(ticket_), std::move(column_specs),
+      managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::View);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::UpdateViewAsync(std::vector<std::string> column_specs) {
+  auto req = MakeSelectOrUpdateRequest(MakeTicketReference(ticket_), std::move(column_specs),
+      managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::UpdateView);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::DropColumnsAsync(std::vector<std::string> column_specs) {
+  auto req = MakeDropColumnsRequest(MakeTicketReference(ticket_), std::move(column_specs),
+      managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::DropColumns);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::WhereAsync(std::string condition) {
+  auto req = MakeWhereRequest(MakeTicketReference(ticket_), std::move(condition), managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::UnstructuredFilter);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::SortAsync(std::vector<SortPair> sort_pairs) {
+  auto req = MakeSortRequest(MakeTicketReference(ticket_), std::move(sort_pairs), managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::Sort);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::HeadAsync(int64_t n) {
+  auto req = MakeHeadOrTailRequest(MakeTicketReference(ticket_), n, managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::Head);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::TailAsync(int64_t n) {
+  auto req = MakeHeadOrTailRequest(MakeTicketReference(ticket_), n, managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::Tail);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::SliceAsync(int64_t first_position_inclusive,
+    int64_t last_position_exclusive) {
+  auto req = MakeSliceRequest(MakeTicketReference(ticket_), first_position_inclusive,
+      last_position_exclusive, managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::Slice);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::CrossJoinAsync(const TableHandleImpl &right_side,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) {
+  auto req = MakeJoinRequest<CrossJoinTablesRequest>(MakeTicketReference(ticket_),
+      MakeTicketReference(right_side.ticket_),
+      std::move(columns_to_match), std::move(columns_to_add), managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::CrossJoinTables);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::NaturalJoinAsync(const TableHandleImpl &right_side,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) {
+  auto req = MakeJoinRequest<NaturalJoinTablesRequest>(MakeTicketReference(ticket_),
+      MakeTicketReference(right_side.ticket_),
+      std::move(columns_to_match), std::move(columns_to_add), managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::NaturalJoinTables);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::ExactJoinAsync(const TableHandleImpl &right_side,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) {
+  auto req = MakeJoinRequest<ExactJoinTablesRequest>(MakeTicketReference(ticket_),
+      MakeTicketReference(right_side.ticket_),
+      std::move(columns_to_match), std::move(columns_to_add), managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::ExactJoinTables);
+}
+
+template<typename Request>
+std::shared_ptr<TableHandleImpl> TableHandleImpl::SendAsync(Request request,
+    asyncMethod_t<Request> method) {
+  // gRPC needs the request and response until the call completes.
+  struct State {
+    Request request_;
+    ExportedTableCreationResponse response_;
+    std::promise<void> promise_;
+  };
+  auto state = std::make_shared<State>();
+  state->request_ = std::move(request);
+  // The new table goes by the ticket we chose for it, so it exists before the server replies.
+  auto result = std::make_shared<TableHandleImpl>(Private(), std::shared_ptr(managerImpl_),
+      TicketType(state->request_.result_id()), 0, false, std::string());
+  result->created_ = state->promise_.get_future().share();
+  result->creation_ = std::make_shared<Creation>();
+
+  auto *server = managerImpl_->Server().get();
+  auto start = [server, &state, method](grpc::ClientContext *ctx,
+      std::function<void(grpc::Status)> done) {
+    (server->TableStub()->async()->*method)(ctx, &state->request_, &state->response_,
+        std::move(done));
+  };
+  auto on_done = [state, weak_result = std::weak_ptr(result), creation = result->creation_,
+      manager = managerImpl_](std::exception_ptr eptr) {
+    // This runs on a gRPC thread, which should not block. But releasing the ticket of a table
+    // that has been dropped may wait for room in the release queue. So we finish up on the client
+    // executor. Someone may be waiting in Await(), so this goes ahead of the executor's ordinary
+    // work.
+    auto finish = [state, weak_result, creation, manager, eptr]() {
+      auto promise = std::move(state->promise_);
+      if (eptr == nullptr) {
+        if (auto result = weak_result.lock(); result != nullptr) {
+          std::unique_lock guard(result->mutex_);
+          result->num_rows_ = state->response_.size();
+          result->is_static_ = state->response_.is_static();
+          result->schemaHeader_ = std::move(*state->response_.mutable_schema_header());
+        }
+      }
+      std::optional<TicketType> orphan;
+      {
+        std::unique_lock guard(creation->mutex_);
+        creation->done_ = true;
+        orphan = std::move(creation->orphan_);
+      }
+      if (orphan.has_value()) {
+        // The table was dropped while its request was outstanding. Now the server is done with
+        // the request, its ticket can go.
+        try {
+          manager->Server()->Release(std::move(*orphan));
+        } catch (...) {
+          auto what = GetWhat(std::current_exception());
+          LOG(INFO) << "SendAsync is ignoring thrown exception from Release: " << what;
+        }
+      }
+      if (eptr != nullptr) {
+        promise.set_exception(eptr);
+        return;
+      }
+      promise.set_value();
+    };
+    try {
+      manager->Executor()->Invoke(std::move(finish), Executor::Priority::kHigh);
+    } catch (...) {
+      // The client has been closed. Server::Shutdown() releases every ticket still outstanding,
+      // including one left in 'creation'.
+      state->promise_.set_exception(std::current_exception());
+    }
+  };
+  server->SendRpcAsync(start, std::move(on_done));
+  return result;
+}
+
 namespace {
 AjRajTablesRequest MakeAjRajTablesRequest(Ticket left_table_ticket, Ticket right_table_ticket,
     std::vector<std::string> on, std::vector<std::string> joins, Ticket result) {
@@ -468,6 +631,20 @@ std::shared_ptr<TableHandleImpl> TableHandleImpl::Raj(const TableHandleImpl &rig
   return TableHandleImpl::Create(managerImpl_, std::move(resp));
 }
 
+std::shared_ptr<TableHandleImpl> TableHandleImpl::AjAsync(const TableHandleImpl &right_side,
+    std::vector<std::string> on, std::vector<std::string> joins) {
+  auto req = MakeAjRajTablesRequest(ticket_, right_side.ticket_, std::move(on), std::move(joins),
+      managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::AjTables);
+}
+
+std::shared_ptr<TableHandleImpl> TableHandleImpl::RajAsync(const TableHandleImpl &right_side,
+    std::vector<std::string> on, std::vector<std::string> joins) {
+  auto req = MakeAjRajTablesRequest(ticket_, right_side.ticket_, std::move(on), std::move(joins),
+      managerImpl_->Server()->NewTicket());
+  return SendAsync(std::move(req), &TableService::Stub::async::RajTables);
+}
+
 std::shared_ptr<TableHandleImpl> TableHandleImpl::LeftOuterJoin(const TableHandleImpl &right_side,
     std::vector<std::string> on, std::vector<std::string> joins) {
   auto *server = managerImpl_->Server().get();
@@ -577,6 +754,18 @@ private:
   TableHandle::onErrorCallback_t onError_ = nullptr;
   void *onErrorUserData_ = nullptr;
 };
+
+std::optional<std::vector<size_t>> ResolveColumnIndices(const Schema &schema,
+    const std::vector<std::string> *columns) {
+  if (columns == nullptr) {
+    return {};
+  }
+  auto result = MakeReservedVector<size_t>(columns->size());
+  for (const auto &column : *columns) {
+    result.push_back(*schema.GetColumnIndex(column, true));
+  }
+  return result;
+}
 }
 
 std::shared_ptr<SubscriptionHandle>
@@ -587,14 +776,30 @@ TableHandleImpl::Subscribe(TableHandle::onTickCallback_t on_tick, void *on_tick_
 }
 
 std::shared_ptr<SubscriptionHandle> TableHandleImpl::Subscribe(std::shared_ptr<TickingCallback> callback) {
+  return Subscribe(std::move(callback), nullptr, nullptr, false, SubscriptionOptions());
+}
+
+std::shared_ptr<SubscriptionHandle> TableHandleImpl::Subscribe(std::shared_ptr<TickingCallback> callback,
+    const std::vector<std::string> *columns, const RowSequence *viewport, bool reverse_viewport,
+    const SubscriptionOptions &options) {
   // On the flight executor thread, we invoke DoExchange (waiting for a successful response).
   // We wait for that response here. That makes the first part of this call synchronous. If there
   // is an error in the DoExchange invocation, the caller will get an exception here. The
   // remainder of the interaction (namely, the sending of a BarrageSubscriptionRequest and the
-  // parsing of all the replies) is done on a newly-created thread dedicated to that job.
+  // parsing of all the replies) is done on a newly-created thread dedicated to that job, or, if
+  // the client was configured with subscription threads, by the shared SubscriptionScheduler.
   auto schema = Schema();
-  auto handle = SubscriptionThread::Start(managerImpl_->Server(), managerImpl_->FlightExecutor().get(),
-      schema, ticket_, std::move(callback));
+  auto column_indices = ResolveColumnIndices(*schema, columns);
+  const auto *column_indices_ptr = column_indices.has_value() ? &*column_indices : nullptr;
+  std::shared_ptr<SubscriptionHandle> handle;
+  if (const auto &scheduler = managerImpl_->SubscriptionScheduler(); scheduler != nullptr) {
+    handle = scheduler->Start(std::move(schema), ticket_, std::move(callback), column_indices_ptr,
+        viewport, reverse_viewport, options);
+  } else {
+    handle = SubscriptionThread::Start(managerImpl_->Server(),
+        managerImpl_->FlightExecutor().get(), std::move(schema), ticket_, std::move(callback),
+        column_indices_ptr, viewport, reverse_viewport, options);
+  }
   managerImpl_->AddSubscriptionHandle(handle);
   return handle;
 }
@@ -604,6 +809,128 @@ void TableHandleImpl::Unsubscribe(const std::shared_ptr<SubscriptionHandle> &han
   handle->Cancel();
 }
 
+void TableHandleImpl::SetViewport(const std::shared_ptr<SubscriptionHandle> &handle,
+    const RowSequence *viewport, bool reverse_viewport) {
+  handle->SetViewport(viewport, reverse_viewport);
+}
+
+SubscriptionMetrics TableHandleImpl::GetSubscriptionMetrics(
+    const std::shared_ptr<SubscriptionHandle> &handle) const {
+  return handle->Metrics();
+}
+
+std::shared_ptr<ClientTable> TableHandleImpl::Snapshot(const RowSequence *rows,
+    const std::vector<std::string> *columns, bool reverse_viewport,
+    const SubscriptionOptions &options) {
+  auto schema = Schema();
+  auto column_indices = ResolveColumnIndices(*schema, columns);
+  return SubscriptionThread::Snapshot(managerImpl_->Server(), std::move(schema), ticket_,
+      column_indices.has_value() ? &*column_indices : nullptr, rows, reverse_viewport, options);
+}
+
+std::shared_ptr<arrow::Table> TableHandleImpl::ToArrowTableParallel(size_t num_streams,
+    bool cooked) {
+  if (num_streams == 0) {
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR("num_streams must be at least 1"));
+  }
+  if (!IsStatic()) {
+    // The slices would be read at different times, and so would not fit together.
+    auto message = DEEPHAVEN_LOCATION_STR("ToArrowTableParallel requires a static table");
+    throw std::runtime_error(message);
+  }
+
+  // Never more streams than rows, and always at least one, so the empty table has a schema.
+  auto num_rows = NumRows();
+  num_streams = std::min(num_streams, static_cast<size_t>(std::max<int64_t>(num_rows, 1)));
+
+  std::vector<std::shared_ptr<TableHandleImpl>> parts;
+  if (num_streams == 1) {
+    parts.push_back(shared_from_this());
+  } else {
+    // Make all the slices in one round trip.
+    auto qb = QueryBuilderImpl::Create(managerImpl_);
+    auto source = qb->FromTableHandle(shared_from_this());
+    std::vector<int32_t> offsets;
+    offsets.reserve(num_streams);
+    for (size_t i = 0; i != num_streams; ++i) {
+      auto begin = num_rows * static_cast<int64_t>(i) / static_cast<int64_t>(num_streams);
+      auto end = num_rows * static_cast<int64_t>(i + 1) / static_cast<int64_t>(num_streams);
+      offsets.push_back(qb->Slice(source, begin, end));
+    }
+    parts = qb->Submit(offsets);
+  }
+
+  auto flight_clients = managerImpl_->Server()->FlightClients(num_streams);
+  arrow::flight::FlightCallOptions options;
+  FlightWrapper(managerImpl_).AddHeaders(&options);
+
+  using part_t = std::pair<std::shared_ptr<arrow::Schema>,
+      std::vector<std::shared_ptr<arrow::RecordBatch>>>;
+  auto read_part = [&options, cooked](arrow::flight::FlightClient *client,
+      const TableHandleImpl &part) {
+    arrow::flight::Ticket ticket;
+    ticket.ticket = part.Ticket().ticket();
+    auto fsr = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(client->DoGet(options, ticket)));
+    auto reader = FlightRecordBatchReader::Create(std::move(fsr), cooked);
+    part_t result;
+    result.first = reader->schema();
+    while (true) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      OkOrThrow(DEEPHAVEN_LOCATION_EXPR(reader->ReadNext(&batch)));
+      if (batch == nullptr) {
+        return result;
+      }
+      result.second.push_back(std::move(batch));
+    }
+  };
+
+  // There may be more slices than connections. Each worker reads on a connection of its own,
+  // taking the next unread slice until there are none left, or until some worker has failed.
+  std::vector<part_t> results(num_streams);
+  std::atomic<size_t> next_part = 0;
+  auto worker = [&](arrow::flight::FlightClient *client) {
+    while (true) {
+      auto i = next_part++;
+      if (i >= num_streams) {
+        return;
+      }
+      try {
+        results[i] = read_part(client, *parts[i]);
+      } catch (...) {
+        next_part = num_streams;
+        throw;
+      }
+    }
+  };
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(flight_clients.size());
+  for (auto *client : flight_clients) {
+    futures.push_back(std::async(std::launch::async, worker, client));
+  }
+
+  // Wait for all of them before rethrowing, because they refer to 'options', 'parts' and
+  // 'results'.
+  std::exception_ptr eptr;
+  for (auto &future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      eptr = std::current_exception();
+    }
+  }
+  if (eptr != nullptr) {
+    std::rethrow_exception(eptr);
+  }
+
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (auto &result : results) {
+    std::move(result.second.begin(), result.second.end(), std::back_inserter(batches));
+  }
+  return ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
+      arrow::Table::FromRecordBatches(results.front().first, std::move(batches))));
+}
+
 void TableHandleImpl::BindToVariable(std::string variable) {
   const auto &console_id = managerImpl_->ConsoleId();
   if (!console_id.has_value()) {
@@ -623,7 +950,27 @@ void TableHandleImpl::BindToVariable(std::string variable) {
   });
 }
 
+void TableHandleImpl::Await() const {
+  if (created_.valid()) {
+    // Each waiter uses a copy of the shared_future, as the standard asks.
+    auto created = created_;
+    created.get();
+  }
+}
+
+int64_t TableHandleImpl::NumRows() const {
+  Await();
+  return num_rows_;
+}
+
+bool TableHandleImpl::IsStatic() const {
+  Await();
+  return is_static_;
+}
+
 std::shared_ptr<Schema> TableHandleImpl::Schema() {
+  // The schema header comes with the server's reply.
+  Await();
   std::unique_lock guard(mutex_);
   if (schema_request_sent_) {
     // Schema request already sent by someone else. So wait for the successful result or error.
@@ -636,36 +983,19 @@ std::shared_ptr<Schema> TableHandleImpl::Schema() {
   std::promise<std::shared_ptr<SchemaType>> schema_promise;
   schema_future_ = schema_promise.get_future().share();
   schema_request_sent_ = true;
+  auto schema_header = std::move(schemaHeader_);
+  schemaHeader_.clear();
   guard.unlock();
 
   try {
-    auto *server = managerImpl_->Server().get();
-
-    arrow::flight::FlightCallOptions options;
-    // Note: Authorization and envoy-prefix headers are automatically added by BearerMiddleware
-    // Only add OTHER extra headers here (if any)
-    server->ForEachHeaderNameAndValue(
-        [&options](const std::string &name, const std::string &value) {
-          // Skip authorization (handled by middleware)
-          if (name == kAuthorizationHeader) {
-            return;
-          }
-          // Skip envoy-prefix (handled by middleware)
-          if (name == kEnvoyPrefixHeader) {
-            return;
-          }
-          // Add any other extra headers
-          options.headers.emplace_back(name, value);
-        }
-    );
-
-    auto fd = ArrowUtil::ConvertTicketToFlightDescriptor(ticket_.ticket());
-    auto gs_result = server->FlightClient()->GetSchema(options, fd);
-    OkOrThrow(DEEPHAVEN_LOCATION_EXPR(gs_result));
-
-    auto schema_result = (*gs_result)->GetSchema(nullptr);
-    auto arrow_schema = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(schema_result));
-    auto deephaven_schema = ArrowUtil::MakeDeephavenSchema(*arrow_schema);
+    // Usually the server told us the schema when it made the table, which saves a round trip.
+    std::shared_ptr<SchemaType> deephaven_schema;
+    if (!schema_header.empty()) {
+      deephaven_schema = DecodeSchemaHeader(std::move(schema_header));
+    }
+    if (deephaven_schema == nullptr) {
+      deephaven_schema = FetchSchema();
+    }
     schema_promise.set_value(std::move(deephaven_schema));
   } catch (...) {
     schema_promise.set_exception(std::current_exception());
@@ -673,4 +1003,46 @@ std::shared_ptr<Schema> TableHandleImpl::Schema() {
 
   return schema_future_.get();
 }
+
+std::shared_ptr<Schema> TableHandleImpl::FetchSchema() {
+  auto *server = managerImpl_->Server().get();
+
+  arrow::flight::FlightCallOptions options;
+  // Note: Authorization and envoy-prefix headers are automatically added by BearerMiddleware
+  // Only add OTHER extra headers here (if any)
+  server->ForEachHeaderNameAndValue(
+      [&options](const std::string &name, const std::string &value) {
+        // Skip authorization (handled by middleware)
+        if (name == kAuthorizationHeader) {
+          return;
+        }
+        // Skip envoy-prefix (handled by middleware)
+        if (name == kEnvoyPrefixHeader) {
+          return;
+        }
+        // Add any other extra headers
+        options.headers.emplace_back(name, value);
+      }
+  );
+
+  auto fd = ArrowUtil::ConvertTicketToFlightDescriptor(ticket_.ticket());
+  auto gs_result = server->FlightClient()->GetSchema(options, fd);
+  OkOrThrow(DEEPHAVEN_LOCATION_EXPR(gs_result));
+
+  auto schema_result = (*gs_result)->GetSchema(nullptr);
+  auto arrow_schema = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(schema_result));
+  return ArrowUtil::MakeDeephavenSchema(*arrow_schema);
+}
+
+namespace {
+std::shared_ptr<Schema> DecodeSchemaHeader(std::string schema_header) {
+  auto schema_result = ArrowUtil::ReadSchemaMessage(std::move(schema_header));
+  if (!schema_result.ok()) {
+    LOG(WARNING) << "Can't decode the schema_header (" << schema_result.status().ToString()
+        << "). Asking the server for the schema instead.";
+    return nullptr;
+  }
+  return ArrowUtil::MakeDeephavenSchema(**schema_result);
+}
+}  // namespace
 }  // namespace deephaven::client::impl
@@ -7,39 +7,38 @@
 #include <absl/log/log.h>
 #include "deephaven/client/utility/executor.h"
 #include "deephaven/client/impl/table_handle_impl.h"
+#include "deephaven/client/impl/table_requests.h"
 #include "deephaven/client/impl/util.h"
 #include "deephaven/dhcore/utility/utility.h"
 
 using deephaven::client::impl::MoveVectorData;
 using deephaven::dhcore::utility::ObjectId;
 using io::deephaven::proto::backplane::grpc::CreateInputTableRequest;
-using io::deephaven::proto::backplane::grpc::EmptyTableRequest;
-using io::deephaven::proto::backplane::grpc::FetchTableRequest;
 using io::deephaven::proto::backplane::grpc::TimeTableRequest;
 using io::deephaven::proto::backplane::grpc::Ticket;
 using io::deephaven::proto::backplane::script::grpc::ExecuteCommandRequest;
 using io::deephaven::proto::backplane::script::grpc::ExecuteCommandResponse;
 
 namespace deephaven::client::impl {
-namespace {
-Ticket MakeScopeReference(std::string_view table_name);
-}  // namespace
-
 std::shared_ptr<TableHandleManagerImpl> TableHandleManagerImpl::Create(std::optional<Ticket> console_id,
     std::shared_ptr<ServerType> server, std::shared_ptr<ExecutorType> executor,
-    std::shared_ptr<ExecutorType> flight_executor) {
+    std::shared_ptr<ExecutorType> flight_executor,
+    std::shared_ptr<SubscriptionSchedulerType> subscription_scheduler) {
   return std::make_shared<TableHandleManagerImpl>(Private(), std::move(console_id),
-      std::move(server), std::move(executor), std::move(flight_executor));
+      std::move(server), std::move(executor), std::move(flight_executor),
+      std::move(subscription_scheduler));
 }
 
 TableHandleManagerImpl::TableHandleManagerImpl(Private, std::optional<Ticket> &&console_id,
     std::shared_ptr<ServerType> &&server, std::shared_ptr<ExecutorType> &&executor,
-    std::shared_ptr<ExecutorType> &&flight_executor) :
+    std::shared_ptr<ExecutorType> &&flight_executor,
+    std::shared_ptr<SubscriptionSchedulerType> &&subscription_scheduler) :
     me_(deephaven::dhcore::utility::ObjectId("TableHandleManagerImpl", this)),
     consoleId_(std::move(console_id)),
     server_(std::move(server)),
     executor_(std::move(executor)),
-    flightExecutor_(std::move(flight_executor)) {
+    flightExecutor_(std::move(flight_executor)),
+    subscriptionScheduler_(std::move(subscription_scheduler)) {
   VLOG(2) << me_ << ": Created.";
 }
 
@@ -51,15 +50,16 @@ void TableHandleManagerImpl::Shutdown() {
   for (const auto &sub : subscriptions_) {
     sub->Cancel();
   }
+  if (subscriptionScheduler_ != nullptr) {
+    subscriptionScheduler_->Shutdown();
+  }
   executor_->Shutdown();
   flightExecutor_->Shutdown();
   server_->Shutdown();
 }
 
 std::shared_ptr<TableHandleImpl> TableHandleManagerImpl::EmptyTable(int64_t size) {
-  EmptyTableRequest req;
-  *req.mutable_result_id() = server_->NewTicket();
-  req.set_size(size);
+  auto req = MakeEmptyTableRequest(size, server_->NewTicket());
   ExportedTableCreationResponse resp;
   server_->SendRpc([&](grpc::ClientContext *ctx) {
     return server_->TableStub()->EmptyTable(ctx, req, &resp);
@@ -68,9 +68,8 @@ std::shared_ptr<TableHandleImpl> TableHandleManagerImpl::EmptyTable(int64_t size
 }
 
 std::shared_ptr<TableHandleImpl> TableHandleManagerImpl::FetchTable(std::string table_name) {
-  FetchTableRequest req;
-  *req.mutable_result_id() = server_->NewTicket();
-  *req.mutable_source_id()->mutable_ticket() = MakeScopeReference(table_name);
+  auto req = MakeFetchTableRequest(MakeTicketReference(MakeScopeReference(table_name)),
+      server_->NewTicket());
   ExportedTableCreationResponse resp;
   server_->SendRpc([&](grpc::ClientContext *ctx) {
     return server_->TableStub()->FetchTable(ctx, req, &resp);
@@ -173,18 +172,4 @@ void TableHandleManagerImpl::RemoveSubscriptionHandle(const std::shared_ptr<Subs
   std::unique_lock guard(mutex_);
   subscriptions_.erase(handle);
 }
-namespace {
-Ticket MakeScopeReference(std::string_view table_name) {
-  if (table_name.empty()) {
-    auto message = DEEPHAVEN_LOCATION_STR("table_name is empty");
-    throw std::runtime_error(message);
-  }
-
-  Ticket result;
-  result.mutable_ticket()->reserve(2 + table_name.size());
-  result.mutable_ticket()->append("s/");
-  result.mutable_ticket()->append(table_name);
-  return result;
-}
-}  // namespace
 }  // namespace deephaven::client::impl
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/client/impl/table_requests.h"
+
+#include <stdexcept>
+#include "deephaven/dhcore/utility/utility.h"
+
+using io::deephaven::proto::backplane::grpc::DropColumnsRequest;
+using io::deephaven::proto::backplane::grpc::EmptyTableRequest;
+using io::deephaven::proto::backplane::grpc::FetchTableRequest;
+using io::deephaven::proto::backplane::grpc::HeadOrTailRequest;
+using io::deephaven::proto::backplane::grpc::SelectOrUpdateRequest;
+using io::deephaven::proto::backplane::grpc::SliceRequest;
+using io::deephaven::proto::backplane::grpc::SortDescriptor;
+using io::deephaven::proto::backplane::grpc::SortTableRequest;
+using io::deephaven::proto::backplane::grpc::TableReference;
+using io::deephaven::proto::backplane::grpc::Ticket;
+using io::deephaven::proto::backplane::grpc::UnstructuredFilterTableRequest;
+
+namespace deephaven::client::impl {
+TableReference MakeTicketReference(Ticket ticket) {
+  TableReference result;
+  *result.mutable_ticket() = std::move(ticket);
+  return result;
+}
+
+Ticket MakeScopeReference(std::string_view table_name) {
+  if (table_name.empty()) {
+    auto message = DEEPHAVEN_LOCATION_STR("table_name is empty");
+    throw std::runtime_error(message);
+  }
+
+  Ticket result;
+  result.mutable_ticket()->reserve(2 + table_name.size());
+  result.mutable_ticket()->append("s/");
+  result.mutable_ticket()->append(table_name);
+  return result;
+}
+
+EmptyTableRequest MakeEmptyTableRequest(int64_t size, Ticket result) {
+  EmptyTableRequest req;
+  *req.mutable_result_id() = std::move(result);
+  req.set_size(size);
+  return req;
+}
+
+FetchTableRequest MakeFetchTableRequest(TableReference source, Ticket result) {
+  FetchTableRequest req;
+  *req.mutable_result_id() = std::move(result);
+  *req.mutable_source_id() = std::move(source);
+  return req;
+}
+
+SelectOrUpdateRequest MakeSelectOrUpdateRequest(TableReference source,
+    std::vector<std::string> column_specs, Ticket result) {
+  SelectOrUpdateRequest req;
+  *req.mutable_result_id() = std::move(result);
+  *req.mutable_source_id() = std::move(source);
+  for (auto &cs: column_specs) {
+    *req.mutable_column_specs()->Add() = std::move(cs);
+  }
+  return req;
+}
+
+DropColumnsRequest MakeDropColumnsRequest(TableReference source,
+    std::vector<std::string> column_specs, Ticket result) {
+  DropColumnsRequest req;
+  *req.mutable_result_id() = std::move(result);
+  *req.mutable_source_id() = std::move(source);
+  MoveVectorData(std::move(column_specs), req.mutable_column_names());
+  return req;
+}
+
+UnstructuredFilterTableRequest MakeWhereRequest(TableReference source, std::string condition,
+    Ticket result) {
+  UnstructuredFilterTableRequest req;
+  *req.mutable_result_id() = std::move(result);
+  *req.mutable_source_id() = std::move(source);
+  *req.mutable_filters()->Add() = std::move(condition);
+  return req;
+}
+
+SortTableRequest MakeSortRequest(TableReference source, std::vector<SortPair> sort_pairs,
+    Ticket result) {
+  SortTableRequest req;
+  *req.mutable_result_id() = std::move(result);
+  *req.mutable_source_id() = std::move(source);
+  for (auto &sp: sort_pairs) {
+    auto which = sp.Direction() == SortDirection::kAscending ?
+        SortDescriptor::ASCENDING : SortDescriptor::DESCENDING;
+    SortDescriptor sd;
+    sd.set_column_name(std::move(sp.Column()));
+    sd.set_is_absolute(sp.Abs());
+    sd.set_direction(which);
+    *req.mutable_sorts()->Add() = std::move(sd);
+  }
+  return req;
+}
+
+HeadOrTailRequest MakeHeadOrTailRequest(TableReference source, int64_t n, Ticket result) {
+  HeadOrTailRequest req;
+  *req.mutable_result_id() = std::move(result);
+  *req.mutable_source_id() = std::move(source);
+  req.set_num_rows(n);
+  return req;
+}
+
+SliceRequest MakeSliceRequest(TableReference source, int64_t first_position_inclusive,
+    int64_t last_position_exclusive, Ticket result) {
+  SliceRequest req;
+  *req.mutable_result_id() = std::move(result);
+  *req.mutable_source_id() = std::move(source);
+  req.set_first_position_inclusive(first_position_inclusive);
+  req.set_last_position_exclusive(last_position_exclusive);
+  return req;
+}
+}  // namespace deephaven::client::impl
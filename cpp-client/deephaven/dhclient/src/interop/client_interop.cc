@@ -20,6 +20,7 @@
 #include "deephaven/client/utility/table_maker.h"
 #include "deephaven/dhcore/chunk/chunk.h"
 #include "deephaven/dhcore/interop/interop_util.h"
+#include "deephaven/dhcore/ticking/subscription_options.h"
 #include "deephaven/dhcore/ticking/ticking.h"
 #include "deephaven/dhcore/types.h"
 #include "deephaven/dhcore/utility/utility.h"
@@ -59,6 +60,8 @@ using deephaven::dhcore::interop::NativePtr;
 using deephaven::dhcore::interop::StringHandle;
 using deephaven::dhcore::interop::StringPoolBuilder;
 using deephaven::dhcore::interop::StringPoolHandle;
+using deephaven::dhcore::ticking::ColumnConversionMode;
+using deephaven::dhcore::ticking::SubscriptionOptions;
 using deephaven::dhcore::ticking::TickingCallback;
 using deephaven::dhcore::ticking::TickingUpdate;
 using deephaven::dhcore::utility::GetWhat;
@@ -748,6 +751,33 @@ void deephaven_client_TableHandle_Subscribe(
   });
 }
 
+void deephaven_client_TableHandle_SubscribeWithOptions(
+    NativePtr<TableHandle> self,
+    NativePtr<NativeOnUpdate> native_on_update,
+    NativePtr<NativeOnFailure> native_on_failure,
+    int32_t batch_size, int32_t max_message_size, int32_t min_update_interval_ms,
+    int32_t column_conversion_mode,
+    NativePtr<std::shared_ptr<SubscriptionHandle>> *native_subscription_handle,
+    ErrorStatus *status) {
+  status->Run([=]() {
+    // Check the value before converting it, because it comes from the other side of the FFI.
+    if (column_conversion_mode < static_cast<int32_t>(ColumnConversionMode::kStringify) ||
+        column_conversion_mode > static_cast<int32_t>(ColumnConversionMode::kThrowError)) {
+      auto message = fmt::format("Unknown column_conversion_mode {}", column_conversion_mode);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    auto mode = static_cast<ColumnConversionMode>(column_conversion_mode);
+    SubscriptionOptions options;
+    options.SetBatchSize(batch_size)
+        .SetMaxMessageSize(max_message_size)
+        .SetMinUpdateIntervalMs(min_update_interval_ms)
+        .SetColumnConversionMode(mode);
+    auto wtc = std::make_shared<WrappedTickingCallback>(native_on_update, native_on_failure);
+    auto handle = self->Subscribe(std::move(wtc), options);
+    native_subscription_handle->Reset(new std::shared_ptr<SubscriptionHandle>(std::move(handle)));
+  });
+}
+
 void deephaven_client_TableHandle_Unsubscribe(
     NativePtr<deephaven::client::TableHandle> self,
     NativePtr<std::shared_ptr<deephaven::client::subscription::SubscriptionHandle>> native_subscription_handle,
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/client/query_builder.h"
+
+#include <stdexcept>
+#include "deephaven/client/impl/query_builder_impl.h"
+#include "deephaven/client/impl/table_handle_impl.h"
+#include "deephaven/dhcore/utility/utility.h"
+
+using deephaven::client::impl::QueryBuilderImpl;
+
+namespace deephaven::client {
+QueryBuilder TableHandleManager::CreateQueryBuilder() const {
+  return QueryBuilder(QueryBuilderImpl::Create(impl_));
+}
+
+QueryTable::QueryTable() = default;
+QueryTable::QueryTable(std::shared_ptr<impl::QueryBuilderImpl> builder, int32_t offset) :
+    builder_(std::move(builder)), offset_(offset) {}
+QueryTable::QueryTable(const QueryTable &other) = default;
+QueryTable &QueryTable::operator=(const QueryTable &other) = default;
+QueryTable::QueryTable(QueryTable &&other) noexcept = default;
+QueryTable &QueryTable::operator=(QueryTable &&other) noexcept = default;
+QueryTable::~QueryTable() = default;
+
+QueryTable QueryTable::Select(std::vector<std::string> column_specs) const {
+  return {builder_, Builder().Select(offset_, std::move(column_specs))};
+}
+
+QueryTable QueryTable::Update(std::vector<std::string> column_specs) const {
+  return {builder_, Builder().Update(offset_, std::move(column_specs))};
+}
+
+QueryTable QueryTable::LazyUpdate(std::vector<std::string> column_specs) const {
+  return {builder_, Builder().LazyUpdate(offset_, std::move(column_specs))};
+}
+
+QueryTable QueryTable::View(std::vector<std::string> column_specs) const {
+  return {builder_, Builder().View(offset_, std::move(column_specs))};
+}
+
+QueryTable QueryTable::UpdateView(std::vector<std::string> column_specs) const {
+  return {builder_, Builder().UpdateView(offset_, std::move(column_specs))};
+}
+
+QueryTable QueryTable::DropColumns(std::vector<std::string> column_specs) const {
+  return {builder_, Builder().DropColumns(offset_, std::move(column_specs))};
+}
+
+QueryTable QueryTable::Where(std::string condition) const {
+  return {builder_, Builder().Where(offset_, std::move(condition))};
+}
+
+QueryTable QueryTable::Sort(std::vector<SortPair> sort_pairs) const {
+  return {builder_, Builder().Sort(offset_, std::move(sort_pairs))};
+}
+
+QueryTable QueryTable::Head(int64_t n) const {
+  return {builder_, Builder().Head(offset_, n)};
+}
+
+QueryTable QueryTable::Tail(int64_t n) const {
+  return {builder_, Builder().Tail(offset_, n)};
+}
+
+QueryTable QueryTable::Slice(int64_t first_position_inclusive,
+    int64_t last_position_exclusive) const {
+  return {builder_, Builder().Slice(offset_, first_position_inclusive, last_position_exclusive)};
+}
+
+QueryTable QueryTable::CrossJoin(const QueryTable &right_side,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) const {
+  auto right = CheckSameBuilder(right_side);
+  return {builder_, Builder().CrossJoin(offset_, right, std::move(columns_to_match),
+      std::move(columns_to_add))};
+}
+
+QueryTable QueryTable::NaturalJoin(const QueryTable &right_side,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) const {
+  auto right = CheckSameBuilder(right_side);
+  return {builder_, Builder().NaturalJoin(offset_, right, std::move(columns_to_match),
+      std::move(columns_to_add))};
+}
+
+QueryTable QueryTable::ExactJoin(const QueryTable &right_side,
+    std::vector<std::string> columns_to_match, std::vector<std::string> columns_to_add) const {
+  auto right = CheckSameBuilder(right_side);
+  return {builder_, Builder().ExactJoin(offset_, right, std::move(columns_to_match),
+      std::move(columns_to_add))};
+}
+
+impl::QueryBuilderImpl &QueryTable::Builder() const {
+  if (builder_ == nullptr) {
+    const char *message = "This QueryTable is empty. Only QueryTables made by a QueryBuilder, or "
+        "by the operations of another QueryTable, can be used";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  return *builder_;
+}
+
+int32_t QueryTable::CheckSameBuilder(const QueryTable &other) const {
+  (void)Builder();
+  (void)other.Builder();
+  if (other.builder_ != builder_) {
+    auto message = DEEPHAVEN_LOCATION_STR("QueryTables come from different QueryBuilders");
+    throw std::runtime_error(message);
+  }
+  return other.offset_;
+}
+
+QueryBuilder::QueryBuilder() = default;
+QueryBuilder::QueryBuilder(std::shared_ptr<impl::QueryBuilderImpl> impl) : impl_(std::move(impl)) {}
+QueryBuilder::QueryBuilder(const QueryBuilder &other) = default;
+QueryBuilder &QueryBuilder::operator=(const QueryBuilder &other) = default;
+QueryBuilder::QueryBuilder(QueryBuilder &&other) noexcept = default;
+QueryBuilder &QueryBuilder::operator=(QueryBuilder &&other) noexcept = default;
+QueryBuilder::~QueryBuilder() = default;
+
+impl::QueryBuilderImpl &QueryBuilder::Builder() const {
+  if (impl_ == nullptr) {
+    const char *message = "This QueryBuilder is empty. Get one from "
+        "TableHandleManager::CreateQueryBuilder()";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  return *impl_;
+}
+
+QueryTable QueryBuilder::EmptyTable(int64_t size) const {
+  return {impl_, Builder().EmptyTable(size)};
+}
+
+QueryTable QueryBuilder::FetchTable(std::string table_name) const {
+  return {impl_, Builder().FetchTable(std::move(table_name))};
+}
+
+QueryTable QueryBuilder::FromTableHandle(const TableHandle &table) const {
+  return {impl_, Builder().FromTableHandle(table.Impl())};
+}
+
+TableHandle QueryBuilder::Submit(const QueryTable &table) const {
+  auto result = Submit(std::vector<QueryTable>{table});
+  return std::move(result.front());
+}
+
+std::vector<TableHandle> QueryBuilder::Submit(const std::vector<QueryTable> &tables) const {
+  auto &builder = Builder();
+  std::vector<int32_t> offsets;
+  offsets.reserve(tables.size());
+  for (const auto &table : tables) {
+    (void)table.Builder();
+    if (table.builder_ != impl_) {
+      auto message = DEEPHAVEN_LOCATION_STR("QueryTable comes from a different QueryBuilder");
+      throw std::runtime_error(message);
+    }
+    offsets.push_back(table.offset_);
+  }
+  auto impls = builder.Submit(offsets);
+  std::vector<TableHandle> result;
+  result.reserve(impls.size());
+  for (auto &impl : impls) {
+    result.emplace_back(std::move(impl));
+  }
+  return result;
+}
+}  // namespace deephaven::client
@@ -3,8 +3,10 @@
  */
 #include "deephaven/client/server/server.h"
 
+#include <algorithm>
 #include <charconv>
 #include <exception>
+#include <iterator>
 #include <grpcpp/grpcpp.h>
 #include <optional>
 #include <absl/log/log.h>
@@ -42,6 +44,11 @@ constexpr const char *kTimeoutKey = "http.session.durationMs";
 // A handshake resend interval to use as a default if our normal interval calculation
 // fails, e.g. due to GRPC errors.
 constexpr const auto kHandshakeResendInterval = std::chrono::seconds(5);
+
+// How many released tickets may wait for the release thread before Release() blocks.
+constexpr const size_t kMaxQueuedReleases = 64 * 1024;
+// How many Release calls the release thread has outstanding at once.
+constexpr const size_t kMaxReleasesInFlight = 64;
 }  // namespace
 
 namespace {
@@ -104,6 +111,7 @@ std::shared_ptr<Server> Server::CreateFromTarget(
   auto ts = TableService::NewStub(channel);
   auto cfs = ConfigService::NewStub(channel);
   auto its = InputTableService::NewStub(channel);
+  auto gs = std::make_unique<grpc::GenericStub>(channel);
 
   // Try to dodge a Flight bug when there's a missing port number.
   // If we're using TLS and there's no port number provided, then append :443.
@@ -192,11 +200,14 @@ std::shared_ptr<Server> Server::CreateFromTarget(
           << ") created with BearerMiddleware, target=" << target;
 
   auto result = std::make_shared<Server>(Private(), std::move(as), std::move(cs),
-    std::move(ss), std::move(ts), std::move(cfs), std::move(its), std::move(*client_res),
+    std::move(ss), std::move(ts), std::move(cfs), std::move(its), std::move(gs),
+    std::move(*client_res), std::move(*location_res), std::move(options),
     shared_state);
 
   // Start the keepalive thread
   shared_state->keepAliveThread_ = std::thread(&SendKeepaliveMessages, result);
+  // And the thread that releases tickets
+  result->releaseThread_ = std::thread(&ReleaseTickets, result);
   VLOG(2) << "Server::CreateFromTarget: Server(" << static_cast<void*>(result.get())
           << ") created, target=" << target;
   return result;
@@ -209,7 +220,10 @@ Server::Server(Private,
     std::unique_ptr<TableService::Stub> table_stub,
     std::unique_ptr<ConfigService::Stub> config_stub,
     std::unique_ptr<InputTableService::Stub> input_table_stub,
+    std::unique_ptr<grpc::GenericStub> generic_stub,
     std::unique_ptr<arrow::flight::FlightClient> flight_client,
+    arrow::flight::Location flight_location,
+    arrow::flight::FlightClientOptions flight_options,
     std::shared_ptr<ServerSharedState> shared_state) :
     me_(deephaven::dhcore::utility::ObjectId(
         "client::server::Server", this)),
@@ -219,7 +233,10 @@ Server::Server(Private,
     tableStub_(std::move(table_stub)),
     configStub_(std::move(config_stub)),
     input_table_stub_(std::move(input_table_stub)),
+    genericStub_(std::move(generic_stub)),
     flightClient_(std::move(flight_client)),
+    flightLocation_(std::move(flight_location)),
+    flightOptions_(std::move(flight_options)),
     shared_state_(std::move(shared_state)) {
 }
 
@@ -227,6 +244,37 @@ Server::~Server() {
   VLOG(2) << me_ << ": Destroyed.";
 }
 
+std::vector<arrow::flight::FlightClient *> Server::FlightClients(size_t n) {
+  std::vector<arrow::flight::FlightClient *> result;
+  n = std::min(n, kMaxFlightClients);
+  if (n == 0) {
+    return result;
+  }
+  result.reserve(n);
+  result.push_back(flightClient_.get());
+
+  std::unique_lock guard(flightClientsMutex_);
+  while (extraFlightClients_.size() < n - 1) {
+    // gRPC shares a connection among channels with the same target and arguments unless they
+    // each have their own subchannel pool.
+    auto options = flightOptions_;
+    options.generic_options.emplace_back(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    auto client_res = arrow::flight::FlightClient::Connect(flightLocation_, options);
+    if (!client_res.ok()) {
+      auto message = fmt::format("FlightClient::Connect() failed, error = {}",
+          client_res.status().ToString());
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    VLOG(2) << me_ << ": extra FlightClient(" << static_cast<void*>(client_res->get())
+            << ") created.";
+    extraFlightClients_.push_back(std::move(*client_res));
+  }
+  for (size_t i = 0; i != n - 1; ++i) {
+    result.push_back(extraFlightClients_[i].get());
+  }
+  return result;
+}
+
 void Server::Shutdown() {
   VLOG(2) << me_ << ": Server Shutdown requested.";
 
@@ -237,16 +285,33 @@ void Server::Shutdown() {
     return;
   }
   shared_state_->cancelled_ = true;
-  auto tickets_to_release = std::move(shared_state_->outstanding_tickets_);
-  shared_state_->outstanding_tickets_.clear();
   guard.unlock();
 
-  for (const auto &ticket : tickets_to_release) {
-    try {
-      ReleaseUnchecked(ticket);
-    } catch (...) {
-      auto what = GetWhat(std::current_exception());
-      LOG(INFO) << "Server::Shutdown() is ignoring thrown exception: " << what;
+  // Queue every ticket that is still outstanding for release, close the queue, and wait for the
+  // release thread to drain it. The release RPCs disregard the cancelled_ flag.
+  {
+    std::unique_lock ticket_guard(ticketMutex_);
+    ticketsClosed_ = true;
+    for (const auto &ticket_bytes : outstandingTickets_) {
+      Ticket ticket;
+      *ticket.mutable_ticket() = ticket_bytes;
+      releaseQueue_.push_back(std::move(ticket));
+    }
+    outstandingTickets_.clear();
+  }
+  ticketCondVar_.notify_all();
+  releaseThread_.join();
+
+  // The extra FlightClients would otherwise hold their connections open until the Server is
+  // destroyed. They stay in the vector, so a transfer still using one fails instead of touching
+  // a freed client.
+  {
+    std::unique_lock flight_guard(flightClientsMutex_);
+    for (const auto &client : extraFlightClients_) {
+      auto status = client->Close();
+      if (!status.ok()) {
+        LOG(ERROR) << me_ << ": FlightClient::Close() failed, error = " << status.ToString();
+      }
     }
   }
 
@@ -269,36 +334,102 @@ Ticket MakeNewTicket(int32_t ticket_id) {
 }  // namespace
 
 Ticket Server::NewTicket() {
-  std::unique_lock guard(shared_state_->mutex_);
-  auto ticket_id = shared_state_->nextFreeTicketId_++;
+  std::unique_lock guard(ticketMutex_);
+  auto ticket_id = nextFreeTicketId_++;
   auto ticket = MakeNewTicket(ticket_id);
-  shared_state_->outstanding_tickets_.insert(ticket);
+  outstandingTickets_.insert(ticket.ticket());
   return ticket;
 }
 
 void Server::Release(Ticket ticket) {
-  // TODO(kosak): In a future version we might queue up these released tickets and release
-  // them asynchronously, in order to give clients a little performance bump without
-  // adding too much unexpected asynchronicity to their programs.
-  std::unique_lock guard(shared_state_->mutex_);
-  if (shared_state_->cancelled_) {
+  std::unique_lock guard(ticketMutex_);
+  // If the queue is full, wait for the release thread to make room. If we are shut down while
+  // waiting, Shutdown() has already taken care of the ticket.
+  while (!ticketsClosed_ && releaseQueue_.size() >= kMaxQueuedReleases) {
+    ticketCondVar_.wait(guard);
+  }
+  if (ticketsClosed_) {
     return;
   }
-  if (shared_state_->outstanding_tickets_.erase(ticket) == 0) {
+  if (outstandingTickets_.erase(ticket.ticket()) == 0) {
     const char *message = "Server was asked to release a ticket that it is not managing.";
     throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
   }
-  guard.unlock();
-  ReleaseUnchecked(std::move(ticket));
+  releaseQueue_.push_back(std::move(ticket));
+  if (releaseQueue_.size() == 1) {
+    // The release thread may be waiting for work.
+    ticketCondVar_.notify_all();
+  }
 }
 
-void Server::ReleaseUnchecked(Ticket ticket) {
-  ReleaseRequest req;
-  ReleaseResponse resp;
-  *req.mutable_id() = std::move(ticket);
-  SendRpc([&](grpc::ClientContext *ctx) {
-    return sessionStub_->Release(ctx, req, &resp);
-  }, true);  // 'true' to disregard cancellation state.
+void Server::ReleaseTickets(const std::shared_ptr<Server> &self) {
+  while (true) {
+    std::vector<Ticket> batch;
+    {
+      std::unique_lock guard(self->ticketMutex_);
+      while (!self->ticketsClosed_ && self->releaseQueue_.empty()) {
+        self->ticketCondVar_.wait(guard);
+      }
+      if (self->releaseQueue_.empty()) {
+        // Closed and drained.
+        break;
+      }
+      auto &queue = self->releaseQueue_;
+      auto size = std::min(queue.size(), kMaxReleasesInFlight);
+      batch.assign(std::make_move_iterator(queue.begin()),
+          std::make_move_iterator(queue.begin() + static_cast<std::ptrdiff_t>(size)));
+      queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(size));
+    }
+    // Wake any callers of Release() that are waiting for room.
+    self->ticketCondVar_.notify_all();
+    self->ReleaseBatch(std::move(batch));
+  }
+
+  VLOG(2) << self->me_ << ": Release thread exiting.";
+}
+
+void Server::ReleaseBatch(std::vector<Ticket> tickets) {
+  struct State {
+    std::mutex mutex;
+    std::condition_variable condVar;
+    size_t remaining = 0;
+    std::vector<ReleaseRequest> requests;
+    std::vector<ReleaseResponse> responses;
+  };
+  auto state = std::make_shared<State>();
+  state->remaining = tickets.size();
+  state->requests.resize(tickets.size());
+  state->responses.resize(tickets.size());
+
+  auto on_done = [state](std::exception_ptr eptr) {
+    if (eptr != nullptr) {
+      auto what = GetWhat(eptr);
+      LOG(INFO) << "Server::ReleaseBatch() is ignoring thrown exception: " << what;
+    }
+    std::unique_lock guard(state->mutex);
+    if (--state->remaining == 0) {
+      state->condVar.notify_all();
+    }
+  };
+
+  for (size_t i = 0; i != tickets.size(); ++i) {
+    auto *req = &state->requests[i];
+    auto *resp = &state->responses[i];
+    *req->mutable_id() = std::move(tickets[i]);
+    try {
+      SendRpcAsync([this, req, resp](grpc::ClientContext *ctx,
+          std::function<void(grpc::Status)> completion) {
+        sessionStub_->async()->Release(ctx, req, resp, std::move(completion));
+      }, on_done, true);  // 'true' to disregard cancellation state.
+    } catch (...) {
+      on_done(std::current_exception());
+    }
+  }
+
+  std::unique_lock guard(state->mutex);
+  while (state->remaining != 0) {
+    state->condVar.wait(guard);
+  }
 }
 
 // 'disregard_cancellation_state' is usually false. We set it to true during Shutdown(), so that
@@ -311,8 +442,45 @@ void Server::SendRpc(const std::function<grpc::Status(grpc::ClientContext *)> &c
           << TimePointToStr(now) << ".";
 
   grpc::ClientContext ctx;
-  ForEachHeaderNameAndValue([&ctx](const std::string &name, const std::string &value) {
-    ctx.AddMetadata(name, value);
+  PrepareContext(&ctx, disregard_cancellation_state);
+  auto status = callback(&ctx);
+  ProcessResponse(shared_state_.get(), ctx, status, now);
+}
+
+void Server::SendRpcAsync(
+    const std::function<void(grpc::ClientContext *, std::function<void(grpc::Status)>)> &callback,
+    std::function<void(std::exception_ptr)> on_done) {
+  SendRpcAsync(callback, std::move(on_done), false);
+}
+
+void Server::SendRpcAsync(
+    const std::function<void(grpc::ClientContext *, std::function<void(grpc::Status)>)> &callback,
+    std::function<void(std::exception_ptr)> on_done, bool disregard_cancellation_state) {
+  using deephaven::dhcore::utility::TimePointToStr;
+  auto now = std::chrono::system_clock::now();
+  VLOG(2) << "Server(" << static_cast<void *>(this) << "): Sending async RPC at time "
+          << TimePointToStr(now) << ".";
+
+  // gRPC needs the context until the call completes.
+  auto ctx = std::make_shared<grpc::ClientContext>();
+  PrepareContext(ctx.get(), disregard_cancellation_state);
+  // The completion holds on to the shared state rather than to us.
+  auto completion = [ctx, shared_state = shared_state_, now,
+      on_done = std::move(on_done)](grpc::Status status) {
+    std::exception_ptr eptr;
+    try {
+      ProcessResponse(shared_state.get(), *ctx, status, now);
+    } catch (...) {
+      eptr = std::current_exception();
+    }
+    on_done(std::move(eptr));
+  };
+  callback(ctx.get(), std::move(completion));
+}
+
+void Server::PrepareContext(grpc::ClientContext *ctx, bool disregard_cancellation_state) {
+  ForEachHeaderNameAndValue([ctx](const std::string &name, const std::string &value) {
+    ctx->AddMetadata(name, value);
   });
 
   if (!disregard_cancellation_state) {
@@ -322,8 +490,10 @@ void Server::SendRpc(const std::function<grpc::Status(grpc::ClientContext *)> &c
       throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
     }
   }
+}
 
-  auto status = callback(&ctx);
+void Server::ProcessResponse(ServerSharedState *shared_state, const grpc::ClientContext &ctx,
+    const grpc::Status &status, std::chrono::system_clock::time_point send_time) {
   if (!status.ok()) {
     auto message = fmt::format("Error {}. Message: {}", static_cast<int>(status.error_code()),
         status.error_message());
@@ -334,12 +504,12 @@ void Server::SendRpc(const std::function<grpc::Status(grpc::ClientContext *)> &c
   const auto &metadata = ctx.GetServerInitialMetadata();
 
   auto ip = metadata.find(kAuthorizationHeader);
-  std::unique_lock lock(shared_state_->mutex_);
+  std::unique_lock lock(shared_state->mutex_);
   if (ip != metadata.end()) {
     const auto &val = ip->second;
-    shared_state_->sessionToken_.assign(val.begin(), val.end());
+    shared_state->sessionToken_.assign(val.begin(), val.end());
   }
-  shared_state_->nextHandshakeTime_ = now + shared_state_->expirationInterval_;
+  shared_state->nextHandshakeTime_ = send_time + shared_state->expirationInterval_;
 }
 
 void Server::SendKeepaliveMessages(const std::shared_ptr<Server> &self) {
@@ -9,7 +9,6 @@ ServerSharedState::ServerSharedState(ClientOptions::extra_headers_t extra_header
   std::chrono::milliseconds expiration_interval,
   std::chrono::system_clock::time_point next_handshake_time
 ) : extraHeaders_(std::move(extra_headers)),
-   nextFreeTicketId_(1),
    sessionToken_(std::move(session_token)),
    expirationInterval_(expiration_interval),
    nextHandshakeTime_(next_handshake_time) {
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/client/subscription/flight_data.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <arrow/buffer.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/proto_buffer_reader.h>
+#include <grpcpp/support/slice.h>
+#include "deephaven/client/utility/arrow_util.h"
+#include "deephaven/dhcore/ticking/barrage_processor.h"
+#include "deephaven/dhcore/utility/utility.h"
+
+using deephaven::client::utility::ValueOrThrow;
+using deephaven::dhcore::ticking::BarrageProcessor;
+using google::protobuf::internal::WireFormatLite;
+
+namespace deephaven::client::subscription {
+FlightData ParseFlightData(grpc::ByteBuffer *buffer) {
+  // Field numbers from Arrow's Flight.proto.
+  constexpr int kDataHeader = 2;
+  constexpr int kAppMetadata = 3;
+  constexpr int kDataBody = 1000;
+
+  grpc::ProtoBufferReader reader(buffer);
+  google::protobuf::io::CodedInputStream input(&reader);
+  input.SetTotalBytesLimit(std::numeric_limits<int>::max());
+  FlightData result;
+  while (auto tag = input.ReadTag()) {
+    auto field = WireFormatLite::GetTagFieldNumber(tag);
+    auto is_bytes = WireFormatLite::GetTagWireType(tag) == WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+    std::shared_ptr<arrow::Buffer> *dest = nullptr;
+    if (is_bytes && field == kDataHeader) {
+      dest = &result.dataHeader_;
+    } else if (is_bytes && field == kAppMetadata) {
+      dest = &result.appMetadata_;
+    } else if (is_bytes && field == kDataBody) {
+      dest = &result.dataBody_;
+    }
+    if (dest == nullptr) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        const char *message = "Malformed FlightData message";
+        throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+      }
+      continue;
+    }
+    uint32_t size;
+    if (!input.ReadVarint32(&size)) {
+      const char *message = "Malformed FlightData message";
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    std::shared_ptr<arrow::Buffer> bytes = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
+        arrow::AllocateBuffer(size)));
+    if (!input.ReadRaw(bytes->mutable_data(), static_cast<int>(size))) {
+      const char *message = "Truncated FlightData message";
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    *dest = std::move(bytes);
+  }
+  return result;
+}
+
+grpc::ByteBuffer MakeFlightData(bool with_descriptor, const std::vector<uint8_t> &app_metadata) {
+  // Field numbers from Arrow's Flight.proto.
+  constexpr int kFlightDescriptor = 1;
+  constexpr int kDescriptorType = 1;
+  constexpr int kDescriptorCmd = 2;
+  constexpr int kDescriptorTypeCmd = 2;
+  constexpr int kAppMetadata = 3;
+
+  std::string result;
+  {
+    google::protobuf::io::StringOutputStream stream(&result);
+    google::protobuf::io::CodedOutputStream output(&stream);
+    if (with_descriptor) {
+      char magic_data[4];
+      auto src = BarrageProcessor::kDeephavenMagicNumber;
+      static_assert(sizeof(src) == sizeof(magic_data));
+      memcpy(magic_data, &src, sizeof(magic_data));
+
+      std::string descriptor;
+      {
+        google::protobuf::io::StringOutputStream dstream(&descriptor);
+        google::protobuf::io::CodedOutputStream doutput(&dstream);
+        WireFormatLite::WriteEnum(kDescriptorType, kDescriptorTypeCmd, &doutput);
+        WireFormatLite::WriteBytes(kDescriptorCmd, std::string(magic_data, 4), &doutput);
+      }
+      WireFormatLite::WriteBytes(kFlightDescriptor, descriptor, &output);
+    }
+    WireFormatLite::WriteTag(kAppMetadata, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, &output);
+    output.WriteVarint32(static_cast<uint32_t>(app_metadata.size()));
+    if (!app_metadata.empty()) {
+      // An empty vector's data() may be nullptr, which WriteRaw doesn't accept.
+      output.WriteRaw(app_metadata.data(), static_cast<int>(app_metadata.size()));
+    }
+  }
+  grpc::Slice slice(result);
+  return grpc::ByteBuffer(&slice, 1);
+}
+}  // namespace deephaven::client::subscription
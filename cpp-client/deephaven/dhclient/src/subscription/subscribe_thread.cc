@@ -7,12 +7,14 @@
 #include <arrow/buffer.h>
 #include <arrow/scalar.h>
 #include <arrow/flight/client.h>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <future>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <thread>
 #include <utility>
@@ -22,6 +24,7 @@
 #include "deephaven/client/arrowutil/arrow_array_converter.h"
 #include "deephaven/client/server/server.h"
 #include "deephaven/client/client_options.h"
+#include "deephaven/client/subscription/bounded_queue.h"
 #include "deephaven/client/utility/arrow_util.h"
 #include "deephaven/client/utility/executor.h"
 #include "deephaven/dhcore/chunk/chunk.h"
@@ -32,9 +35,15 @@
 
 using deephaven::dhcore::column::ColumnSource;
 using deephaven::dhcore::chunk::AnyChunk;
+using deephaven::dhcore::clienttable::ClientTable;
 using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::container::RowSequence;
 using deephaven::dhcore::ticking::BarrageProcessor;
+using deephaven::dhcore::ticking::ConflationPolicy;
+using deephaven::dhcore::ticking::SubscriptionMetrics;
+using deephaven::dhcore::ticking::SubscriptionOptions;
 using deephaven::dhcore::ticking::TickingCallback;
+using deephaven::dhcore::ticking::TickingUpdate;
 using deephaven::dhcore::utility::MakeReservedVector;
 using deephaven::dhcore::utility::separatedList;
 using deephaven::dhcore::utility::VerboseCast;
@@ -55,6 +64,7 @@ using deephaven::client::utility::Executor;
 using deephaven::client::utility::OkOrThrow;
 using deephaven::client::server::Server;
 using io::deephaven::proto::backplane::grpc::Ticket;
+using arrow::flight::FlightStreamChunk;
 using arrow::flight::FlightStreamReader;
 using arrow::flight::FlightStreamWriter;
 
@@ -66,7 +76,9 @@ class SubscribeState final {
 
 public:
   SubscribeState(std::shared_ptr<Server> server, std::vector<int8_t> ticket_bytes,
-      std::shared_ptr<Schema> schema, std::promise<std::shared_ptr<SubscriptionHandle>> promise,
+      std::optional<std::vector<size_t>> column_indices, bool viewport, SubscriptionOptions options,
+      std::vector<uint8_t> subscription_request, std::shared_ptr<Schema> schema,
+      std::promise<std::shared_ptr<SubscriptionHandle>> promise,
       std::shared_ptr <TickingCallback> callback);
   void Invoke();
 
@@ -76,6 +88,10 @@ private:
 
   std::shared_ptr<Server> server_;
   std::vector<int8_t> ticketBytes_;
+  std::optional<std::vector<size_t>> columnIndices_;
+  bool viewport_ = false;
+  SubscriptionOptions options_;
+  std::vector<uint8_t> subscriptionRequest_;
   std::shared_ptr<Schema> schema_;
   std::promise<std::shared_ptr<SubscriptionHandle>> promise_;
   std::shared_ptr<TickingCallback> callback_;
@@ -83,27 +99,56 @@ private:
 
 // The UpdateProcessor class also implements the SubscriptionHandle interface so that our callers
 // can cancel us if they want to.
+//
+// Ordinarily a single thread reads each message, feeds it to the BarrageProcessor and invokes the
+// callback. When the subscription is pipelined (SubscriptionOptions::SetPipelineDepth), those
+// are three threads: the reader (thread_), the decoder and the dispatcher, connected by bounded
+// queues. Errors flow downstream along with the data, so the callback still sees every update
+// that was decoded before the failure, and all callbacks (OnFailure included) are made on the
+// dispatcher thread.
 class UpdateProcessor final : public SubscriptionHandle {
 public:
   [[nodiscard]]
-  static std::shared_ptr<UpdateProcessor> StartThread(std::unique_ptr<FlightStreamReader> fsr,
+  static std::shared_ptr<UpdateProcessor> StartThread(std::vector<int8_t> ticket_bytes,
+      std::optional<std::vector<size_t>> column_indices, bool viewport, SubscriptionOptions options,
+      std::unique_ptr<FlightStreamReader> fsr, std::unique_ptr<FlightStreamWriter> fsw,
+      std::shared_ptr<Schema> schema, std::shared_ptr<TickingCallback> callback);
+
+  UpdateProcessor(std::vector<int8_t> ticket_bytes,
+      std::optional<std::vector<size_t>> column_indices, bool viewport, SubscriptionOptions options,
+      std::unique_ptr<FlightStreamReader> fsr,
       std::unique_ptr<FlightStreamWriter> fsw, std::shared_ptr<Schema> schema,
       std::shared_ptr<TickingCallback> callback);
-
-  UpdateProcessor(std::unique_ptr<FlightStreamReader> fsr, std::unique_ptr<FlightStreamWriter> fsw,
-      std::shared_ptr<Schema> schema, std::shared_ptr<TickingCallback> callback);
   ~UpdateProcessor() final;
 
   void Cancel() final;
+  void SetViewport(const RowSequence *viewport, bool reverse_viewport) final;
+  [[nodiscard]]
+  SubscriptionMetrics Metrics() const final;
 
   static void RunUntilCancelled(std::shared_ptr<UpdateProcessor> self);
   void RunForeverHelper();
 
 private:
+  [[nodiscard]]
+  bool Pipelined() const { return messages_ != nullptr; }
+  [[nodiscard]]
+  bool Cancelled();
+  void RunReader();
+  void RunDecoder();
+  void RunDispatcher();
+  void StopReading();
+
+  // Needed to build the new BarrageSubscriptionRequest when the viewport changes.
+  std::vector<int8_t> ticketBytes_;
+  std::optional<std::vector<size_t>> columnIndices_;
+  // Whether this is a viewport subscription. The server doesn't let that change.
+  bool viewport_ = false;
+  SubscriptionOptions options_;
   std::unique_ptr<FlightStreamReader> fsr_;
   // The FlightStreamWriter is not used inside the thread, but arrow Flight >= 8.0.0 seems to
   // require that it stay alive (along with the FlightStreamReader) for the duration of the
-  // DoExchange session.
+  // DoExchange session. It is also used (under 'mutex_') to send viewport changes.
   std::unique_ptr<FlightStreamWriter> fsw_;
   std::shared_ptr<Schema> schema_;
   std::shared_ptr<TickingCallback> callback_;
@@ -111,6 +156,17 @@ private:
   std::mutex mutex_;
   bool cancelled_ = false;
   std::thread thread_;
+
+  // These are only set for pipelined subscriptions.
+  std::unique_ptr<BoundedQueue<FlightStreamChunk>> messages_;
+  std::unique_ptr<BoundedQueue<TickingUpdate>> updates_;
+  std::thread decoderThread_;
+  std::thread dispatcherThread_;
+
+  std::atomic<uint64_t> messagesRead_ = 0;
+  std::atomic<uint64_t> updatesDecoded_ = 0;
+  std::atomic<uint64_t> updatesDelivered_ = 0;
+  std::atomic<uint64_t> updatesConflated_ = 0;
 };
 
 class OwningBuffer final : public arrow::Buffer {
@@ -126,26 +182,92 @@ struct ColumnSourceAndSize {
   size_t size_ = 0;
 };
 
+/**
+ * Opens a Barrage DoExchange session with the server and sends it 'request' (a
+ * BarrageSubscriptionRequest or BarrageSnapshotRequest).
+ */
+arrow::flight::FlightClient::DoExchangeResult StartBarrageExchange(Server *server,
+    std::vector<uint8_t> request);
+std::shared_ptr<arrow::Array> UnwrapList(const arrow::Array &array);
 }  // namespace
 
 std::shared_ptr<SubscriptionHandle> SubscriptionThread::Start(std::shared_ptr<Server> server,
     Executor *flight_executor, std::shared_ptr<Schema> schema, const Ticket &ticket,
-    std::shared_ptr<TickingCallback> callback) {
+    std::shared_ptr<TickingCallback> callback, const std::vector<size_t> *column_indices,
+    const RowSequence *viewport, bool reverse_viewport, const SubscriptionOptions &options) {
   std::promise<std::shared_ptr<SubscriptionHandle>> promise;
   auto future = promise.get_future();
   std::vector<int8_t> ticket_bytes(ticket.ticket().begin(), ticket.ticket().end());
+  auto subscription_request = BarrageProcessor::CreateSubscriptionRequest(ticket_bytes.data(),
+      ticket_bytes.size(), column_indices, viewport, reverse_viewport, options);
+  std::optional<std::vector<size_t>> column_indices_copy;
+  if (column_indices != nullptr) {
+    column_indices_copy = *column_indices;
+  }
   auto ss = std::make_shared<SubscribeState>(std::move(server), std::move(ticket_bytes),
-      std::move(schema), std::move(promise), std::move(callback));
+      std::move(column_indices_copy), viewport != nullptr, options, std::move(subscription_request), std::move(schema),
+      std::move(promise), std::move(callback));
   flight_executor->Invoke([ss]() { ss->Invoke(); });
   return future.get();
 }
 
+std::shared_ptr<ClientTable> SubscriptionThread::Snapshot(std::shared_ptr<Server> server,
+    std::shared_ptr<Schema> schema, const Ticket &ticket,
+    const std::vector<size_t> *column_indices, const RowSequence *viewport,
+    bool reverse_viewport, const SubscriptionOptions &options) {
+  std::vector<int8_t> ticket_bytes(ticket.ticket().begin(), ticket.ticket().end());
+  auto request = BarrageProcessor::CreateSnapshotRequest(ticket_bytes.data(), ticket_bytes.size(),
+      column_indices, viewport, reverse_viewport, options);
+  auto res = StartBarrageExchange(server.get(), std::move(request));
+
+  auto bp = BarrageProcessor::ForSnapshot(std::move(schema));
+  while (true) {
+    auto chunk = res.reader->Next();
+    OkOrThrow(DEEPHAVEN_LOCATION_EXPR(chunk));
+    if (chunk->data == nullptr) {
+      const char *message = "Stream ended before the snapshot was complete";
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    auto result = SubscriptionThread::ProcessChunk(&bp, *chunk);
+    if (result.has_value()) {
+      // The snapshot is the only message we need from this exchange. A failure to close it means
+      // the exchange went wrong, so the snapshot can't be trusted either.
+      OkOrThrow(DEEPHAVEN_LOCATION_EXPR(res.writer->Close()));
+      return result->Current();
+    }
+  }
+}
+
+std::optional<TickingUpdate> SubscriptionThread::ProcessChunk(BarrageProcessor *bp,
+    const arrow::flight::FlightStreamChunk &chunk) {
+  const auto &cols = chunk.data->columns();
+  auto column_sources = MakeReservedVector<std::shared_ptr<ColumnSource>>(cols.size());
+  auto sizes = MakeReservedVector<size_t>(cols.size());
+  for (const auto &col : cols) {
+    auto array = UnwrapList(*col);
+    sizes.push_back(array->length());
+    auto cs = ArrowArrayConverter::ArrayToColumnSource(std::move(array));
+    column_sources.push_back(std::move(cs));
+  }
+
+  const void *metadata = nullptr;
+  size_t metadata_size = 0;
+  if (chunk.app_metadata != nullptr) {
+    metadata = chunk.app_metadata->data();
+    metadata_size = chunk.app_metadata->size();
+  }
+  return bp->ProcessNextChunk(column_sources, sizes, metadata, metadata_size);
+}
+
 namespace {
 SubscribeState::SubscribeState(std::shared_ptr<Server> server, std::vector<int8_t> ticket_bytes,
-    std::shared_ptr<Schema> schema,
+    std::optional<std::vector<size_t>> column_indices, bool viewport, SubscriptionOptions options,
+    std::vector<uint8_t> subscription_request, std::shared_ptr<Schema> schema,
     std::promise<std::shared_ptr<SubscriptionHandle>> promise,
     std::shared_ptr<TickingCallback> callback) :
-    server_(std::move(server)), ticketBytes_(std::move(ticket_bytes)), schema_(std::move(schema)),
+    server_(std::move(server)), ticketBytes_(std::move(ticket_bytes)),
+    columnIndices_(std::move(column_indices)), viewport_(viewport), options_(std::move(options)),
+    subscriptionRequest_(std::move(subscription_request)), schema_(std::move(schema)),
     promise_(std::move(promise)), callback_(std::move(callback)) {}
 
 void SubscribeState::Invoke() {
@@ -159,63 +281,48 @@ void SubscribeState::Invoke() {
 }
 
 std::shared_ptr<SubscriptionHandle> SubscribeState::InvokeHelper() {
-  arrow::flight::FlightCallOptions fco;
-  // Note: Authorization and envoy-prefix headers are automatically added by BearerMiddleware
-  // Only add OTHER extra headers here (if any)
-  server_->ForEachHeaderNameAndValue(
-      [&fco](const std::string &name, const std::string &value) {
-        // Skip authorization (handled by middleware)
-        if (name == deephaven::client::kAuthorizationHeader) {
-          return;
-        }
-        // Skip envoy-prefix (handled by middleware)
-        if (name == deephaven::client::kEnvoyPrefixHeader) {
-          return;
-        }
-        // Add any other extra headers
-        fco.headers.emplace_back(name, value);
-      }
-  );
-  auto *client = server_->FlightClient();
-
-  arrow::flight::FlightDescriptor descriptor;
-  char magic_data[4];
-  auto src = BarrageProcessor::kDeephavenMagicNumber;
-  static_assert(sizeof(src) == sizeof(magic_data));
-  memcpy(magic_data, &src, sizeof(magic_data));
-
-  descriptor.type = arrow::flight::FlightDescriptor::DescriptorType::CMD;
-  descriptor.cmd = std::string(magic_data, 4);
-  auto res = client->DoExchange(fco, descriptor);
-  OkOrThrow(DEEPHAVEN_LOCATION_EXPR(res));
-
-  auto sub_req_raw = BarrageProcessor::CreateSubscriptionRequest(ticketBytes_.data(),
-      ticketBytes_.size());
-  auto buffer = std::make_shared<OwningBuffer>(std::move(sub_req_raw));
-  OkOrThrow(DEEPHAVEN_LOCATION_EXPR(res->writer->WriteMetadata(std::move(buffer))));
+  auto res = StartBarrageExchange(server_.get(), std::move(subscriptionRequest_));
 
   // Run forever (until error or cancellation)
-  auto processor = UpdateProcessor::StartThread(std::move(res->reader), std::move(res->writer),
-      std::move(schema_), std::move(callback_));
+  auto processor = UpdateProcessor::StartThread(std::move(ticketBytes_), std::move(columnIndices_),
+      viewport_, std::move(options_), std::move(res.reader), std::move(res.writer), std::move(schema_), std::move(callback_));
   return processor;
 }
 
 std::shared_ptr<UpdateProcessor> UpdateProcessor::StartThread(
+    std::vector<int8_t> ticket_bytes,
+    std::optional<std::vector<size_t>> column_indices,
+    bool viewport,
+    SubscriptionOptions options,
     std::unique_ptr<FlightStreamReader> fsr,
     std::unique_ptr<FlightStreamWriter> fsw,
     std::shared_ptr<Schema> schema,
     std::shared_ptr<TickingCallback> callback) {
-  auto result = std::make_shared<UpdateProcessor>(std::move(fsr), std::move(fsw),
-      std::move(schema), std::move(callback));
+  auto result = std::make_shared<UpdateProcessor>(std::move(ticket_bytes),
+      std::move(column_indices), viewport, std::move(options), std::move(fsr), std::move(fsw), std::move(schema),
+      std::move(callback));
+  if (auto depth = result->options_.PipelineDepth(); depth > 0) {
+    result->messages_ = std::make_unique<BoundedQueue<FlightStreamChunk>>(depth);
+    result->updates_ = std::make_unique<BoundedQueue<TickingUpdate>>(depth);
+    // These two are joined by Cancel(), which the destructor calls, so they need not keep the
+    // object alive.
+    result->decoderThread_ = std::thread(&UpdateProcessor::RunDecoder, result.get());
+    result->dispatcherThread_ = std::thread(&UpdateProcessor::RunDispatcher, result.get());
+  }
   result->thread_ = std::thread(&RunUntilCancelled, result);
   return result;
 }
 
-UpdateProcessor::UpdateProcessor(std::unique_ptr<FlightStreamReader> fsr,
+UpdateProcessor::UpdateProcessor(std::vector<int8_t> ticket_bytes,
+    std::optional<std::vector<size_t>> column_indices,
+    bool viewport,
+    SubscriptionOptions options,
+    std::unique_ptr<FlightStreamReader> fsr,
     std::unique_ptr<FlightStreamWriter> fsw,
     std::shared_ptr<Schema> schema, std::shared_ptr<TickingCallback> callback) :
-    fsr_(std::move(fsr)), fsw_(std::move(fsw)), schema_(std::move(schema)),
-    callback_(std::move(callback)), cancelled_(false) {}
+    ticketBytes_(std::move(ticket_bytes)), columnIndices_(std::move(column_indices)),
+    viewport_(viewport), options_(std::move(options)), fsr_(std::move(fsr)), fsw_(std::move(fsw)),
+    schema_(std::move(schema)), callback_(std::move(callback)), cancelled_(false) {}
 
 UpdateProcessor::~UpdateProcessor() {
   Cancel();
@@ -235,15 +342,73 @@ void UpdateProcessor::Cancel() {
 
   fsr_->Cancel();
   (void)fsw_->Close();
+  if (Pipelined()) {
+    messages_->Abort();
+    updates_->Abort();
+  }
   thread_.join();
+  if (Pipelined()) {
+    decoderThread_.join();
+    dispatcherThread_.join();
+  }
+}
+
+bool UpdateProcessor::Cancelled() {
+  std::unique_lock guard(mutex_);
+  return cancelled_;
+}
+
+SubscriptionMetrics UpdateProcessor::Metrics() const {
+  SubscriptionMetrics result;
+  result.messages_read = messagesRead_;
+  result.updates_decoded = updatesDecoded_;
+  result.updates_delivered = updatesDelivered_;
+  result.updates_conflated = updatesConflated_;
+  if (Pipelined()) {
+    result.queue_capacity = messages_->Capacity();
+    result.message_queue_size = messages_->Size();
+    result.message_queue_high_water = messages_->HighWater();
+    result.update_queue_size = updates_->Size();
+    result.update_queue_high_water = updates_->HighWater();
+  }
+  return result;
+}
+
+void UpdateProcessor::SetViewport(const RowSequence *viewport, bool reverse_viewport) {
+  if ((viewport != nullptr) != viewport_) {
+    const char *message = "Can't switch a subscription between a viewport and the whole table; "
+        "that is fixed when the subscription is created";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  // The request replaces the whole subscription, so it needs to repeat the column set and options.
+  const auto *column_indices = columnIndices_.has_value() ? &*columnIndices_ : nullptr;
+  auto sub_req_raw = BarrageProcessor::CreateSubscriptionRequest(ticketBytes_.data(),
+      ticketBytes_.size(), column_indices, viewport, reverse_viewport, options_);
+  auto buffer = std::make_shared<OwningBuffer>(std::move(sub_req_raw));
+  std::unique_lock guard(mutex_);
+  if (cancelled_) {
+    const char *message = "Can't change the viewport of a cancelled subscription";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  OkOrThrow(DEEPHAVEN_LOCATION_EXPR(fsw_->WriteMetadata(std::move(buffer))));
 }
 
 void UpdateProcessor::RunUntilCancelled(std::shared_ptr<UpdateProcessor> self) {
   try {
-    self->RunForeverHelper();
+    if (self->Pipelined()) {
+      self->RunReader();
+    } else {
+      self->RunForeverHelper();
+    }
   } catch (...) {
+    if (self->Pipelined()) {
+      // Let the decoder and dispatcher finish what they have, then report the error. If they
+      // have been stopped, this does nothing.
+      self->messages_->Close(std::current_exception());
+      return;
+    }
     // If the thread has been cancelled via explicit user action, then swallow all errors.
-    if (!self->cancelled_) {
+    if (!self->Cancelled()) {
       self->callback_->OnFailure(std::current_exception());
     }
   }
@@ -276,7 +441,7 @@ std::shared_ptr<arrow::Array> UnwrapList(const arrow::Array &array) {
 
 void UpdateProcessor::RunForeverHelper() {
   // Reuse the chunk for efficiency.
-  BarrageProcessor bp(schema_);
+  BarrageProcessor bp(schema_, options_);
   // Process Arrow Flight messages until error or cancellation.
   while (true) {
     auto chunk = fsr_->Next();
@@ -286,30 +451,148 @@ void UpdateProcessor::RunForeverHelper() {
       const char *message = "Unexpected end of stream";
       throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
     }
-    const auto &cols = chunk->data->columns();
-    auto column_sources = MakeReservedVector<std::shared_ptr<ColumnSource>>(cols.size());
-    auto sizes = MakeReservedVector<size_t>(cols.size());
-    for (const auto &col : cols) {
-      auto array = UnwrapList(*col);
-      sizes.push_back(array->length());
-      auto cs = ArrowArrayConverter::ArrayToColumnSource(std::move(array));
-      column_sources.push_back(std::move(cs));
+    ++messagesRead_;
+    auto result = SubscriptionThread::ProcessChunk(&bp, *chunk);
+
+    if (result.has_value()) {
+      ++updatesDecoded_;
+      callback_->OnTick(std::move(*result));
+      ++updatesDelivered_;
     }
+  }
+}
 
-    const void *metadata = nullptr;
-    size_t metadata_size = 0;
-    if (chunk->app_metadata != nullptr) {
-      metadata = chunk->app_metadata->data();
-      metadata_size = chunk->app_metadata->size();
+void UpdateProcessor::RunReader() {
+  while (true) {
+    auto chunk = fsr_->Next();
+    OkOrThrow(DEEPHAVEN_LOCATION_EXPR(chunk));
+    if (chunk->data == nullptr) {
+      // Stream ended. This is abnormal for Deephaven.
+      const char *message = "Unexpected end of stream";
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
     }
-    auto result = bp.ProcessNextChunk(column_sources, sizes, metadata, metadata_size);
+    ++messagesRead_;
+    if (!messages_->Push(std::move(*chunk))) {
+      // Stopped.
+      return;
+    }
+  }
+}
 
-    if (result.has_value()) {
-      callback_->OnTick(std::move(*result));
+void UpdateProcessor::RunDecoder() {
+  // Deltas-only updates have no snapshots to conflate.
+  TickingUpdate (*fold)(const TickingUpdate &, const TickingUpdate &) = nullptr;
+  if (!options_.DeltasOnly()) {
+    switch (options_.GetConflationPolicy()) {
+      case ConflationPolicy::kReplace: {
+        fold = &TickingUpdate::Replace;
+        break;
+      }
+      case ConflationPolicy::kMerge: {
+        fold = &TickingUpdate::Merge;
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+  }
+  try {
+    BarrageProcessor bp(schema_, options_);
+    while (auto chunk = messages_->Pop()) {
+      auto result = SubscriptionThread::ProcessChunk(&bp, *chunk);
+      if (!result.has_value()) {
+        continue;
+      }
+      ++updatesDecoded_;
+      bool pushed;
+      if (fold != nullptr) {
+        size_t num_folded;
+        pushed = updates_->PushOrFold(std::move(*result), fold, &num_folded);
+        updatesConflated_ += num_folded;
+      } else {
+        pushed = updates_->Push(std::move(*result));
+      }
+      if (!pushed) {
+        // Stopped.
+        return;
+      }
+    }
+    // The reader has stopped; pass on its reason.
+    updates_->Close(messages_->Error());
+  } catch (...) {
+    // We can't go on, so there is no point in reading any more.
+    messages_->Abort();
+    fsr_->Cancel();
+    updates_->Close(std::current_exception());
+  }
+}
+
+void UpdateProcessor::RunDispatcher() {
+  std::exception_ptr eptr;
+  try {
+    while (auto update = updates_->Pop()) {
+      callback_->OnTick(std::move(*update));
+      ++updatesDelivered_;
     }
+    eptr = updates_->Error();
+  } catch (...) {
+    eptr = std::current_exception();
+  }
+  if (eptr == nullptr) {
+    // Stopped by Cancel().
+    return;
+  }
+  StopReading();
+  // If the subscription has been cancelled via explicit user action, then swallow all errors.
+  if (!Cancelled()) {
+    callback_->OnFailure(eptr);
   }
 }
 
+void UpdateProcessor::StopReading() {
+  messages_->Abort();
+  updates_->Abort();
+  fsr_->Cancel();
+}
+
+arrow::flight::FlightClient::DoExchangeResult StartBarrageExchange(Server *server,
+    std::vector<uint8_t> request) {
+  arrow::flight::FlightCallOptions fco;
+  // Note: Authorization and envoy-prefix headers are automatically added by BearerMiddleware
+  // Only add OTHER extra headers here (if any)
+  server->ForEachHeaderNameAndValue(
+      [&fco](const std::string &name, const std::string &value) {
+        // Skip authorization (handled by middleware)
+        if (name == deephaven::client::kAuthorizationHeader) {
+          return;
+        }
+        // Skip envoy-prefix (handled by middleware)
+        if (name == deephaven::client::kEnvoyPrefixHeader) {
+          return;
+        }
+        // Add any other extra headers
+        fco.headers.emplace_back(name, value);
+      }
+  );
+  auto *client = server->FlightClient();
+
+  arrow::flight::FlightDescriptor descriptor;
+  char magic_data[4];
+  auto src = BarrageProcessor::kDeephavenMagicNumber;
+  static_assert(sizeof(src) == sizeof(magic_data));
+  memcpy(magic_data, &src, sizeof(magic_data));
+
+  descriptor.type = arrow::flight::FlightDescriptor::DescriptorType::CMD;
+  descriptor.cmd = std::string(magic_data, 4);
+  auto res = client->DoExchange(fco, descriptor);
+  OkOrThrow(DEEPHAVEN_LOCATION_EXPR(res));
+
+  auto buffer = std::make_shared<OwningBuffer>(std::move(request));
+  OkOrThrow(DEEPHAVEN_LOCATION_EXPR(res->writer->WriteMetadata(std::move(buffer))));
+  return std::move(*res);
+}
+
 OwningBuffer::OwningBuffer(std::vector<uint8_t> data) :
     arrow::Buffer(data.data(), static_cast<int64_t>(data.size())), data_(std::move(data)) {}
 OwningBuffer::~OwningBuffer() = default;
@@ -0,0 +1,626 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/client/subscription/subscription_scheduler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <absl/log/log.h>
+#include <arrow/buffer.h>
+#include <arrow/flight/types.h>
+#include <arrow/ipc/dictionary.h>
+#include <arrow/ipc/message.h>
+#include <arrow/ipc/reader.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/support/byte_buffer.h>
+#include "deephaven/client/subscription/flight_data.h"
+#include "deephaven/client/subscription/subscribe_thread.h"
+#include "deephaven/client/utility/arrow_util.h"
+#include "deephaven/dhcore/ticking/barrage_processor.h"
+#include "deephaven/dhcore/utility/utility.h"
+
+using deephaven::client::utility::ValueOrThrow;
+using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::ticking::BarrageProcessor;
+using deephaven::dhcore::ticking::SubscriptionMetrics;
+using deephaven::dhcore::ticking::SubscriptionOptions;
+using deephaven::dhcore::ticking::TickingCallback;
+using deephaven::dhcore::ticking::TickingUpdate;
+using deephaven::dhcore::utility::ObjectId;
+
+namespace deephaven::client::subscription {
+namespace {
+constexpr const char *kDoExchangeMethod = "/arrow.flight.protocol.FlightService/DoExchange";
+}  // namespace
+
+namespace internal {
+/**
+ * One Barrage subscription, driven by the SubscriptionScheduler. The completion queue thread
+ * calls OnEvent() as each gRPC operation completes; the workers call RunOnce() to process
+ * the messages that have arrived. The decoding state (bp_, arrowSchema_, dictionaryMemo_) is
+ * only touched by RunOnce(), and since the subscription is in the scheduler's line at most once,
+ * only one worker at a time.
+ */
+class MultiplexedSubscription final : public SubscriptionHandle,
+    public std::enable_shared_from_this<MultiplexedSubscription> {
+  using Server = deephaven::client::server::Server;
+
+public:
+  enum class Op { kStart, kRead, kWrite, kFinish };
+  /**
+   * What we give gRPC as the tag of each operation, and get back from the completion queue.
+   */
+  struct Tag {
+    MultiplexedSubscription *owner_ = nullptr;
+    Op op_ = Op::kStart;
+  };
+
+  MultiplexedSubscription(std::shared_ptr<SubscriptionScheduler> scheduler,
+      std::vector<int8_t> ticket_bytes, std::optional<std::vector<size_t>> column_indices,
+      bool viewport, SubscriptionOptions options, std::shared_ptr<Schema> schema,
+      std::shared_ptr<TickingCallback> callback);
+  ~MultiplexedSubscription() final;
+
+  /**
+   * Starts the DoExchange call and queues 'request' to be sent once the server accepts it. Does
+   * not wait. Anything that can throw happens before the call is started, so if this throws,
+   * gRPC has never heard of us.
+   */
+  void Begin(Server *server, std::vector<uint8_t> request);
+  /**
+   * Waits for the server to accept the call started by Begin(). Throws if it does not.
+   */
+  void AwaitStart();
+  /**
+   * Called on the completion queue thread when an operation completes.
+   */
+  void OnEvent(Op op, bool ok);
+  /**
+   * Called on a worker thread. Processes one message, or reports the failure of the stream.
+   * Returns true if the subscription has more work and should go to the back of the line.
+   */
+  [[nodiscard]]
+  bool RunOnce();
+
+  void Cancel() final;
+  void SetViewport(const RowSequence *viewport, bool reverse_viewport) final;
+  [[nodiscard]]
+  SubscriptionMetrics Metrics() const final;
+
+private:
+  [[nodiscard]]
+  std::optional<TickingUpdate> Decode(grpc::ByteBuffer *message);
+  [[nodiscard]]
+  bool HasWorkLocked() const;
+  [[nodiscard]]
+  bool DoneLocked() const { return finished_ && outstanding_ == 0; }
+  void StartReadLocked();
+  void StartWriteLocked();
+  void StartFinishLocked();
+  void ScheduleLocked();
+  void FailLocked(std::exception_ptr eptr);
+
+  std::shared_ptr<SubscriptionScheduler> scheduler_;
+  // Needed to build the new BarrageSubscriptionRequest when the viewport changes.
+  std::vector<int8_t> ticketBytes_;
+  std::optional<std::vector<size_t>> columnIndices_;
+  // Whether this is a viewport subscription. The server doesn't let that change.
+  bool viewport_ = false;
+  SubscriptionOptions options_;
+  std::shared_ptr<TickingCallback> callback_;
+  // The most messages we hold for a worker before we stop reading.
+  size_t readAhead_ = 0;
+
+  Tag startTag_;
+  Tag readTag_;
+  Tag writeTag_;
+  Tag finishTag_;
+  grpc::ClientContext context_;
+  std::unique_ptr<grpc::GenericClientAsyncReaderWriter> call_;
+
+  BarrageProcessor bp_;
+  std::shared_ptr<arrow::Schema> arrowSchema_;
+  arrow::ipc::DictionaryMemo dictionaryMemo_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condvar_;
+  std::promise<void> startPromise_;
+  bool started_ = false;
+  bool cancelled_ = false;
+  // The number of operations gRPC has yet to hand back to us.
+  size_t outstanding_ = 0;
+  bool readInFlight_ = false;
+  grpc::ByteBuffer readBuffer_;
+  bool writeInFlight_ = false;
+  grpc::ByteBuffer writeBuffer_;
+  std::deque<grpc::ByteBuffer> writes_;
+  bool finishing_ = false;
+  bool finished_ = false;
+  grpc::Status finishStatus_;
+  // Messages read but not yet processed.
+  std::deque<grpc::ByteBuffer> pending_;
+  size_t pendingHighWater_ = 0;
+  // True while the subscription is in the scheduler's line or being processed by a worker.
+  bool scheduled_ = false;
+  bool running_ = false;
+  std::thread::id runningThread_;
+  std::exception_ptr error_;
+  bool failureDelivered_ = false;
+
+  uint64_t messagesRead_ = 0;
+  uint64_t updatesDecoded_ = 0;
+  uint64_t updatesDelivered_ = 0;
+};
+}  // namespace internal
+
+using internal::MultiplexedSubscription;
+
+std::shared_ptr<SubscriptionScheduler> SubscriptionScheduler::Create(
+    std::shared_ptr<Server> server, size_t num_threads) {
+  if (num_threads == 0) {
+    const char *message = "SubscriptionScheduler needs at least one worker thread";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  auto result = std::make_shared<SubscriptionScheduler>(Private(), std::move(server));
+  result->pollerThread_ = std::thread(&RunPoller, result);
+  result->workerThreads_.reserve(num_threads);
+  for (size_t i = 0; i != num_threads; ++i) {
+    result->workerThreads_.emplace_back(&RunWorker, result);
+  }
+  return result;
+}
+
+SubscriptionScheduler::SubscriptionScheduler(Private, std::shared_ptr<Server> server) :
+    me_(ObjectId("SubscriptionScheduler", this)),
+    server_(std::move(server)) {}
+
+SubscriptionScheduler::~SubscriptionScheduler() = default;
+
+std::shared_ptr<SubscriptionHandle> SubscriptionScheduler::Start(std::shared_ptr<Schema> schema,
+    const Ticket &ticket, std::shared_ptr<TickingCallback> callback,
+    const std::vector<size_t> *column_indices, const RowSequence *viewport, bool reverse_viewport,
+    const SubscriptionOptions &options) {
+  std::vector<int8_t> ticket_bytes(ticket.ticket().begin(), ticket.ticket().end());
+  auto request = BarrageProcessor::CreateSubscriptionRequest(ticket_bytes.data(),
+      ticket_bytes.size(), column_indices, viewport, reverse_viewport, options);
+  std::optional<std::vector<size_t>> column_indices_copy;
+  if (column_indices != nullptr) {
+    column_indices_copy = *column_indices;
+  }
+  auto subscription = std::make_shared<MultiplexedSubscription>(shared_from_this(),
+      std::move(ticket_bytes), std::move(column_indices_copy), viewport != nullptr, options,
+      std::move(schema), std::move(callback));
+  {
+    std::unique_lock guard(mutex_);
+    if (shutdown_) {
+      auto message = fmt::format("{}: can't subscribe after Shutdown()", me_);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    live_.insert(subscription);
+    ++starting_;
+  }
+  std::exception_ptr eptr;
+  try {
+    subscription->Begin(server_.get(), std::move(request));
+  } catch (...) {
+    eptr = std::current_exception();
+  }
+  {
+    std::unique_lock guard(mutex_);
+    --starting_;
+    if (eptr != nullptr) {
+      // No call was started, so nothing else will forget it.
+      live_.erase(subscription);
+    }
+  }
+  condvar_.notify_all();
+  if (eptr != nullptr) {
+    std::rethrow_exception(eptr);
+  }
+  // If this throws, the subscription forgets itself once its call has finished.
+  subscription->AwaitStart();
+  return subscription;
+}
+
+void SubscriptionScheduler::Shutdown() {
+  std::unique_lock guard(mutex_);
+  if (shutdown_) {
+    guard.unlock();
+    LOG(INFO) << me_ << ": Already shut down.";
+    return;
+  }
+  shutdown_ = true;
+  ready_.clear();
+  condvar_.notify_all();
+  // A Start() that got in before us may not have started its call yet. Wait for it, so that
+  // every subscription we cancel has a call, and no call is started after the completion queue
+  // is shut down.
+  condvar_.wait(guard, [this]() { return starting_ == 0; });
+  auto live = live_;
+  guard.unlock();
+
+  // The completion queue thread has to keep running until every call has finished.
+  for (const auto &subscription : live) {
+    subscription->Cancel();
+  }
+  completionQueue_.Shutdown();
+  pollerThread_.join();
+  for (auto &thread : workerThreads_) {
+    thread.join();
+  }
+}
+
+void SubscriptionScheduler::RunPoller(std::shared_ptr<SubscriptionScheduler> self) {
+  void *raw_tag;
+  bool ok;
+  while (self->completionQueue_.Next(&raw_tag, &ok)) {
+    const auto *tag = static_cast<const MultiplexedSubscription::Tag *>(raw_tag);
+    tag->owner_->OnEvent(tag->op_, ok);
+  }
+}
+
+void SubscriptionScheduler::RunWorker(std::shared_ptr<SubscriptionScheduler> self) {
+  while (true) {
+    std::shared_ptr<MultiplexedSubscription> subscription;
+    {
+      std::unique_lock guard(self->mutex_);
+      self->condvar_.wait(guard, [&self]() { return self->shutdown_ || !self->ready_.empty(); });
+      if (self->shutdown_) {
+        return;
+      }
+      subscription = std::move(self->ready_.front());
+      self->ready_.pop_front();
+    }
+    if (subscription->RunOnce()) {
+      self->Enqueue(std::move(subscription));
+    }
+  }
+}
+
+void SubscriptionScheduler::Enqueue(std::shared_ptr<MultiplexedSubscription> subscription) {
+  std::unique_lock guard(mutex_);
+  if (shutdown_) {
+    return;
+  }
+  ready_.push_back(std::move(subscription));
+  guard.unlock();
+  condvar_.notify_one();
+}
+
+void SubscriptionScheduler::Forget(const std::shared_ptr<MultiplexedSubscription> &subscription) {
+  std::unique_lock guard(mutex_);
+  live_.erase(subscription);
+}
+
+namespace internal {
+MultiplexedSubscription::MultiplexedSubscription(std::shared_ptr<SubscriptionScheduler> scheduler,
+    std::vector<int8_t> ticket_bytes, std::optional<std::vector<size_t>> column_indices,
+    bool viewport, SubscriptionOptions options, std::shared_ptr<Schema> schema,
+    std::shared_ptr<TickingCallback> callback) :
+    scheduler_(std::move(scheduler)), ticketBytes_(std::move(ticket_bytes)),
+    columnIndices_(std::move(column_indices)), viewport_(viewport), options_(std::move(options)),
+    callback_(std::move(callback)),
+    readAhead_(std::max<size_t>(1, options_.PipelineDepth())),
+    startTag_{this, Op::kStart}, readTag_{this, Op::kRead}, writeTag_{this, Op::kWrite},
+    finishTag_{this, Op::kFinish}, bp_(std::move(schema), options_) {}
+
+MultiplexedSubscription::~MultiplexedSubscription() = default;
+
+void MultiplexedSubscription::Begin(Server *server, std::vector<uint8_t> request) {
+  server->ForEachHeaderNameAndValue([this](const std::string &name, const std::string &value) {
+    context_.AddMetadata(name, value);
+  });
+  auto first_message = MakeFlightData(true, request);
+  std::unique_lock guard(mutex_);
+  call_ = server->GenericStub()->PrepareCall(&context_, kDoExchangeMethod,
+      &scheduler_->completionQueue_);
+  writes_.push_back(std::move(first_message));
+  ++outstanding_;
+  call_->StartCall(&startTag_);
+}
+
+void MultiplexedSubscription::AwaitStart() {
+  startPromise_.get_future().get();
+}
+
+void MultiplexedSubscription::OnEvent(Op op, bool ok) {
+  std::unique_lock guard(mutex_);
+  // Keep ourselves alive until we return. Once the lock is released, AwaitStart() and Cancel()
+  // can return, and their callers drop their references. Taking this under the lock is safe:
+  // with this operation still outstanding we are not done, so the scheduler still holds us.
+  auto self = shared_from_this();
+  --outstanding_;
+  switch (op) {
+    case Op::kStart: {
+      if (!ok || finishing_) {
+        // Finish() will tell us why. If we were cancelled while starting, it may already have.
+        StartFinishLocked();
+        break;
+      }
+      started_ = true;
+      startPromise_.set_value();
+      StartWriteLocked();
+      StartReadLocked();
+      break;
+    }
+    case Op::kRead: {
+      readInFlight_ = false;
+      if (!ok || cancelled_ || error_ != nullptr) {
+        StartFinishLocked();
+        break;
+      }
+      ++messagesRead_;
+      pending_.push_back(std::move(readBuffer_));
+      pendingHighWater_ = std::max(pendingHighWater_, pending_.size());
+      if (pending_.size() < readAhead_) {
+        StartReadLocked();
+      }
+      ScheduleLocked();
+      break;
+    }
+    case Op::kWrite: {
+      writeInFlight_ = false;
+      if (ok) {
+        StartWriteLocked();
+      }
+      break;
+    }
+    case Op::kFinish: {
+      finished_ = true;
+      if (!started_) {
+        auto message = fmt::format("DoExchange failed: {}", finishStatus_.error_message());
+        startPromise_.set_exception(std::make_exception_ptr(
+            std::runtime_error(DEEPHAVEN_LOCATION_STR(message))));
+        break;
+      }
+      if (cancelled_ || error_ != nullptr) {
+        break;
+      }
+      // The stream ended. This is abnormal for Deephaven.
+      std::string message = finishStatus_.ok() ? "Unexpected end of stream" :
+          fmt::format("Stream failed: {}", finishStatus_.error_message());
+      error_ = std::make_exception_ptr(std::runtime_error(DEEPHAVEN_LOCATION_STR(message)));
+      ScheduleLocked();
+      break;
+    }
+  }
+  auto done = DoneLocked();
+  guard.unlock();
+  condvar_.notify_all();
+  if (done) {
+    // The completion queue no longer refers to us. This is the only place we are forgotten.
+    scheduler_->Forget(self);
+  }
+}
+
+bool MultiplexedSubscription::RunOnce() {
+  std::unique_lock guard(mutex_);
+  if (cancelled_) {
+    scheduled_ = false;
+    return false;
+  }
+  std::optional<grpc::ByteBuffer> message;
+  std::exception_ptr failure;
+  if (!pending_.empty()) {
+    message = std::move(pending_.front());
+    pending_.pop_front();
+    // If we had stopped reading because the worker had fallen behind, start again.
+    if (started_ && !readInFlight_ && !finishing_) {
+      StartReadLocked();
+    }
+  } else if (error_ != nullptr && !failureDelivered_) {
+    failureDelivered_ = true;
+    failure = error_;
+  }
+  running_ = true;
+  runningThread_ = std::this_thread::get_id();
+  guard.unlock();
+
+  if (message.has_value()) {
+    try {
+      auto update = Decode(&*message);
+      if (update.has_value()) {
+        guard.lock();
+        ++updatesDecoded_;
+        auto cancelled = cancelled_;
+        guard.unlock();
+        if (!cancelled) {
+          callback_->OnTick(std::move(*update));
+          guard.lock();
+          ++updatesDelivered_;
+          guard.unlock();
+        }
+      }
+    } catch (...) {
+      guard.lock();
+      FailLocked(std::current_exception());
+      guard.unlock();
+    }
+  } else if (failure != nullptr) {
+    guard.lock();
+    // If the subscription has been cancelled via explicit user action, then swallow all errors.
+    auto cancelled = cancelled_;
+    guard.unlock();
+    if (!cancelled) {
+      try {
+        callback_->OnFailure(failure);
+      } catch (const std::exception &e) {
+        LOG(ERROR) << "MultiplexedSubscription: OnFailure threw: " << e.what();
+      }
+    }
+  }
+
+  guard.lock();
+  running_ = false;
+  scheduled_ = HasWorkLocked();
+  auto result = scheduled_;
+  guard.unlock();
+  condvar_.notify_all();
+  return result;
+}
+
+void MultiplexedSubscription::Cancel() {
+  constexpr const char *const kMe = "MultiplexedSubscription::Cancel";
+  LOG(INFO) << kMe << ": Subscription Shutdown requested.";
+  std::unique_lock guard(mutex_);
+  if (cancelled_) {
+    // Still wait below: SubscriptionScheduler::Shutdown relies on every Cancel() returning only
+    // once gRPC is done with us, even if someone else cancelled us first.
+    LOG(ERROR) << kMe << ": Already cancelled.";
+  } else {
+    cancelled_ = true;
+    pending_.clear();
+    context_.TryCancel();
+    if (!readInFlight_) {
+      // Otherwise the failed read will do it.
+      StartFinishLocked();
+    }
+  }
+  // Wait for gRPC to let go of us, and for any callback in progress to return. If we are being
+  // cancelled from within our own callback, that callback is the one in progress.
+  auto on_own_thread = [this]() {
+    return running_ && runningThread_ == std::this_thread::get_id();
+  };
+  // OnEvent() forgets us when the last operation completes.
+  condvar_.wait(guard, [&]() { return DoneLocked() && (!running_ || on_own_thread()); });
+}
+
+void MultiplexedSubscription::SetViewport(const RowSequence *viewport, bool reverse_viewport) {
+  if ((viewport != nullptr) != viewport_) {
+    const char *message = "Can't switch a subscription between a viewport and the whole table; "
+        "that is fixed when the subscription is created";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  // The request replaces the whole subscription, so it needs to repeat the column set and options.
+  const auto *column_indices = columnIndices_.has_value() ? &*columnIndices_ : nullptr;
+  auto sub_req_raw = BarrageProcessor::CreateSubscriptionRequest(ticketBytes_.data(),
+      ticketBytes_.size(), column_indices, viewport, reverse_viewport, options_);
+  auto message = MakeFlightData(false, sub_req_raw);
+  std::unique_lock guard(mutex_);
+  if (cancelled_ || finishing_) {
+    const char *text = "Can't change the viewport of a cancelled subscription";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(text));
+  }
+  writes_.push_back(std::move(message));
+  StartWriteLocked();
+}
+
+SubscriptionMetrics MultiplexedSubscription::Metrics() const {
+  std::unique_lock guard(mutex_);
+  SubscriptionMetrics result;
+  result.messages_read = messagesRead_;
+  result.updates_decoded = updatesDecoded_;
+  result.updates_delivered = updatesDelivered_;
+  result.queue_capacity = readAhead_;
+  result.message_queue_size = pending_.size();
+  result.message_queue_high_water = pendingHighWater_;
+  return result;
+}
+
+std::optional<TickingUpdate> MultiplexedSubscription::Decode(grpc::ByteBuffer *message) {
+  auto data = ParseFlightData(message);
+  if (data.dataHeader_ == nullptr) {
+    const char *text = "Unexpected message without data";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(text));
+  }
+  auto ipc_message = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
+      arrow::ipc::Message::Open(data.dataHeader_, data.dataBody_)));
+  switch (ipc_message->type()) {
+    case arrow::ipc::MessageType::SCHEMA: {
+      arrowSchema_ = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
+          arrow::ipc::ReadSchema(*ipc_message, &dictionaryMemo_)));
+      return {};
+    }
+    case arrow::ipc::MessageType::RECORD_BATCH: {
+      if (arrowSchema_ == nullptr) {
+        const char *text = "Record batch arrived before the schema";
+        throw std::runtime_error(DEEPHAVEN_LOCATION_STR(text));
+      }
+      arrow::flight::FlightStreamChunk chunk;
+      chunk.data = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(arrow::ipc::ReadRecordBatch(*ipc_message,
+          arrowSchema_, &dictionaryMemo_, arrow::ipc::IpcReadOptions::Defaults())));
+      chunk.app_metadata = std::move(data.appMetadata_);
+      return SubscriptionThread::ProcessChunk(&bp_, chunk);
+    }
+    default: {
+      auto text = fmt::format("Unexpected IPC message type {}",
+          arrow::ipc::FormatMessageType(ipc_message->type()));
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(text));
+    }
+  }
+}
+
+bool MultiplexedSubscription::HasWorkLocked() const {
+  if (cancelled_) {
+    return false;
+  }
+  // Messages that arrived before a failure are delivered before it.
+  return !pending_.empty() || (error_ != nullptr && !failureDelivered_);
+}
+
+void MultiplexedSubscription::StartReadLocked() {
+  if (readInFlight_ || finishing_) {
+    return;
+  }
+  readInFlight_ = true;
+  ++outstanding_;
+  call_->Read(&readBuffer_, &readTag_);
+}
+
+void MultiplexedSubscription::StartWriteLocked() {
+  if (!started_ || writeInFlight_ || finishing_ || writes_.empty()) {
+    return;
+  }
+  writeBuffer_ = std::move(writes_.front());
+  writes_.pop_front();
+  writeInFlight_ = true;
+  ++outstanding_;
+  call_->Write(writeBuffer_, &writeTag_);
+}
+
+void MultiplexedSubscription::StartFinishLocked() {
+  if (finishing_) {
+    return;
+  }
+  finishing_ = true;
+  ++outstanding_;
+  call_->Finish(&finishStatus_, &finishTag_);
+}
+
+void MultiplexedSubscription::ScheduleLocked() {
+  if (scheduled_ || !HasWorkLocked()) {
+    return;
+  }
+  scheduled_ = true;
+  // Lock order is subscription, then scheduler.
+  scheduler_->Enqueue(shared_from_this());
+}
+
+void MultiplexedSubscription::FailLocked(std::exception_ptr eptr) {
+  if (error_ == nullptr) {
+    error_ = std::move(eptr);
+  }
+  // We can't go on, so there is no point in reading any more.
+  pending_.clear();
+  context_.TryCancel();
+  if (!readInFlight_) {
+    StartFinishLocked();
+  }
+}
+}  // namespace internal
+
+}  // namespace deephaven::client::subscription
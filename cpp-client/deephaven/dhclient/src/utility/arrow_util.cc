@@ -12,8 +12,12 @@
 #include <optional>
 #include <utility>
 
+#include <arrow/buffer.h>
 #include <arrow/status.h>
 #include <arrow/flight/types.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/dictionary.h>
+#include <arrow/ipc/reader.h>
 #include <arrow/table.h>
 #include <arrow/type.h>
 #include <arrow/visitor.h>
@@ -221,6 +225,12 @@ std::shared_ptr<Schema> ArrowUtil::MakeDeephavenSchema(const arrow::Schema &sche
   return Schema::Create(std::move(names), std::move(types));
 }
 
+arrow::Result<std::shared_ptr<arrow::Schema>> ArrowUtil::ReadSchemaMessage(std::string message) {
+  arrow::io::BufferReader reader(arrow::Buffer::FromString(std::move(message)));
+  arrow::ipc::DictionaryMemo dictionary_memo;
+  return arrow::ipc::ReadSchema(&reader, &dictionary_memo);
+}
+
 std::shared_ptr<arrow::Table> ArrowUtil::MakeArrowTable(const ClientTable &client_table) {
   auto ncols = client_table.NumColumns();
   auto nrows = client_table.NumRows();
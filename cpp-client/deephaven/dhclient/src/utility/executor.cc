@@ -3,22 +3,46 @@
  */
 #include "deephaven/client/utility/executor.h"
 
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <stdexcept>
 #include <thread>
 #include <absl/log/log.h>
 #include "deephaven/dhcore/utility/utility.h"
+#include "deephaven/third_party/fmt/format.h"
 
 using deephaven::dhcore::utility::GetWhat;
 
 namespace deephaven::client::utility {
-std::shared_ptr<Executor> Executor::Create(std::string id) {
-  auto result = std::make_shared<Executor>(Private(), std::move(id));
-  result->executorThread_ = std::thread(&ThreadStart, result);
-  VLOG(2) << result->id_ << ": Created.";
+namespace {
+template<typename T>
+void UpdateMax(std::atomic<T> *target, T value) {
+  auto current = target->load();
+  while (value > current && !target->compare_exchange_weak(current, value)) {
+  }
+}
+}  // namespace
+
+std::shared_ptr<Executor> Executor::Create(std::string id, size_t num_threads) {
+  if (num_threads == 0) {
+    auto message = fmt::format("Executor '{}' needs at least one thread", id);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  auto result = std::make_shared<Executor>(Private(), std::move(id), num_threads);
+  for (size_t i = 0; i != num_threads; ++i) {
+    result->threads_.emplace_back(&ThreadStart, result, i);
+  }
+  VLOG(2) << result->id_ << ": Created with " << num_threads << " threads.";
   return result;
 }
 
-Executor::Executor(Private, std::string id) : id_(std::move(id)), cancelled_(false) {}
+Executor::Executor(Private, std::string id, size_t num_threads) : id_(std::move(id)) {
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i != num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+}
 
 Executor::~Executor() {
   VLOG(2) << id_ << ": Destroyed.";
@@ -35,57 +59,144 @@ void Executor::Shutdown() {
   cancelled_ = true;
   guard.unlock();
   condvar_.notify_all();
-  executorThread_.join();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+
+  // The tasks still queued will never run. Destroying them releases whatever they captured, so
+  // that (for example) a promise they would have kept is broken rather than left pending. Invoke()
+  // checks cancelled_ under the same lock it pushes under, so no task can arrive after this.
+  size_t discarded = 0;
+  for (auto &worker : workers_) {
+    std::array<std::deque<Task>, 2> queues;
+    {
+      std::unique_lock worker_guard(worker->mutex_);
+      queues.swap(worker->queues_);
+    }
+    auto count = queues[0].size() + queues[1].size();
+    queued_ -= count;
+    discarded += count;
+    // 'queues' is destroyed here, outside the lock, in case a task's destructor calls Invoke().
+  }
+  if (discarded != 0) {
+    LOG(WARNING) << id_ << ": Discarded " << discarded << " tasks that were queued at Shutdown.";
+  }
 }
 
-void Executor::Invoke(std::function<void()> f) {
-  std::unique_lock guard(mutex_);
-  auto needs_notify = todo_.empty();
-  if (cancelled_) {
-    auto message = fmt::format("Executor '{}' is cancelled: ignoring Invoke()\n", id_);
-    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+void Executor::Invoke(std::function<void()> f, Priority priority) {
+  auto &worker = *workers_[nextWorker_++ % workers_.size()];
+  {
+    std::unique_lock guard(worker.mutex_);
+    // Checked under the worker's lock, so that Shutdown() either sees our task when it empties the
+    // queues or has already set cancelled_ by the time we look.
+    if (cancelled_) {
+      guard.unlock();
+      auto message = fmt::format("Executor '{}' is cancelled: ignoring Invoke()\n", id_);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    worker.queues_[static_cast<size_t>(priority)].push_back({std::move(f), clock_t::now()});
+    UpdateMax(&queueHighWater_, ++queued_);
   }
-  todo_.push_back(std::move(f));
-  guard.unlock();
 
-  if (needs_notify) {
-    condvar_.notify_all();
+  // A worker announces itself in sleepers_ before it checks queued_ for the last time, so either
+  // it sees our task or we see it.
+  if (sleepers_ != 0) {
+    // Taking the mutex ensures that a worker between its check and its wait() gets the signal.
+    std::unique_lock guard(mutex_);
+    guard.unlock();
+    condvar_.notify_one();
   }
 }
 
-void Executor::ThreadStart(std::shared_ptr<Executor> self) {
-  VLOG(2) << self->id_ << ": thread starting.";
-  self->RunUntilCancelled();
-  VLOG(2) << self->id_ << ": thread exiting.";
+ExecutorMetrics Executor::Metrics() const {
+  ExecutorMetrics result;
+  result.name = id_;
+  result.num_threads = workers_.size();
+  result.queue_size = queued_;
+  result.queue_high_water = queueHighWater_;
+  result.tasks_run = tasksRun_;
+  result.tasks_stolen = tasksStolen_;
+  result.total_queue_time = std::chrono::nanoseconds(totalWaitNanos_);
+  result.max_queue_time = std::chrono::nanoseconds(maxWaitNanos_);
+  result.total_run_time = std::chrono::nanoseconds(totalRunNanos_);
+  result.max_run_time = std::chrono::nanoseconds(maxRunNanos_);
+  return result;
+}
+
+void Executor::ThreadStart(std::shared_ptr<Executor> self, size_t index) {
+  VLOG(2) << self->id_ << ": thread " << index << " starting.";
+  self->RunUntilCancelled(index);
+  VLOG(2) << self->id_ << ": thread " << index << " exiting.";
 }
 
-void Executor::RunUntilCancelled() {
-  std::unique_lock<std::mutex> lock(mutex_);
+void Executor::RunUntilCancelled(size_t index) {
   while (true) {
-    while (true) {
-      if (cancelled_) {
-        return;
-      }
-      if (!todo_.empty()) {
-        break;
-      }
+    if (cancelled_) {
+      return;
+    }
+    Task task;
+    if (TryTake(index, &task)) {
+      RunTask(&task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++sleepers_;
+    while (!cancelled_ && queued_ == 0) {
       condvar_.wait(lock);
     }
-    std::vector<std::function<void()>> local_callbacks(std::move(todo_));
-    todo_.clear();
-    lock.unlock();
-
-    // invoke callbacks while not under lock
-    for (const auto &cb: local_callbacks) {
-      try {
-        cb();
-      } catch (...) {
-        auto what = GetWhat(std::current_exception());
-        LOG(ERROR) << id_ << ": Executor ignored exception: " << what << ".";
+    --sleepers_;
+  }
+}
+
+bool Executor::TryTake(size_t index, Task *task) {
+  auto num_workers = workers_.size();
+  for (size_t priority = 0; priority != 2; ++priority) {
+    // Our own queue first, oldest task first. Then the other workers' queues, newest task first,
+    // which leaves their owners the tasks that have waited longest.
+    for (size_t i = 0; i != num_workers; ++i) {
+      auto &worker = *workers_[(index + i) % num_workers];
+      auto own = i == 0;
+      std::unique_lock guard(worker.mutex_);
+      auto &queue = worker.queues_[priority];
+      if (queue.empty()) {
+        continue;
       }
+      if (own) {
+        *task = std::move(queue.front());
+        queue.pop_front();
+      } else {
+        *task = std::move(queue.back());
+        queue.pop_back();
+        ++tasksStolen_;
+      }
+      --queued_;
+      return true;
     }
+  }
+  return false;
+}
 
-    lock.lock();
+void Executor::RunTask(Task *task) {
+  auto start = clock_t::now();
+  try {
+    task->fun_();
+  } catch (...) {
+    auto what = GetWhat(std::current_exception());
+    LOG(ERROR) << id_ << ": Executor ignored exception: " << what << ".";
   }
+  auto end = clock_t::now();
+
+  auto wait_nanos = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(start - task->enqueueTime_).count());
+  auto run_nanos = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  ++tasksRun_;
+  totalWaitNanos_ += wait_nanos;
+  UpdateMax(&maxWaitNanos_, wait_nanos);
+  totalRunNanos_ += run_nanos;
+  UpdateMax(&maxRunNanos_, run_nanos);
+  // Destroy the callback here, so that whatever it captured is released on this thread.
+  task->fun_ = nullptr;
 }
 }  // namespace deephaven::client::utility
@@ -4,13 +4,17 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
 #include <utility>
+#include <immer/algorithm.hpp>
 #include <immer/flex_vector.hpp>
 #include <immer/flex_vector_transient.hpp>
 #include "deephaven/dhcore/chunk/chunk.h"
 #include "deephaven/dhcore/chunk/chunk_traits.h"
 #include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/container/row_sequence.h"
 #include "deephaven/dhcore/immerutil/immer_column_source.h"
 #include "deephaven/dhcore/utility/utility.h"
 
@@ -36,11 +40,125 @@ public:
     *dest_data = transient_data.persistent();
   }
 
+  /**
+   * Fast path for numeric types, where nulls are represented in-band and so no separate null
+   * vector is needed. If the source can expose its data contiguously, append straight from that
+   * memory, bypassing the intermediate Chunk. Whatever the source cannot expose that way falls
+   * back to Append().
+   */
+  template<typename T>
+  static void AppendNumeric(const ColumnSource &src, size_t begin, size_t end,
+      immer::flex_vector<T> *dest_data) {
+    using deephaven::dhcore::column::GenericColumnSource;
+    const auto *typed_src = dynamic_cast<const GenericColumnSource<T> *>(&src);
+    if (typed_src != nullptr && begin != end) {
+      auto transient_data = dest_data->transient();
+      while (begin != end) {
+        size_t available = 0;
+        const auto *srcp = typed_src->ContiguousData(begin, end, &available);
+        if (srcp == nullptr || available == 0) {
+          break;
+        }
+        for (const auto *endp = srcp + available; srcp != endp; ++srcp) {
+          transient_data.push_back(*srcp);
+        }
+        begin += available;
+      }
+      *dest_data = transient_data.persistent();
+    }
+    if (begin != end) {
+      Append(src, begin, end, dest_data, nullptr);
+    }
+  }
 
 private:
   static AnyChunk AppendHelper(const ColumnSource &src, size_t begin, size_t end,
       immer::flex_vector<bool> *optional_dest_nulls);
 };
+
+/**
+ * Single-pass alternatives to the take/drop/concat splicing that ImmerTableState does per
+ * interval. Each of these walks all the intervals of 'rows' at once and copies the affected
+ * vectors into a fresh transient, so the cost is O(n) regardless of how fragmented 'rows' is.
+ */
+class FlexVectorSplicer {
+  using RowSequence = deephaven::dhcore::container::RowSequence;
+
+public:
+  /**
+   * Returns 'src' with the elements of 'added' inserted at the positions in 'rows'. The positions
+   * are expressed in post-insertion coordinates, as produced by SpaceMapper::AddKeys.
+   */
+  template<typename T>
+  static immer::flex_vector<T> Insert(const immer::flex_vector<T> &src,
+      const immer::flex_vector<T> &added, const RowSequence &rows) {
+    auto result = immer::flex_vector<T>().transient();
+    size_t src_pos = 0;
+    size_t added_pos = 0;
+    rows.ForEachIntervalInline([&](uint64_t begin_index, uint64_t end_index) {
+      auto size = end_index - begin_index;
+      // Everything before 'begin_index' that did not come from 'added' comes from 'src'.
+      auto src_end = begin_index - added_pos;
+      CopyRange(src, src_pos, src_end, &result);
+      CopyRange(added, added_pos, added_pos + size, &result);
+      src_pos = src_end;
+      added_pos += size;
+    });
+    CopyRange(src, src_pos, src.size(), &result);
+    return result.persistent();
+  }
+
+  /**
+   * Returns 'src' with the elements at the positions in 'rows' removed.
+   */
+  template<typename T>
+  static immer::flex_vector<T> Erase(const immer::flex_vector<T> &src, const RowSequence &rows) {
+    auto result = immer::flex_vector<T>().transient();
+    size_t src_pos = 0;
+    rows.ForEachIntervalInline([&](uint64_t begin_index, uint64_t end_index) {
+      CopyRange(src, src_pos, begin_index, &result);
+      src_pos = end_index;
+    });
+    CopyRange(src, src_pos, src.size(), &result);
+    return result.persistent();
+  }
+
+  /**
+   * Returns 'src' with the elements at the positions in 'rows' overwritten, in order, by the
+   * elements of 'replacement'.
+   */
+  template<typename T>
+  static immer::flex_vector<T> Replace(const immer::flex_vector<T> &src,
+      const immer::flex_vector<T> &replacement, const RowSequence &rows) {
+    auto result = immer::flex_vector<T>().transient();
+    size_t src_pos = 0;
+    size_t replacement_pos = 0;
+    rows.ForEachIntervalInline([&](uint64_t begin_index, uint64_t end_index) {
+      auto size = end_index - begin_index;
+      CopyRange(src, src_pos, begin_index, &result);
+      CopyRange(replacement, replacement_pos, replacement_pos + size, &result);
+      src_pos = end_index;
+      replacement_pos += size;
+    });
+    CopyRange(src, src_pos, src.size(), &result);
+    return result.persistent();
+  }
+
+private:
+  template<typename T>
+  static void CopyRange(const immer::flex_vector<T> &src, size_t begin, size_t end,
+      typename immer::flex_vector<T>::transient_type *dest) {
+    if (begin > end || end > src.size()) {
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR("RowSequence is out of range"));
+    }
+    immer::for_each_chunk(src.begin() + begin, src.begin() + end,
+        [dest](const T *chunk_begin, const T *chunk_end) {
+          for (const auto *p = chunk_begin; p != chunk_end; ++p) {
+            dest->push_back(*p);
+          }
+        });
+  }
+};
 }  // namespace internal
 
 /**
@@ -51,6 +169,7 @@ class AbstractFlexVectorBase {
 protected:
   using Chunk = deephaven::dhcore::chunk::Chunk;
   using ColumnSource = deephaven::dhcore::column::ColumnSource;
+  using RowSequence = deephaven::dhcore::container::RowSequence;
 public:
   explicit AbstractFlexVectorBase(const ElementType &element_type) : element_type_(element_type) {}
   virtual ~AbstractFlexVectorBase() = default;
@@ -60,6 +179,22 @@ public:
   virtual void InPlaceAppend(std::unique_ptr<AbstractFlexVectorBase> other) = 0;
   virtual void InPlaceAppendSource(const ColumnSource &source, size_t begin, size_t end) = 0;
 
+  /**
+   * Inserts the elements of 'added' at the positions in 'rows' (in post-insertion coordinates)
+   * with a single pass over this vector. 'added' must be of the same concrete type.
+   */
+  virtual void InPlaceInsertAll(const AbstractFlexVectorBase &added, const RowSequence &rows) = 0;
+  /**
+   * Removes the elements at the positions in 'rows' with a single pass over this vector.
+   */
+  virtual void InPlaceEraseAll(const RowSequence &rows) = 0;
+  /**
+   * Overwrites the elements at the positions in 'rows' with the elements of 'replacement', with a
+   * single pass over this vector. 'replacement' must be of the same concrete type.
+   */
+  virtual void InPlaceReplaceAll(const AbstractFlexVectorBase &replacement,
+      const RowSequence &rows) = 0;
+
   [[nodiscard]] virtual std::shared_ptr<ColumnSource> MakeColumnSource() const = 0;
 
 protected:
@@ -94,7 +229,23 @@ public:
   }
 
   void InPlaceAppendSource(const ColumnSource &source, size_t begin, size_t end) final {
-    internal::FlexVectorAppender::Append(source, begin, end, &vec_, nullptr);
+    internal::FlexVectorAppender::AppendNumeric(source, begin, end, &vec_);
+  }
+
+  void InPlaceInsertAll(const AbstractFlexVectorBase &added, const RowSequence &rows) final {
+    const auto *added_vec = deephaven::dhcore::utility::VerboseCast<const NumericAbstractFlexVector *>(
+        DEEPHAVEN_LOCATION_EXPR(&added));
+    vec_ = internal::FlexVectorSplicer::Insert(vec_, added_vec->vec_, rows);
+  }
+
+  void InPlaceEraseAll(const RowSequence &rows) final {
+    vec_ = internal::FlexVectorSplicer::Erase(vec_, rows);
+  }
+
+  void InPlaceReplaceAll(const AbstractFlexVectorBase &replacement, const RowSequence &rows) final {
+    const auto *replacement_vec = deephaven::dhcore::utility::VerboseCast<const NumericAbstractFlexVector *>(
+        DEEPHAVEN_LOCATION_EXPR(&replacement));
+    vec_ = internal::FlexVectorSplicer::Replace(vec_, replacement_vec->vec_, rows);
   }
 
   [[nodiscard]]
@@ -144,6 +295,25 @@ public:
     internal::FlexVectorAppender::Append(source, begin, end, &data_, &nulls_);
   }
 
+  void InPlaceInsertAll(const AbstractFlexVectorBase &added, const RowSequence &rows) final {
+    const auto *added_vec = deephaven::dhcore::utility::VerboseCast<const GenericAbstractFlexVector *>(
+        DEEPHAVEN_LOCATION_EXPR(&added));
+    data_ = internal::FlexVectorSplicer::Insert(data_, added_vec->data_, rows);
+    nulls_ = internal::FlexVectorSplicer::Insert(nulls_, added_vec->nulls_, rows);
+  }
+
+  void InPlaceEraseAll(const RowSequence &rows) final {
+    data_ = internal::FlexVectorSplicer::Erase(data_, rows);
+    nulls_ = internal::FlexVectorSplicer::Erase(nulls_, rows);
+  }
+
+  void InPlaceReplaceAll(const AbstractFlexVectorBase &replacement, const RowSequence &rows) final {
+    const auto *replacement_vec = deephaven::dhcore::utility::VerboseCast<const GenericAbstractFlexVector *>(
+        DEEPHAVEN_LOCATION_EXPR(&replacement));
+    data_ = internal::FlexVectorSplicer::Replace(data_, replacement_vec->data_, rows);
+    nulls_ = internal::FlexVectorSplicer::Replace(nulls_, replacement_vec->nulls_, rows);
+  }
+
   [[nodiscard]]
   std::shared_ptr<ColumnSource> MakeColumnSource() const final {
     return GenericImmerColumnSource<T>::Create(element_type_, data_, nulls_);
@@ -57,7 +57,7 @@ struct ImmerColumnSourceImpls {
 
     auto *dest_datap = typed_dest->data();
     // We have a nested loop here, represented by two lambdas. This code invokes
-    // RowSequence::ForEachInterval which takes contiguous ranges from 'rows' and feeds them
+    // RowSequence::ForEachIntervalInline which takes contiguous ranges from 'rows' and feeds them
     // to 'copy_data_outer'. Then 'copy_data_outer' turns that contiguous range into a
     // pair of [begin, end) Immer iterators. But then, rather than store into that iterator range
     // directly, those Immer iterators are passed to immer::for_each_chunk. This breaks down the
@@ -75,7 +75,7 @@ struct ImmerColumnSourceImpls {
       immer::for_each_chunk(src_beginp, src_endp, copy_data_inner);
     };
 
-    rows.ForEachInterval(copy_data_outer);
+    rows.ForEachIntervalInline(copy_data_outer);
 
     // If the caller has opted out of getting null flags, we are done.
     if (optional_dest_null_flags == nullptr) {
@@ -103,7 +103,7 @@ struct ImmerColumnSourceImpls {
         auto src_endp = src_data.begin() + src_end;
         immer::for_each_chunk(src_beginp, src_endp, copy_nulls_inner);
       };
-      rows.ForEachInterval(copy_nulls_outer);
+      rows.ForEachIntervalInline(copy_nulls_outer);
     } else {
       auto copy_nulls_inner = [&dest_nullp](const bool *null_begin, const bool *null_end) {
         for (const bool *current = null_begin; current != null_end; ++current) {
@@ -117,7 +117,7 @@ struct ImmerColumnSourceImpls {
         auto nulls_end = src_null_flags->begin() + src_end;
         immer::for_each_chunk(nulls_begin, nulls_end, copy_nulls_inner);
       };
-      rows.ForEachInterval(copy_nulls_outer);
+      rows.ForEachIntervalInline(copy_nulls_outer);
     }
   }
 
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace deephaven::dhcore::ticking {
+namespace internal {
+struct ColumnJob;
+}  // namespace internal
+
+/**
+ * A small fixed-size thread pool for running independent per-column work (splicing and appending
+ * flex vectors) in parallel. ForEach is a fork/join: it returns only once every index has been
+ * processed, so callers see the same state they would have seen had the work run serially.
+ */
+class ColumnWorkerPool final {
+  struct Private {
+  };
+
+public:
+  /**
+   * Creates a pool that runs ForEach on 'parallelism' threads in total. The calling thread counts
+   * as one of them, so 'parallelism' - 1 worker threads are started. A parallelism of 1 (or 0)
+   * starts no threads, and ForEach simply runs serially on the caller.
+   */
+  [[nodiscard]]
+  static std::shared_ptr<ColumnWorkerPool> Create(size_t parallelism);
+
+  ColumnWorkerPool(Private, size_t num_workers);
+  ColumnWorkerPool(const ColumnWorkerPool &other) = delete;
+  ColumnWorkerPool &operator=(const ColumnWorkerPool &other) = delete;
+  ~ColumnWorkerPool();
+
+  /**
+   * Invokes fn(i) for each i in [0, count), spread across the pool and the calling thread, and
+   * waits for them all to finish. If any invocation throws, the exception from the lowest such
+   * index is rethrown once all the work is done.
+   */
+  void ForEach(size_t count, const std::function<void(size_t)> &fn);
+
+private:
+  void RunWorker();
+
+  // Serializes concurrent callers of ForEach.
+  std::mutex forEachMutex_;
+
+  // Protects everything below.
+  std::mutex mutex_;
+  std::condition_variable workAvailable_;
+  std::condition_variable workDone_;
+  bool cancelled_ = false;
+  uint64_t generation_ = 0;
+  internal::ColumnJob *job_ = nullptr;
+  size_t busy_ = 0;
+  std::vector<std::thread> threads_;
+};
+}  // namespace deephaven::dhcore::ticking
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "deephaven/dhcore/clienttable/client_table.h"
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/ticking/segmented_column.h"
+
+namespace deephaven::dhcore::ticking {
+/**
+ * The counterpart of ImmerTableState for deltas-only subscriptions. It holds no table: it only
+ * collects the added and modified data of the current update, as views over the ColumnSources it
+ * is given, and hands them over (and forgets them) once the update is complete. Nothing is
+ * copied, so the ColumnSources must own their data, as the Arrow-backed ones in dhclient do.
+ */
+class DeltaTableState final {
+  using ClientTable = deephaven::dhcore::clienttable::ClientTable;
+  using ColumnSource = deephaven::dhcore::column::ColumnSource;
+  using Schema = deephaven::dhcore::clienttable::Schema;
+
+public:
+  explicit DeltaTableState(std::shared_ptr<Schema> schema);
+  ~DeltaTableState();
+
+  /**
+   * Sets which columns are subscribed. Initially all columns are subscribed. Unsubscribed
+   * columns receive no data and appear as all-null columns in TakeAdded().
+   * @param subscribed For each column in the schema, whether it is subscribed
+   */
+  void SetSubscribedColumns(const std::vector<bool> &subscribed);
+
+  /**
+   * Whether column 'col_num' is subscribed.
+   */
+  [[nodiscard]]
+  bool IsSubscribed(size_t col_num) const {
+    return subscribed_[col_num];
+  }
+
+  /**
+   * For each subscribed column i, appends the rows [begins[i], ends[i]) of sources[i] to the rows
+   * added in this update. The number of rows must be the same for every subscribed column.
+   */
+  void AddData(const std::vector<std::shared_ptr<ColumnSource>> &sources,
+      const std::vector<size_t> &begins, const std::vector<size_t> &ends);
+
+  /**
+   * Appends the rows [begin, end) of 'source' to the new values of column 'col_num' in this
+   * update. Calls for different columns touch disjoint state, so they may be made concurrently.
+   */
+  void ModifyData(size_t col_num, const std::shared_ptr<ColumnSource> &source, size_t begin,
+      size_t end);
+
+  /**
+   * Returns a table of the rows added in this update, in the order they were added, and forgets
+   * them.
+   */
+  [[nodiscard]]
+  std::shared_ptr<ClientTable> TakeAdded();
+
+  /**
+   * Returns, for each column, the new values of its rows that were modified in this update, in the
+   * order they were given to ModifyData, and forgets them. If 'any_modified' is false, returns an
+   * empty vector.
+   */
+  [[nodiscard]]
+  std::vector<std::shared_ptr<ColumnSource>> TakeModified(bool any_modified);
+
+private:
+  /**
+   * The data handed to us for one column so far in this update. The segments are collected in a
+   * plain vector, which keeps its capacity from one update to the next. If there is a single
+   * segment starting at row 0 of its source, Take returns that source itself; otherwise it
+   * builds the persistent segment list and segmented column source that stitch them together.
+   */
+  struct Pending {
+    void Append(const std::shared_ptr<ColumnSource> &source, size_t begin, size_t end);
+    [[nodiscard]]
+    std::shared_ptr<ColumnSource> Take(const ElementType &element_type);
+
+    std::vector<ColumnSegment> segments_;
+    size_t size_ = 0;
+  };
+
+  std::shared_ptr<Schema> schema_;
+  std::vector<bool> subscribed_;
+  // One per column in the schema.
+  std::vector<Pending> added_;
+  size_t numAdded_ = 0;
+  // One per column in the schema.
+  std::vector<Pending> modified_;
+};
+}  // namespace deephaven::dhcore::ticking
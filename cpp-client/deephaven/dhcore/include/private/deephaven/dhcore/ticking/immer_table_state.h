@@ -2,13 +2,18 @@
  * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
  */
 #pragma once
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <vector>
 #include "deephaven/dhcore/column/column_source.h"
 #include "deephaven/dhcore/container/row_sequence.h"
 #include "deephaven/dhcore/immerutil/abstract_flex_vector.h"
 #include "deephaven/dhcore/clienttable/client_table.h"
+#include "deephaven/dhcore/ticking/column_worker_pool.h"
+#include "deephaven/dhcore/ticking/segmented_column.h"
 #include "deephaven/dhcore/ticking/space_mapper.h"
+#include "deephaven/dhcore/ticking/ticking.h"
 
 namespace deephaven::dhcore::ticking {
 class ImmerTableState final {
@@ -21,9 +26,72 @@ class ImmerTableState final {
   using Schema = deephaven::dhcore::clienttable::Schema;
 
 public:
+  /**
+   * How AddData, Erase, and ModifyData apply a RowSequence to the flex vectors.
+   * kPerInterval does a take/drop/concat splice for every interval, which costs
+   * O(intervals * log n) per column. kRebuild rebuilds each column in a single O(n) pass over all
+   * the intervals. kAuto picks between them based on the number of intervals relative to the
+   * table size. The constants kAuto uses have not been measured yet, so it is off by default, and
+   * tables splice per interval unless SetSpliceMode() says otherwise.
+   */
+  enum class SpliceMode { kAuto, kPerInterval, kRebuild };
+
   explicit ImmerTableState(std::shared_ptr<Schema> schema);
   ~ImmerTableState();
 
+  /**
+   * Sets the splice strategy. The default is kPerInterval. Intended for benchmarking and testing.
+   */
+  void SetSpliceMode(SpliceMode splice_mode) {
+    spliceMode_ = splice_mode;
+  }
+
+  /**
+   * Sets whether snapshots reuse the ColumnSources of the columns that have not changed since the
+   * previous snapshot (the default), or make new ones for every column. Intended for benchmarking.
+   */
+  void SetReuseUnchangedColumns(bool reuse_unchanged_columns) {
+    reuseUnchangedColumns_ = reuse_unchanged_columns;
+  }
+
+  /**
+   * Sets the pool used to process the columns of AddData and Erase in parallel. If null (the
+   * default), columns are processed serially on the calling thread.
+   */
+  void SetColumnWorkerPool(std::shared_ptr<ColumnWorkerPool> pool) {
+    columnWorkerPool_ = std::move(pool);
+  }
+
+  /**
+   * Enables or disables zero-copy appends. While enabled, and for as long as rows only arrive at
+   * the end of the table (and only leave from the front), AddData keeps a reference to the
+   * ColumnSources it is given instead of copying them, and Snapshot() returns views over them.
+   * Snapshots then cost O(1) per column regardless of the number of rows. The first operation
+   * that does not fit that pattern (an insertion before the end, an erasure anywhere but the
+   * front, or a modification) copies the affected columns into flex vectors, after which they
+   * behave as if zero-copy appends had never been enabled.
+   *
+   * Only enable this if the ColumnSources passed to AddData own their data (or otherwise keep it
+   * alive for as long as they do). It can only be enabled while the table is empty.
+   */
+  void SetZeroCopyAppends(bool zero_copy_appends);
+
+  /**
+   * Sets which columns are subscribed. Initially all columns are subscribed. Unsubscribed
+   * columns hold no data (the server does not send any for them) and appear as all-null columns
+   * in Snapshot(). A column that becomes subscribed starts out null for the existing rows.
+   * @param subscribed For each column in the schema, whether it is subscribed
+   */
+  void SetSubscribedColumns(const std::vector<bool> &subscribed);
+
+  /**
+   * Whether column 'col_num' is subscribed.
+   */
+  [[nodiscard]]
+  bool IsSubscribed(size_t col_num) const {
+    return flexVectors_[col_num] != nullptr;
+  }
+
   /**
    * When the caller wants to add data to the ImmerTableState, they do it in two steps:
    * AddKeys and then AddData. First, they call AddKeys, which updates the (key space) ->
@@ -58,6 +126,26 @@ public:
   [[nodiscard]]
   std::shared_ptr<RowSequence> Erase(const RowSequence &rows_to_erase_key_space);
 
+  /**
+   * AddPositions and ErasePositions are the counterparts of AddKeys and Erase for a table whose
+   * rows have no keys of their own, such as the table of a viewport subscription, where the
+   * server identifies rows by their positions in the viewport. The keys of such a table are just
+   * its positions [0, size), and these calls keep them that way. Don't mix them with AddKeys,
+   * Erase, or ApplyShifts on the same table.
+   *
+   * AddPositions makes room for new rows at 'rows_to_add_index_space', which are positions in the
+   * table as it will be once the rows are added. As with AddKeys, the caller then fills in the
+   * data with AddData.
+   * @param rows_to_add_index_space Positions of the new rows, represented in index space
+   */
+  void AddPositions(const RowSequence &rows_to_add_index_space);
+
+  /**
+   * Erases the rows at the positions in 'rows_to_erase_index_space'. See AddPositions.
+   * @param rows_to_erase_index_space Positions of the rows to erase, represented in index space
+   */
+  void ErasePositions(const RowSequence &rows_to_erase_index_space);
+
   /**
    * Converts a RowSequence of keys represented in key space to a RowSequence of keys represented in index space.
    * It is an error to try to use a key that is not already in the map.
@@ -67,11 +155,11 @@ public:
   [[nodiscard]]
   std::shared_ptr<RowSequence> ConvertKeysToIndices(const RowSequence &keys_row_space) const;
 
-
   /**
    * Modifies column 'col_num' with the contiguous data sourced in 'src'
    * at the half-open interval [begin, end), to be stored in the destination
-   * at the positions indicated by 'rows_to_modify_index_space'.
+   * at the positions indicated by 'rows_to_modify_index_space'. Calls for different columns touch
+   * disjoint state, so they may be made concurrently.
    * @param col_num Index of the column to be modified
    * @param src A ColumnSource containing the source data
    * @param begin The start of the source range
@@ -103,10 +191,87 @@ public:
   [[nodiscard]]
   std::shared_ptr<ClientTable> Snapshot() const;
 
+  /**
+   * Captures the current table state, leaving the ClientTable to be built later (see
+   * TickingUpdate). Only the columns that have changed since the last capture get new
+   * ColumnSources, and if none have, this just shares the previous capture's columns.
+   */
+  [[nodiscard]]
+  internal::LazyTable LazySnapshot() const;
+
 private:
+  /**
+   * Erases the rows at 'rows_index_space' from the columns of a table that had 'num_rows' rows.
+   * The caller has already updated the key mapping.
+   */
+  void EraseIndices(const RowSequence &rows_index_space, size_t num_rows);
+  /**
+   * Whether to rebuild the columns in a single pass rather than splicing each interval of
+   * 'rows_index_space' into a table of 'num_rows' rows (see SpliceMode).
+   */
+  [[nodiscard]]
+  bool ShouldRebuild(const RowSequence &rows_index_space, size_t num_rows) const;
+  /**
+   * Invokes fn(i) for every subscribed column i < num_columns, on the worker pool if there is one.
+   */
+  void ForEachSubscribedColumn(size_t num_columns, const std::function<void(size_t)> &fn);
+  /**
+   * Copies column 'col_num' out of its SegmentedColumn (if it has one) into its flex vector.
+   */
+  void LeaveZeroCopyMode(size_t col_num);
+  void LeaveZeroCopyModeAll();
+  /**
+   * Notes that column 'col_num' has changed, so its cached ColumnSource is out of date. Calls for
+   * different columns may be made concurrently.
+   */
+  void InvalidateColumn(size_t col_num) {
+    columnCache_[col_num].reset();
+  }
+  void InvalidateAllColumns();
+
   std::shared_ptr<Schema> schema_;
+  // One per column in the schema. The entries for unsubscribed columns are null.
   std::vector<std::unique_ptr<AbstractFlexVectorBase>> flexVectors_;
+  // One per column in the schema. Non-null for the columns that are in zero-copy mode, in which
+  // case the column's data is here and the corresponding entry of flexVectors_ is empty.
+  std::vector<std::unique_ptr<SegmentedColumn>> segmentedColumns_;
   // Keeps track of keyspace -> index space mapping
   SpaceMapper spaceMapper_;
+  SpliceMode spliceMode_ = SpliceMode::kPerInterval;
+  std::shared_ptr<ColumnWorkerPool> columnWorkerPool_;
+  bool reuseUnchangedColumns_ = true;
+  // One per column in the schema: the ColumnSource for its current contents, or null if the
+  // column has changed since it was made.
+  mutable std::vector<std::shared_ptr<ColumnSource>> columnCache_;
+  // The columns of the last snapshot. Reused as is if no column has changed since.
+  mutable std::shared_ptr<const std::vector<std::shared_ptr<ColumnSource>>> lastColumns_;
 };
+
+namespace internal {
+/**
+ * Makes a ClientTable out of 'sources' (one per column of 'schema'), each of which has 'num_rows'
+ * rows.
+ */
+[[nodiscard]]
+std::shared_ptr<deephaven::dhcore::clienttable::ClientTable> MakeClientTable(
+    std::shared_ptr<deephaven::dhcore::clienttable::Schema> schema,
+    std::vector<std::shared_ptr<deephaven::dhcore::column::ColumnSource>> sources,
+    size_t num_rows);
+
+/**
+ * As above, but sharing 'sources' rather than taking it over.
+ */
+[[nodiscard]]
+std::shared_ptr<deephaven::dhcore::clienttable::ClientTable> MakeClientTable(
+    std::shared_ptr<deephaven::dhcore::clienttable::Schema> schema,
+    std::shared_ptr<const std::vector<std::shared_ptr<deephaven::dhcore::column::ColumnSource>>> sources,
+    size_t num_rows);
+
+/**
+ * Makes a column of 'size' rows, all of them null. Stands in for an unsubscribed column.
+ */
+[[nodiscard]]
+std::shared_ptr<deephaven::dhcore::column::ColumnSource> MakeNullColumnSource(
+    const ElementType &element_type, size_t size);
+}  // namespace internal
 }  // namespace deephaven::dhcore::ticking
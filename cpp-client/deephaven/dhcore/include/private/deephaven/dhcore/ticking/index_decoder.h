@@ -3,7 +3,11 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
 #include "flatbuffers/flatbuffers.h"
 #include "deephaven/dhcore/container/row_sequence.h"
 
@@ -22,14 +26,56 @@ public:
   [[nodiscard]] int16_t ReadShort();
   [[nodiscard]] int8_t ReadByte();
 
+  /**
+   * Copies the next 'count' values of type T (as written by the corresponding DataOutput calls)
+   * into 'dest'.
+   */
+  template<typename T>
+  void ReadArray(T *dest, size_t count) {
+    auto num_bytes = count * sizeof(T);
+    std::memcpy(dest, data_, num_bytes);
+    data_ += num_bytes;
+  }
+
 private:
   const char *data_ = nullptr;
   const char *end_ = nullptr;
 };
 
+class DataOutput {
+public:
+  explicit DataOutput(std::vector<int8_t> *dest) : dest_(dest) {}
+
+  void WriteValue(int8_t command, int64_t value);
+
+  void WriteLong(int64_t value);
+  void WriteInt(int32_t value);
+  void WriteShort(int16_t value);
+  void WriteByte(int8_t value);
+
+private:
+  std::vector<int8_t> *dest_ = nullptr;
+};
+
 struct IndexDecoder {
   using RowSequence = deephaven::dhcore::container::RowSequence;
 
+  /**
+   * Decodes a RowSequence in the server's compressed delta format. The intervals are written
+   * straight into a flat sorted array (see RowSequence::CreateFromIntervals) rather than going
+   * through RowSequenceBuilder, and the byte and short array commands are widened a block at a
+   * time so that the compiler can vectorize the expansion.
+   */
   [[nodiscard]] static std::shared_ptr<RowSequence> ReadExternalCompressedDelta(DataInput *in);
 };
+
+/**
+ * The inverse of IndexDecoder. Writes a RowSequence in the compressed delta format that the
+ * server understands (used for example to encode a viewport in a BarrageSubscriptionRequest).
+ */
+struct IndexEncoder {
+  using RowSequence = deephaven::dhcore::container::RowSequence;
+
+  static void WriteExternalCompressedDelta(const RowSequence &rows, DataOutput *out);
+};
 }  // namespace deephaven::dhcore::ticking
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <immer/flex_vector.hpp>
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/immerutil/abstract_flex_vector.h"
+#include "deephaven/dhcore/types.h"
+
+namespace deephaven::dhcore::ticking {
+/**
+ * The rows [begin_, end_) of 'source_', which start at absolute position 'position_' of a
+ * SegmentedColumn. Absolute positions count every row ever appended to the column, including the
+ * ones since erased from the front.
+ */
+struct ColumnSegment {
+  std::shared_ptr<deephaven::dhcore::column::ColumnSource> source_;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+  uint64_t position_ = 0;
+};
+
+/**
+ * Makes an immutable column source whose position p is absolute position p + 'begin_position' of
+ * 'segments'. The column has 'size' rows, all of which must be covered by 'segments'.
+ */
+std::shared_ptr<deephaven::dhcore::column::ColumnSource> MakeSegmentedColumnSource(
+    const ElementType &element_type, immer::flex_vector<ColumnSegment> segments,
+    uint64_t begin_position, size_t size);
+
+/**
+ * Storage for one column of an ImmerTableState whose rows only ever arrive at the end (and
+ * perhaps leave from the front). Rather than copying appended data into a flex vector, it holds
+ * on to the ColumnSources it was given and records which rows of each one belong to the column.
+ * This is only correct if those ColumnSources own their data, as the Arrow-backed ones that
+ * dhclient makes from each Flight message do.
+ *
+ * Batches smaller than kMinZeroCopyRows are copied into a flex vector "tail" instead, so that a
+ * stream of tiny updates does not turn into a long list of tiny segments. The tail is frozen
+ * into a segment of its own whenever a large batch arrives.
+ *
+ * The segment list is a persistent vector, so MakeColumnSource() is O(1) and the sources it
+ * returns are unaffected by later changes to the column.
+ */
+class SegmentedColumn final {
+  using AbstractFlexVectorBase = deephaven::dhcore::immerutil::AbstractFlexVectorBase;
+  using ColumnSource = deephaven::dhcore::column::ColumnSource;
+
+public:
+  /**
+   * Batches with at least this many rows are kept by reference rather than copied.
+   */
+  static constexpr const size_t kMinZeroCopyRows = 1024;
+
+  /**
+   * Constructor.
+   * @param element_type The type of the column
+   * @param empty_tail An empty flex vector of the right type, used to hold small batches
+   */
+  SegmentedColumn(const ElementType &element_type,
+      std::unique_ptr<AbstractFlexVectorBase> empty_tail);
+  ~SegmentedColumn();
+
+  /**
+   * Appends the rows [begin, end) of 'source' to the end of the column.
+   */
+  void Append(const std::shared_ptr<ColumnSource> &source, size_t begin, size_t end);
+
+  /**
+   * Removes the first 'count' rows of the column.
+   */
+  void EraseFront(size_t count);
+
+  /**
+   * The number of rows in the column.
+   */
+  [[nodiscard]]
+  size_t Size() const {
+    return static_cast<size_t>(endPosition_ - beginPosition_);
+  }
+
+  /**
+   * An immutable view of the column's current contents.
+   */
+  [[nodiscard]]
+  std::shared_ptr<ColumnSource> MakeColumnSource() const;
+
+private:
+  void FreezeTail();
+
+  ElementType elementType_;
+  immer::flex_vector<ColumnSegment> segments_;
+  // Absolute positions of the first row of the column and of one past its last row.
+  uint64_t beginPosition_ = 0;
+  uint64_t endPosition_ = 0;
+  // Small batches accumulate here. If it is nonempty, it is also the last entry of segments_
+  // (as a column source snapshot, updated on every append).
+  std::unique_ptr<AbstractFlexVectorBase> tail_;
+  size_t tailSize_ = 0;
+};
+}  // namespace deephaven::dhcore::ticking
@@ -3,7 +3,11 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <cstdlib>
+#include <map>
+#include <memory>
+#include <vector>
 #include "deephaven/dhcore/container/row_sequence.h"
 #include "roaring/roaring.hh"
 
@@ -45,12 +49,26 @@ public:
    * and insert this new set of keys into the map.
    *
    * This has the effect of offsetting all the existing keys by (dest_key - begin_key)
+   *
+   * The keys are moved a bucket at a time rather than a key at a time: buckets lying entirely
+   * inside the range are detached without copying, and are reattached under a new bucket id when
+   * the offset is a multiple of the bucket size. Otherwise a bucket holding a single run moves as
+   * a range, and any other bucket is copied out to an array and bulk-added to the (at most two)
+   * buckets it lands in.
    * @param begin_key The start of the range of keys
    * @param end_key One past the end of the range of keys
    * @param dest_key The start of the target range to move keys to.
    */
   void ApplyShift(uint64_t begin_key, uint64_t end_key, uint64_t dest_key);
 
+  /**
+   * Applies the Barrage shift data to the set. The three RowSequences are the "transposed" form
+   * of the tuples (first_key, last_key, dest_key), where [first_key, last_key] is a *closed*
+   * range. See ImmerTableState::ApplyShifts for a fuller description.
+   */
+  void ApplyShifts(const RowSequence &first_index, const RowSequence &last_index,
+      const RowSequence &dest_index);
+
   /**
    * Adds 'keys' (specified in key space) to the map, and returns the positions (in position
    * space) of those keys after insertion. 'keys' are required to not already been in the map.
@@ -75,17 +93,96 @@ public:
   std::shared_ptr<RowSequence> ConvertKeysToIndices(const RowSequence &keys) const;
 
   /**
-   * Note: this call iterates over the Roaring64Map and is not constant-time.
+   * Removes 'keys' (specified in key space) from the map. It is ok if some or all of the keys
+   * do not exist in the map.
+   */
+  void EraseKeys(const RowSequence &keys);
+
+  /**
+   * Returns all the keys in the map.
+   */
+  [[nodiscard]]
+  std::shared_ptr<RowSequence> Keys() const;
+
+  /**
+   * The number of keys in the map. This is maintained as the map is mutated and is constant-time.
    */
   [[nodiscard]]
   size_t Cardinality() const {
-    return set_.cardinality();
+    return cardinality_;
   }
 
+  /**
+   * The number of keys in the map that are strictly less than 'value'. This is logarithmic in
+   * the number of buckets (see below) once the rank index covers 'value'.
+   */
   [[nodiscard]]
   uint64_t ZeroBasedRank(uint64_t value) const;
 
 private:
-  roaring::Roaring64Map set_;
+  /**
+   * The keys are partitioned by their high bits into buckets of kBucketSize consecutive keys.
+   * Each bucket holds the low bits of its keys in a Roaring bitmap (which therefore has a single
+   * container) and caches its own cardinality.
+   */
+  static constexpr uint32_t kBucketBits = 16;
+  static constexpr uint64_t kBucketSize = uint64_t(1) << kBucketBits;
+
+  struct Bucket {
+    roaring::Roaring bits_;
+    uint64_t cardinality_ = 0;
+  };
+  using buckets_t = std::map<uint64_t, Bucket>;
+
+  /**
+   * An entry in the rank index: a bucket id and the number of keys in all the buckets before it.
+   */
+  struct RankEntry {
+    uint64_t bucket_id_ = 0;
+    uint64_t keys_before_ = 0;
+  };
+
+  /**
+   * Adds the keys in [begin_key, end_key) and returns how many of them were not already present.
+   */
+  uint64_t InsertRange(uint64_t begin_key, uint64_t end_key);
+  /**
+   * Removes the keys in [begin_key, end_key) and returns how many of them were present.
+   */
+  uint64_t RemoveRange(uint64_t begin_key, uint64_t end_key);
+  /**
+   * Removes the keys in [begin_key, end_key) and returns them as buckets under their original
+   * bucket ids.
+   */
+  [[nodiscard]]
+  buckets_t ExtractRange(uint64_t begin_key, uint64_t end_key);
+  /**
+   * Adds the keys of a bucket detached by ExtractRange, offset by 'offset' (modulo 2^64, so this
+   * also moves keys downward). Returns how many of them were not already present.
+   */
+  uint64_t InsertShiftedBucket(buckets_t::node_type node, uint64_t offset);
+  /**
+   * Adds the sorted low bits in [values, values + count) to the bucket 'bucket_id' and returns how
+   * many of them were not already present.
+   */
+  uint64_t AddManyToBucket(uint64_t bucket_id, const uint32_t *values, size_t count);
+  /**
+   * Drops the rank index entries at and after 'bucket_id'. Called whenever a bucket's
+   * cardinality changes or a bucket is created or destroyed.
+   */
+  void InvalidateRankIndex(uint64_t bucket_id);
+  /**
+   * Extends the rank index so that it covers every bucket whose id is <= 'bucket_id'.
+   */
+  void ExtendRankIndex(uint64_t bucket_id) const;
+
+  buckets_t buckets_;
+  size_t cardinality_ = 0;
+  /**
+   * The rank index covers a prefix of buckets_, in order. Mutations truncate it at the first
+   * bucket they touch and rank queries extend it lazily, so appending at the end of the key space
+   * (the common case) only ever touches the tail of the index.
+   */
+  mutable std::vector<RankEntry> rank_index_;
 };
 }  // namespace deephaven::dhcore::ticking
@@ -51,6 +51,12 @@ public:
     }
   }
 
+  [[nodiscard]]
+  const T *Data(size_t begin_index, size_t end_index) const {
+    ColumnSourceImpls::AssertRangeValid(begin_index, end_index, size_);
+    return start_ + begin_index;
+  }
+
 private:
   const T *start_ = nullptr;
 };
@@ -167,6 +173,12 @@ public:
     ColumnSourceImpls::FillChunkUnordered<chunkType_t>(row_keys, dest, optional_null_flags, data_);
   }
 
+  [[nodiscard]]
+  const T *ContiguousData(size_t begin, size_t end, size_t *available) const final {
+    *available = end - begin;
+    return data_.Data(begin, end);
+  }
+
   void AcceptVisitor(ColumnSourceVisitor *visitor) const final {
     visitor->Visit(*this);
   }
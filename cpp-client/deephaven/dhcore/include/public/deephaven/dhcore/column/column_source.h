@@ -133,6 +133,24 @@ public:
  */
 template<typename T>
 class GenericColumnSource : public virtual ColumnSource {
+public:
+  /**
+   * If the elements starting at position 'begin' are stored contiguously in memory, in the same
+   * representation that FillChunk() would produce, returns a pointer to the element at 'begin'
+   * and sets *available to the number of elements in [begin, end) that can be read from that
+   * pointer. Otherwise returns nullptr. This allows bulk consumers to skip the intermediate Chunk
+   * copy. The default implementation returns nullptr.
+   * @param begin The position of the first element requested.
+   * @param end One past the position of the last element requested.
+   * @param available Receives the number of contiguous elements available at the returned
+   *   pointer. This is at most end - begin, and may be less if the data is segmented.
+   * @return A pointer to the element at 'begin', or nullptr.
+   */
+  [[nodiscard]]
+  virtual const T *ContiguousData(size_t /*begin*/, size_t /*end*/, size_t *available) const {
+    *available = 0;
+    return nullptr;
+  }
 };
 
 /**
@@ -36,7 +36,7 @@ struct ColumnSourceImpls {
         dest_null += size;
       }
     };
-    rows.ForEachInterval(apply_chunk);
+    rows.ForEachIntervalInline(apply_chunk);
   }
 
   template<typename ChunkType, typename BackingStore>
@@ -82,7 +82,7 @@ struct ColumnSourceImpls {
         null_data += size;
       }
     };
-    rows.ForEachInterval(apply_chunk);
+    rows.ForEachIntervalInline(apply_chunk);
   }
 
   template<typename ChunkType, typename BackingStore>
@@ -51,7 +51,7 @@ public:
     size_t dest_index = 0;
     const auto *data = container_->data();
     auto *typed_dest = VerboseCast<chunkType_t*>(DEEPHAVEN_LOCATION_EXPR(dest));
-    rows.ForEachInterval([&](uint64_t begin_key, uint64_t end_key) {
+    rows.ForEachIntervalInline([&](uint64_t begin_key, uint64_t end_key) {
       for (auto current = begin_key; current != end_key; ++current) {
         auto is_null = container_->IsNull(current);
         if (!is_null) {
@@ -10,6 +10,8 @@
 #include <memory>
 #include <ostream>
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "deephaven/third_party/fmt/format.h"
 #include "deephaven/third_party/fmt/ostream.h"
@@ -17,6 +19,35 @@
 namespace deephaven::dhcore::container {
 class RowSequenceIterator;
 
+/**
+ * A non-owning view of a RowSequence's intervals, for iterating without going through a
+ * std::function. The view covers 'size_' keys, starting 'first_offset_' keys into
+ * intervals_[0]. It is only valid as long as the RowSequence it came from.
+ */
+struct IntervalView {
+  const std::pair<uint64_t, uint64_t> *intervals_ = nullptr;
+  size_t num_intervals_ = 0;
+  uint64_t first_offset_ = 0;
+  size_t size_ = 0;
+
+  /**
+   * Invokes f(begin_key, end_key) on each of the half-open intervals covered by the view.
+   */
+  template<typename F>
+  void ForEach(const F &f) const {
+    auto remaining = size_;
+    auto offset = first_offset_;
+    for (size_t i = 0; remaining != 0 && i != num_intervals_; ++i) {
+      auto begin = intervals_[i].first + offset;
+      auto end = intervals_[i].second - begin > remaining ? begin + remaining :
+          intervals_[i].second;
+      remaining -= end - begin;
+      offset = 0;
+      f(begin, end);
+    }
+  }
+};
+
 /**
  * Represets a monotonically increasing sequence of row numbers. The coordinate space of those
  * row numbers (key space vs index space) is unspecified here.
@@ -33,6 +64,15 @@ public:
    */
   [[nodiscard]]
   static std::shared_ptr<RowSequence> CreateSequential(uint64_t begin, uint64_t end);
+  /**
+   * Create a RowSequence backed directly by 'intervals', a vector of half-open intervals
+   * [begin, end) which must be nonempty, sorted, and disjoint. This avoids the per-interval cost
+   * of RowSequenceBuilder when the caller already produces its intervals in order.
+   * @throws std::runtime_error if the intervals are empty, out of order, or overlapping
+   */
+  [[nodiscard]]
+  static std::shared_ptr<RowSequence> CreateFromIntervals(
+      std::vector<std::pair<uint64_t, uint64_t>> intervals);
 
   /**
    * Destructor.
@@ -66,6 +106,29 @@ public:
   virtual void ForEachInterval(
       const std::function<void(uint64_t begin_key, uint64_t end_key)> &callback) const = 0;
 
+  /**
+   * Like ForEachInterval, but the callback is a template parameter, so it can be inlined rather
+   * than being called through a std::function. This uses the IntervalView when the RowSequence
+   * offers one (all the RowSequences created by this class and by RowSequenceBuilder do) and
+   * falls back to ForEachInterval otherwise.
+   */
+  template<typename F>
+  void ForEachIntervalInline(const F &f) const {
+    IntervalView view;
+    if (TryGetIntervalView(&view)) {
+      view.ForEach(f);
+      return;
+    }
+    ForEachInterval(f);
+  }
+
+  /**
+   * If this RowSequence is backed by an array of intervals, fills in *result and returns true.
+   * Otherwise returns false. The default implementation returns false.
+   */
+  [[nodiscard]]
+  virtual bool TryGetIntervalView(IntervalView *result) const;
+
   /**
    * The number of elements in this RowSequence.
    */
@@ -152,20 +215,20 @@ public:
   }
 
   /**
-   * Builds the RowSequence.
+   * Builds the RowSequence. This leaves the builder empty.
    */
   [[nodiscard]]
   std::shared_ptr<RowSequence> Build();
 
 private:
   /**
-   * We store our half-open intervals as a map from (begin of interval) to (end of interval).
-   * Our code maintains the invariants that map entries do not contain overlapping ranges,
-   * and if two adjacent ranges are contiguous, they will get merged into one.
+   * We store our half-open intervals in a flat vector, in the order they were added. Intervals
+   * that start at or after the start of the last one are merged into it on the spot, so adding
+   * in increasing order (by far the common case) keeps the vector sorted and disjoint. Anything
+   * else sets 'needs_normalizing_', and Build() sorts and merges once at the end.
    */
-  using ranges_t = std::map<uint64_t, uint64_t>;
-  ranges_t ranges_;
-  size_t size_ = 0;
+  std::vector<std::pair<uint64_t, uint64_t>> ranges_;
+  bool needs_normalizing_ = false;
 };
 }  // namespace deephaven::dhcore::container
 
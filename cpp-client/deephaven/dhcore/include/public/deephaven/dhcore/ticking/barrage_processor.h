@@ -9,6 +9,8 @@
 #include <vector>
 #include "deephaven/dhcore/chunk/chunk.h"
 #include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/subscription_options.h"
 #include "deephaven/dhcore/ticking/ticking.h"
 
 namespace deephaven::dhcore::ticking {
@@ -20,24 +22,90 @@ class BarrageProcessor final {
 protected:
   using Schema = deephaven::dhcore::clienttable::Schema;
   using ColumnSource = deephaven::dhcore::column::ColumnSource;
+  using RowSequence = deephaven::dhcore::container::RowSequence;
 
 public:
   static constexpr const uint32_t kDeephavenMagicNumber = 0x6E687064U;
 
   [[nodiscard]]
   static std::vector<uint8_t> CreateSubscriptionRequest(const void *ticket_bytes, size_t size);
+  /**
+   * Creates a BarrageSubscriptionRequest, optionally restricted to a subset of the columns and/or
+   * a viewport. The same request can be sent again on a live subscription in order to move the
+   * viewport, but not to switch between a viewport and the whole table: the server fixes that
+   * when the subscription is created.
+   * @param ticket_bytes The bytes of the ticket of the table to subscribe to
+   * @param size The number of bytes in the ticket
+   * @param column_indices The indices (in the table's schema) of the columns to subscribe to, or
+   *   nullptr to subscribe to all of them
+   * @param viewport The row positions to subscribe to, or nullptr to subscribe to the whole table
+   * @param reverse_viewport If true, the positions in 'viewport' are counted backwards from the
+   *   end of the table
+   * @param options Batch size, message size, update interval and column conversion settings
+   * @return The serialized BarrageMessageWrapper
+   */
+  [[nodiscard]]
+  static std::vector<uint8_t> CreateSubscriptionRequest(const void *ticket_bytes, size_t size,
+      const std::vector<size_t> *column_indices, const RowSequence *viewport, bool reverse_viewport,
+      const SubscriptionOptions &options);
+  /**
+   * Creates a BarrageSnapshotRequest, which asks the server for a one-time snapshot of (a subset
+   * of) the table rather than a subscription. The server replies with a single snapshot message,
+   * which a BarrageProcessor made by ForSnapshot() turns into a TickingUpdate.
+   * @param ticket_bytes The bytes of the ticket of the table to snapshot
+   * @param size The number of bytes in the ticket
+   * @param column_indices The indices (in the table's schema) of the columns to fetch, or nullptr
+   *   to fetch all of them
+   * @param viewport The row positions to fetch, or nullptr to fetch the whole table
+   * @param reverse_viewport If true, the positions in 'viewport' are counted backwards from the
+   *   end of the table
+   * @param options Batch size, message size and column conversion settings. The minimum update
+   *   interval does not apply to a snapshot.
+   * @return The serialized BarrageMessageWrapper
+   */
+  [[nodiscard]]
+  static std::vector<uint8_t> CreateSnapshotRequest(const void *ticket_bytes, size_t size,
+      const std::vector<size_t> *column_indices, const RowSequence *viewport, bool reverse_viewport,
+      const SubscriptionOptions &options);
   /**
    * Returning a 'string' type makes life in Cython slightly easier.
    */
   [[nodiscard]]
   static std::string CreateSubscriptionRequestCython(const void *ticket_bytes, size_t size);
+  [[nodiscard]]
+  static std::string CreateSubscriptionRequestCython(const void *ticket_bytes, size_t size,
+      const SubscriptionOptions &options);
 
   BarrageProcessor();
   explicit BarrageProcessor(std::shared_ptr<Schema> schema);
+  /**
+   * Constructor.
+   * @param schema The schema of the table being subscribed to
+   * @param options The subscription options. Only the client-side settings affect the
+   *   BarrageProcessor: the column parallelism, zero-copy appends and deltas-only. With either of
+   *   the last two, the ColumnSources passed to ProcessNextChunk must own their data, because the
+   *   processor keeps views over them rather than copying them.
+   */
+  BarrageProcessor(std::shared_ptr<Schema> schema, const SubscriptionOptions &options);
   BarrageProcessor(BarrageProcessor &&other) noexcept;
   BarrageProcessor &operator=(BarrageProcessor &&other) noexcept;
   ~BarrageProcessor();
 
+  /**
+   * Makes a BarrageProcessor for the reply to a BarrageSnapshotRequest (see
+   * CreateSnapshotRequest), rather than for a subscription. Unlike the updates of a viewport
+   * subscription, which identify rows by their positions in the viewport, that reply identifies
+   * them by key.
+   *
+   * A snapshot only ever appends, so the processor has zero-copy appends turned on (see
+   * SubscriptionOptions::SetZeroCopyAppends): the resulting table is a view over the
+   * ColumnSources passed to ProcessNextChunk. The caller must keep the data behind them alive for
+   * as long as the table is in use, for instance by passing ColumnSources that own their buffers.
+   * @param schema The schema of the table being snapshotted
+   */
+  [[nodiscard]]
+  static BarrageProcessor ForSnapshot(std::shared_ptr<Schema> schema);
+
   [[nodiscard]]
   std::optional<TickingUpdate> ProcessNextChunk(const std::vector<std::shared_ptr<ColumnSource>> &sources,
       const std::vector<size_t> &sizes, const void *metadata, size_t metadata_size);
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace deephaven::dhcore::ticking {
+/**
+ * How the server should send columns whose types cannot be represented directly in Arrow.
+ * The numeric values match the Barrage ColumnConversionMode enum.
+ */
+enum class ColumnConversionMode : int8_t {
+  /**
+   * Send the column as strings.
+   */
+  kStringify = 1,
+  /**
+   * Send the column as Java-serialized bytes.
+   */
+  kJavaSerialization = 2,
+  /**
+   * Refuse to send the column and fail the subscription.
+   */
+  kThrowError = 3
+};
+
+/**
+ * What a pipelined subscription (see SubscriptionOptions::SetPipelineDepth) does when the
+ * TickingCallback falls so far behind that its queue of updates is full.
+ */
+enum class ConflationPolicy : int8_t {
+  /**
+   * Never conflate. Decoding waits until the callback catches up, and so, once the queue of
+   * received messages fills up too, does reading from the server.
+   */
+  kNone = 0,
+  /**
+   * Replace the waiting updates, and the new one, with a single update that goes straight from
+   * the first one's Prev() to the new one's Current(), by removing every row and adding every row
+   * back. The callback sees fewer, coarser updates, but always a current table.
+   */
+  kReplace = 1,
+  /**
+   * Merge the waiting updates, and the new one, into a single update (see TickingUpdate::Merge)
+   * that goes from the first one's Prev() to the new one's Current() with the rows that were
+   * really removed, added and modified along the way. The callback sees fewer updates, with the
+   * same cumulative effect as the ones they stand for.
+   */
+  kMerge = 2
+};
+
+/**
+ * Counters describing the progress of a subscription, for monitoring. The queue figures are only
+ * meaningful for pipelined subscriptions (see SubscriptionOptions::SetPipelineDepth); otherwise
+ * they are zero.
+ */
+struct SubscriptionMetrics {
+  /**
+   * The number of messages read from the server.
+   */
+  uint64_t messages_read = 0;
+  /**
+   * The number of updates produced from those messages.
+   */
+  uint64_t updates_decoded = 0;
+  /**
+   * The number of updates handed to the TickingCallback.
+   */
+  uint64_t updates_delivered = 0;
+  /**
+   * The number of updates that were folded into others, rather than delivered, because the
+   * TickingCallback fell behind.
+   */
+  uint64_t updates_conflated = 0;
+  /**
+   * The capacity of each of the two queues.
+   */
+  size_t queue_capacity = 0;
+  /**
+   * The number of messages read but not yet decoded, now and at most.
+   */
+  size_t message_queue_size = 0;
+  size_t message_queue_high_water = 0;
+  /**
+   * The number of updates decoded but not yet delivered, now and at most.
+   */
+  size_t update_queue_size = 0;
+  size_t update_queue_high_water = 0;
+};
+
+/**
+ * Tuning parameters for a subscription. Most of them are sent to the server as the
+ * BarrageSubscriptionOptions of the BarrageSubscriptionRequest; the column parallelism,
+ * zero-copy appends, deltas-only mode and pipelining are client-side settings. For convenience, the mutating
+ * methods can be chained.
+ * @example auto handle = table.Subscribe(callback, SubscriptionOptions().SetMinUpdateIntervalMs(500).SetBatchSize(65536))
+ */
+class SubscriptionOptions {
+public:
+  static constexpr const int32_t kDefaultBatchSize = 4096;
+
+  /**
+   * Default constructor. Creates a SubscriptionOptions object with the same settings the client
+   * has always used: batches of 4096 rows, no message size limit, the server's default update
+   * interval, string conversion of unsupported column types, serial application of updates, no
+   * zero-copy appends, a full copy of the table maintained on the client, and reading, decoding
+   * and callbacks all on one thread.
+   */
+  SubscriptionOptions();
+  SubscriptionOptions(const SubscriptionOptions &other);
+  SubscriptionOptions(SubscriptionOptions &&other) noexcept;
+  SubscriptionOptions &operator=(const SubscriptionOptions &other);
+  SubscriptionOptions &operator=(SubscriptionOptions &&other) noexcept;
+  ~SubscriptionOptions();
+
+  /**
+   * Sets the maximum number of rows the server puts in each record batch. Larger batches mean
+   * fewer messages (and less per-message overhead) for large snapshots and updates.
+   * @param batch_size The number of rows, which must be positive.
+   * @return *this, so that methods can be chained.
+   */
+  SubscriptionOptions &SetBatchSize(int32_t batch_size);
+  /**
+   * Sets the maximum size in bytes of each message the server sends. The server splits updates
+   * that would exceed this size.
+   * @param max_message_size The size in bytes, or 0 for the server's default.
+   * @return *this, so that methods can be chained.
+   */
+  SubscriptionOptions &SetMaxMessageSize(int32_t max_message_size);
+  /**
+   * Sets the minimum interval between updates. The server coalesces the changes that happen
+   * within an interval into a single update, which is useful for tables that tick very quickly.
+   * @param min_update_interval_ms The interval in milliseconds, or 0 for the server's default.
+   * @return *this, so that methods can be chained.
+   */
+  SubscriptionOptions &SetMinUpdateIntervalMs(int32_t min_update_interval_ms);
+  /**
+   * Sets how the server sends columns whose types cannot be represented directly in Arrow.
+   * @param column_conversion_mode The conversion mode.
+   * @return *this, so that methods can be chained.
+   */
+  SubscriptionOptions &SetColumnConversionMode(ColumnConversionMode column_conversion_mode);
+  /**
+   * Sets the number of threads the client uses to apply each update to the table's columns.
+   * Every column is stored independently, so on wide tables splitting the per-column work across
+   * cores cuts update latency roughly in proportion. The update is fully applied before the
+   * TickingCallback sees it, whatever the setting.
+   * @param column_parallelism The number of threads, including the subscription's own update
+   *   thread. Must be positive. 1 (the default) applies updates serially.
+   * @return *this, so that methods can be chained.
+   */
+  SubscriptionOptions &SetColumnParallelism(int32_t column_parallelism);
+  /**
+   * Sets whether the client keeps appended rows in the Arrow buffers they arrived in, rather than
+   * copying them into its own storage. This suits add-only (and blink or ring) tables: while
+   * rows only arrive at the end of the table and only leave from the front, each snapshot the
+   * TickingCallback sees is a view over the received batches, and costs O(1) per column to make
+   * however large the table grows. The first update that inserts, removes or modifies rows
+   * anywhere else copies the data once, after which the subscription behaves as usual.
+   *
+   * This requires that the column data handed to the BarrageProcessor own its buffers, which is
+   * true of the C++ client's subscriptions.
+   * @param zero_copy_appends Whether to enable zero-copy appends. The default is false.
+   * @return *this, so that methods can be chained.
+   */
+  SubscriptionOptions &SetZeroCopyAppends(bool zero_copy_appends);
+  /**
+   * Sets whether the client delivers only the changes in each update, rather than maintaining a
+   * copy of the table. This suits blink tables, and any other table where the callback only
+   * cares about each update's new data. In this mode the TickingUpdate has no table snapshots;
+   * instead TickingUpdate::Added() holds the added rows and TickingUpdate::ModifiedColumns() the
+   * new values of the modified ones, as views over the received Arrow batches. Its RemovedRows(),
+   * AddedRows() and ModifiedRows() are in the server's key space rather than in position space,
+   * because without the table there are no positions. The client keeps nothing from one update
+   * to the next.
+   *
+   * As with zero-copy appends, this requires that the column data handed to the BarrageProcessor
+   * own its buffers, which is true of the C++ client's subscriptions.
+   * @param deltas_only Whether to deliver only the changes. The default is false.
+   * @return *this, so that methods can be chained.
+   */
+  SubscriptionOptions &SetDeltasOnly(bool deltas_only);
+  /**
+   * Sets whether, and how deeply, the subscription is pipelined. Ordinarily one thread reads each
+   * message from the server, decodes it into the table and then calls the TickingCallback, so a
+   * slow callback holds up reading and the server has to buffer (and eventually throttle) the
+   * subscription. When pipelined, the three stages run on threads of their own, connected by
+   * queues that each hold up to 'pipeline_depth' entries; once the callback's queue is full,
+   * the ConflationPolicy decides what happens. Either way the callback sees the same sequence
+   * of tables, in order, on a single thread.
+   * @param pipeline_depth The queue capacity, or 0 (the default) for no pipelining.
+   * @return *this, so that methods can be chained.
+   */
+  SubscriptionOptions &SetPipelineDepth(int32_t pipeline_depth);
+  /**
+   * Sets what a pipelined subscription does when the TickingCallback falls behind. Ignored
+   * unless the subscription is pipelined. Deltas-only subscriptions have no snapshots to
+   * conflate, so they always behave as ConflationPolicy::kNone.
+   * @param conflation_policy The policy. The default is ConflationPolicy::kNone.
+   * @return *this, so that methods can be chained.
+   */
+  SubscriptionOptions &SetConflationPolicy(ConflationPolicy conflation_policy);
+
+  [[nodiscard]]
+  int32_t BatchSize() const { return batchSize_; }
+  [[nodiscard]]
+  int32_t MaxMessageSize() const { return maxMessageSize_; }
+  [[nodiscard]]
+  int32_t MinUpdateIntervalMs() const { return minUpdateIntervalMs_; }
+  [[nodiscard]]
+  ColumnConversionMode GetColumnConversionMode() const { return columnConversionMode_; }
+  [[nodiscard]]
+  int32_t ColumnParallelism() const { return columnParallelism_; }
+  [[nodiscard]]
+  bool ZeroCopyAppends() const { return zeroCopyAppends_; }
+  [[nodiscard]]
+  bool DeltasOnly() const { return deltasOnly_; }
+  [[nodiscard]]
+  int32_t PipelineDepth() const { return pipelineDepth_; }
+  [[nodiscard]]
+  ConflationPolicy GetConflationPolicy() const { return conflationPolicy_; }
+
+private:
+  int32_t batchSize_ = kDefaultBatchSize;
+  int32_t maxMessageSize_ = 0;
+  int32_t minUpdateIntervalMs_ = 0;
+  ColumnConversionMode columnConversionMode_ = ColumnConversionMode::kStringify;
+  int32_t columnParallelism_ = 1;
+  bool zeroCopyAppends_ = false;
+  bool deltasOnly_ = false;
+  int32_t pipelineDepth_ = 0;
+  ConflationPolicy conflationPolicy_ = ConflationPolicy::kNone;
+};
+}  // namespace deephaven::dhcore::ticking
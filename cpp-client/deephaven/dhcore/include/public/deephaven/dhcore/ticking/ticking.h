@@ -3,11 +3,15 @@
  */
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdlib>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <set>
+#include <vector>
 #include "deephaven/dhcore/container/row_sequence.h"
 #include "deephaven/dhcore/clienttable/client_table.h"
 
@@ -15,20 +19,52 @@ namespace deephaven::dhcore::ticking {
 class TickingUpdate;
 
 namespace internal {
+/**
+ * The makings of a snapshot of the table: one immutable ColumnSource per column, shared with every
+ * other snapshot in which that column is unchanged. This is cheap to capture. The ClientTable
+ * itself is only built when someone asks for it.
+ */
+struct LazyTable {
+  std::shared_ptr<deephaven::dhcore::clienttable::Schema> schema_;
+  std::shared_ptr<const std::vector<std::shared_ptr<deephaven::dhcore::column::ColumnSource>>> columns_;
+  size_t num_rows_ = 0;
+};
+
 class OnDemandState {
+  /**
+   * Alias.
+   */
+  using ClientTable = deephaven::dhcore::clienttable::ClientTable;
   /**
    * Alias.
    */
   using RowSequence = deephaven::dhcore::container::RowSequence;
 public:
+  /**
+   * The snapshots of a TickingUpdate, in the order they were taken.
+   */
+  enum Snapshot : size_t { kPrev, kAfterRemoves, kAfterAdds, kAfterModifies, kNumSnapshots };
+
   OnDemandState();
+  explicit OnDemandState(std::array<std::shared_ptr<ClientTable>, kNumSnapshots> tables);
+  explicit OnDemandState(std::array<LazyTable, kNumSnapshots> lazy_tables);
   ~OnDemandState();
 
+  /**
+   * The given snapshot, which is built on first use. Snapshots that were captured from the same
+   * columns come back as the same ClientTable.
+   */
+  const std::shared_ptr<ClientTable> &Table(Snapshot which);
+
   const std::shared_ptr<RowSequence> &AllModifiedRows(
       const std::vector<std::shared_ptr<RowSequence>> &modified_rows);
 
 private:
+  const std::shared_ptr<ClientTable> &TableLocked(Snapshot which);
+
   std::mutex mutex_;
+  std::array<LazyTable, kNumSnapshots> lazyTables_;
+  std::array<std::shared_ptr<ClientTable>, kNumSnapshots> tables_;
   std::shared_ptr<RowSequence> allModifiedRows_;
 };
 }  // namespace internal
@@ -59,7 +95,12 @@ public:
  * version. This class is threadsafe and can be kept around for an arbitrary amount of time, though
  * this will consume some memory. The underlying snapshots share a common substructure, so the
  * amount of memory they consumed is roughly proportional to the amount of "new" data in that
- * snapshot.
+ * snapshot. The snapshots are built lazily, on first access, so a callback only pays for the
+ * ones it looks at.
+ *
+ * In a deltas-only subscription (SubscriptionOptions::SetDeltasOnly) there are no snapshots, so
+ * Prev(), Current() and the other snapshot accessors return null. The changes are instead in
+ * Added() and ModifiedColumns(), and the RowSequences are in the server's key space.
  */
 class TickingUpdate final {
 public:
@@ -71,6 +112,10 @@ public:
    * Alias.
    */
   using ClientTable = deephaven::dhcore::clienttable::ClientTable;
+  /**
+   * Alias.
+   */
+  using ColumnSource = deephaven::dhcore::column::ColumnSource;
 
   /**
    * Default constructor.
@@ -84,6 +129,19 @@ public:
       std::shared_ptr<RowSequence> removed_rows, std::shared_ptr<ClientTable> after_removes,
       std::shared_ptr<RowSequence> added_rows, std::shared_ptr<ClientTable> after_adds,
       std::vector<std::shared_ptr<RowSequence>> modified_rows, std::shared_ptr<ClientTable> after_modifies);
+  /**
+   * Constructor, taking snapshots that are to be built on first access. Used internally.
+   */
+  TickingUpdate(internal::LazyTable prev,
+      std::shared_ptr<RowSequence> removed_rows, internal::LazyTable after_removes,
+      std::shared_ptr<RowSequence> added_rows, internal::LazyTable after_adds,
+      std::vector<std::shared_ptr<RowSequence>> modified_rows, internal::LazyTable after_modifies);
+  /**
+   * Constructor for deltas-only updates. Used internally.
+   */
+  TickingUpdate(std::shared_ptr<RowSequence> removed_rows, std::shared_ptr<RowSequence> added_rows,
+      std::shared_ptr<ClientTable> added, std::vector<std::shared_ptr<RowSequence>> modified_rows,
+      std::vector<std::shared_ptr<ColumnSource>> modified_columns);
   /**
    * Copy constructor.
    */
@@ -105,11 +163,38 @@ public:
    */
   ~TickingUpdate();
 
+  /**
+   * Makes a single update that stands for a run of consecutive updates, from 'first' up to and
+   * including 'last'. It goes from first.Prev() to last.Current() by removing every row of the
+   * former and adding every row of the latter, and reports nothing as modified (an empty
+   * RowSequence for each column, as usual). This is what ConflationPolicy::kReplace delivers.
+   * Deltas-only updates have no snapshots, so they cannot be combined this way.
+   */
+  [[nodiscard]]
+  static TickingUpdate Replace(const TickingUpdate &first, const TickingUpdate &last);
+
+  /**
+   * Makes a single update that has the same effect as 'first' followed by 'second', which must
+   * immediately follow it. The result goes from first.Prev() to second.Current(). Its removed rows
+   * are the rows of first.Prev() that did not survive both updates, and its added rows are the
+   * rows of second.Current() that either update added. A row added by one update and removed by
+   * the other appears in neither. A row that was modified by either update and is in both
+   * first.Prev() and second.Current() is reported as modified, at its position in the latter.
+   * ModifiedRows() has an entry for each column, which is empty if the column was not modified.
+   * The intermediate snapshots are views onto first.Prev() and second.Current(), so the merged
+   * update holds on to no table state in between. This is what ConflationPolicy::kMerge
+   * delivers. Deltas-only updates have no snapshots, so they cannot be combined this way.
+   */
+  [[nodiscard]]
+  static TickingUpdate Merge(const TickingUpdate &first, const TickingUpdate &second);
+
   /**
    * A snapshot of the table before any of the changes in this cycle were applied.
    */
   [[nodiscard]]
-  const std::shared_ptr<ClientTable> &Prev() const { return prev_; }
+  const std::shared_ptr<ClientTable> &Prev() const {
+    return onDemandState_->Table(internal::OnDemandState::kPrev);
+  }
 
   /**
    * A snapshot of the table before any rows were removed in this cycle.
@@ -117,7 +202,7 @@ public:
   [[nodiscard]]
   const std::shared_ptr<ClientTable> &BeforeRemoves() const {
     // Implementation detail: 'beforeRemoves' and 'prev' happen to refer to the same snapshot.
-    return prev_;
+    return Prev();
   }
   /**
    * A RowSequence indicating the indexes of the rows (if any) that were removed in this cycle.
@@ -129,7 +214,9 @@ public:
    * If no rows were removed, then this pointer will compare equal to BeforeRemoves().
    */
   [[nodiscard]]
-  const std::shared_ptr<ClientTable> &AfterRemoves() const { return afterRemoves_; }
+  const std::shared_ptr<ClientTable> &AfterRemoves() const {
+    return onDemandState_->Table(internal::OnDemandState::kAfterRemoves);
+  }
 
   /**
    * A snapshot of the table before any rows were added in this cycle.
@@ -137,7 +224,7 @@ public:
   [[nodiscard]]
   const std::shared_ptr<ClientTable> &BeforeAdds() const {
     // Implementation detail: 'afterRemoves' and 'beforeAdds' happen to refer to the same snapshot.
-    return afterRemoves_;
+    return AfterRemoves();
   }
   /**
    * A RowSequence indicating the indexes of the rows (if any) that were added in this cycle.
@@ -149,7 +236,9 @@ public:
    * If no rows were added, then this pointer will compare equal to BeforeAdds().
    */
   [[nodiscard]]
-  const std::shared_ptr<ClientTable> &AfterAdds() const { return afterAdds_; }
+  const std::shared_ptr<ClientTable> &AfterAdds() const {
+    return onDemandState_->Table(internal::OnDemandState::kAfterAdds);
+  }
 
   /**
    * A snapshot of the table before cells were modified in this cycle.
@@ -157,7 +246,7 @@ public:
   [[nodiscard]]
   const std::shared_ptr<ClientTable> &BeforeModifies() const {
     // Implementation detail: 'afterAdds' and 'beforeModifies' happen to refer to the same snapshot.
-    return afterAdds_;
+    return AfterAdds();
   }
   /**
    * A vector of RowSequences which represents, for each column in the table, the indexes of the
@@ -176,7 +265,9 @@ public:
    * A snapshot of the table after cells (if any) were modified in this cycle.
    */
   [[nodiscard]]
-  const std::shared_ptr<ClientTable> &AfterModifies() const { return afterModifies_; }
+  const std::shared_ptr<ClientTable> &AfterModifies() const {
+    return onDemandState_->Table(internal::OnDemandState::kAfterModifies);
+  }
 
   /**
    * A snapshot of the table after all of the changes in this cycle were applied.
@@ -184,17 +275,37 @@ public:
   [[nodiscard]]
   const std::shared_ptr<ClientTable> &Current() const {
     // Implementation detail: 'afterModifies' and 'current' happen to refer to the same snapshot.
-    return afterModifies_;
+    return AfterModifies();
+  }
+
+  /**
+   * Whether this update comes from a deltas-only subscription.
+   */
+  [[nodiscard]]
+  bool DeltasOnly() const { return deltasOnly_; }
+  /**
+   * Deltas-only subscriptions: a table holding just the rows added in this cycle, in the order of
+   * AddedRows(). Null otherwise.
+   */
+  [[nodiscard]]
+  const std::shared_ptr<ClientTable> &Added() const { return added_; }
+  /**
+   * Deltas-only subscriptions: for each column in the table, the new values of the rows of that
+   * column that were modified in this cycle, in the order of ModifiedRows()[i]. Like
+   * ModifiedRows(), this is empty if nothing was modified. Empty otherwise.
+   */
+  [[nodiscard]]
+  const std::vector<std::shared_ptr<ColumnSource>> &ModifiedColumns() const {
+    return modifiedColumns_;
   }
 
 private:
-  std::shared_ptr<ClientTable> prev_;
   std::shared_ptr<RowSequence> removedRows_;
-  std::shared_ptr<ClientTable> afterRemoves_;
   std::shared_ptr<RowSequence> addedRows_;
-  std::shared_ptr<ClientTable> afterAdds_;
   std::vector<std::shared_ptr<RowSequence>> modifiedRows_;
-  std::shared_ptr<ClientTable> afterModifies_;
+  bool deltasOnly_ = false;
+  std::shared_ptr<ClientTable> added_;
+  std::vector<std::shared_ptr<ColumnSource>> modifiedColumns_;
   std::shared_ptr<internal::OnDemandState> onDemandState_;
 };
 }  // namespace deephaven::dhcore::ticking
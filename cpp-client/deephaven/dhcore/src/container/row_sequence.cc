@@ -3,7 +3,10 @@
  */
 #include "deephaven/dhcore/container/row_sequence.h"
 
+#include <algorithm>
 #include <optional>
+#include <utility>
+#include <vector>
 #include "deephaven/dhcore/utility/utility.h"
 #include "deephaven/third_party/fmt/format.h"
 
@@ -13,23 +16,85 @@ class SequentialRowSequence final : public RowSequence {
 public:
   static std::shared_ptr<SequentialRowSequence> Create(uint64_t begin, uint64_t end);
 
-  SequentialRowSequence(uint64_t begin, uint64_t end) : begin_(begin), end_(end) {}
+  SequentialRowSequence(uint64_t begin, uint64_t end) : interval_(begin, end) {}
 
   [[nodiscard]]
   std::shared_ptr<RowSequence> Take(size_t size) const final;
   [[nodiscard]]
   std::shared_ptr<RowSequence> Drop(size_t size) const final;
   void ForEachInterval(const std::function<void(uint64_t, uint64_t)> &f) const final;
+  [[nodiscard]]
+  bool TryGetIntervalView(IntervalView *result) const final;
 
   [[nodiscard]]
   size_t Size() const final {
-    return end_ - begin_;
+    return interval_.second - interval_.first;
   }
 
 private:
-  uint64_t begin_ = 0;
-  uint64_t end_ = 0;
+  std::pair<uint64_t, uint64_t> interval_;
+};
+
+/**
+ * Sorted, disjoint, nonempty half-open intervals, plus prefix sums: prefix_[i] is the number of
+ * keys in intervals_[0..i), so prefix_ has one more entry than intervals_. Shared (immutably) by
+ * all the IntervalArrayRowSequences that are slices of it.
+ */
+struct IntervalArray {
+  explicit IntervalArray(std::vector<std::pair<uint64_t, uint64_t>> intervals);
+
+  /**
+   * The index of the interval containing the key at 'position', which must be < prefix_.back().
+   */
+  [[nodiscard]]
+  size_t IntervalAt(uint64_t position) const {
+    return std::upper_bound(prefix_.begin(), prefix_.end(), position) - prefix_.begin() - 1;
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> intervals_;
+  std::vector<uint64_t> prefix_;
 };
+
+/**
+ * A slice of an IntervalArray: 'size_' keys starting at the key 'entryOffset_' keys into
+ * intervals_[beginIndex_]. Take is O(1) and Drop is O(log n) in the number of intervals.
+ */
+class IntervalArrayRowSequence final : public RowSequence {
+public:
+  IntervalArrayRowSequence(std::shared_ptr<const IntervalArray> array, size_t begin_index,
+      uint64_t entry_offset, size_t size);
+  ~IntervalArrayRowSequence() final = default;
+
+  [[nodiscard]]
+  std::shared_ptr<RowSequence> Take(size_t size) const final;
+  [[nodiscard]]
+  std::shared_ptr<RowSequence> Drop(size_t size) const final;
+
+  void ForEachInterval(const std::function<void(uint64_t begin_key, uint64_t end_key)> &f) const final;
+  [[nodiscard]]
+  bool TryGetIntervalView(IntervalView *result) const final;
+
+  [[nodiscard]]
+  size_t Size() const final {
+    return size_;
+  }
+
+private:
+  std::shared_ptr<const IntervalArray> array_;
+  size_t beginIndex_ = 0;
+  uint64_t entryOffset_ = 0;
+  size_t size_ = 0;
+};
+
+std::shared_ptr<RowSequence> MakeIntervalArrayRowSequence(
+    std::vector<std::pair<uint64_t, uint64_t>> intervals) {
+  if (intervals.empty()) {
+    return RowSequence::CreateEmpty();
+  }
+  auto array = std::make_shared<const IntervalArray>(std::move(intervals));
+  auto size = array->prefix_.back();
+  return std::make_shared<IntervalArrayRowSequence>(std::move(array), 0, 0, size);
+}
 }  // namespace
 
 std::shared_ptr<RowSequence> RowSequence::CreateEmpty() {
@@ -40,16 +105,33 @@ std::shared_ptr<RowSequence> RowSequence::CreateSequential(uint64_t begin, uint6
   return SequentialRowSequence::Create(begin, end);
 }
 
+std::shared_ptr<RowSequence> RowSequence::CreateFromIntervals(
+    std::vector<std::pair<uint64_t, uint64_t>> intervals) {
+  for (size_t i = 0; i != intervals.size(); ++i) {
+    const auto &[begin, end] = intervals[i];
+    if (begin >= end || (i != 0 && begin < intervals[i - 1].second)) {
+      auto message = fmt::format("Interval {} [{},{}) is empty, out of order, or overlapping", i,
+          begin, end);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+  }
+  return MakeIntervalArrayRowSequence(std::move(intervals));
+}
+
 RowSequence::~RowSequence() = default;
 
 RowSequenceIterator RowSequence::GetRowSequenceIterator() const {
   return RowSequenceIterator(Drop(0));
 }
 
+bool RowSequence::TryGetIntervalView(IntervalView */*result*/) const {
+  return false;
+}
+
 std::ostream &operator<<(std::ostream &s, const RowSequence &o) {
   s << '[';
   const char *sep = "";
-  o.ForEachInterval([&](uint64_t start, uint64_t end) {
+  o.ForEachIntervalInline([&](uint64_t start, uint64_t end) {
     s << sep;
     sep = ", ";
     s << '[' << start << ',' << end << ')';
@@ -95,38 +177,9 @@ void RowSequenceIterator::RefillRanges() {
   auto add_range = [this](uint64_t begin_key, uint64_t end_key) {
     ranges_.emplace_back(begin_key, end_key);
   };
-  this_chunk->ForEachInterval(add_range);
+  this_chunk->ForEachIntervalInline(add_range);
 }
 
-namespace {
-class MyRowSequence final : public RowSequence {
-  // begin->end
-  using ranges_t = std::map<uint64_t, uint64_t>;
-public:
-  MyRowSequence(std::shared_ptr<ranges_t> ranges, ranges_t::const_iterator beginp,
-      size_t entry_offset, size_t size);
-  ~MyRowSequence() final = default;
-
-  [[nodiscard]]
-  std::shared_ptr<RowSequence> Take(size_t size) const final;
-  [[nodiscard]]
-  std::shared_ptr<RowSequence> Drop(size_t size) const final;
-
-  void ForEachInterval(const std::function<void(uint64_t begin_key, uint64_t end_key)> &f) const final;
-
-  [[nodiscard]]
-  size_t Size() const final {
-    return size_;
-  }
-
-private:
-  std::shared_ptr<ranges_t> ranges_;
-  ranges_t::const_iterator beginp_;
-  size_t entryOffset_ = 0;
-  size_t size_ = 0;
-};
-} // namespace
-
 RowSequenceBuilder::RowSequenceBuilder() = default;
 RowSequenceBuilder::~RowSequenceBuilder() = default;
 
@@ -140,108 +193,91 @@ void RowSequenceBuilder::AddInterval(uint64_t begin, uint64_t end) {
     return;
   }
 
-  // ip points to the first element greater than begin, or it is end()
-  auto ip = ranges_.upper_bound(begin);
-
-  // Reusable storage for the node we will ultimately insert.
-  ranges_t::node_type node;
-
-  // The start point `begin` might fall inside an existing interval, or it might be outside all
-  // intervals. If it's inside any interval, it will be the one just prior to ip.
-  if (ip != ranges_.begin()) {
-    auto prev_ip = std::prev(ip);
-    if (begin <= prev_ip->second) {
-      // Remove that interval from the map (but, reuse its storage later) and extend the range
-      // we are inserting to include the start of the interval.
-      begin = prev_ip->first;
-      size_ -= prev_ip->second - prev_ip->first;
-      node = ranges_.extract(prev_ip);
+  if (!ranges_.empty() && begin >= ranges_.back().first) {
+    auto &last = ranges_.back();
+    if (begin <= last.second) {
+      // Overlaps or abuts the last interval, so extend it.
+      last.second = std::max(last.second, end);
+      return;
     }
+    // Strictly after the last interval. The vector stays sorted.
+    ranges_.emplace_back(begin, end);
+    return;
   }
 
-  // Now 'begin' is not inside any existing interval. Determine what to do about 'end' by repeating
-  // the below:
-  // 1. If it falls short of the next interval, we are done
-  // 2. If it falls inside the next interval, remove that interval and extend 'end' to the end of
-  //    that interval, and repeat
-  // 3. If it falls past the end of the next interval, remove that interval, and repeat
-  while (ip != ranges_.end() && end >= ip->first) {
-    end = std::max(end, ip->second);
-    auto temp = ip++;
-    size_ -= temp->second - temp->first;
-    node = ranges_.extract(temp);
-  }
-
-  // Now we can insert 'node' into the map, reusing existing storage if possible.
-  if (node.empty()) {
-    // We were not able to reuse any nodes
-    ranges_.insert(std::make_pair(begin, end));
-  } else {
-    // We were able to reuse one node.
-    node.key() = begin;
-    node.mapped() = end;
-    ranges_.insert(std::move(node));
-  }
-  size_ += end - begin;
+  // Either the first interval, or one that starts before the last one. The latter means we need
+  // to sort and merge in Build().
+  needs_normalizing_ = needs_normalizing_ || !ranges_.empty();
+  ranges_.emplace_back(begin, end);
 }
 
 std::shared_ptr<RowSequence> RowSequenceBuilder::Build() {
-  auto sp = std::make_shared<ranges_t>(std::move(ranges_));
-  auto begin = sp->begin();
-  return std::make_shared<MyRowSequence>(std::move(sp), begin, 0, size_);
+  auto ranges = std::move(ranges_);
+  ranges_.clear();
+  if (needs_normalizing_) {
+    needs_normalizing_ = false;
+    std::sort(ranges.begin(), ranges.end());
+    // Merge overlapping or abutting intervals in place.
+    size_t dest = 0;
+    for (size_t src = 1; src < ranges.size(); ++src) {
+      if (ranges[src].first <= ranges[dest].second) {
+        ranges[dest].second = std::max(ranges[dest].second, ranges[src].second);
+      } else {
+        ranges[++dest] = ranges[src];
+      }
+    }
+    ranges.resize(dest + 1);
+  }
+  return MakeIntervalArrayRowSequence(std::move(ranges));
 }
 
 namespace {
-MyRowSequence::MyRowSequence(std::shared_ptr<ranges_t> ranges, ranges_t::const_iterator beginp,
-    size_t entry_offset, size_t size) : ranges_(std::move(ranges)), beginp_(beginp),
-    entryOffset_(entry_offset), size_(size) {}
-
-std::shared_ptr<RowSequence> MyRowSequence::Take(size_t size) const {
-  auto new_size = std::min(size, size_);
-  return std::make_shared<MyRowSequence>(ranges_, beginp_, entryOffset_, new_size);
+IntervalArray::IntervalArray(std::vector<std::pair<uint64_t, uint64_t>> intervals) :
+    intervals_(std::move(intervals)) {
+  prefix_.reserve(intervals_.size() + 1);
+  uint64_t total = 0;
+  prefix_.push_back(total);
+  for (const auto &[begin, end] : intervals_) {
+    total += end - begin;
+    prefix_.push_back(total);
+  }
 }
 
-std::shared_ptr<RowSequence> MyRowSequence::Drop(size_t size) const {
-  auto current = beginp_;
-  auto current_offset = entryOffset_;
-  auto size_to_drop = std::min(size, size_);
-  auto new_size = size_ - size_to_drop;
-  while (size_to_drop != 0) {
-    auto entry_size = current->second - current->first;
-    if (current_offset == entry_size) {
-      ++current;
-      current_offset = 0;
-      continue;
-    }
-    auto entry_remaining = entry_size - current_offset;
-    auto amount_to_consume = std::min(entry_remaining, size_to_drop);
-    current_offset += amount_to_consume;
-    size_to_drop -= amount_to_consume;
+IntervalArrayRowSequence::IntervalArrayRowSequence(std::shared_ptr<const IntervalArray> array,
+    size_t begin_index, uint64_t entry_offset, size_t size) : array_(std::move(array)),
+    beginIndex_(begin_index), entryOffset_(entry_offset), size_(size) {}
+
+std::shared_ptr<RowSequence> IntervalArrayRowSequence::Take(size_t size) const {
+  if (size >= size_) {
+    return std::make_shared<IntervalArrayRowSequence>(*this);
   }
-  return std::make_shared<MyRowSequence>(ranges_, current, current_offset, new_size);
+  return std::make_shared<IntervalArrayRowSequence>(array_, beginIndex_, entryOffset_, size);
 }
 
-void MyRowSequence::ForEachInterval(const std::function<void(uint64_t begin_key, uint64_t end_key)> &f)
-    const {
-  // The code is similar to "drop"
-  auto current = beginp_;
-  auto current_offset = entryOffset_;
-  auto remaining = size_;
-  while (remaining != 0) {
-    auto entry_size = current->second - current->first;
-    if (current_offset == entry_size) {
-      ++current;
-      current_offset = 0;
-      continue;
-    }
-    auto entry_remaining = entry_size - current_offset;
-    auto amount_to_consume = std::min(entry_remaining, remaining);
-    auto begin = current->first + current_offset;
-    auto end = begin + amount_to_consume;
-    current_offset += amount_to_consume;
-    remaining -= amount_to_consume;
-    f(begin, end);
+std::shared_ptr<RowSequence> IntervalArrayRowSequence::Drop(size_t size) const {
+  if (size >= size_) {
+    return RowSequence::CreateEmpty();
   }
+  // Translate to a position in the whole array and look it up in the prefix sums.
+  auto position = array_->prefix_[beginIndex_] + entryOffset_ + size;
+  auto index = array_->IntervalAt(position);
+  auto offset = position - array_->prefix_[index];
+  return std::make_shared<IntervalArrayRowSequence>(array_, index, offset, size_ - size);
+}
+
+void IntervalArrayRowSequence::ForEachInterval(
+    const std::function<void(uint64_t begin_key, uint64_t end_key)> &f) const {
+  IntervalView view;
+  (void)TryGetIntervalView(&view);
+  view.ForEach(f);
+}
+
+bool IntervalArrayRowSequence::TryGetIntervalView(IntervalView *result) const {
+  result->intervals_ = array_->intervals_.data() + beginIndex_;
+  result->num_intervals_ = array_->intervals_.size() - beginIndex_;
+  result->first_offset_ = entryOffset_;
+  result->size_ = size_;
+  return true;
 }
 
 std::shared_ptr<SequentialRowSequence> SequentialRowSequence::Create(uint64_t begin, uint64_t end) {
@@ -250,19 +286,27 @@ std::shared_ptr<SequentialRowSequence> SequentialRowSequence::Create(uint64_t be
 
 std::shared_ptr<RowSequence> SequentialRowSequence::Take(size_t size) const {
   auto size_to_use = std::min(size, this->Size());
-  return Create(begin_, begin_ + size_to_use);
+  return Create(interval_.first, interval_.first + size_to_use);
 }
 
 std::shared_ptr<RowSequence> SequentialRowSequence::Drop(size_t size) const {
   auto size_to_use = std::min(size, this->Size());
-  return Create(begin_ + size_to_use, end_);
+  return Create(interval_.first + size_to_use, interval_.second);
 }
 
 void SequentialRowSequence::ForEachInterval(const std::function<void(uint64_t, uint64_t)> &f) const {
-  if (begin_ == end_) {
+  if (interval_.first == interval_.second) {
     return;
   }
-  f(begin_, end_);
+  f(interval_.first, interval_.second);
+}
+
+bool SequentialRowSequence::TryGetIntervalView(IntervalView *result) const {
+  result->intervals_ = &interval_;
+  result->num_intervals_ = 1;
+  result->first_offset_ = 0;
+  result->size_ = Size();
+  return true;
 }
 }  // namespace
 }  // namespace deephaven::client::container
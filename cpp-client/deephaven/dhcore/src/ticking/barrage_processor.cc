@@ -3,8 +3,10 @@
  */
 #include "deephaven/dhcore/ticking/barrage_processor.h"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -14,6 +16,8 @@
 #include "deephaven/dhcore/utility/utility.h"
 #include "deephaven/dhcore/container/row_sequence.h"
 #include "deephaven/dhcore/ticking/ticking.h"
+#include "deephaven/dhcore/ticking/column_worker_pool.h"
+#include "deephaven/dhcore/ticking/delta_table_state.h"
 #include "deephaven/dhcore/ticking/immer_table_state.h"
 #include "deephaven/dhcore/ticking/index_decoder.h"
 #include "deephaven/flatbuf/Barrage_generated.h"
@@ -38,8 +42,9 @@ using io::deephaven::barrage::flatbuf::BarrageMessageType;
 using io::deephaven::barrage::flatbuf::BarrageMessageWrapper;
 using io::deephaven::barrage::flatbuf::BarrageModColumnMetadata;
 using io::deephaven::barrage::flatbuf::BarrageUpdateMetadata;
-using io::deephaven::barrage::flatbuf::ColumnConversionMode;
 using io::deephaven::barrage::flatbuf::CreateBarrageMessageWrapper;
+using io::deephaven::barrage::flatbuf::CreateBarrageSnapshotOptions;
+using io::deephaven::barrage::flatbuf::CreateBarrageSnapshotRequest;
 using io::deephaven::barrage::flatbuf::CreateBarrageSubscriptionOptions;
 using io::deephaven::barrage::flatbuf::CreateBarrageSubscriptionRequest;
 
@@ -63,11 +68,43 @@ public:
       size_t metadata_size);
 
   [[nodiscard]]
-  std::tuple<std::shared_ptr<ClientTable>, std::shared_ptr<RowSequence>, std::shared_ptr<ClientTable>>
-  ProcessRemoves(const RowSequence &removed_rows);
+  std::tuple<LazyTable, std::shared_ptr<RowSequence>, LazyTable>
+  ProcessRemoves(std::shared_ptr<RowSequence> removed_rows);
+
+  void SetViewportMode(const flatbuffers::Vector<int8_t> *effective_viewport);
+
+  [[nodiscard]]
+  bool IsViewport() const {
+    return viewport_mode_.value_or(false);
+  }
+
+  [[nodiscard]]
+  bool IsSubscribed(size_t col_num) const {
+    return deltas_only_ ? delta_state_.IsSubscribed(col_num) : table_state_.IsSubscribed(col_num);
+  }
 
   size_t num_cols_ = 0;
   ImmerTableState table_state_;
+  /**
+   * If set, we keep no table. table_state_ stays empty and the data of each update is collected
+   * in delta_state_ instead.
+   */
+  bool deltas_only_ = false;
+  DeltaTableState delta_state_;
+
+  /**
+   * Set if we are processing the reply to a BarrageSnapshotRequest rather than a subscription.
+   * That reply describes its rows by key even when the request has a viewport, and its data
+   * follows added_rows_included (the rows of added_rows that are inside the viewport).
+   */
+  bool snapshot_request_ = false;
+  /**
+   * Whether this is a viewport subscription, as learned from the first snapshot (and unset until
+   * then). The server doesn't let a subscription change between the two. In a viewport
+   * subscription table_state_ holds just the rows in the viewport, and the server describes the
+   * removed, added, and modified rows by their positions in it. It never sends shifts.
+   */
+  std::optional<bool> viewport_mode_;
 };
 
 class AwaitingAdds final {
@@ -76,9 +113,9 @@ public:
   ~AwaitingAdds();
 
   void Init(std::vector<std::shared_ptr<RowSequence>> per_column_modifies,
-      std::shared_ptr<ClientTable> prev,
+      LazyTable prev,
       std::shared_ptr<RowSequence> removed_rows_index_space,
-      std::shared_ptr<ClientTable> after_removes,
+      LazyTable after_removes,
       std::shared_ptr<RowSequence> added_rows_index_space);
 
   [[nodiscard]]
@@ -92,9 +129,9 @@ public:
   bool first_time_ = true;
 
   std::vector<std::shared_ptr<RowSequence>> per_column_modifies_;
-  std::shared_ptr<ClientTable> prev_;
+  LazyTable prev_;
   std::shared_ptr<RowSequence> removed_rows_index_space_;
-  std::shared_ptr<ClientTable> after_removes_;
+  LazyTable after_removes_;
   std::shared_ptr<RowSequence> added_rows_index_space_;
 
   std::shared_ptr<RowSequence> added_rows_remaining_;
@@ -105,7 +142,7 @@ public:
   AwaitingModifies();
   ~AwaitingModifies();
 
-  void Init(std::shared_ptr<ClientTable> after_adds);
+  void Init(LazyTable after_adds);
 
   [[nodiscard]]
   std::optional<TickingUpdate> ProcessNextChunk(BarrageProcessorImpl *owner,
@@ -117,7 +154,7 @@ public:
 
   bool first_time_ = true;
 
-  std::shared_ptr<ClientTable> after_adds_;
+  LazyTable after_adds_;
   std::vector<std::shared_ptr<RowSequence>> modified_rows_remaining_;
   std::vector<std::shared_ptr<RowSequence>> modified_rows_index_space_;
 };
@@ -127,7 +164,7 @@ public:
   BuildingResult();
   ~BuildingResult();
 
-  void Init(std::shared_ptr<ClientTable> after_modifies);
+  void Init(LazyTable after_modifies);
 
   [[nodiscard]]
   std::optional<TickingUpdate> ProcessNextChunk(BarrageProcessorImpl *owner,
@@ -137,18 +174,29 @@ public:
 
   void Reset();
 
-  std::shared_ptr<ClientTable> afterModifies_;
+  LazyTable afterModifies_;
 };
 
 bool AllEmpty(const std::vector<std::shared_ptr<RowSequence>> &row_sequences);
 void AssertAllSame(size_t val0, size_t val1, size_t val2);
+std::vector<int8_t> EncodeColumnSet(const std::vector<size_t> &column_indices);
+std::vector<bool> DecodeColumnSet(const flatbuffers::Vector<int8_t> &column_set, size_t num_cols);
+flatbuffers::Offset<flatbuffers::Vector<int8_t>> MaybeEncodeColumnSet(
+    flatbuffers::FlatBufferBuilder *builder, const std::vector<size_t> *column_indices);
+flatbuffers::Offset<flatbuffers::Vector<int8_t>> MaybeEncodeViewport(
+    flatbuffers::FlatBufferBuilder *builder, const RowSequence *viewport);
+std::vector<uint8_t> WrapPayload(BarrageMessageType message_type,
+    const flatbuffers::FlatBufferBuilder &payload_builder);
+std::shared_ptr<RowSequence> DecodeIndex(const flatbuffers::Vector<int8_t> *index);
 }  // namespace
 
 class BarrageProcessorImpl final {
 public:
-  explicit BarrageProcessorImpl(std::shared_ptr<Schema> schema);
+  BarrageProcessorImpl(std::shared_ptr<Schema> schema, const SubscriptionOptions &options);
   ~BarrageProcessorImpl();
 
+  // Null when updates are applied serially.
+  std::shared_ptr<ColumnWorkerPool> column_worker_pool_;
   State state_ = State::kAwaitingMetadata;
   AwaitingMetadata awaitingMetadata_;
   AwaitingAdds awaitingAdds_;
@@ -165,44 +213,79 @@ public:
 BarrageProcessor::BarrageProcessor() = default;
 BarrageProcessor::BarrageProcessor(BarrageProcessor &&other) noexcept = default;
 BarrageProcessor &BarrageProcessor::operator=(BarrageProcessor &&other) noexcept = default;
-BarrageProcessor::BarrageProcessor(std::shared_ptr<Schema> schema) {
-  impl_ = std::make_unique<internal::BarrageProcessorImpl>(std::move(schema));
+BarrageProcessor::BarrageProcessor(std::shared_ptr<Schema> schema) :
+    BarrageProcessor(std::move(schema), SubscriptionOptions()) {}
+BarrageProcessor::BarrageProcessor(std::shared_ptr<Schema> schema,
+    const SubscriptionOptions &options) {
+  impl_ = std::make_unique<internal::BarrageProcessorImpl>(std::move(schema), options);
 }
 BarrageProcessor::~BarrageProcessor() = default;
 
+BarrageProcessor BarrageProcessor::ForSnapshot(std::shared_ptr<Schema> schema) {
+  // A snapshot only ever appends, so there is no need to copy the data out of the Arrow batches.
+  BarrageProcessor result(std::move(schema), SubscriptionOptions().SetZeroCopyAppends(true));
+  result.impl_->awaitingMetadata_.snapshot_request_ = true;
+  return result;
+}
+
 std::vector<uint8_t> BarrageProcessor::CreateSubscriptionRequest(const void *ticket_bytes, size_t size) {
+  return CreateSubscriptionRequest(ticket_bytes, size, nullptr, nullptr, false,
+      SubscriptionOptions());
+}
+
+std::vector<uint8_t> BarrageProcessor::CreateSubscriptionRequest(const void *ticket_bytes, size_t size,
+    const std::vector<size_t> *column_indices, const RowSequence *viewport, bool reverse_viewport,
+    const SubscriptionOptions &options) {
   // Make a BarrageMessageWrapper
   // ...Whose payload is a BarrageSubscriptionRequest
   // ......which has BarrageSubscriptionOptions
   flatbuffers::FlatBufferBuilder payload_builder(4096);
 
   auto sub_options = CreateBarrageSubscriptionOptions(payload_builder,
-      ColumnConversionMode::ColumnConversionMode_Stringify, true, 0, 4096, 0, true);
+      static_cast<io::deephaven::barrage::flatbuf::ColumnConversionMode>(
+          options.GetColumnConversionMode()), true,
+      options.MinUpdateIntervalMs(), options.BatchSize(), options.MaxMessageSize(), true);
 
   auto ticket = payload_builder.CreateVector(static_cast<const int8_t*>(ticket_bytes), size);
-  auto subreq = CreateBarrageSubscriptionRequest(payload_builder, ticket, {}, {}, sub_options);
+  auto columns_offset = internal::MaybeEncodeColumnSet(&payload_builder, column_indices);
+  auto viewport_offset = internal::MaybeEncodeViewport(&payload_builder, viewport);
+  auto subreq = CreateBarrageSubscriptionRequest(payload_builder, ticket, columns_offset,
+      viewport_offset, sub_options, reverse_viewport);
   payload_builder.Finish(subreq);
-  // TODO(kosak): fix sad cast
-  const auto *payloadp = static_cast<int8_t*>(static_cast<void*>(payload_builder.GetBufferPointer()));
-  const auto payload_size = payload_builder.GetSize();
+  return internal::WrapPayload(BarrageMessageType::BarrageMessageType_BarrageSubscriptionRequest,
+      payload_builder);
+}
 
-  // TODO(kosak): I'd really like to just point this buffer backwards to the thing I just created, rather
-  // then copying it. But, eh, version 2.
-  flatbuffers::FlatBufferBuilder wrapper_builder(4096);
-  auto payload = wrapper_builder.CreateVector(payloadp, payload_size);
-  auto message_wrapper = CreateBarrageMessageWrapper(wrapper_builder, kDeephavenMagicNumber,
-      BarrageMessageType::BarrageMessageType_BarrageSubscriptionRequest, payload);
-  wrapper_builder.Finish(message_wrapper);
-  auto wrapper_buffer = wrapper_builder.Release();
+std::vector<uint8_t> BarrageProcessor::CreateSnapshotRequest(const void *ticket_bytes, size_t size,
+    const std::vector<size_t> *column_indices, const RowSequence *viewport, bool reverse_viewport,
+    const SubscriptionOptions &options) {
+  // Make a BarrageMessageWrapper
+  // ...Whose payload is a BarrageSnapshotRequest
+  // ......which has BarrageSnapshotOptions
+  flatbuffers::FlatBufferBuilder payload_builder(4096);
 
-  std::vector<uint8_t> result;
-  result.resize(wrapper_buffer.size());
-  memcpy(result.data(), wrapper_buffer.data(), wrapper_buffer.size());
-  return result;
+  auto snapshot_options = CreateBarrageSnapshotOptions(payload_builder,
+      static_cast<io::deephaven::barrage::flatbuf::ColumnConversionMode>(
+          options.GetColumnConversionMode()), true,
+      options.BatchSize(), options.MaxMessageSize());
+
+  auto ticket = payload_builder.CreateVector(static_cast<const int8_t*>(ticket_bytes), size);
+  auto columns_offset = internal::MaybeEncodeColumnSet(&payload_builder, column_indices);
+  auto viewport_offset = internal::MaybeEncodeViewport(&payload_builder, viewport);
+  auto snapreq = CreateBarrageSnapshotRequest(payload_builder, ticket, columns_offset,
+      viewport_offset, snapshot_options, reverse_viewport);
+  payload_builder.Finish(snapreq);
+  return internal::WrapPayload(BarrageMessageType::BarrageMessageType_BarrageSnapshotRequest,
+      payload_builder);
 }
 
 std::string BarrageProcessor::CreateSubscriptionRequestCython(const void *ticket_bytes, size_t size) {
-  auto vec = CreateSubscriptionRequest(ticket_bytes, size);
+  return CreateSubscriptionRequestCython(ticket_bytes, size, SubscriptionOptions());
+}
+
+std::string BarrageProcessor::CreateSubscriptionRequestCython(const void *ticket_bytes, size_t size,
+    const SubscriptionOptions &options) {
+  auto vec = CreateSubscriptionRequest(ticket_bytes, size, nullptr, nullptr, false, options);
   std::string result;
   result.reserve(vec.size());
   for (auto ch : vec) {
@@ -219,8 +302,20 @@ std::optional<TickingUpdate> BarrageProcessor::ProcessNextChunk(
 }
 
 namespace internal {
-BarrageProcessorImpl::BarrageProcessorImpl(std::shared_ptr<Schema> schema) : state_(State::kAwaitingMetadata),
-    awaitingMetadata_(std::move(schema)) {}
+BarrageProcessorImpl::BarrageProcessorImpl(std::shared_ptr<Schema> schema,
+    const SubscriptionOptions &options) : state_(State::kAwaitingMetadata),
+    awaitingMetadata_(std::move(schema)) {
+  auto column_parallelism = static_cast<size_t>(options.ColumnParallelism());
+  if (column_parallelism > 1) {
+    column_worker_pool_ = ColumnWorkerPool::Create(column_parallelism);
+    awaitingMetadata_.table_state_.SetColumnWorkerPool(column_worker_pool_);
+  }
+  if (options.DeltasOnly()) {
+    awaitingMetadata_.deltas_only_ = true;
+  } else if (options.ZeroCopyAppends()) {
+    awaitingMetadata_.table_state_.SetZeroCopyAppends(true);
+  }
+}
 BarrageProcessorImpl::~BarrageProcessorImpl() = default;
 
 std::optional<TickingUpdate>
@@ -244,7 +339,7 @@ BarrageProcessorImpl::ProcessNextChunk(const std::vector<std::shared_ptr<ColumnS
 
 namespace {
 AwaitingMetadata::AwaitingMetadata(std::shared_ptr<Schema> schema) : num_cols_(schema->NumCols()),
-    table_state_(std::move(schema)) {
+    table_state_(schema), delta_state_(std::move(schema)) {
 }
 AwaitingMetadata::~AwaitingMetadata() = default;
 
@@ -276,15 +371,43 @@ std::optional<TickingUpdate> AwaitingMetadata::ProcessNextChunk(BarrageProcessor
   const auto *bmw_raw = barrage_wrapper->msg_payload()->data();
   const auto *bmd = flatbuffers::GetRoot<BarrageUpdateMetadata>(bmw_raw);
 
-  DataInput di_removed(*bmd->removed_rows());
-  DataInput di_three_shift_indices(*bmd->shift_data());
-  DataInput di_added(*bmd->added_rows());
+  // The server leaves out the index fields it has nothing to put in. For example, it never sends
+  // shift_data in a viewport subscription. DecodeIndex treats a missing field as empty.
+  auto removed_rows = DecodeIndex(bmd->removed_rows());
+  auto added_rows = DecodeIndex(bmd->added_rows());
+  std::shared_ptr<RowSequence> shift_start_index;
+  std::shared_ptr<RowSequence> shift_end_index;
+  std::shared_ptr<RowSequence> shift_dest_index;
+  if (const auto *shift_data = bmd->shift_data(); shift_data != nullptr && shift_data->size() != 0) {
+    DataInput di_three_shift_indices(*shift_data);
+    shift_start_index = IndexDecoder::ReadExternalCompressedDelta(&di_three_shift_indices);
+    shift_end_index = IndexDecoder::ReadExternalCompressedDelta(&di_three_shift_indices);
+    shift_dest_index = IndexDecoder::ReadExternalCompressedDelta(&di_three_shift_indices);
+  } else {
+    shift_start_index = RowSequence::CreateEmpty();
+    shift_end_index = shift_start_index;
+    shift_dest_index = shift_start_index;
+  }
 
-  auto removed_rows = IndexDecoder::ReadExternalCompressedDelta(&di_removed);
-  auto shift_start_index = IndexDecoder::ReadExternalCompressedDelta(&di_three_shift_indices);
-  auto shift_end_index = IndexDecoder::ReadExternalCompressedDelta(&di_three_shift_indices);
-  auto shift_dest_index = IndexDecoder::ReadExternalCompressedDelta(&di_three_shift_indices);
-  auto added_rows = IndexDecoder::ReadExternalCompressedDelta(&di_added);
+  if (snapshot_request_) {
+    if (const auto *included = bmd->added_rows_included(); included != nullptr) {
+      added_rows = DecodeIndex(included);
+    }
+  }
+
+  if (bmd->is_snapshot()) {
+    if (!snapshot_request_) {
+      SetViewportMode(bmd->effective_viewport());
+    }
+    if (const auto *column_set = bmd->effective_column_set(); column_set != nullptr && column_set->size() != 0) {
+      auto subscribed = DecodeColumnSet(*column_set, num_cols_);
+      if (deltas_only_) {
+        delta_state_.SetSubscribedColumns(subscribed);
+      } else {
+        table_state_.SetSubscribedColumns(subscribed);
+      }
+    }
+  }
 
   // Disabled because it's too verbose
   if (false) {
@@ -292,15 +415,30 @@ std::optional<TickingUpdate> AwaitingMetadata::ProcessNextChunk(BarrageProcessor
         *shift_start_index, *shift_end_index, *shift_dest_index);
   }
 
-  const auto &mod_column_nodes = *bmd->mod_column_nodes();
-
   std::vector<std::shared_ptr<RowSequence>> per_column_modifies;
-  per_column_modifies.reserve(mod_column_nodes.size());
-  for (flatbuffers::uoffset_t i = 0; i < mod_column_nodes.size(); ++i) {
-    const auto &elt = mod_column_nodes.Get(i);
-    DataInput di_modified(*elt->modified_rows());
-    auto mod_rows = IndexDecoder::ReadExternalCompressedDelta(&di_modified);
-    per_column_modifies.push_back(std::move(mod_rows));
+  if (const auto *mod_column_nodes = bmd->mod_column_nodes(); mod_column_nodes != nullptr) {
+    per_column_modifies.reserve(mod_column_nodes->size());
+    for (flatbuffers::uoffset_t i = 0; i < mod_column_nodes->size(); ++i) {
+      per_column_modifies.push_back(DecodeIndex(mod_column_nodes->Get(i)->modified_rows()));
+    }
+  }
+  // AwaitingModifies expects an entry for every column, and the server may leave out
+  // mod_column_nodes altogether when nothing was modified.
+  while (per_column_modifies.size() < num_cols_) {
+    per_column_modifies.push_back(RowSequence::CreateEmpty());
+  }
+
+  if (deltas_only_) {
+    // There is no table to remove rows from or shift, so just pass the keys on.
+    owner->state_ = State::kAwaitingAdds;
+    owner->awaitingAdds_.Init(std::move(per_column_modifies), LazyTable(), std::move(removed_rows),
+        LazyTable(), std::move(added_rows));
+    return owner->awaitingAdds_.ProcessNextChunk(owner, sources, begins, ends, nullptr, 0);
+  }
+
+  if (IsViewport() && !shift_start_index->Empty()) {
+    const char *message = "The server sent shifts in a viewport subscription";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
   }
 
   // Correct order to process Barrage info is:
@@ -310,10 +448,17 @@ std::optional<TickingUpdate> AwaitingMetadata::ProcessNextChunk(BarrageProcessor
   // 4. modifies
   // We have not called with add or modify data yet, but we can do removes and shifts now
   // (steps 1 and 2).
-  auto [prev, removedRowsIndexSpace, afterRemoves] = ProcessRemoves(*removed_rows);
-  table_state_.ApplyShifts(*shift_start_index, *shift_end_index, *shift_dest_index);
+  auto [prev, removedRowsIndexSpace, afterRemoves] = ProcessRemoves(std::move(removed_rows));
 
-  auto added_rows_index_space = table_state_.AddKeys(*added_rows);
+  std::shared_ptr<RowSequence> added_rows_index_space;
+  if (IsViewport()) {
+    // The added rows are already positions in the table as it will be after the adds.
+    table_state_.AddPositions(*added_rows);
+    added_rows_index_space = std::move(added_rows);
+  } else {
+    table_state_.ApplyShifts(*shift_start_index, *shift_end_index, *shift_dest_index);
+    added_rows_index_space = table_state_.AddKeys(*added_rows);
+  }
 
   owner->state_ = State::kAwaitingAdds;
   owner->awaitingAdds_.Init(std::move(per_column_modifies), std::move(prev),
@@ -322,23 +467,41 @@ std::optional<TickingUpdate> AwaitingMetadata::ProcessNextChunk(BarrageProcessor
   return owner->awaitingAdds_.ProcessNextChunk(owner, sources, begins, ends, nullptr, 0);
 }
 
-std::tuple<std::shared_ptr<ClientTable>, std::shared_ptr<RowSequence>, std::shared_ptr<ClientTable>>
-AwaitingMetadata::ProcessRemoves(const RowSequence &removed_rows) {
-  auto prev = table_state_.Snapshot();
+std::tuple<LazyTable, std::shared_ptr<RowSequence>, LazyTable>
+AwaitingMetadata::ProcessRemoves(std::shared_ptr<RowSequence> removed_rows) {
+  auto prev = table_state_.LazySnapshot();
   // The reason we special-case "empty" is because when the tables are unchanged, we prefer
   // to indicate this via pointer equality (e.g. beforeRemoves == afterRemoves).
   std::shared_ptr<RowSequence> removed_rows_index_space;
-  std::shared_ptr<ClientTable> after_removes;
-  if (removed_rows.Empty()) {
+  LazyTable after_removes;
+  if (removed_rows->Empty()) {
     removed_rows_index_space = RowSequence::CreateEmpty();
     after_removes = prev;
   } else {
-    removed_rows_index_space = table_state_.Erase(removed_rows);
-    after_removes = table_state_.Snapshot();
+    if (IsViewport()) {
+      // The removed rows are already positions in the table as it was before the update.
+      table_state_.ErasePositions(*removed_rows);
+      removed_rows_index_space = std::move(removed_rows);
+    } else {
+      removed_rows_index_space = table_state_.Erase(*removed_rows);
+    }
+    after_removes = table_state_.LazySnapshot();
   }
   return {std::move(prev), std::move(removed_rows_index_space), std::move(after_removes)};
 }
 
+void AwaitingMetadata::SetViewportMode(const flatbuffers::Vector<int8_t> *effective_viewport) {
+  auto viewport = effective_viewport != nullptr && effective_viewport->size() != 0;
+  if (viewport_mode_.has_value() && *viewport_mode_ != viewport) {
+    auto message = fmt::format("The server changed this subscription from {} to {}, but a "
+        "subscription can't change between the two",
+        *viewport_mode_ ? "a viewport" : "the whole table",
+        viewport ? "a viewport" : "the whole table");
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  viewport_mode_ = viewport;
+}
+
 AwaitingAdds::AwaitingAdds() = default;
 AwaitingAdds::~AwaitingAdds() = default;
 
@@ -346,8 +509,8 @@ void AwaitingAdds::Reset() {
   *this = AwaitingAdds();
 }
 
-void AwaitingAdds::Init(std::vector<std::shared_ptr<RowSequence>> per_column_modifies, std::shared_ptr<ClientTable> prev,
-    std::shared_ptr<RowSequence> removed_rows_index_space, std::shared_ptr<ClientTable> after_removes,
+void AwaitingAdds::Init(std::vector<std::shared_ptr<RowSequence>> per_column_modifies, LazyTable prev,
+    std::shared_ptr<RowSequence> removed_rows_index_space, LazyTable after_removes,
     std::shared_ptr<RowSequence> added_rows_index_space) {
 
   auto result = std::make_shared<AwaitingAdds>();
@@ -384,33 +547,49 @@ std::optional<TickingUpdate> AwaitingAdds::ProcessNextChunk(BarrageProcessorImpl
   auto &begins = *beginsp;
   AssertAllSame(sources.size(), begins.size(), ends.size());
   auto num_sources = sources.size();
+  auto *am = &owner->awaitingMetadata_;
 
   if (added_rows_remaining_->Empty()) {
     throw std::runtime_error(DEEPHAVEN_LOCATION_STR("Impossible: addedRowsRemaining is Empty"));
   }
 
-  if (begins == ends) {
-    // Need more data from caller.
-    return {};
-  }
-
-  auto chunk_size = ends[0] - begins[0];
-  for (size_t i = 1; i != num_sources; ++i) {
+  // The server sends no data for unsubscribed columns, so only the subscribed columns are
+  // required to agree on the chunk size.
+  std::optional<size_t> chunk_size;
+  for (size_t i = 0; i != num_sources; ++i) {
+    if (!am->IsSubscribed(i)) {
+      continue;
+    }
     auto this_size = ends[i] - begins[i];
-    if (this_size != chunk_size) {
-      auto message = fmt::format("Chunks have inconsistent sizes: {} vs {}", this_size, chunk_size);
+    if (!chunk_size.has_value()) {
+      chunk_size = this_size;
+    } else if (this_size != *chunk_size) {
+      auto message = fmt::format("Chunks have inconsistent sizes: {} vs {}", this_size, *chunk_size);
       throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
     }
   }
 
-  if (added_rows_remaining_->Size() < chunk_size) {
+  if (!chunk_size.has_value()) {
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR("!AddedRows.Empty() but no columns are subscribed"));
+  }
+
+  if (*chunk_size == 0) {
+    // Need more data from caller.
+    return {};
+  }
+
+  if (added_rows_remaining_->Size() < *chunk_size) {
     const char *message = "There is excess data in the chunk";
     throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
   }
 
-  auto index_rows_this_time = added_rows_remaining_->Take(chunk_size);
-  added_rows_remaining_ = added_rows_remaining_->Drop(chunk_size);
-  owner->awaitingMetadata_.table_state_.AddData(sources, begins, ends, *index_rows_this_time);
+  auto index_rows_this_time = added_rows_remaining_->Take(*chunk_size);
+  added_rows_remaining_ = added_rows_remaining_->Drop(*chunk_size);
+  if (am->deltas_only_) {
+    am->delta_state_.AddData(sources, begins, ends);
+  } else {
+    am->table_state_.AddData(sources, begins, ends, *index_rows_this_time);
+  }
 
   // To indicate to the caller that we've consumed the data here (so it can't e.g. be passed on to modify)
   for (size_t i = 0; i != num_sources; ++i) {
@@ -423,7 +602,7 @@ std::optional<TickingUpdate> AwaitingAdds::ProcessNextChunk(BarrageProcessorImpl
   }
 
   // No more data remaining. Add phase is done.
-  auto after_adds = owner->awaitingMetadata_.table_state_.Snapshot();
+  auto after_adds = am->deltas_only_ ? LazyTable() : am->table_state_.LazySnapshot();
 
   owner->state_ = State::kAwaitingModifies;
   owner->awaitingModifies_.Init(std::move(after_adds));
@@ -434,7 +613,7 @@ void AwaitingModifies::Reset() {
   *this = AwaitingModifies();
 }
 
-void AwaitingModifies::Init(std::shared_ptr<ClientTable> after_adds) {
+void AwaitingModifies::Init(LazyTable after_adds) {
   after_adds_ = std::move(after_adds);
 }
 
@@ -459,11 +638,20 @@ std::optional<TickingUpdate> AwaitingModifies::ProcessNextChunk(BarrageProcessor
     }
 
     auto ncols = owner->awaitingMetadata_.num_cols_;
+    const auto &am = owner->awaitingMetadata_;
     modified_rows_index_space_ = MakeReservedVector<std::shared_ptr<RowSequence>>(ncols);
     modified_rows_remaining_ = MakeReservedVector<std::shared_ptr<RowSequence>>(ncols);
     for (size_t i = 0; i < ncols; ++i) {
-      auto rs = owner->awaitingMetadata_.table_state_.ConvertKeysToIndices(
-          *owner->awaitingAdds_.per_column_modifies_[i]);
+      if (!am.IsSubscribed(i)) {
+        // We hold no data for this column, so there is nothing to modify.
+        modified_rows_index_space_.push_back(RowSequence::CreateEmpty());
+        modified_rows_remaining_.push_back(RowSequence::CreateEmpty());
+        continue;
+      }
+      // In a deltas-only subscription, the modified rows stay in key space. In a viewport
+      // subscription, they are already positions.
+      const auto &mods = owner->awaitingAdds_.per_column_modifies_[i];
+      auto rs = am.deltas_only_ || am.IsViewport() ? mods : am.table_state_.ConvertKeysToIndices(*mods);
       modified_rows_index_space_.push_back(rs->Drop(0));  // make copy
       modified_rows_remaining_.push_back(std::move(rs));
     }
@@ -486,6 +674,9 @@ std::optional<TickingUpdate> AwaitingModifies::ProcessNextChunk(BarrageProcessor
     throw std::runtime_error(message);
   }
 
+  // Columns are modified independently of each other, so first work out what each column gets,
+  // then (perhaps in parallel) apply the modifications.
+  std::vector<std::pair<size_t, std::shared_ptr<RowSequence>>> work;
   for (size_t i = 0; i < num_sources; ++i) {
     auto num_rows_remaining = modified_rows_remaining_[i]->Size();
     auto num_rows_available = ends[i] - begins[i];
@@ -497,17 +688,33 @@ std::optional<TickingUpdate> AwaitingModifies::ProcessNextChunk(BarrageProcessor
     }
 
     if (num_rows_available == 0) {
-      // Nothing available for this column. Advance to next column.
+      // Nothing available for this column (or it is unsubscribed). Advance to next column.
       continue;
     }
 
     auto &mr = modified_rows_remaining_[i];
-    auto rows_available = mr->Take(num_rows_available);
+    work.emplace_back(i, mr->Take(num_rows_available));
     mr = mr->Drop(num_rows_available);
+  }
 
-    owner->awaitingMetadata_.table_state_.ModifyData(i, *sources[i], begins[i], ends[i],
-        *rows_available);
-    begins[i] = ends[i];
+  auto *am = &owner->awaitingMetadata_;
+  auto modify_column = [&](size_t which) {
+    const auto &[i, rows_available] = work[which];
+    if (am->deltas_only_) {
+      am->delta_state_.ModifyData(i, sources[i], begins[i], ends[i]);
+    } else {
+      am->table_state_.ModifyData(i, *sources[i], begins[i], ends[i], *rows_available);
+    }
+  };
+  if (owner->column_worker_pool_ != nullptr) {
+    owner->column_worker_pool_->ForEach(work.size(), modify_column);
+  } else {
+    for (size_t which = 0; which != work.size(); ++which) {
+      modify_column(which);
+    }
+  }
+  for (const auto &item : work) {
+    begins[item.first] = ends[item.first];
   }
 
   for (const auto &mr : modified_rows_remaining_) {
@@ -518,7 +725,7 @@ std::optional<TickingUpdate> AwaitingModifies::ProcessNextChunk(BarrageProcessor
   }
 
   // No more data. Modify phase is done.
-  auto after_modifies = owner->awaitingMetadata_.table_state_.Snapshot();
+  auto after_modifies = am->deltas_only_ ? LazyTable() : am->table_state_.LazySnapshot();
 
   owner->state_ = State::kBuildingResult;
   owner->buildingResult_.Init(std::move(after_modifies));
@@ -532,7 +739,7 @@ void BuildingResult::Reset() {
   *this = BuildingResult();
 }
 
-void BuildingResult::Init(std::shared_ptr<ClientTable> after_modifies) {
+void BuildingResult::Init(LazyTable after_modifies) {
   afterModifies_ = std::move(after_modifies);
 }
 
@@ -547,10 +754,21 @@ std::optional<TickingUpdate> BuildingResult::ProcessNextChunk(BarrageProcessorIm
   }
   auto *aa = &owner->awaitingAdds_;
   auto *am = &owner->awaitingModifies_;
-  auto result = TickingUpdate(std::move(aa->prev_),
-      std::move(aa->removed_rows_index_space_), std::move(aa->after_removes_),
-      std::move(aa->added_rows_index_space_), std::move(am->after_adds_),
-      std::move(am->modified_rows_index_space_), std::move(afterModifies_));
+  std::optional<TickingUpdate> result;
+  if (owner->awaitingMetadata_.deltas_only_) {
+    // In this mode the "index space" RowSequences hold keys.
+    auto &delta_state = owner->awaitingMetadata_.delta_state_;
+    auto any_modified = !am->modified_rows_index_space_.empty();
+    result.emplace(std::move(aa->removed_rows_index_space_),
+        std::move(aa->added_rows_index_space_), delta_state.TakeAdded(),
+        std::move(am->modified_rows_index_space_), delta_state.TakeModified(any_modified));
+  } else {
+    // The ClientTables are built from these only if the caller asks for them.
+    result.emplace(std::move(aa->prev_),
+        std::move(aa->removed_rows_index_space_), std::move(aa->after_removes_),
+        std::move(aa->added_rows_index_space_), std::move(am->after_adds_),
+        std::move(am->modified_rows_index_space_), std::move(afterModifies_));
+  }
   aa->Reset();
   am->Reset();
   this->Reset();
@@ -568,6 +786,81 @@ void AssertAllSame(size_t val0, size_t val1, size_t val2) {
     throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
   }
 }
+
+/**
+ * Columns are encoded as a little-endian bitset (as in java.util.BitSet.toByteArray()).
+ */
+std::vector<int8_t> EncodeColumnSet(const std::vector<size_t> &column_indices) {
+  std::vector<int8_t> result;
+  for (auto index : column_indices) {
+    auto byte_index = index / 8;
+    if (byte_index >= result.size()) {
+      result.resize(byte_index + 1);
+    }
+    result[byte_index] = static_cast<int8_t>(result[byte_index] | (1 << (index % 8)));
+  }
+  return result;
+}
+
+std::vector<bool> DecodeColumnSet(const flatbuffers::Vector<int8_t> &column_set, size_t num_cols) {
+  std::vector<bool> result(num_cols);
+  for (size_t i = 0; i != num_cols; ++i) {
+    auto byte_index = i / 8;
+    if (byte_index >= column_set.size()) {
+      break;
+    }
+    result[i] = (column_set.Get(byte_index) & (1 << (i % 8))) != 0;
+  }
+  return result;
+}
+
+flatbuffers::Offset<flatbuffers::Vector<int8_t>> MaybeEncodeColumnSet(
+    flatbuffers::FlatBufferBuilder *builder, const std::vector<size_t> *column_indices) {
+  if (column_indices == nullptr) {
+    return {};
+  }
+  return builder->CreateVector(EncodeColumnSet(*column_indices));
+}
+
+flatbuffers::Offset<flatbuffers::Vector<int8_t>> MaybeEncodeViewport(
+    flatbuffers::FlatBufferBuilder *builder, const RowSequence *viewport) {
+  if (viewport == nullptr) {
+    return {};
+  }
+  std::vector<int8_t> encoded_viewport;
+  DataOutput out(&encoded_viewport);
+  IndexEncoder::WriteExternalCompressedDelta(*viewport, &out);
+  return builder->CreateVector(encoded_viewport);
+}
+
+std::vector<uint8_t> WrapPayload(BarrageMessageType message_type,
+    const flatbuffers::FlatBufferBuilder &payload_builder) {
+  // TODO(kosak): fix sad cast
+  const auto *payloadp = static_cast<int8_t*>(static_cast<void*>(payload_builder.GetBufferPointer()));
+  const auto payload_size = payload_builder.GetSize();
+
+  // TODO(kosak): I'd really like to just point this buffer backwards to the thing I just created, rather
+  // then copying it. But, eh, version 2.
+  flatbuffers::FlatBufferBuilder wrapper_builder(4096);
+  auto payload = wrapper_builder.CreateVector(payloadp, payload_size);
+  auto message_wrapper = CreateBarrageMessageWrapper(wrapper_builder,
+      BarrageProcessor::kDeephavenMagicNumber, message_type, payload);
+  wrapper_builder.Finish(message_wrapper);
+  auto wrapper_buffer = wrapper_builder.Release();
+
+  std::vector<uint8_t> result;
+  result.resize(wrapper_buffer.size());
+  memcpy(result.data(), wrapper_buffer.data(), wrapper_buffer.size());
+  return result;
+}
+
+std::shared_ptr<RowSequence> DecodeIndex(const flatbuffers::Vector<int8_t> *index) {
+  if (index == nullptr || index->size() == 0) {
+    return RowSequence::CreateEmpty();
+  }
+  DataInput di(*index);
+  return IndexDecoder::ReadExternalCompressedDelta(&di);
+}
 }  // namespace
 }  // namespace internal
 }  // namespace deephaven::dhcore::ticking
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/dhcore/ticking/column_worker_pool.h"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace deephaven::dhcore::ticking {
+namespace internal {
+struct ColumnJob {
+  ColumnJob(size_t count, const std::function<void(size_t)> *fn) : count_(count), fn_(fn),
+      errors_(count) {}
+
+  /**
+   * Claims and runs indices until there are none left. Called concurrently by every participating
+   * thread. Each index is claimed by exactly one thread, so errors_ needs no locking.
+   */
+  void Run() {
+    while (true) {
+      auto index = next_.fetch_add(1);
+      if (index >= count_) {
+        return;
+      }
+      try {
+        (*fn_)(index);
+      } catch (...) {
+        errors_[index] = std::current_exception();
+      }
+    }
+  }
+
+  size_t count_ = 0;
+  const std::function<void(size_t)> *fn_ = nullptr;
+  std::atomic<size_t> next_{0};
+  std::vector<std::exception_ptr> errors_;
+};
+}  // namespace internal
+
+std::shared_ptr<ColumnWorkerPool> ColumnWorkerPool::Create(size_t parallelism) {
+  auto num_workers = parallelism > 1 ? parallelism - 1 : 0;
+  return std::make_shared<ColumnWorkerPool>(Private(), num_workers);
+}
+
+ColumnWorkerPool::ColumnWorkerPool(Private, size_t num_workers) {
+  threads_.reserve(num_workers);
+  for (size_t i = 0; i != num_workers; ++i) {
+    threads_.emplace_back(&ColumnWorkerPool::RunWorker, this);
+  }
+}
+
+ColumnWorkerPool::~ColumnWorkerPool() {
+  {
+    std::unique_lock guard(mutex_);
+    cancelled_ = true;
+  }
+  workAvailable_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void ColumnWorkerPool::ForEach(size_t count, const std::function<void(size_t)> &fn) {
+  if (threads_.empty() || count <= 1) {
+    for (size_t i = 0; i != count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  std::unique_lock for_each_guard(forEachMutex_);
+  internal::ColumnJob job(count, &fn);
+  {
+    std::unique_lock guard(mutex_);
+    job_ = &job;
+    ++generation_;
+  }
+  workAvailable_.notify_all();
+
+  job.Run();
+
+  {
+    // Workers only pick up job_ while it is set, and they register as busy before letting go of
+    // the lock. So once busy_ is zero and job_ is cleared, nobody can touch 'job' again.
+    std::unique_lock guard(mutex_);
+    workDone_.wait(guard, [this] { return busy_ == 0; });
+    job_ = nullptr;
+  }
+
+  for (const auto &error : job.errors_) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+void ColumnWorkerPool::RunWorker() {
+  uint64_t generation_seen = 0;
+  std::unique_lock guard(mutex_);
+  while (true) {
+    workAvailable_.wait(guard, [this, generation_seen] {
+      return cancelled_ || generation_ != generation_seen;
+    });
+    if (cancelled_) {
+      return;
+    }
+    generation_seen = generation_;
+    auto *job = job_;
+    if (job == nullptr) {
+      // The job finished before we got to it.
+      continue;
+    }
+    ++busy_;
+    guard.unlock();
+    job->Run();
+    guard.lock();
+    if (--busy_ == 0) {
+      workDone_.notify_all();
+    }
+  }
+}
+}  // namespace deephaven::dhcore::ticking
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/dhcore/ticking/delta_table_state.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <immer/flex_vector.hpp>
+#include <immer/flex_vector_transient.hpp>
+
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/ticking/immer_table_state.h"
+#include "deephaven/dhcore/ticking/segmented_column.h"
+#include "deephaven/dhcore/utility/utility.h"
+#include "deephaven/third_party/fmt/core.h"
+
+using deephaven::dhcore::clienttable::ClientTable;
+using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::column::ColumnSource;
+using deephaven::dhcore::utility::MakeReservedVector;
+
+namespace deephaven::dhcore::ticking {
+DeltaTableState::DeltaTableState(std::shared_ptr<Schema> schema) : schema_(std::move(schema)) {
+  auto ncols = schema_->NumCols();
+  subscribed_.resize(ncols, true);
+  added_.resize(ncols);
+  modified_.resize(ncols);
+}
+DeltaTableState::~DeltaTableState() = default;
+
+void DeltaTableState::SetSubscribedColumns(const std::vector<bool> &subscribed) {
+  if (subscribed.size() != subscribed_.size()) {
+    auto message = fmt::format("Expected {} subscription flags, got {}", subscribed_.size(),
+        subscribed.size());
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  subscribed_ = subscribed;
+}
+
+void DeltaTableState::AddData(const std::vector<std::shared_ptr<ColumnSource>> &sources,
+    const std::vector<size_t> &begins, const std::vector<size_t> &ends) {
+  std::optional<size_t> num_rows;
+  for (size_t i = 0; i != sources.size(); ++i) {
+    if (!subscribed_[i]) {
+      continue;
+    }
+    auto size = ends[i] - begins[i];
+    if (num_rows.has_value() && size != *num_rows) {
+      auto message = fmt::format("Columns have inconsistent sizes: {} vs {}", size, *num_rows);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    num_rows = size;
+    added_[i].Append(sources[i], begins[i], ends[i]);
+  }
+  numAdded_ += num_rows.value_or(0);
+}
+
+void DeltaTableState::ModifyData(size_t col_num, const std::shared_ptr<ColumnSource> &source,
+    size_t begin, size_t end) {
+  modified_[col_num].Append(source, begin, end);
+}
+
+std::shared_ptr<ClientTable> DeltaTableState::TakeAdded() {
+  const auto &element_types = schema_->ElementTypes();
+  auto columns = MakeReservedVector<std::shared_ptr<ColumnSource>>(added_.size());
+  for (size_t i = 0; i != added_.size(); ++i) {
+    if (!subscribed_[i]) {
+      columns.push_back(internal::MakeNullColumnSource(element_types[i], numAdded_));
+      continue;
+    }
+    columns.push_back(added_[i].Take(element_types[i]));
+  }
+  auto result = internal::MakeClientTable(schema_, std::move(columns), numAdded_);
+  numAdded_ = 0;
+  return result;
+}
+
+std::vector<std::shared_ptr<ColumnSource>> DeltaTableState::TakeModified(bool any_modified) {
+  if (!any_modified) {
+    return {};
+  }
+  const auto &element_types = schema_->ElementTypes();
+  auto result = MakeReservedVector<std::shared_ptr<ColumnSource>>(modified_.size());
+  for (size_t i = 0; i != modified_.size(); ++i) {
+    result.push_back(modified_[i].Take(element_types[i]));
+  }
+  return result;
+}
+
+void DeltaTableState::Pending::Append(const std::shared_ptr<ColumnSource> &source, size_t begin,
+    size_t end) {
+  if (begin == end) {
+    return;
+  }
+  segments_.push_back(ColumnSegment{source, begin, end, size_});
+  size_ += end - begin;
+}
+
+std::shared_ptr<ColumnSource> DeltaTableState::Pending::Take(const ElementType &element_type) {
+  if (segments_.size() == 1 && segments_[0].begin_ == 0) {
+    // The usual case: the column's data came in one message and starts at row 0 of its source.
+    // The source's positions are then the column's own, so it can be handed over as it is.
+    auto result = std::move(segments_[0].source_);
+    segments_.clear();
+    size_ = 0;
+    return result;
+  }
+  auto segments = immer::flex_vector<ColumnSegment>().transient();
+  for (auto &segment : segments_) {
+    segments.push_back(std::move(segment));
+  }
+  auto result = MakeSegmentedColumnSource(element_type, segments.persistent(), 0, size_);
+  // clear() keeps the capacity, so the next update appends without allocating.
+  segments_.clear();
+  size_ = 0;
+  return result;
+}
+}  // namespace deephaven::dhcore::ticking
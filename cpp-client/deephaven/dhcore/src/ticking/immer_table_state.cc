@@ -3,52 +3,60 @@
  */
 #include "deephaven/dhcore/ticking/immer_table_state.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
 
 #include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/chunk/chunk_traits.h"
 #include "deephaven/dhcore/clienttable/schema.h"
 #include "deephaven/dhcore/column/column_source.h"
 #include "deephaven/dhcore/container/container.h"
 #include "deephaven/dhcore/container/row_sequence.h"
 #include "deephaven/dhcore/immerutil/abstract_flex_vector.h"
-#include "deephaven/dhcore/ticking/shift_processor.h"
 #include "deephaven/dhcore/types.h"
 #include "deephaven/dhcore/utility/utility.h"
 #include "deephaven/third_party/fmt/core.h"
 
 using deephaven::dhcore::ElementTypeId;
 using deephaven::dhcore::chunk::AnyChunk;
+using deephaven::dhcore::chunk::BooleanChunk;
 using deephaven::dhcore::chunk::Chunk;
 using deephaven::dhcore::chunk::ChunkVisitor;
 using deephaven::dhcore::chunk::Int64Chunk;
+using deephaven::dhcore::chunk::TypeToChunk;
+using deephaven::dhcore::chunk::UInt64Chunk;
 using deephaven::dhcore::column::ColumnSource;
 using deephaven::dhcore::column::ColumnSourceVisitor;
+using deephaven::dhcore::column::GenericColumnSource;
 using deephaven::dhcore::container::ContainerBase;
 using deephaven::dhcore::container::RowSequence;
 using deephaven::dhcore::container::RowSequenceBuilder;
 using deephaven::dhcore::container::RowSequenceIterator;
-using deephaven::dhcore::subscription::ShiftProcessor;
 using deephaven::dhcore::immerutil::AbstractFlexVectorBase;
 using deephaven::dhcore::immerutil::GenericAbstractFlexVector;
 using deephaven::dhcore::immerutil::NumericAbstractFlexVector;
 using deephaven::dhcore::clienttable::Schema;
 using deephaven::dhcore::clienttable::ClientTable;
 using deephaven::dhcore::utility::MakeReservedVector;
+using deephaven::dhcore::utility::TrueOrThrow;
+using deephaven::dhcore::utility::VerboseCast;
 
 namespace deephaven::dhcore::ticking {
 namespace {
 class MyTable final : public ClientTable {
   // Because we have a name clash with a member function called Schema()
   using SchemaType = deephaven::dhcore::clienttable::Schema;
+  using SourcesType = std::vector<std::shared_ptr<ColumnSource>>;
 
 public:
-  explicit MyTable(std::shared_ptr<SchemaType> schema,
-      std::vector<std::shared_ptr<ColumnSource>> sources, size_t num_rows);
+  explicit MyTable(std::shared_ptr<SchemaType> schema, std::shared_ptr<const SourcesType> sources,
+      size_t num_rows);
   ~MyTable() final;
 
   [[nodiscard]]
@@ -56,12 +64,12 @@ public:
 
   [[nodiscard]]
   std::shared_ptr<ColumnSource> GetColumn(size_t column_index) const final {
-    if (column_index >= sources_.size()) {
+    if (column_index >= sources_->size()) {
       auto message = fmt::format("Requested column index {} >= num columns {}", column_index,
-          sources_.size());
+          sources_->size());
       throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
     }
-    return sources_[column_index];
+    return (*sources_)[column_index];
   }
 
   [[nodiscard]]
@@ -71,7 +79,7 @@ public:
 
   [[nodiscard]]
   size_t NumColumns() const final {
-    return sources_.size();
+    return sources_->size();
   }
 
   [[nodiscard]]
@@ -81,25 +89,155 @@ public:
 
 private:
   std::shared_ptr<SchemaType> schema_;
-  std::vector<std::shared_ptr<ColumnSource>> sources_;
+  // Shared with the snapshots that were captured from the same columns.
+  std::shared_ptr<const SourcesType> sources_;
   size_t numRows_ = 0;
 };
 
+/**
+ * Stands in for an unsubscribed column: 'size' rows, all of them null.
+ */
+#ifdef _WIN32
+// Avoid Visual Studio warning about "inherits via dominance" for diamond inheritance pattern.
+#pragma warning(push)
+#pragma warning(disable: 4250)
+#endif
+template<typename T>
+class NullColumnSource final : public GenericColumnSource<T> {
+public:
+  NullColumnSource(const ElementType &element_type, size_t size) : element_type_(element_type),
+      size_(size) {}
+  ~NullColumnSource() final = default;
+
+  void FillChunk(const RowSequence &rows, Chunk *dest_data,
+      BooleanChunk *optional_dest_null_flags) const final {
+    FillWithNulls(rows.Size(), dest_data, optional_dest_null_flags);
+  }
+
+  void FillChunkUnordered(const UInt64Chunk &rows, Chunk *dest_data,
+      BooleanChunk *optional_dest_null_flags) const final {
+    FillWithNulls(rows.Size(), dest_data, optional_dest_null_flags);
+  }
+
+  [[nodiscard]]
+  const ElementType &GetElementType() const final {
+    return element_type_;
+  }
+
+  void AcceptVisitor(ColumnSourceVisitor *visitor) const final {
+    visitor->Visit(*this);
+  }
+
+private:
+  void FillWithNulls(size_t num_rows, Chunk *dest_data, BooleanChunk *optional_dest_null_flags) const {
+    using chunkType_t = typename TypeToChunk<T>::type_t;
+    auto *typed_dest = VerboseCast<chunkType_t *>(DEEPHAVEN_LOCATION_EXPR(dest_data));
+    TrueOrThrow(DEEPHAVEN_LOCATION_EXPR(num_rows <= size_));
+    TrueOrThrow(DEEPHAVEN_LOCATION_EXPR(num_rows <= typed_dest->Size()));
+    T null_value{};
+    if constexpr (DeephavenTraits<T>::kIsNumeric) {
+      null_value = DeephavenTraits<T>::kNullValue;
+    }
+    std::fill_n(typed_dest->data(), num_rows, null_value);
+    if (optional_dest_null_flags != nullptr) {
+      TrueOrThrow(DEEPHAVEN_LOCATION_EXPR(num_rows <= optional_dest_null_flags->Size()));
+      std::fill_n(optional_dest_null_flags->data(), num_rows, true);
+    }
+  }
+
+  ElementType element_type_;
+  size_t size_ = 0;
+};
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+std::unique_ptr<AbstractFlexVectorBase> MakeFlexVectorFromType(const ElementType &element_type);
 std::vector<std::unique_ptr<AbstractFlexVectorBase>> MakeEmptyFlexVectorsFromSchema(const Schema &schema);
 std::unique_ptr<AbstractFlexVectorBase> MakeFlexVectorFromColumnSource(const ColumnSource &source, size_t begin,
     size_t end);
 void AssertAllSame(size_t val0, size_t val1, size_t val2);
 void AssertLeq(size_t lhs, size_t rhs, const char *format);
+/**
+ * Whether 'rows' is either empty or the single interval [position, position + rows.Size()).
+ */
+bool IsIntervalAt(const RowSequence &rows, uint64_t position);
+/**
+ * One past the last row in 'rows', or 0 if it is empty.
+ */
+uint64_t EndOf(const RowSequence &rows);
+
+// Crossover point between the two splice strategies: splicing one interval costs about as much as
+// copying this many elements during a single-pass rebuild. These should be the "implied
+// constants" printed by benchmarks/immer_table_state_benchmark.cc; the current values have not
+// yet been checked against a run of it, which is why SpliceMode::kAuto is not the default.
+constexpr size_t kRowsPerIntervalSplice = 512;
+// With fewer intervals than this, we always splice per interval.
+constexpr size_t kMinIntervalsForRebuild = 16;
 }  // namespace
 
 ImmerTableState::ImmerTableState(std::shared_ptr<Schema> schema) : schema_(std::move(schema)) {
   flexVectors_ = MakeEmptyFlexVectorsFromSchema(*schema_);
+  segmentedColumns_.resize(flexVectors_.size());
+  columnCache_.resize(flexVectors_.size());
 }
 
 ImmerTableState::~ImmerTableState() = default;
 
+void ImmerTableState::SetZeroCopyAppends(bool zero_copy_appends) {
+  if (!zero_copy_appends) {
+    LeaveZeroCopyModeAll();
+    return;
+  }
+  if (spaceMapper_.Cardinality() != 0) {
+    const char *message = "Zero-copy appends can only be enabled while the table is empty";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  for (size_t i = 0; i != flexVectors_.size(); ++i) {
+    if (flexVectors_[i] != nullptr && segmentedColumns_[i] == nullptr) {
+      segmentedColumns_[i] = std::make_unique<SegmentedColumn>(schema_->ElementTypes()[i],
+          flexVectors_[i]->Take(0));
+    }
+  }
+}
+
+void ImmerTableState::SetSubscribedColumns(const std::vector<bool> &subscribed) {
+  if (subscribed.size() != flexVectors_.size()) {
+    auto message = fmt::format("Expected {} columns, got {}", flexVectors_.size(),
+        subscribed.size());
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  InvalidateAllColumns();
+  auto num_rows = spaceMapper_.Cardinality();
+  for (size_t i = 0; i != flexVectors_.size(); ++i) {
+    auto &fv = flexVectors_[i];
+    if (!subscribed[i]) {
+      fv.reset();
+      segmentedColumns_[i].reset();
+      continue;
+    }
+    if (fv != nullptr) {
+      continue;
+    }
+    const auto &element_type = schema_->ElementTypes()[i];
+    fv = MakeFlexVectorFromType(element_type);
+    if (num_rows != 0) {
+      fv->InPlaceAppendSource(*internal::MakeNullColumnSource(element_type, num_rows), 0, num_rows);
+    }
+  }
+}
+
 std::shared_ptr<RowSequence> ImmerTableState::AddKeys(const RowSequence &rows_to_add_key_space) {
-  return spaceMapper_.AddKeys(rows_to_add_key_space);
+  auto old_size = spaceMapper_.Cardinality();
+  auto result = spaceMapper_.AddKeys(rows_to_add_key_space);
+  if (!result->Empty()) {
+    InvalidateAllColumns();
+  }
+  if (!IsIntervalAt(*result, old_size)) {
+    // Not an append, so the columns can no longer be kept as segments.
+    LeaveZeroCopyModeAll();
+  }
+  return result;
 }
 
 void ImmerTableState::AddData(const std::vector<std::shared_ptr<ColumnSource>> &sources,
@@ -109,20 +247,36 @@ void ImmerTableState::AddData(const std::vector<std::shared_ptr<ColumnSource>> &
   auto nrows = rows_to_add_index_space.Size();
   AssertAllSame(sources.size(), begins.size(), ends.size());
   AssertLeq(ncols, flexVectors_.size(), "More columns provided than was expected ({} vs {})");
+  // Unsubscribed columns get no data, so there is nothing to check or build for them.
   for (size_t i = 0; i != ncols; ++i) {
+    if (flexVectors_[i] != nullptr) {
       AssertLeq(nrows, ends[i] - begins[i], "Sources contain insufficient data ({} vs {})");
-  }
-  auto added_data = MakeReservedVector<std::unique_ptr<AbstractFlexVectorBase>>(ncols);
-  for (size_t i = 0; i != ncols; ++i) {
-    added_data.push_back(MakeFlexVectorFromColumnSource(*sources[i], begins[i], begins[i] + nrows));
+    }
   }
 
-  auto add_chunk = [this, &added_data](uint64_t begin_index, uint64_t end_index) {
-    auto size = end_index - begin_index;
+  auto rebuild = ShouldRebuild(rows_to_add_index_space, spaceMapper_.Cardinality());
+  ForEachSubscribedColumn(ncols, [&](size_t i) {
+    if (nrows != 0) {
+      InvalidateColumn(i);
+    }
+    auto &segmented = segmentedColumns_[i];
+    if (segmented != nullptr) {
+      if (IsIntervalAt(rows_to_add_index_space, segmented->Size())) {
+        segmented->Append(sources[i], begins[i], begins[i] + nrows);
+        return;
+      }
+      LeaveZeroCopyMode(i);
+    }
+
+    auto &fv = flexVectors_[i];
+    auto ad = MakeFlexVectorFromColumnSource(*sources[i], begins[i], begins[i] + nrows);
+    if (rebuild) {
+      fv->InPlaceInsertAll(*ad, rows_to_add_index_space);
+      return;
+    }
 
-    for (size_t i = 0; i < flexVectors_.size(); ++i) {
-      auto &fv = flexVectors_[i];
-      auto &ad = added_data[i];
+    auto add_chunk = [&fv, &ad](uint64_t begin_index, uint64_t end_index) {
+      auto size = end_index - begin_index;
 
       auto fv_temp = std::move(fv);
       // Give "fv" its original values up to 'beginIndex'; leave fvTemp with the rest.
@@ -135,28 +289,96 @@ void ImmerTableState::AddData(const std::vector<std::shared_ptr<ColumnSource>> &
 
       // Append the residual items back from 'fvTemp'.
       fv->InPlaceAppend(std::move(fv_temp));
-    }
-  };
-  rows_to_add_index_space.ForEachInterval(add_chunk);
+    };
+    rows_to_add_index_space.ForEachIntervalInline(add_chunk);
+  });
 }
 
 std::shared_ptr<RowSequence> ImmerTableState::Erase(const RowSequence &rows_to_erase_key_space) {
+  auto num_rows = spaceMapper_.Cardinality();
   auto result = spaceMapper_.ConvertKeysToIndices(rows_to_erase_key_space);
+  spaceMapper_.EraseKeys(rows_to_erase_key_space);
+  EraseIndices(*result, num_rows);
+  return result;
+}
+
+void ImmerTableState::AddPositions(const RowSequence &rows_to_add_index_space) {
+  auto old_size = spaceMapper_.Cardinality();
+  auto new_size = old_size + rows_to_add_index_space.Size();
+  if (auto end = EndOf(rows_to_add_index_space); end > new_size) {
+    auto message = fmt::format("Can't add a row at position {} to a table that will have {} rows",
+        end - 1, new_size);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  if (rows_to_add_index_space.Empty()) {
+    return;
+  }
+  // The keys are the positions, so the new keys are the ones at the end.
+  (void)spaceMapper_.AddRange(old_size, new_size);
+  InvalidateAllColumns();
+  if (!IsIntervalAt(rows_to_add_index_space, old_size)) {
+    LeaveZeroCopyModeAll();
+  }
+}
+
+void ImmerTableState::ErasePositions(const RowSequence &rows_to_erase_index_space) {
+  auto num_rows = spaceMapper_.Cardinality();
+  if (auto end = EndOf(rows_to_erase_index_space); end > num_rows) {
+    auto message = fmt::format("Can't erase the row at position {} from a table with {} rows",
+        end - 1, num_rows);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  // Likewise, the keys that go away are the ones at the end.
+  (void)spaceMapper_.EraseRange(num_rows - rows_to_erase_index_space.Size(), num_rows);
+  EraseIndices(rows_to_erase_index_space, num_rows);
+}
 
-  auto erase_chunk = [this](uint64_t begin_key, uint64_t end_key) {
-    auto size = end_key - begin_key;
-    auto begin_index = spaceMapper_.EraseRange(begin_key, end_key);
-    auto end_index = begin_index + size;
+void ImmerTableState::EraseIndices(const RowSequence &rows_index_space, size_t num_rows) {
+  if (rows_index_space.Empty()) {
+    return;
+  }
+  InvalidateAllColumns();
+  if (IsIntervalAt(rows_index_space, 0)) {
+    // Erasing a prefix of the table, which is what happens to blink and ring tables. The
+    // segmented columns can handle this, and for the others it is just a drop.
+    auto count = rows_index_space.Size();
+    ForEachSubscribedColumn(flexVectors_.size(), [this, count](size_t i) {
+      if (segmentedColumns_[i] != nullptr) {
+        segmentedColumns_[i]->EraseFront(count);
+      } else {
+        flexVectors_[i]->InPlaceDrop(count);
+      }
+    });
+    return;
+  }
+  LeaveZeroCopyModeAll();
 
-    for (auto &fv : flexVectors_) {
+  if (ShouldRebuild(rows_index_space, num_rows)) {
+    ForEachSubscribedColumn(flexVectors_.size(), [this, &rows_index_space](size_t i) {
+      flexVectors_[i]->InPlaceEraseAll(rows_index_space);
+    });
+    return;
+  }
+
+  // Work out where each erased range is at the time it is erased (that is, after the ranges
+  // before it are gone). Then the columns can replay those erasures independently of each other.
+  std::vector<std::pair<uint64_t, uint64_t>> erased_ranges;
+  uint64_t num_erased = 0;
+  rows_index_space.ForEachIntervalInline([&erased_ranges, &num_erased](uint64_t begin_index,
+      uint64_t end_index) {
+    erased_ranges.emplace_back(begin_index - num_erased, end_index - num_erased);
+    num_erased += end_index - begin_index;
+  });
+
+  ForEachSubscribedColumn(flexVectors_.size(), [this, &erased_ranges](size_t i) {
+    auto &fv = flexVectors_[i];
+    for (const auto &[begin_index, end_index] : erased_ranges) {
       auto fv_temp = std::move(fv);
       fv = fv_temp->Take(begin_index);
       fv_temp->InPlaceDrop(end_index);
       fv->InPlaceAppend(std::move(fv_temp));
     }
-  };
-  rows_to_erase_key_space.ForEachInterval(erase_chunk);
-  return result;
+  });
 }
 
 std::shared_ptr<RowSequence> ImmerTableState::ConvertKeysToIndices(
@@ -166,12 +388,26 @@ std::shared_ptr<RowSequence> ImmerTableState::ConvertKeysToIndices(
 
 void ImmerTableState::ModifyData(size_t col_num, const ColumnSource &src, size_t begin, size_t end,
     const RowSequence &rows_to_modify_index_space) {
+  if (flexVectors_[col_num] == nullptr) {
+    // Unsubscribed column. Nothing to do.
+    return;
+  }
   auto nrows = rows_to_modify_index_space.Size();
+  if (nrows != 0) {
+    InvalidateColumn(col_num);
+    LeaveZeroCopyMode(col_num);
+  }
   auto source_size = end - begin;
     AssertLeq(nrows, source_size, "Insufficient data in source ({} vs {})");
   auto modified_data = MakeFlexVectorFromColumnSource(src, begin, begin + nrows);
 
   auto &fv = flexVectors_[col_num];
+  // Each batch is a separate pass over the column, so it is the batch's own intervals that count.
+  if (ShouldRebuild(rows_to_modify_index_space, spaceMapper_.Cardinality())) {
+    fv->InPlaceReplaceAll(*modified_data, rows_to_modify_index_space);
+    return;
+  }
+
   auto modify_chunk = [&fv, &modified_data](uint64_t begin_index, uint64_t end_index) {
     auto size = end_index - begin_index;
     auto fv_temp = std::move(fv);
@@ -187,30 +423,179 @@ void ImmerTableState::ModifyData(size_t col_num, const ColumnSource &src, size_t
     // Append the residual items back from 'fvTemp'.
     fv->InPlaceAppend(std::move(fv_temp));
   };
-  rows_to_modify_index_space.ForEachInterval(modify_chunk);
+  rows_to_modify_index_space.ForEachIntervalInline(modify_chunk);
 }
 
 void ImmerTableState::ApplyShifts(const RowSequence &first_index, const RowSequence &last_index,
     const RowSequence &dest_index) {
-  auto process_shift = [this](int64_t first, int64_t last, int64_t dest) {
-    uint64_t begin = first;
-    uint64_t end = static_cast<uint64_t>(last) + 1;
-    uint64_t dest_begin = dest;
-    spaceMapper_.ApplyShift(begin, end, dest_begin);
-  };
-  ShiftProcessor::ApplyShiftData(first_index, last_index, dest_index, process_shift);
+  spaceMapper_.ApplyShifts(first_index, last_index, dest_index);
+}
+
+bool ImmerTableState::ShouldRebuild(const RowSequence &rows_index_space, size_t num_rows) const {
+  if (spliceMode_ != SpliceMode::kAuto) {
+    return spliceMode_ == SpliceMode::kRebuild;
+  }
+  size_t num_intervals = 0;
+  rows_index_space.ForEachIntervalInline([&num_intervals](uint64_t, uint64_t) { ++num_intervals; });
+  return num_intervals >= kMinIntervalsForRebuild &&
+      num_intervals * kRowsPerIntervalSplice >= num_rows;
+}
+
+void ImmerTableState::ForEachSubscribedColumn(size_t num_columns,
+    const std::function<void(size_t)> &fn) {
+  auto columns = MakeReservedVector<size_t>(num_columns);
+  for (size_t i = 0; i != num_columns; ++i) {
+    if (flexVectors_[i] != nullptr) {
+      columns.push_back(i);
+    }
+  }
+  if (columnWorkerPool_ == nullptr) {
+    for (auto i : columns) {
+      fn(i);
+    }
+    return;
+  }
+  columnWorkerPool_->ForEach(columns.size(), [&columns, &fn](size_t which) {
+    fn(columns[which]);
+  });
+}
+
+void ImmerTableState::LeaveZeroCopyMode(size_t col_num) {
+  auto &segmented = segmentedColumns_[col_num];
+  if (segmented == nullptr) {
+    return;
+  }
+  auto size = segmented->Size();
+  if (size != 0) {
+    flexVectors_[col_num]->InPlaceAppendSource(*segmented->MakeColumnSource(), 0, size);
+  }
+  segmented.reset();
+}
+
+void ImmerTableState::LeaveZeroCopyModeAll() {
+  ForEachSubscribedColumn(flexVectors_.size(), [this](size_t i) { LeaveZeroCopyMode(i); });
+}
+
+void ImmerTableState::InvalidateAllColumns() {
+  for (auto &column : columnCache_) {
+    column.reset();
+  }
 }
 
 std::shared_ptr<ClientTable> ImmerTableState::Snapshot() const {
-  auto column_sources = MakeReservedVector<std::shared_ptr<ColumnSource>>(flexVectors_.size());
-  for (const auto &fv : flexVectors_) {
-    column_sources.push_back(fv->MakeColumnSource());
+  auto lazy = LazySnapshot();
+  return internal::MakeClientTable(std::move(lazy.schema_), std::move(lazy.columns_),
+      lazy.num_rows_);
+}
+
+internal::LazyTable ImmerTableState::LazySnapshot() const {
+  auto num_rows = spaceMapper_.Cardinality();
+  auto changed = lastColumns_ == nullptr || !reuseUnchangedColumns_;
+  for (size_t i = 0; i != flexVectors_.size(); ++i) {
+    auto &column = columnCache_[i];
+    if (column != nullptr && reuseUnchangedColumns_) {
+      continue;
+    }
+    changed = true;
+    const auto &fv = flexVectors_[i];
+    if (fv == nullptr) {
+      column = internal::MakeNullColumnSource(schema_->ElementTypes()[i], num_rows);
+    } else if (segmentedColumns_[i] != nullptr) {
+      column = segmentedColumns_[i]->MakeColumnSource();
+    } else {
+      column = fv->MakeColumnSource();
+    }
   }
-  return std::make_shared<MyTable>(schema_, std::move(column_sources), spaceMapper_.Cardinality());
+  if (changed) {
+    lastColumns_ = std::make_shared<const std::vector<std::shared_ptr<ColumnSource>>>(columnCache_);
+  }
+  return {schema_, lastColumns_, num_rows};
+}
+
+namespace internal {
+std::shared_ptr<ClientTable> MakeClientTable(std::shared_ptr<Schema> schema,
+    std::vector<std::shared_ptr<ColumnSource>> sources, size_t num_rows) {
+  return MakeClientTable(std::move(schema),
+      std::make_shared<const std::vector<std::shared_ptr<ColumnSource>>>(std::move(sources)),
+      num_rows);
+}
+
+std::shared_ptr<ClientTable> MakeClientTable(std::shared_ptr<Schema> schema,
+    std::shared_ptr<const std::vector<std::shared_ptr<ColumnSource>>> sources, size_t num_rows) {
+  return std::make_shared<MyTable>(std::move(schema), std::move(sources), num_rows);
 }
 
+std::shared_ptr<ColumnSource> MakeNullColumnSource(const ElementType &element_type, size_t size) {
+  if (element_type.ListDepth() > 1) {
+    auto message = fmt::format("Don't know how to make null column sources with list depth {}",
+        element_type.ListDepth());
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+
+  if (element_type.ListDepth() == 1) {
+    return std::make_shared<NullColumnSource<std::shared_ptr<ContainerBase>>>(element_type, size);
+  }
+
+  switch (element_type.Id()) {
+    case ElementTypeId::kChar: {
+      return std::make_shared<NullColumnSource<char16_t>>(element_type, size);
+    }
+
+    case ElementTypeId::kInt8: {
+      return std::make_shared<NullColumnSource<int8_t>>(element_type, size);
+    }
+
+    case ElementTypeId::kInt16: {
+      return std::make_shared<NullColumnSource<int16_t>>(element_type, size);
+    }
+
+    case ElementTypeId::kInt32: {
+      return std::make_shared<NullColumnSource<int32_t>>(element_type, size);
+    }
+
+    case ElementTypeId::kInt64: {
+      return std::make_shared<NullColumnSource<int64_t>>(element_type, size);
+    }
+
+    case ElementTypeId::kFloat: {
+      return std::make_shared<NullColumnSource<float>>(element_type, size);
+    }
+
+    case ElementTypeId::kDouble: {
+      return std::make_shared<NullColumnSource<double>>(element_type, size);
+    }
+
+    case ElementTypeId::kBool: {
+      return std::make_shared<NullColumnSource<bool>>(element_type, size);
+    }
+
+    case ElementTypeId::kString: {
+      return std::make_shared<NullColumnSource<std::string>>(element_type, size);
+    }
+
+    case ElementTypeId::kTimestamp: {
+      return std::make_shared<NullColumnSource<DateTime>>(element_type, size);
+    }
+
+    case ElementTypeId::kLocalDate: {
+      return std::make_shared<NullColumnSource<LocalDate>>(element_type, size);
+    }
+
+    case ElementTypeId::kLocalTime: {
+      return std::make_shared<NullColumnSource<LocalTime>>(element_type, size);
+    }
+
+    default: {
+      auto message = fmt::format("Internal error: elementTypeId {} not supported here",
+          static_cast<int>(element_type.Id()));
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+  }
+}
+}  // namespace internal
+
 namespace {
-MyTable::MyTable(std::shared_ptr<SchemaType> schema, std::vector<std::shared_ptr<ColumnSource>> sources,
+MyTable::MyTable(std::shared_ptr<SchemaType> schema, std::shared_ptr<const SourcesType> sources,
     size_t num_rows) : schema_(std::move(schema)), sources_(std::move(sources)), numRows_(num_rows) {}
 MyTable::~MyTable() = default;
 
@@ -385,6 +770,25 @@ void AssertAllSame(size_t val0, size_t val1, size_t val2) {
   }
 }
 
+bool IsIntervalAt(const RowSequence &rows, uint64_t position) {
+  if (rows.Empty()) {
+    return true;
+  }
+  size_t num_intervals = 0;
+  uint64_t first_begin = 0;
+  rows.ForEachIntervalInline([&num_intervals, &first_begin](uint64_t begin, uint64_t) {
+    if (num_intervals++ == 0) {
+      first_begin = begin;
+    }
+  });
+  return num_intervals == 1 && first_begin == position;
+}
+uint64_t EndOf(const RowSequence &rows) {
+  uint64_t result = 0;
+  rows.ForEachIntervalInline([&result](uint64_t, uint64_t end) { result = end; });
+  return result;
+}
+
 void AssertLeq(size_t lhs, size_t rhs, const char *format) {
   if (lhs <= rhs) {
     return;
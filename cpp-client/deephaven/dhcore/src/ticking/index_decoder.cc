@@ -3,13 +3,17 @@
  */
 #include "deephaven/dhcore/ticking/index_decoder.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 #include "deephaven/dhcore/container/row_sequence.h"
 #include "deephaven/dhcore/utility/utility.h"
 #include "deephaven/third_party/fmt/format.h"
 
 using deephaven::dhcore::container::RowSequence;
-using deephaven::dhcore::container::RowSequenceBuilder;
 
 namespace deephaven::dhcore::ticking {
 namespace {
@@ -27,69 +31,130 @@ struct Constants {
   static constexpr const int8_t kEnd = 32;
   static constexpr const int8_t kCmdMask = 0x78;
 };
-}  // namespace
-
-std::shared_ptr<RowSequence> IndexDecoder::ReadExternalCompressedDelta(DataInput *in) {
-  RowSequenceBuilder builder;
 
-  int64_t offset = 0;
+/**
+ * The narrowest value type (kByteValue, kShortValue, kIntValue, kLongValue) that can hold
+ * 'value'. We stay away from the most negative value of each type because the decoder negates it.
+ */
+int8_t NarrowestValueType(int64_t value) {
+  auto magnitude = value < 0 ? -value : value;
+  if (magnitude <= std::numeric_limits<int8_t>::max()) {
+    return Constants::kByteValue;
+  }
+  if (magnitude <= std::numeric_limits<int16_t>::max()) {
+    return Constants::kShortValue;
+  }
+  if (magnitude <= std::numeric_limits<int32_t>::max()) {
+    return Constants::kIntValue;
+  }
+  return Constants::kLongValue;
+}
 
-  int64_t pending = -1;
-  auto consume = [&pending, &builder](int64_t v) {
-    auto s = pending;
-    if (s == -1) {
-      pending = v;
+/**
+ * Turns the decoded stream of values into a flat, sorted interval array. A nonnegative value
+ * starts a new range (or is a singleton), and a negative value closes the range started by the
+ * value before it.
+ */
+class IntervalAccumulator {
+public:
+  void Consume(int64_t v) {
+    if (pending_ == -1) {
+      pending_ = v;
     } else if (v < 0) {
-      auto begin = static_cast<uint64_t>(s);
-      auto end = static_cast<uint64_t>(-v) + 1;
-      builder.AddInterval(begin, end);
-      pending = -1;
+      Append(static_cast<uint64_t>(pending_), static_cast<uint64_t>(-v) + 1);
+      pending_ = -1;
     } else {
-      builder.Add(s);
-      pending = v;
+      Append(static_cast<uint64_t>(pending_), static_cast<uint64_t>(pending_) + 1);
+      pending_ = v;
+    }
+  }
+
+  [[nodiscard]]
+  std::shared_ptr<RowSequence> Finish() {
+    if (pending_ >= 0) {
+      Append(static_cast<uint64_t>(pending_), static_cast<uint64_t>(pending_) + 1);
+      pending_ = -1;
     }
-  };
+    if (intervals_.empty()) {
+      return RowSequence::CreateEmpty();
+    }
+    return RowSequence::CreateFromIntervals(std::move(intervals_));
+  }
+
+private:
+  void Append(uint64_t begin, uint64_t end) {
+    // The encoding only ever moves forward, but it is free to split a run across two entries, so
+    // merge anything that touches the last interval.
+    if (!intervals_.empty() && begin <= intervals_.back().second) {
+      intervals_.back().second = std::max(intervals_.back().second, end);
+      return;
+    }
+    intervals_.emplace_back(begin, end);
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> intervals_;
+  int64_t pending_ = -1;
+};
+
+/**
+ * Decodes 'count' values of type T (the payload of a kByteArray or kShortArray command). Each
+ * block is copied out, widened, and turned into magnitudes in a loop with no dependencies between
+ * iterations (which the compiler vectorizes); only the running sum and the interval state machine
+ * are serial.
+ */
+template<typename T>
+void ExpandArray(DataInput *in, size_t count, int64_t *offset, IntervalAccumulator *accumulator) {
+  constexpr size_t kBlockSize = 256;
+  T raw[kBlockSize];
+  int64_t magnitudes[kBlockSize];
+  auto running = *offset;
+  while (count != 0) {
+    auto block_size = std::min(count, kBlockSize);
+    in->ReadArray(raw, block_size);
+    for (size_t i = 0; i != block_size; ++i) {
+      auto value = static_cast<int64_t>(raw[i]);
+      magnitudes[i] = value < 0 ? -value : value;
+    }
+    for (size_t i = 0; i != block_size; ++i) {
+      running += magnitudes[i];
+      accumulator->Consume(raw[i] < 0 ? -running : running);
+    }
+    count -= block_size;
+  }
+  *offset = running;
+}
+}  // namespace
+
+std::shared_ptr<RowSequence> IndexDecoder::ReadExternalCompressedDelta(DataInput *in) {
+  IntervalAccumulator accumulator;
+  int64_t offset = 0;
 
   while (true) {
-    int64_t actual_value;
     int command = in->ReadByte();
 
     switch (command & Constants::kCmdMask) {
       case Constants::kOffset: {
         int64_t value = in->ReadValue(command);
-          actual_value = offset + (value < 0 ? -value : value);
-        consume(value < 0 ? -actual_value : actual_value);
+        auto actual_value = offset + (value < 0 ? -value : value);
+        accumulator.Consume(value < 0 ? -actual_value : actual_value);
         offset = actual_value;
         break;
       }
 
       case Constants::kShortArray: {
-        int short_count = static_cast<int>(in->ReadValue(command));
-        for (int ii = 0; ii < short_count; ++ii) {
-          int16_t short_value = in->ReadShort();
-            actual_value = offset + (short_value < 0 ? -short_value : short_value);
-          consume(short_value < 0 ? -actual_value : actual_value);
-          offset = actual_value;
-        }
+        auto short_count = static_cast<size_t>(in->ReadValue(command));
+        ExpandArray<int16_t>(in, short_count, &offset, &accumulator);
         break;
       }
 
       case Constants::kByteArray: {
-        int byte_count = static_cast<int>(in->ReadValue(command));
-        for (int ii = 0; ii < byte_count; ++ii) {
-          int8_t byte_value = in->ReadByte();
-            actual_value = offset + (byte_value < 0 ? -byte_value : byte_value);
-          consume(byte_value < 0 ? -actual_value : actual_value);
-          offset = actual_value;
-        }
+        auto byte_count = static_cast<size_t>(in->ReadValue(command));
+        ExpandArray<int8_t>(in, byte_count, &offset, &accumulator);
         break;
       }
 
       case Constants::kEnd: {
-        if (pending >= 0) {
-          builder.Add(pending);
-        }
-        return builder.Build();
+        return accumulator.Finish();
       }
 
       default: {
@@ -100,6 +165,55 @@ std::shared_ptr<RowSequence> IndexDecoder::ReadExternalCompressedDelta(DataInput
   }
 }
 
+void IndexEncoder::WriteExternalCompressedDelta(const RowSequence &rows, DataOutput *out) {
+  // First, compute the deltas in the same form that IndexDecoder consumes them: a nonnegative
+  // delta starts a new range (or is a singleton), and a negative delta closes the range that
+  // was just started. Each delta is relative to the previous key written.
+  std::vector<int64_t> deltas;
+  int64_t offset = 0;
+  rows.ForEachIntervalInline([&deltas, &offset](uint64_t begin_key, uint64_t end_key) {
+    auto first = static_cast<int64_t>(begin_key);
+    auto last = static_cast<int64_t>(end_key - 1);
+    deltas.push_back(first - offset);
+    offset = first;
+    if (last != first) {
+      deltas.push_back(-(last - first));
+      offset = last;
+    }
+  });
+
+  // Then write them. Runs of byte-sized or short-sized deltas are packed into arrays; everything
+  // else is written one at a time as an offset.
+  size_t i = 0;
+  while (i != deltas.size()) {
+    auto value_type = NarrowestValueType(deltas[i]);
+    size_t run_end = i + 1;
+    if (value_type == Constants::kByteValue || value_type == Constants::kShortValue) {
+      while (run_end != deltas.size() && NarrowestValueType(deltas[run_end]) == value_type) {
+        ++run_end;
+      }
+    }
+    auto run_size = run_end - i;
+    if (run_size == 1) {
+      out->WriteValue(Constants::kOffset, deltas[i]);
+      ++i;
+      continue;
+    }
+    if (value_type == Constants::kByteValue) {
+      out->WriteValue(Constants::kByteArray, static_cast<int64_t>(run_size));
+      for (; i != run_end; ++i) {
+        out->WriteByte(static_cast<int8_t>(deltas[i]));
+      }
+    } else {
+      out->WriteValue(Constants::kShortArray, static_cast<int64_t>(run_size));
+      for (; i != run_end; ++i) {
+        out->WriteShort(static_cast<int16_t>(deltas[i]));
+      }
+    }
+  }
+  out->WriteByte(Constants::kEnd);
+}
+
 int64_t DataInput::ReadValue(int command) {
   switch (command & Constants::kValueMask) {
     case Constants::kLongValue: {
@@ -148,4 +262,55 @@ int64_t DataInput::ReadLong() {
   data_ += sizeof(result);
   return result;
 }
+
+void DataOutput::WriteValue(int8_t command, int64_t value) {
+  auto value_type = NarrowestValueType(value);
+  WriteByte(static_cast<int8_t>(command | value_type));
+  switch (value_type) {
+    case Constants::kLongValue: {
+      WriteLong(value);
+      return;
+    }
+    case Constants::kIntValue: {
+      WriteInt(static_cast<int32_t>(value));
+      return;
+    }
+    case Constants::kShortValue: {
+      WriteShort(static_cast<int16_t>(value));
+      return;
+    }
+    case Constants::kByteValue: {
+      WriteByte(static_cast<int8_t>(value));
+      return;
+    }
+    default: {
+      auto message = fmt::format("Bad value type: {}", value_type);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+  }
+}
+
+void DataOutput::WriteByte(int8_t value) {
+  auto size = dest_->size();
+  dest_->resize(size + sizeof(value));
+  std::memcpy(dest_->data() + size, &value, sizeof(value));
+}
+
+void DataOutput::WriteShort(int16_t value) {
+  auto size = dest_->size();
+  dest_->resize(size + sizeof(value));
+  std::memcpy(dest_->data() + size, &value, sizeof(value));
+}
+
+void DataOutput::WriteInt(int32_t value) {
+  auto size = dest_->size();
+  dest_->resize(size + sizeof(value));
+  std::memcpy(dest_->data() + size, &value, sizeof(value));
+}
+
+void DataOutput::WriteLong(int64_t value) {
+  auto size = dest_->size();
+  dest_->resize(size + sizeof(value));
+  std::memcpy(dest_->data() + size, &value, sizeof(value));
+}
 }  // namespace deephaven::dhcore::ticking
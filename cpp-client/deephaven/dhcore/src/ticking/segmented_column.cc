@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/dhcore/ticking/segmented_column.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/chunk/chunk_traits.h"
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/container/container.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/types.h"
+#include "deephaven/dhcore/utility/utility.h"
+#include "deephaven/third_party/fmt/core.h"
+
+using deephaven::dhcore::chunk::BooleanChunk;
+using deephaven::dhcore::chunk::Chunk;
+using deephaven::dhcore::chunk::TypeToChunk;
+using deephaven::dhcore::chunk::UInt64Chunk;
+using deephaven::dhcore::column::ColumnSource;
+using deephaven::dhcore::column::ColumnSourceVisitor;
+using deephaven::dhcore::column::GenericColumnSource;
+using deephaven::dhcore::container::ContainerBase;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::immerutil::AbstractFlexVectorBase;
+using deephaven::dhcore::utility::TrueOrThrow;
+using deephaven::dhcore::utility::VerboseCast;
+
+namespace deephaven::dhcore::ticking {
+namespace {
+/**
+ * An immutable column made of the rows of several other column sources, one after another.
+ * Position p of this column is absolute position p + begin_position_ of the segment list.
+ */
+#ifdef _WIN32
+// Avoid Visual Studio warning about "inherits via dominance" for diamond inheritance pattern.
+#pragma warning(push)
+#pragma warning(disable: 4250)
+#endif
+template<typename T>
+class SegmentedColumnSource final : public GenericColumnSource<T> {
+  using chunkType_t = typename TypeToChunk<T>::type_t;
+
+public:
+  SegmentedColumnSource(const ElementType &element_type, immer::flex_vector<ColumnSegment> segments,
+      uint64_t begin_position, size_t size) : element_type_(element_type),
+      segments_(std::move(segments)), begin_position_(begin_position), size_(size) {}
+  ~SegmentedColumnSource() final = default;
+
+  void FillChunk(const RowSequence &rows, Chunk *dest_data,
+      BooleanChunk *optional_dest_null_flags) const final {
+    auto *typed_dest = VerboseCast<chunkType_t *>(DEEPHAVEN_LOCATION_EXPR(dest_data));
+    TrueOrThrow(DEEPHAVEN_LOCATION_EXPR(rows.Size() <= typed_dest->Size()));
+    TrueOrThrow(DEEPHAVEN_LOCATION_EXPR(optional_dest_null_flags == nullptr ||
+        rows.Size() <= optional_dest_null_flags->Size()));
+
+    if (segments_.size() == 1 && segments_[0].begin_ + begin_position_ == segments_[0].position_) {
+      // The common case of a single segment whose coordinates are our own, so the rows can be
+      // passed straight through.
+      uint64_t last_end = 0;
+      rows.ForEachIntervalInline([&last_end](uint64_t /*begin*/, uint64_t end) { last_end = end; });
+      CheckRange(last_end);
+      segments_[0].source_->FillChunk(rows, dest_data, optional_dest_null_flags);
+      return;
+    }
+
+    // Rows that fall in the same segment are gathered into one RowSequence, so that each segment
+    // gets a single FillChunk call however fragmented 'rows' is. Because 'rows' is ordered, the
+    // rows of each segment land in a contiguous slice of the destination.
+    size_t segment_index = segments_.size();
+    uint64_t segment_end = 0;
+    size_t dest_offset = 0;
+    size_t pending = 0;
+    RowSequenceBuilder builder;
+    auto flush = [&]() {
+      if (pending == 0) {
+        return;
+      }
+      auto segment_rows = builder.Build();
+      auto dest_slice = typed_dest->Drop(dest_offset).Take(pending);
+      BooleanChunk null_slice;
+      BooleanChunk *null_slicep = nullptr;
+      if (optional_dest_null_flags != nullptr) {
+        null_slice = optional_dest_null_flags->Drop(dest_offset).Take(pending);
+        null_slicep = &null_slice;
+      }
+      segments_[segment_index].source_->FillChunk(*segment_rows, &dest_slice, null_slicep);
+      dest_offset += pending;
+      pending = 0;
+    };
+
+    rows.ForEachIntervalInline([&](uint64_t begin, uint64_t end) {
+      CheckRange(end);
+      auto current = begin + begin_position_;
+      auto stop = end + begin_position_;
+      while (current != stop) {
+        if (segment_index == segments_.size() || current >= segment_end) {
+          flush();
+          segment_index = Locate(current);
+          segment_end = EndOf(segments_[segment_index]);
+        }
+        const auto &segment = segments_[segment_index];
+        auto count = std::min(stop, segment_end) - current;
+        auto src_begin = segment.begin_ + (current - segment.position_);
+        builder.AddInterval(src_begin, src_begin + count);
+        pending += count;
+        current += count;
+      }
+    });
+    flush();
+  }
+
+  void FillChunkUnordered(const UInt64Chunk &rows, Chunk *dest_data,
+      BooleanChunk *optional_dest_null_flags) const final {
+    auto *typed_dest = VerboseCast<chunkType_t *>(DEEPHAVEN_LOCATION_EXPR(dest_data));
+    TrueOrThrow(DEEPHAVEN_LOCATION_EXPR(rows.Size() <= typed_dest->Size()));
+    TrueOrThrow(DEEPHAVEN_LOCATION_EXPR(optional_dest_null_flags == nullptr ||
+        rows.Size() <= optional_dest_null_flags->Size()));
+
+    // Translate the keys into each segment's own coordinates and hand over runs of consecutive
+    // keys that fall in the same segment.
+    auto translated = UInt64Chunk::Create(rows.Size());
+    size_t run_begin = 0;
+    while (run_begin != rows.Size()) {
+      CheckRange(rows[run_begin] + 1);
+      auto segment_index = Locate(rows[run_begin] + begin_position_);
+      const auto &segment = segments_[segment_index];
+      auto segment_end = EndOf(segment);
+      auto run_end = run_begin;
+      while (run_end != rows.Size()) {
+        auto position = rows[run_end] + begin_position_;
+        if (position < segment.position_ || position >= segment_end) {
+          break;
+        }
+        translated[run_end] = segment.begin_ + (position - segment.position_);
+        ++run_end;
+      }
+      auto count = run_end - run_begin;
+      auto keys_slice = translated.Drop(run_begin).Take(count);
+      auto dest_slice = typed_dest->Drop(run_begin).Take(count);
+      BooleanChunk null_slice;
+      BooleanChunk *null_slicep = nullptr;
+      if (optional_dest_null_flags != nullptr) {
+        null_slice = optional_dest_null_flags->Drop(run_begin).Take(count);
+        null_slicep = &null_slice;
+      }
+      segment.source_->FillChunkUnordered(keys_slice, &dest_slice, null_slicep);
+      run_begin = run_end;
+    }
+  }
+
+  [[nodiscard]]
+  const T *ContiguousData(size_t begin, size_t end, size_t *available) const final {
+    *available = 0;
+    if (begin == end) {
+      return nullptr;
+    }
+    CheckRange(end);
+    auto position = begin + begin_position_;
+    const auto &segment = segments_[Locate(position)];
+    const auto *typed_source = dynamic_cast<const GenericColumnSource<T> *>(segment.source_.get());
+    if (typed_source == nullptr) {
+      return nullptr;
+    }
+    auto count = std::min<uint64_t>(end + begin_position_, EndOf(segment)) - position;
+    auto src_begin = segment.begin_ + (position - segment.position_);
+    return typed_source->ContiguousData(src_begin, src_begin + count, available);
+  }
+
+  [[nodiscard]]
+  const ElementType &GetElementType() const final {
+    return element_type_;
+  }
+
+  void AcceptVisitor(ColumnSourceVisitor *visitor) const final {
+    visitor->Visit(*this);
+  }
+
+private:
+  static uint64_t EndOf(const ColumnSegment &segment) {
+    return segment.position_ + (segment.end_ - segment.begin_);
+  }
+
+  /**
+   * The index of the segment holding absolute position 'position', which must be in range.
+   */
+  [[nodiscard]]
+  size_t Locate(uint64_t position) const {
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), position,
+        [](uint64_t pos, const ColumnSegment &segment) { return pos < segment.position_; });
+    return static_cast<size_t>(it - segments_.begin()) - 1;
+  }
+
+  void CheckRange(uint64_t end) const {
+    if (end > size_) {
+      auto message = fmt::format("Row {} is out of range for a column of size {}", end - 1, size_);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+  }
+
+  ElementType element_type_;
+  immer::flex_vector<ColumnSegment> segments_;
+  uint64_t begin_position_ = 0;
+  size_t size_ = 0;
+};
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+template<typename T>
+std::shared_ptr<ColumnSource> Make(const ElementType &element_type,
+    immer::flex_vector<ColumnSegment> segments, uint64_t begin_position, size_t size) {
+  return std::make_shared<SegmentedColumnSource<T>>(element_type, std::move(segments),
+      begin_position, size);
+}
+}  // namespace
+
+SegmentedColumn::SegmentedColumn(const ElementType &element_type,
+    std::unique_ptr<AbstractFlexVectorBase> empty_tail) : elementType_(element_type),
+    tail_(std::move(empty_tail)) {}
+SegmentedColumn::~SegmentedColumn() = default;
+
+void SegmentedColumn::Append(const std::shared_ptr<ColumnSource> &source, size_t begin,
+    size_t end) {
+  auto size = end - begin;
+  if (size == 0) {
+    return;
+  }
+  if (size >= kMinZeroCopyRows) {
+    FreezeTail();
+    segments_ = std::move(segments_).push_back(ColumnSegment{source, begin, end, endPosition_});
+    endPosition_ += size;
+    return;
+  }
+
+  // Copy it into the tail, and refresh the tail's entry in segments_.
+  tail_->InPlaceAppendSource(*source, begin, end);
+  ColumnSegment tail_segment{tail_->MakeColumnSource(), 0, tailSize_ + size,
+      endPosition_ - tailSize_};
+  if (tailSize_ == 0) {
+    segments_ = std::move(segments_).push_back(std::move(tail_segment));
+  } else {
+    segments_ = std::move(segments_).set(segments_.size() - 1, std::move(tail_segment));
+  }
+  tailSize_ += size;
+  endPosition_ += size;
+}
+
+void SegmentedColumn::EraseFront(size_t count) {
+  if (count > Size()) {
+    auto message = fmt::format("Can't erase {} rows from a column of size {}", count, Size());
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  beginPosition_ += count;
+  // Drop the segments that are now entirely erased. A partially erased segment stays as it is;
+  // beginPosition_ tells us where its live rows start.
+  size_t num_dead = 0;
+  while (num_dead != segments_.size()) {
+    const auto &segment = segments_[num_dead];
+    if (segment.position_ + (segment.end_ - segment.begin_) > beginPosition_) {
+      break;
+    }
+    ++num_dead;
+  }
+  if (num_dead != 0) {
+    segments_ = std::move(segments_).drop(num_dead);
+  }
+
+  if (tailSize_ == 0) {
+    return;
+  }
+  if (segments_.empty()) {
+    // The tail went too.
+    tail_ = tail_->Take(0);
+    tailSize_ = 0;
+    return;
+  }
+  // If the erasure reached into the tail, trim it, so that a table which keeps losing rows from
+  // the front does not accumulate dead rows in its tail.
+  auto tail_position = endPosition_ - tailSize_;
+  if (segments_.size() == 1 && tail_position < beginPosition_) {
+    auto num_erased = static_cast<size_t>(beginPosition_ - tail_position);
+    tail_->InPlaceDrop(num_erased);
+    tailSize_ -= num_erased;
+    segments_ = std::move(segments_).set(0,
+        ColumnSegment{tail_->MakeColumnSource(), 0, tailSize_, beginPosition_});
+  }
+}
+
+std::shared_ptr<ColumnSource> SegmentedColumn::MakeColumnSource() const {
+  return MakeSegmentedColumnSource(elementType_, segments_, beginPosition_, Size());
+}
+
+void SegmentedColumn::FreezeTail() {
+  if (tailSize_ == 0) {
+    return;
+  }
+  // The tail's last snapshot is already in segments_, so just start a new tail.
+  tail_ = tail_->Take(0);
+  tailSize_ = 0;
+}
+
+std::shared_ptr<ColumnSource> MakeSegmentedColumnSource(const ElementType &element_type,
+    immer::flex_vector<ColumnSegment> segments, uint64_t begin_position, size_t size) {
+  if (element_type.ListDepth() > 1) {
+    auto message = fmt::format("Don't know how to make segmented column sources with list depth {}",
+        element_type.ListDepth());
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+
+  if (element_type.ListDepth() == 1) {
+    return Make<std::shared_ptr<ContainerBase>>(element_type, std::move(segments), begin_position,
+        size);
+  }
+
+  switch (element_type.Id()) {
+    case ElementTypeId::kChar: {
+      return Make<char16_t>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kInt8: {
+      return Make<int8_t>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kInt16: {
+      return Make<int16_t>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kInt32: {
+      return Make<int32_t>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kInt64: {
+      return Make<int64_t>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kFloat: {
+      return Make<float>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kDouble: {
+      return Make<double>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kBool: {
+      return Make<bool>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kString: {
+      return Make<std::string>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kTimestamp: {
+      return Make<DateTime>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kLocalDate: {
+      return Make<LocalDate>(element_type, std::move(segments), begin_position, size);
+    }
+
+    case ElementTypeId::kLocalTime: {
+      return Make<LocalTime>(element_type, std::move(segments), begin_position, size);
+    }
+
+    default: {
+      auto message = fmt::format("Internal error: elementTypeId {} not supported here",
+          static_cast<int>(element_type.Id()));
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+  }
+}
+}  // namespace deephaven::dhcore::ticking
@@ -1,83 +1,127 @@
 /*
  * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
  */
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
 #include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/shift_processor.h"
 #include "deephaven/dhcore/ticking/space_mapper.h"
 #include "deephaven/dhcore/utility/utility.h"
 #include "deephaven/third_party/fmt/format.h"
 
 using deephaven::dhcore::container::RowSequence;
 using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::subscription::ShiftProcessor;
 using deephaven::dhcore::utility::MakeReservedVector;
 using deephaven::dhcore::utility::separatedList;
 
 namespace deephaven::dhcore::ticking {
+namespace {
+/**
+ * Accumulates keys (which must arrive in increasing order) into a RowSequence, coalescing runs
+ * of consecutive keys so we feed the builder whole intervals.
+ */
+class IntervalCoalescer {
+public:
+  void Add(uint64_t key) {
+    if (!empty_ && key == end_key_) {
+      ++end_key_;
+      return;
+    }
+    Flush();
+    begin_key_ = key;
+    end_key_ = key + 1;
+    empty_ = false;
+  }
+
+  [[nodiscard]]
+  std::shared_ptr<RowSequence> Build() {
+    Flush();
+    return builder_.Build();
+  }
+
+private:
+  void Flush() {
+    if (!empty_) {
+      builder_.AddInterval(begin_key_, end_key_);
+    }
+  }
+
+  RowSequenceBuilder builder_;
+  bool empty_ = true;
+  uint64_t begin_key_ = 0;
+  uint64_t end_key_ = 0;
+};
+}  // namespace
+
 SpaceMapper::SpaceMapper() = default;
 SpaceMapper::~SpaceMapper() = default;
 
 uint64_t SpaceMapper::AddRange(uint64_t begin_key, uint64_t end_key) {
-  roaring::Roaring64Map x;
   auto size = end_key - begin_key;
-  auto initial_size = set_.cardinality();
-  set_.addRange(begin_key, end_key);
-  if (set_.cardinality() != initial_size + size) {
+  auto result = ZeroBasedRank(begin_key);
+  if (ZeroBasedRank(end_key) != result) {
     auto message = fmt::format("Some elements of [{},{}) were already in the set", begin_key,
         end_key);
     throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
   }
-  return ZeroBasedRank(begin_key);
+  auto added = InsertRange(begin_key, end_key);
+  if (added != size) {
+    auto message = fmt::format("Expected to add {} keys in [{},{}) but added {}", size,
+        begin_key, end_key, added);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  return result;
 }
 
 uint64_t SpaceMapper::EraseRange(uint64_t begin_key, uint64_t end_key) {
   auto result = ZeroBasedRank(begin_key);
-  set_.removeRange(begin_key, end_key);
+  (void)RemoveRange(begin_key, end_key);
   return result;
 }
 
 void SpaceMapper::ApplyShift(uint64_t begin_key, uint64_t end_key, uint64_t dest_key) {
-  // Shifts do not change the size of the set. So, note the original size as a sanity check.
-  auto original_size = set_.cardinality();
-
+  if (begin_key >= end_key || begin_key == dest_key) {
+    return;
+  }
   // Note that [begin_key, end_key) is potentially a superset of the keys we have.
   // We need to remove all our keys in the range [begin_key, end_key),
   // and then, for each key k that we removed, add a new key (k - begin_key + dest_key).
-
-  // As we scan the keys in our set, we build this vector which contains contiguous ranges.
-  std::vector<std::pair<uint64_t, uint64_t>> new_ranges;
-  auto it = set_.begin();
-  if (!it.move(begin_key)) {
-    // begin_key is bigger than any key in our set, so the shift request has no effect.
-    return;
-  }
-
-  while (it != set_.end() && *it < end_key) {
-    auto offset = *it - begin_key;
-    auto new_key = dest_key + offset;
-    if (!new_ranges.empty() && new_ranges.back().second == new_key) {
-      // This key is contiguous with the last range, so extend it by one.
-      ++new_ranges.back().second;
-    } else {
-      // This key is not contiguous with the last range (or there is no last range), so
-      // start a new range here having size 1.
-      new_ranges.emplace_back(new_key, new_key + 1);
-    }
-    ++it;
+  auto moved = ExtractRange(begin_key, end_key);
+  // Unsigned arithmetic wraps, so adding this moves keys down as well as up.
+  auto offset = dest_key - begin_key;
+  uint64_t num_moved = 0;
+  uint64_t num_added = 0;
+  while (!moved.empty()) {
+    auto node = moved.extract(moved.begin());
+    num_moved += node.mapped().cardinality_;
+    num_added += InsertShiftedBucket(std::move(node), offset);
   }
 
-  set_.removeRange(begin_key, end_key);
-  for (const auto &range : new_ranges) {
-    set_.addRange(range.first, range.second);
-  }
-
-  // Sanity check.
-  auto final_size = set_.cardinality();
-  if (original_size != final_size) {
-    auto message = fmt::format("Unexpected rowkey size change: from {} to {}", original_size,
-        final_size);
+  // Shifts do not change the size of the set. Sanity check that no key landed on an existing one.
+  if (num_added != num_moved) {
+    auto message = fmt::format("Unexpected rowkey size change: moved {}, added {}", num_moved,
+        num_added);
     throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
   }
 }
 
+void SpaceMapper::ApplyShifts(const RowSequence &first_index, const RowSequence &last_index,
+    const RowSequence &dest_index) {
+  auto process_shift = [this](int64_t first, int64_t last, int64_t dest) {
+    uint64_t begin = first;
+    uint64_t end = static_cast<uint64_t>(last) + 1;
+    uint64_t dest_begin = dest;
+    ApplyShift(begin, end, dest_begin);
+  };
+  ShiftProcessor::ApplyShiftData(first_index, last_index, dest_index, process_shift);
+}
+
 std::shared_ptr<RowSequence> SpaceMapper::AddKeys(const RowSequence &keys) {
   RowSequenceBuilder builder;
   auto add_interval = [this, &builder](uint64_t begin_key, uint64_t end_key) {
@@ -85,7 +129,7 @@ std::shared_ptr<RowSequence> SpaceMapper::AddKeys(const RowSequence &keys) {
     auto begin_index = AddRange(begin_key, end_key);
     builder.AddInterval(begin_index, begin_index + size);
   };
-  keys.ForEachInterval(add_interval);
+  keys.ForEachIntervalInline(add_interval);
   return builder.Build();
 }
 
@@ -96,36 +140,240 @@ std::shared_ptr<RowSequence> SpaceMapper::ConvertKeysToIndices(const RowSequence
 
   RowSequenceBuilder builder;
   auto convert_interval = [this, &builder](uint64_t begin_key, uint64_t end_key) {
-    auto beginp = set_.begin();
-    if (!beginp.move(begin_key)) {
-      auto message = fmt::format("begin key {} is too large for the src map", begin_key);
-      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
-    }
     auto next_rank = ZeroBasedRank(begin_key);
     // Confirm we have entries for everything in the range.
-    auto currentp = beginp;
-    for (auto current_key = begin_key; current_key != end_key; ++current_key) {
-      if (current_key != *currentp) {
-        auto message = fmt::format("Current key {} is in not the src map", current_key);
-        throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
-      }
-      ++currentp;
+    auto size = end_key - begin_key;
+    if (ZeroBasedRank(end_key) - next_rank != size) {
+      auto message = fmt::format("Some keys in [{},{}) are not in the src map", begin_key,
+          end_key);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
     }
     // It is ok to add a chunk like this because rowkeys [begin_key, end_key) are contiguous;
     // therefore their corresponding index space indices are also contiguous.
-    auto size = end_key - begin_key;
     builder.AddInterval(next_rank, next_rank + size);
   };
-  keys.ForEachInterval(convert_interval);
+  keys.ForEachIntervalInline(convert_interval);
   return builder.Build();
 }
 
+void SpaceMapper::EraseKeys(const RowSequence &keys) {
+  keys.ForEachIntervalInline([this](uint64_t begin_key, uint64_t end_key) {
+    (void)RemoveRange(begin_key, end_key);
+  });
+}
+
+std::shared_ptr<RowSequence> SpaceMapper::Keys() const {
+  IntervalCoalescer result;
+  for (const auto &[bucket_id, bucket] : buckets_) {
+    auto bucket_base = bucket_id << kBucketBits;
+    for (auto value : bucket.bits_) {
+      result.Add(bucket_base + value);
+    }
+  }
+  return result.Build();
+}
+
 uint64_t SpaceMapper::ZeroBasedRank(uint64_t value) const {
+  auto bucket_id = value >> kBucketBits;
+  ExtendRankIndex(bucket_id);
+  auto ip = std::lower_bound(rank_index_.begin(), rank_index_.end(), bucket_id,
+      [](const RankEntry &entry, uint64_t id) { return entry.bucket_id_ < id; });
+  if (ip == rank_index_.end()) {
+    // The index covers every bucket <= bucket_id, so every key in the map is less than 'value'
+    // unless we have no bucket at or after it. In both cases this is the number of keys covered.
+    if (rank_index_.empty()) {
+      return 0;
+    }
+    const auto &last = rank_index_.back();
+    return last.keys_before_ + buckets_.find(last.bucket_id_)->second.cardinality_;
+  }
+  if (ip->bucket_id_ != bucket_id) {
+    return ip->keys_before_;
+  }
   // Roaring's convention for rank is to "Return the number of integers that are smaller or equal to x".
   // But we would rather know the number of values that are strictly smaller than x.
-  auto result = set_.rank(value);
-  // Adjust if 'value' is in the set.
-  return set_.contains(value) ? result - 1 : result;
+  auto low_bits = static_cast<uint32_t>(value & (kBucketSize - 1));
+  if (low_bits == 0) {
+    return ip->keys_before_;
+  }
+  return ip->keys_before_ + buckets_.find(bucket_id)->second.bits_.rank(low_bits - 1);
+}
+
+uint64_t SpaceMapper::InsertRange(uint64_t begin_key, uint64_t end_key) {
+  if (begin_key >= end_key) {
+    return 0;
+  }
+  InvalidateRankIndex(begin_key >> kBucketBits);
+  uint64_t num_added = 0;
+  while (begin_key != end_key) {
+    auto bucket_id = begin_key >> kBucketBits;
+    auto bucket_base = bucket_id << kBucketBits;
+    auto bucket_end = std::min(end_key, bucket_base + kBucketSize);
+    auto &bucket = buckets_[bucket_id];
+    bucket.bits_.addRangeClosed(static_cast<uint32_t>(begin_key - bucket_base),
+        static_cast<uint32_t>(bucket_end - 1 - bucket_base));
+    auto new_cardinality = bucket.bits_.cardinality();
+    num_added += new_cardinality - bucket.cardinality_;
+    bucket.cardinality_ = new_cardinality;
+    begin_key = bucket_end;
+  }
+  cardinality_ += num_added;
+  return num_added;
+}
+
+uint64_t SpaceMapper::RemoveRange(uint64_t begin_key, uint64_t end_key) {
+  if (begin_key >= end_key) {
+    return 0;
+  }
+  auto last_bucket_id = (end_key - 1) >> kBucketBits;
+  auto ip = buckets_.lower_bound(begin_key >> kBucketBits);
+  if (ip == buckets_.end() || ip->first > last_bucket_id) {
+    return 0;
+  }
+  InvalidateRankIndex(ip->first);
+  uint64_t num_removed = 0;
+  while (ip != buckets_.end() && ip->first <= last_bucket_id) {
+    auto bucket_base = ip->first << kBucketBits;
+    auto &bucket = ip->second;
+    auto low = std::max(begin_key, bucket_base) - bucket_base;
+    auto high = std::min(end_key, bucket_base + kBucketSize) - 1 - bucket_base;
+    bucket.bits_.removeRangeClosed(static_cast<uint32_t>(low), static_cast<uint32_t>(high));
+    auto new_cardinality = bucket.bits_.cardinality();
+    num_removed += bucket.cardinality_ - new_cardinality;
+    bucket.cardinality_ = new_cardinality;
+    ip = new_cardinality == 0 ? buckets_.erase(ip) : std::next(ip);
+  }
+  cardinality_ -= num_removed;
+  return num_removed;
+}
+
+SpaceMapper::buckets_t SpaceMapper::ExtractRange(uint64_t begin_key, uint64_t end_key) {
+  buckets_t result;
+  if (begin_key >= end_key) {
+    return result;
+  }
+  auto last_bucket_id = (end_key - 1) >> kBucketBits;
+  auto ip = buckets_.lower_bound(begin_key >> kBucketBits);
+  if (ip == buckets_.end() || ip->first > last_bucket_id) {
+    return result;
+  }
+  InvalidateRankIndex(ip->first);
+  while (ip != buckets_.end() && ip->first <= last_bucket_id) {
+    auto bucket_base = ip->first << kBucketBits;
+    auto &bucket = ip->second;
+    auto low = static_cast<uint32_t>(std::max(begin_key, bucket_base) - bucket_base);
+    auto high = static_cast<uint32_t>(std::min(end_key, bucket_base + kBucketSize) - 1 -
+        bucket_base);
+    if (low == 0 && high == kBucketSize - 1) {
+      // The whole bucket is in range, so detach it without copying.
+      cardinality_ -= bucket.cardinality_;
+      auto next = std::next(ip);
+      result.insert(buckets_.extract(ip));
+      ip = next;
+      continue;
+    }
+    roaring::Roaring range;
+    range.addRangeClosed(low, high);
+    Bucket part;
+    part.bits_ = bucket.bits_ & range;
+    part.cardinality_ = part.bits_.cardinality();
+    if (part.cardinality_ != 0) {
+      bucket.bits_.removeRangeClosed(low, high);
+      bucket.cardinality_ -= part.cardinality_;
+      cardinality_ -= part.cardinality_;
+      result.emplace(ip->first, std::move(part));
+    }
+    ip = bucket.cardinality_ == 0 ? buckets_.erase(ip) : std::next(ip);
+  }
+  return result;
 }
-}  // namespace deephaven::dhcore::ticking
 
+uint64_t SpaceMapper::InsertShiftedBucket(buckets_t::node_type node, uint64_t offset) {
+  auto new_base = (node.key() << kBucketBits) + offset;
+  auto new_bucket_id = new_base >> kBucketBits;
+  auto low_offset = static_cast<uint32_t>(new_base & (kBucketSize - 1));
+  const auto &bits = node.mapped().bits_;
+  auto cardinality = node.mapped().cardinality_;
+
+  if (low_offset == 0) {
+    // The container moves intact to a new bucket id. If that bucket is vacant we just relink the
+    // node; otherwise we merge into it.
+    InvalidateRankIndex(new_bucket_id);
+    node.key() = new_bucket_id;
+    auto inserted = buckets_.insert(std::move(node));
+    if (inserted.inserted) {
+      cardinality_ += cardinality;
+      return cardinality;
+    }
+    auto &dest = inserted.position->second;
+    dest.bits_ |= inserted.node.mapped().bits_;
+    auto new_cardinality = dest.bits_.cardinality();
+    auto num_added = new_cardinality - dest.cardinality_;
+    dest.cardinality_ = new_cardinality;
+    cardinality_ += num_added;
+    return num_added;
+  }
+
+  auto min = bits.minimum();
+  auto max = bits.maximum();
+  if (max - min + 1 == cardinality) {
+    // A single run (typical for dense tables) moves as a range.
+    return InsertRange(new_base + min, new_base + max + 1);
+  }
+
+  // Otherwise the keys straddle two destination buckets. Values below 'split' land in
+  // new_bucket_id and the rest in the bucket after it; in both cases the new low bits are
+  // (value + low_offset) modulo the bucket size.
+  std::vector<uint32_t> values(cardinality);
+  bits.toUint32Array(values.data());
+  auto split = static_cast<size_t>(std::lower_bound(values.begin(), values.end(),
+      static_cast<uint32_t>(kBucketSize - low_offset)) - values.begin());
+  for (auto &value : values) {
+    value = (value + low_offset) & static_cast<uint32_t>(kBucketSize - 1);
+  }
+  // Bucket ids are the high (64 - kBucketBits) bits of a key, so the next one wraps accordingly.
+  auto next_bucket_id = (new_bucket_id + 1) & (std::numeric_limits<uint64_t>::max() >> kBucketBits);
+  return AddManyToBucket(new_bucket_id, values.data(), split) +
+      AddManyToBucket(next_bucket_id, values.data() + split, values.size() - split);
+}
+
+uint64_t SpaceMapper::AddManyToBucket(uint64_t bucket_id, const uint32_t *values, size_t count) {
+  if (count == 0) {
+    return 0;
+  }
+  InvalidateRankIndex(bucket_id);
+  auto &bucket = buckets_[bucket_id];
+  bucket.bits_.addMany(count, values);
+  auto new_cardinality = bucket.bits_.cardinality();
+  auto num_added = new_cardinality - bucket.cardinality_;
+  bucket.cardinality_ = new_cardinality;
+  cardinality_ += num_added;
+  return num_added;
+}
+
+void SpaceMapper::InvalidateRankIndex(uint64_t bucket_id) {
+  auto ip = std::lower_bound(rank_index_.begin(), rank_index_.end(), bucket_id,
+      [](const RankEntry &entry, uint64_t id) { return entry.bucket_id_ < id; });
+  rank_index_.erase(ip, rank_index_.end());
+}
+
+void SpaceMapper::ExtendRankIndex(uint64_t bucket_id) const {
+  if (!rank_index_.empty() && rank_index_.back().bucket_id_ >= bucket_id) {
+    return;
+  }
+  buckets_t::const_iterator ip;
+  uint64_t keys_before = 0;
+  if (rank_index_.empty()) {
+    ip = buckets_.begin();
+  } else {
+    const auto &last = rank_index_.back();
+    ip = buckets_.find(last.bucket_id_);
+    keys_before = last.keys_before_ + ip->second.cardinality_;
+    ++ip;
+  }
+  for (; ip != buckets_.end() && ip->first <= bucket_id; ++ip) {
+    rank_index_.push_back(RankEntry{ip->first, keys_before});
+    keys_before += ip->second.cardinality_;
+  }
+}
+}  // namespace deephaven::dhcore::ticking
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/dhcore/ticking/subscription_options.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include "deephaven/dhcore/utility/utility.h"
+#include "deephaven/third_party/fmt/format.h"
+
+namespace deephaven::dhcore::ticking {
+namespace {
+void CheckNotNegative(const char *what, int32_t value) {
+  if (value < 0) {
+    auto message = fmt::format("{} must be non-negative, got {}", what, value);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+}
+}  // namespace
+
+SubscriptionOptions::SubscriptionOptions() = default;
+SubscriptionOptions::SubscriptionOptions(const SubscriptionOptions &other) = default;
+SubscriptionOptions::SubscriptionOptions(SubscriptionOptions &&other) noexcept = default;
+SubscriptionOptions &SubscriptionOptions::operator=(const SubscriptionOptions &other) = default;
+SubscriptionOptions &SubscriptionOptions::operator=(SubscriptionOptions &&other) noexcept = default;
+SubscriptionOptions::~SubscriptionOptions() = default;
+
+SubscriptionOptions &SubscriptionOptions::SetBatchSize(int32_t batch_size) {
+  if (batch_size <= 0) {
+    auto message = fmt::format("batch_size must be positive, got {}", batch_size);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  batchSize_ = batch_size;
+  return *this;
+}
+
+SubscriptionOptions &SubscriptionOptions::SetMaxMessageSize(int32_t max_message_size) {
+  CheckNotNegative("max_message_size", max_message_size);
+  maxMessageSize_ = max_message_size;
+  return *this;
+}
+
+SubscriptionOptions &SubscriptionOptions::SetMinUpdateIntervalMs(int32_t min_update_interval_ms) {
+  CheckNotNegative("min_update_interval_ms", min_update_interval_ms);
+  minUpdateIntervalMs_ = min_update_interval_ms;
+  return *this;
+}
+
+SubscriptionOptions &SubscriptionOptions::SetColumnConversionMode(
+    ColumnConversionMode column_conversion_mode) {
+  switch (column_conversion_mode) {
+    case ColumnConversionMode::kStringify:
+    case ColumnConversionMode::kJavaSerialization:
+    case ColumnConversionMode::kThrowError:
+      break;
+    default: {
+      auto message = fmt::format("Unknown ColumnConversionMode {}",
+          static_cast<int>(column_conversion_mode));
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+  }
+  columnConversionMode_ = column_conversion_mode;
+  return *this;
+}
+
+SubscriptionOptions &SubscriptionOptions::SetColumnParallelism(int32_t column_parallelism) {
+  if (column_parallelism <= 0) {
+    auto message = fmt::format("column_parallelism must be positive, got {}", column_parallelism);
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  columnParallelism_ = column_parallelism;
+  return *this;
+}
+
+SubscriptionOptions &SubscriptionOptions::SetZeroCopyAppends(bool zero_copy_appends) {
+  zeroCopyAppends_ = zero_copy_appends;
+  return *this;
+}
+
+SubscriptionOptions &SubscriptionOptions::SetDeltasOnly(bool deltas_only) {
+  deltasOnly_ = deltas_only;
+  return *this;
+}
+
+SubscriptionOptions &SubscriptionOptions::SetPipelineDepth(int32_t pipeline_depth) {
+  CheckNotNegative("pipeline_depth", pipeline_depth);
+  pipelineDepth_ = pipeline_depth;
+  return *this;
+}
+
+SubscriptionOptions &SubscriptionOptions::SetConflationPolicy(ConflationPolicy conflation_policy) {
+  switch (conflation_policy) {
+    case ConflationPolicy::kNone:
+    case ConflationPolicy::kReplace:
+    case ConflationPolicy::kMerge:
+      break;
+    default: {
+      auto message = fmt::format("Unknown ConflationPolicy {}",
+          static_cast<int>(conflation_policy));
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+  }
+  conflationPolicy_ = conflation_policy;
+  return *this;
+}
+}  // namespace deephaven::dhcore::ticking
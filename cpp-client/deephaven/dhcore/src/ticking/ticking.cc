@@ -4,26 +4,131 @@
 #include "deephaven/dhcore/container/row_sequence.h"
 #include "deephaven/dhcore/ticking/ticking.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <utility>
 #include <vector>
+#include <immer/flex_vector.hpp>
+#include <immer/flex_vector_transient.hpp>
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/ticking/immer_table_state.h"
+#include "deephaven/dhcore/ticking/segmented_column.h"
+#include "deephaven/dhcore/utility/utility.h"
 
 namespace deephaven::dhcore::ticking {
+using deephaven::dhcore::clienttable::ClientTable;
+using deephaven::dhcore::column::ColumnSource;
 using deephaven::dhcore::container::RowSequence;
 using deephaven::dhcore::container::RowSequenceBuilder;
 
+namespace {
+using Intervals = std::vector<std::pair<uint64_t, uint64_t>>;
+
+/**
+ * A stretch of 'size_' consecutive rows of the table that an update produced, starting at
+ * position 'dest_begin_' there. Either the update added them, or they were carried over from the
+ * table it started with, where they start at position 'source_begin_'.
+ */
+struct Run {
+  bool added_ = false;
+  uint64_t source_begin_ = 0;
+  uint64_t dest_begin_ = 0;
+  uint64_t size_ = 0;
+};
+
+/**
+ * Where each row of the table that an update (or a sequence of them) produced came from, as a
+ * list of Runs in position order.
+ */
+class Layout {
+public:
+  /**
+   * The layout of the table that results from removing 'removed' from a table of 'old_size' rows
+   * and then adding 'added' (in the coordinates of the result).
+   */
+  [[nodiscard]]
+  static Layout Of(const RowSequence &removed, const RowSequence &added, uint64_t old_size);
+  /**
+   * The layout of 'second' in terms of the table that 'first' started with, given that 'second'
+   * started with the table that 'first' produced.
+   */
+  [[nodiscard]]
+  static Layout Compose(const Layout &first, const Layout &second);
+
+  /**
+   * Appends a run of 'size' rows, merging it into the last run where possible.
+   */
+  void Append(bool added, uint64_t source_begin, uint64_t size);
+
+  /**
+   * The positions of the result that were added (or not, if 'added' is false).
+   */
+  [[nodiscard]]
+  Intervals DestIntervals(bool added) const;
+
+  /**
+   * The positions of the old table of 'old_size' rows that did not survive.
+   */
+  [[nodiscard]]
+  std::shared_ptr<RowSequence> Removed(uint64_t old_size) const;
+
+  /**
+   * Translates 'rows', which are positions in the old table, to positions in the result, dropping
+   * the ones that did not survive.
+   */
+  [[nodiscard]]
+  Intervals MapForward(const RowSequence &rows) const;
+
+  [[nodiscard]]
+  const std::vector<Run> &Runs() const { return runs_; }
+
+private:
+  std::vector<Run> runs_;
+  uint64_t size_ = 0;
+};
+
+Intervals ToIntervals(const RowSequence &rows);
+std::shared_ptr<RowSequence> Intersect(const Intervals &lhs, const Intervals &rhs);
+std::shared_ptr<ClientTable> MakeSplicedTable(const ClientTable &prev, const ClientTable &current,
+    const Layout &layout, bool include_added);
+}  // namespace
+
 TickingCallback::~TickingCallback() = default;
 
-TickingUpdate::TickingUpdate() = default;
+TickingUpdate::TickingUpdate() : onDemandState_(std::make_shared<internal::OnDemandState>()) {}
 TickingUpdate::TickingUpdate(std::shared_ptr<ClientTable> prev,
     std::shared_ptr<RowSequence> removed_rows,
     std::shared_ptr<ClientTable> after_removes, std::shared_ptr<RowSequence> added_rows,
     std::shared_ptr<ClientTable> after_adds, std::vector<std::shared_ptr<RowSequence>> modified_rows,
-    std::shared_ptr<ClientTable> after_modifies) : prev_(std::move(prev)),
-    removedRows_(std::move(removed_rows)), afterRemoves_(std::move(after_removes)),
-    addedRows_(std::move(added_rows)), afterAdds_(std::move(after_adds)),
-    modifiedRows_(std::move(modified_rows)), afterModifies_(std::move(after_modifies)),
+    std::shared_ptr<ClientTable> after_modifies) : removedRows_(std::move(removed_rows)),
+    addedRows_(std::move(added_rows)), modifiedRows_(std::move(modified_rows)),
+    onDemandState_(std::make_shared<internal::OnDemandState>(
+        std::array<std::shared_ptr<ClientTable>, internal::OnDemandState::kNumSnapshots>{
+            std::move(prev), std::move(after_removes), std::move(after_adds),
+            std::move(after_modifies)})) {}
+TickingUpdate::TickingUpdate(internal::LazyTable prev,
+    std::shared_ptr<RowSequence> removed_rows, internal::LazyTable after_removes,
+    std::shared_ptr<RowSequence> added_rows, internal::LazyTable after_adds,
+    std::vector<std::shared_ptr<RowSequence>> modified_rows, internal::LazyTable after_modifies) :
+    removedRows_(std::move(removed_rows)), addedRows_(std::move(added_rows)),
+    modifiedRows_(std::move(modified_rows)),
+    onDemandState_(std::make_shared<internal::OnDemandState>(
+        std::array<internal::LazyTable, internal::OnDemandState::kNumSnapshots>{
+            std::move(prev), std::move(after_removes), std::move(after_adds),
+            std::move(after_modifies)})) {}
+TickingUpdate::TickingUpdate(std::shared_ptr<RowSequence> removed_rows,
+    std::shared_ptr<RowSequence> added_rows, std::shared_ptr<ClientTable> added,
+    std::vector<std::shared_ptr<RowSequence>> modified_rows,
+    std::vector<std::shared_ptr<ColumnSource>> modified_columns) :
+    removedRows_(std::move(removed_rows)), addedRows_(std::move(added_rows)),
+    modifiedRows_(std::move(modified_rows)), deltasOnly_(true), added_(std::move(added)),
+    modifiedColumns_(std::move(modified_columns)),
     onDemandState_(std::make_shared<internal::OnDemandState>()) {}
 TickingUpdate::TickingUpdate(const TickingUpdate &other) = default;
 TickingUpdate &TickingUpdate::operator=(const TickingUpdate &other) = default;
@@ -31,10 +136,137 @@ TickingUpdate::TickingUpdate(TickingUpdate &&other) noexcept = default;
 TickingUpdate &TickingUpdate::operator=(TickingUpdate &&other) noexcept = default;
 TickingUpdate::~TickingUpdate() = default;
 
+TickingUpdate TickingUpdate::Replace(const TickingUpdate &first, const TickingUpdate &last) {
+  if (first.DeltasOnly() || last.DeltasOnly()) {
+    const char *message = "Deltas-only updates cannot be combined";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  const auto &prev = first.Prev();
+  const auto &current = last.Current();
+  // Keep the usual promise that a step which changes nothing gives back the same table.
+  std::shared_ptr<ClientTable> empty;
+  if (prev->NumRows() == 0) {
+    empty = prev;
+  } else if (current->NumRows() == 0) {
+    empty = current;
+  } else {
+    auto schema = prev->Schema();
+    const auto &element_types = schema->ElementTypes();
+    std::vector<std::shared_ptr<ColumnSource>> empty_columns;
+    empty_columns.reserve(element_types.size());
+    for (const auto &element_type : element_types) {
+      empty_columns.push_back(internal::MakeNullColumnSource(element_type, 0));
+    }
+    empty = internal::MakeClientTable(std::move(schema), std::move(empty_columns), 0);
+  }
+  auto after_adds = current->NumRows() == 0 ? empty : current;
+  auto removed_rows = RowSequence::CreateSequential(0, prev->NumRows());
+  auto added_rows = RowSequence::CreateSequential(0, current->NumRows());
+  // Nothing is modified, but like every other update this has an entry for each column.
+  std::vector<std::shared_ptr<RowSequence>> modified_rows(current->NumColumns(),
+      RowSequence::CreateEmpty());
+  return {prev, std::move(removed_rows), empty, std::move(added_rows), after_adds,
+      std::move(modified_rows), after_adds};
+}
+
+TickingUpdate TickingUpdate::Merge(const TickingUpdate &first, const TickingUpdate &second) {
+  if (first.DeltasOnly() || second.DeltasOnly()) {
+    const char *message = "Deltas-only updates cannot be combined";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  const auto &prev = first.Prev();
+  const auto &current = second.Current();
+  auto prev_size = prev->NumRows();
+  auto middle_size = prev_size - first.RemovedRows()->Size() + first.AddedRows()->Size();
+  auto first_layout = Layout::Of(*first.RemovedRows(), *first.AddedRows(), prev_size);
+  auto second_layout = Layout::Of(*second.RemovedRows(), *second.AddedRows(), middle_size);
+  auto layout = Layout::Compose(first_layout, second_layout);
+  auto removed_rows = layout.Removed(prev_size);
+
+  RowSequenceBuilder added_builder;
+  for (const auto &[begin, end] : layout.DestIntervals(true)) {
+    added_builder.AddInterval(begin, end);
+  }
+  auto added_rows = added_builder.Build();
+
+  // A row counts as modified if either update modified it, unless it is being reported as added.
+  auto kept = layout.DestIntervals(false);
+  const auto &first_modified = first.ModifiedRows();
+  const auto &second_modified = second.ModifiedRows();
+  auto ncols = std::max(first_modified.size(), second_modified.size());
+  std::vector<std::shared_ptr<RowSequence>> modified_rows;
+  modified_rows.reserve(ncols);
+  bool any_modified = false;
+  for (size_t i = 0; i != ncols; ++i) {
+    auto candidates = i < second_modified.size() ? ToIntervals(*second_modified[i]) : Intervals();
+    if (i < first_modified.size()) {
+      auto moved = second_layout.MapForward(*first_modified[i]);
+      candidates.insert(candidates.end(), moved.begin(), moved.end());
+    }
+    RowSequenceBuilder builder;
+    for (const auto &[begin, end] : candidates) {
+      builder.AddInterval(begin, end);
+    }
+    auto rows = Intersect(ToIntervals(*builder.Build()), kept);
+    any_modified = any_modified || !rows->Empty();
+    modified_rows.push_back(std::move(rows));
+  }
+
+  // Keep the usual promise that a step which changes nothing gives back the same table. A
+  // snapshot that is followed only by steps that change nothing is the same as the final one.
+  // (The exception is an update that changes nothing at all, which still ends at 'current'.)
+  std::shared_ptr<ClientTable> after_removes;
+  if (removed_rows->Empty()) {
+    after_removes = prev;
+  } else if (added_rows->Empty() && !any_modified) {
+    after_removes = current;
+  } else {
+    after_removes = MakeSplicedTable(*prev, *current, layout, false);
+  }
+  std::shared_ptr<ClientTable> after_adds;
+  if (added_rows->Empty()) {
+    after_adds = after_removes;
+  } else if (!any_modified) {
+    after_adds = current;
+  } else {
+    after_adds = MakeSplicedTable(*prev, *current, layout, true);
+  }
+  return {prev, std::move(removed_rows), std::move(after_removes), std::move(added_rows),
+      std::move(after_adds), std::move(modified_rows), current};
+}
+
 namespace internal {
 OnDemandState::OnDemandState() = default;
+OnDemandState::OnDemandState(std::array<std::shared_ptr<ClientTable>, kNumSnapshots> tables) :
+    tables_(std::move(tables)) {}
+OnDemandState::OnDemandState(std::array<LazyTable, kNumSnapshots> lazy_tables) :
+    lazyTables_(std::move(lazy_tables)) {}
 OnDemandState::~OnDemandState() = default;
 
+const std::shared_ptr<ClientTable> &OnDemandState::Table(Snapshot which) {
+  std::unique_lock guard(mutex_);
+  return TableLocked(which);
+}
+
+const std::shared_ptr<ClientTable> &OnDemandState::TableLocked(Snapshot which) {
+  auto &table = tables_[which];
+  const auto &lazy = lazyTables_[which];
+  if (table != nullptr || lazy.columns_ == nullptr) {
+    return table;
+  }
+  // Unchanged snapshots share their columns. Give them the same ClientTable too, so that callers
+  // can keep using pointer equality to tell that nothing happened in some phase.
+  for (size_t i = 0; i != which; ++i) {
+    const auto &other = lazyTables_[i];
+    if (other.columns_ == lazy.columns_ && other.num_rows_ == lazy.num_rows_) {
+      table = TableLocked(static_cast<Snapshot>(i));
+      return table;
+    }
+  }
+  table = MakeClientTable(lazy.schema_, lazy.columns_, lazy.num_rows_);
+  return table;
+}
+
 const std::shared_ptr<RowSequence> &OnDemandState::AllModifiedRows(
     const std::vector<std::shared_ptr<RowSequence>> &modified_rows) {
   std::unique_lock guard(mutex_);
@@ -47,11 +279,218 @@ const std::shared_ptr<RowSequence> &OnDemandState::AllModifiedRows(
     builder.AddInterval(begin, end);
   };
   for (const auto &rs : modified_rows) {
-    rs->ForEachInterval(cb);
+    rs->ForEachIntervalInline(cb);
   }
   allModifiedRows_ = builder.Build();
   return allModifiedRows_;
 }
 }  // namespace internal
-}  // namespace deephaven::dhcore::ticking
 
+namespace {
+Layout Layout::Of(const RowSequence &removed, const RowSequence &added, uint64_t old_size) {
+  // The rows of the old table that survive, in order.
+  Intervals survivors;
+  uint64_t next = 0;
+  removed.ForEachIntervalInline([&survivors, &next](uint64_t begin, uint64_t end) {
+    if (begin != next) {
+      survivors.emplace_back(next, begin);
+    }
+    next = end;
+  });
+  if (next > old_size) {
+    const char *message = "Removed rows extend past the end of the table";
+    throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+  }
+  if (next != old_size) {
+    survivors.emplace_back(next, old_size);
+  }
+
+  Layout result;
+  size_t survivor_index = 0;
+  uint64_t survivor_offset = 0;
+  // Fills the result up to position 'dest_end' with survivors.
+  auto take_survivors = [&](uint64_t dest_end) {
+    while (result.size_ != dest_end) {
+      if (survivor_index == survivors.size()) {
+        const char *message = "Added rows leave a gap at the end of the table";
+        throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+      }
+      const auto &[begin, end] = survivors[survivor_index];
+      auto count = std::min(dest_end - result.size_, end - begin - survivor_offset);
+      result.Append(false, begin + survivor_offset, count);
+      survivor_offset += count;
+      if (survivor_offset == end - begin) {
+        ++survivor_index;
+        survivor_offset = 0;
+      }
+    }
+  };
+  added.ForEachIntervalInline([&](uint64_t begin, uint64_t end) {
+    take_survivors(begin);
+    result.Append(true, 0, end - begin);
+  });
+  for (; survivor_index != survivors.size(); ++survivor_index) {
+    const auto &[begin, end] = survivors[survivor_index];
+    result.Append(false, begin + survivor_offset, end - begin - survivor_offset);
+    survivor_offset = 0;
+  }
+  return result;
+}
+
+Layout Layout::Compose(const Layout &first, const Layout &second) {
+  Layout result;
+  size_t first_index = 0;
+  for (const auto &run : second.runs_) {
+    if (run.added_) {
+      result.Append(true, 0, run.size_);
+      continue;
+    }
+    // The carried-over rows of 'second' are in increasing order, so a single pass over 'first'
+    // finds where each of them came from.
+    auto position = run.source_begin_;
+    auto remaining = run.size_;
+    while (remaining != 0) {
+      while (first_index != first.runs_.size() &&
+          first.runs_[first_index].dest_begin_ + first.runs_[first_index].size_ <= position) {
+        ++first_index;
+      }
+      if (first_index == first.runs_.size()) {
+        const char *message = "Updates do not line up: rows carried over from past the end";
+        throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+      }
+      const auto &source = first.runs_[first_index];
+      auto offset = position - source.dest_begin_;
+      auto count = std::min(remaining, source.size_ - offset);
+      result.Append(source.added_, source.source_begin_ + offset, count);
+      position += count;
+      remaining -= count;
+    }
+  }
+  return result;
+}
+
+void Layout::Append(bool added, uint64_t source_begin, uint64_t size) {
+  if (size == 0) {
+    return;
+  }
+  if (!runs_.empty()) {
+    auto &last = runs_.back();
+    if (last.added_ == added && (added || last.source_begin_ + last.size_ == source_begin)) {
+      last.size_ += size;
+      size_ += size;
+      return;
+    }
+  }
+  runs_.push_back(Run{added, source_begin, size_, size});
+  size_ += size;
+}
+
+Intervals Layout::DestIntervals(bool added) const {
+  Intervals result;
+  for (const auto &run : runs_) {
+    if (run.added_ == added) {
+      result.emplace_back(run.dest_begin_, run.dest_begin_ + run.size_);
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<RowSequence> Layout::Removed(uint64_t old_size) const {
+  RowSequenceBuilder builder;
+  uint64_t next = 0;
+  for (const auto &run : runs_) {
+    if (run.added_) {
+      continue;
+    }
+    builder.AddInterval(next, run.source_begin_);
+    next = run.source_begin_ + run.size_;
+  }
+  builder.AddInterval(next, old_size);
+  return builder.Build();
+}
+
+Intervals Layout::MapForward(const RowSequence &rows) const {
+  auto intervals = ToIntervals(rows);
+  Intervals result;
+  size_t index = 0;
+  for (const auto &run : runs_) {
+    if (run.added_) {
+      continue;
+    }
+    auto run_end = run.source_begin_ + run.size_;
+    while (index != intervals.size() && intervals[index].second <= run.source_begin_) {
+      ++index;
+    }
+    for (auto i = index; i != intervals.size() && intervals[i].first < run_end; ++i) {
+      auto begin = std::max(intervals[i].first, run.source_begin_);
+      auto end = std::min(intervals[i].second, run_end);
+      result.emplace_back(run.dest_begin_ + (begin - run.source_begin_),
+          run.dest_begin_ + (end - run.source_begin_));
+    }
+  }
+  return result;
+}
+
+Intervals ToIntervals(const RowSequence &rows) {
+  Intervals result;
+  rows.ForEachIntervalInline([&result](uint64_t begin, uint64_t end) {
+    result.emplace_back(begin, end);
+  });
+  return result;
+}
+
+std::shared_ptr<RowSequence> Intersect(const Intervals &lhs, const Intervals &rhs) {
+  RowSequenceBuilder builder;
+  size_t l = 0;
+  size_t r = 0;
+  while (l != lhs.size() && r != rhs.size()) {
+    auto begin = std::max(lhs[l].first, rhs[r].first);
+    auto end = std::min(lhs[l].second, rhs[r].second);
+    if (begin < end) {
+      builder.AddInterval(begin, end);
+    }
+    if (lhs[l].second < rhs[r].second) {
+      ++l;
+    } else {
+      ++r;
+    }
+  }
+  return builder.Build();
+}
+
+/**
+ * Makes the table whose carried-over rows are the corresponding rows of 'prev' and whose added
+ * rows (if 'include_added'; otherwise they are left out) are the rows at the same position of
+ * 'current'. The columns are views onto those of 'prev' and 'current'; no data is copied.
+ */
+std::shared_ptr<ClientTable> MakeSplicedTable(const ClientTable &prev, const ClientTable &current,
+    const Layout &layout, bool include_added) {
+  auto schema = prev.Schema();
+  const auto &element_types = schema->ElementTypes();
+  std::vector<std::shared_ptr<ColumnSource>> columns;
+  columns.reserve(element_types.size());
+  uint64_t num_rows = 0;
+  for (size_t i = 0; i != element_types.size(); ++i) {
+    auto prev_column = prev.GetColumn(i);
+    auto current_column = include_added ? current.GetColumn(i) : nullptr;
+    auto segments = immer::flex_vector<ColumnSegment>().transient();
+    num_rows = 0;
+    for (const auto &run : layout.Runs()) {
+      if (!run.added_) {
+        segments.push_back(ColumnSegment{prev_column, run.source_begin_,
+            run.source_begin_ + run.size_, num_rows});
+      } else if (include_added) {
+        segments.push_back(ColumnSegment{current_column, run.dest_begin_,
+            run.dest_begin_ + run.size_, num_rows});
+      } else {
+        continue;
+      }
+      num_rows += run.size_;
+    }
+    columns.push_back(MakeSegmentedColumnSource(element_types[i], segments.persistent(), 0,
+        num_rows));
+  }
+  return internal::MakeClientTable(std::move(schema), std::move(columns), num_rows);
+}
+}  // namespace
+}  // namespace deephaven::dhcore::ticking
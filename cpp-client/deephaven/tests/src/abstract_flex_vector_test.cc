@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/client/arrowutil/arrow_column_source.h"
+#include "deephaven/client/utility/arrow_util.h"
+#include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/immerutil/abstract_flex_vector.h"
+#include "deephaven/dhcore/types.h"
+
+using deephaven::client::arrowutil::Int64ArrowColumnSource;
+using deephaven::client::utility::OkOrThrow;
+using deephaven::client::utility::ValueOrThrow;
+using deephaven::dhcore::ElementType;
+using deephaven::dhcore::ElementTypeId;
+using deephaven::dhcore::chunk::BooleanChunk;
+using deephaven::dhcore::chunk::Chunk;
+using deephaven::dhcore::chunk::Int64Chunk;
+using deephaven::dhcore::chunk::UInt64Chunk;
+using deephaven::dhcore::column::ColumnSourceVisitor;
+using deephaven::dhcore::column::Int64ColumnSource;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::immerutil::NumericAbstractFlexVector;
+
+// These tests append ranges of an Arrow-backed column, split over several chunks, to a
+// NumericAbstractFlexVector. That goes through the ContiguousData() fast path one chunk at a time,
+// and falls back to Append() for whatever the source can't expose that way.
+namespace deephaven::client::tests {
+namespace {
+// The chunks hold 0, 1, 2, ... in order. The chunk of one element makes two boundaries in a row.
+const std::vector<size_t> kChunkSizes = {5, 1, 7, 4};
+
+std::shared_ptr<Int64ArrowColumnSource> MakeChunkedSource() {
+  std::vector<std::shared_ptr<arrow::Int64Array>> arrays;
+  int64_t next = 0;
+  for (auto size : kChunkSizes) {
+    arrow::Int64Builder builder;
+    for (size_t i = 0; i != size; ++i) {
+      OkOrThrow(DEEPHAVEN_LOCATION_EXPR(builder.Append(next++)));
+    }
+    auto array = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(builder.Finish()));
+    arrays.push_back(std::static_pointer_cast<arrow::Int64Array>(array));
+  }
+  return Int64ArrowColumnSource::OfArrowArrayVec(ElementType::Of(ElementTypeId::kInt64),
+      std::move(arrays));
+}
+
+/**
+ * Wraps another source, but only exposes its data through ContiguousData() before position
+ * 'cutoff', so that an append that crosses 'cutoff' has to finish with Append(). Records the
+ * calls to ContiguousData().
+ */
+class CutoffSource final : public Int64ColumnSource {
+public:
+  CutoffSource(std::shared_ptr<Int64ArrowColumnSource> inner, size_t cutoff) :
+      inner_(std::move(inner)), cutoff_(cutoff) {}
+
+  void FillChunk(const RowSequence &rows, Chunk *dest_data,
+      BooleanChunk *optional_dest_null_flags) const final {
+    inner_->FillChunk(rows, dest_data, optional_dest_null_flags);
+  }
+
+  void FillChunkUnordered(const UInt64Chunk &rows, Chunk *dest_data,
+      BooleanChunk *optional_dest_null_flags) const final {
+    inner_->FillChunkUnordered(rows, dest_data, optional_dest_null_flags);
+  }
+
+  [[nodiscard]]
+  const ElementType &GetElementType() const final {
+    return inner_->GetElementType();
+  }
+
+  void AcceptVisitor(ColumnSourceVisitor *visitor) const final {
+    inner_->AcceptVisitor(visitor);
+  }
+
+  [[nodiscard]]
+  const int64_t *ContiguousData(size_t begin, size_t end, size_t *available) const final {
+    contiguousCalls_.push_back(begin);
+    if (begin >= cutoff_) {
+      *available = 0;
+      return nullptr;
+    }
+    return inner_->ContiguousData(begin, std::min(end, cutoff_), available);
+  }
+
+  mutable std::vector<size_t> contiguousCalls_;
+
+private:
+  std::shared_ptr<Int64ArrowColumnSource> inner_;
+  size_t cutoff_ = 0;
+};
+
+std::vector<int64_t> Contents(const NumericAbstractFlexVector<int64_t> &vec, size_t size) {
+  auto source = vec.MakeColumnSource();
+  auto data = Int64Chunk::Create(size);
+  source->FillChunk(*RowSequence::CreateSequential(0, size), &data, nullptr);
+  return {data.begin(), data.end()};
+}
+
+std::vector<int64_t> Iota(size_t begin, size_t end) {
+  std::vector<int64_t> result(end - begin);
+  std::iota(result.begin(), result.end(), static_cast<int64_t>(begin));
+  return result;
+}
+}  // namespace
+
+TEST_CASE("Append a range of a chunked Arrow column to a flex vector", "[abstractflexvector]") {
+  // The chunks are [0, 5), [5, 6), [6, 13) and [13, 17).
+  const auto [begin, end] = GENERATE(
+      std::pair<size_t, size_t>(0, 17),  // everything
+      std::pair<size_t, size_t>(2, 15),  // from the middle of the first chunk to the last
+      std::pair<size_t, size_t>(5, 6),   // exactly the one-element chunk
+      std::pair<size_t, size_t>(4, 7),   // across both of its boundaries
+      std::pair<size_t, size_t>(6, 13),  // exactly one chunk
+      std::pair<size_t, size_t>(13, 17), // the last chunk
+      std::pair<size_t, size_t>(9, 9)    // nothing
+      );
+  INFO("Appending [" << begin << ", " << end << ")");
+  auto source = MakeChunkedSource();
+  NumericAbstractFlexVector<int64_t> vec(ElementType::Of(ElementTypeId::kInt64));
+  // Append twice, so the second append has to go after existing data.
+  vec.InPlaceAppendSource(*source, begin, end);
+  vec.InPlaceAppendSource(*source, begin, end);
+
+  auto expected = Iota(begin, end);
+  auto once = expected;
+  expected.insert(expected.end(), once.begin(), once.end());
+  CHECK(Contents(vec, expected.size()) == expected);
+}
+
+TEST_CASE("Append falls back to copying where the data isn't contiguous", "[abstractflexvector]") {
+  // ContiguousData() works up to position 10, which is in the middle of the third chunk.
+  // Each case is the range to append and the positions ContiguousData() is asked for.
+  using Case = std::tuple<size_t, size_t, std::vector<size_t>>;
+  const size_t cutoff = 10;
+  const auto [begin, end, expected_calls] = GENERATE(
+      // Chunk by chunk through the first three, then Append() for [10, 16).
+      Case{3, 16, {3, 5, 6, 10}},
+      // Stops exactly at the cutoff, so no fallback is needed.
+      Case{4, 10, {4, 5, 6}},
+      // Starts past the cutoff, so it is all Append().
+      Case{12, 17, {12}}
+      );
+  INFO("Appending [" << begin << ", " << end << ")");
+  CutoffSource source(MakeChunkedSource(), cutoff);
+  NumericAbstractFlexVector<int64_t> vec(ElementType::Of(ElementTypeId::kInt64));
+  vec.InPlaceAppendSource(source, begin, end);
+
+  CHECK(source.contiguousCalls_ == expected_calls);
+  auto expected = Iota(begin, end);
+  CHECK(Contents(vec, expected.size()) == expected);
+}
+}  // namespace deephaven::client::tests
@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/clienttable/client_table.h"
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/buffer_column_source.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/barrage_processor.h"
+#include "deephaven/dhcore/ticking/delta_table_state.h"
+#include "deephaven/dhcore/ticking/index_decoder.h"
+#include "deephaven/dhcore/ticking/subscription_options.h"
+#include "deephaven/dhcore/ticking/ticking.h"
+#include "deephaven/dhcore/types.h"
+#include "deephaven/flatbuf/Barrage_generated.h"
+
+using deephaven::dhcore::ElementType;
+using deephaven::dhcore::ElementTypeId;
+using deephaven::dhcore::chunk::Int64Chunk;
+using deephaven::dhcore::clienttable::ClientTable;
+using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::column::ColumnSource;
+using deephaven::dhcore::column::NumericBufferColumnSource;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::ticking::BarrageProcessor;
+using deephaven::dhcore::ticking::ColumnConversionMode;
+using deephaven::dhcore::ticking::DataOutput;
+using deephaven::dhcore::ticking::DeltaTableState;
+using deephaven::dhcore::ticking::IndexEncoder;
+using deephaven::dhcore::ticking::SubscriptionOptions;
+using deephaven::dhcore::ticking::TickingUpdate;
+using io::deephaven::barrage::flatbuf::BarrageMessageType;
+using io::deephaven::barrage::flatbuf::BarrageMessageWrapper;
+using io::deephaven::barrage::flatbuf::BarrageModColumnMetadata;
+using io::deephaven::barrage::flatbuf::BarrageSnapshotRequest;
+using io::deephaven::barrage::flatbuf::CreateBarrageMessageWrapper;
+using io::deephaven::barrage::flatbuf::CreateBarrageModColumnMetadata;
+using io::deephaven::barrage::flatbuf::CreateBarrageUpdateMetadata;
+
+// These tests feed the BarrageProcessor hand-built messages shaped like the ones the server sends,
+// so they don't need a server. The table has a single int64 column.
+namespace deephaven::client::tests {
+namespace {
+using rows_t = std::shared_ptr<RowSequence>;
+
+/**
+ * The parts of a BarrageUpdateMetadata that these tests care about. Like the server, we leave a
+ * field out of the message entirely when it is null.
+ */
+struct Update {
+  bool is_snapshot_ = false;
+  rows_t viewport_;
+  bool reverse_viewport_ = false;
+  rows_t removed_;
+  // The shift data, as (first, last, dest) triples.
+  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> shifts_;
+  rows_t added_;
+  rows_t added_included_;
+  std::vector<int64_t> added_data_;
+  // If null, the message has no mod_column_nodes at all.
+  rows_t modified_;
+  std::vector<int64_t> modified_data_;
+};
+
+std::shared_ptr<Schema> MakeSchema() {
+  return Schema::Create({"Value"}, {ElementType::Of(ElementTypeId::kInt64)});
+}
+
+rows_t Rows(const std::vector<std::pair<uint64_t, uint64_t>> &intervals) {
+  RowSequenceBuilder builder;
+  for (const auto &[begin, end] : intervals) {
+    builder.AddInterval(begin, end);
+  }
+  return builder.Build();
+}
+
+std::vector<uint64_t> Expand(const RowSequence &rows) {
+  std::vector<uint64_t> result;
+  rows.ForEachInterval([&result](uint64_t begin, uint64_t end) {
+    for (auto i = begin; i != end; ++i) {
+      result.push_back(i);
+    }
+  });
+  return result;
+}
+
+std::vector<int64_t> Values(const ColumnSource &source, size_t size) {
+  auto rows = RowSequence::CreateSequential(0, size);
+  auto data = Int64Chunk::Create(size);
+  source.FillChunk(*rows, &data, nullptr);
+  return {data.begin(), data.end()};
+}
+
+std::vector<int64_t> Values(const ClientTable &table) {
+  return Values(*table.GetColumn(0), table.NumRows());
+}
+
+flatbuffers::Offset<flatbuffers::Vector<int8_t>> MaybeEncode(flatbuffers::FlatBufferBuilder *builder,
+    const rows_t &rows) {
+  if (rows == nullptr) {
+    return {};
+  }
+  std::vector<int8_t> encoded;
+  DataOutput out(&encoded);
+  IndexEncoder::WriteExternalCompressedDelta(*rows, &out);
+  return builder->CreateVector(encoded);
+}
+
+std::vector<uint8_t> MakeMetadata(const Update &update) {
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto viewport = MaybeEncode(&builder, update.viewport_);
+  auto removed = MaybeEncode(&builder, update.removed_);
+  auto added = MaybeEncode(&builder, update.added_);
+  auto added_included = MaybeEncode(&builder, update.added_included_);
+
+  flatbuffers::Offset<flatbuffers::Vector<int8_t>> shift_data;
+  if (!update.shifts_.empty()) {
+    std::vector<std::pair<uint64_t, uint64_t>> firsts, lasts, dests;
+    for (const auto &[first, last, dest] : update.shifts_) {
+      firsts.emplace_back(first, first + 1);
+      lasts.emplace_back(last, last + 1);
+      dests.emplace_back(dest, dest + 1);
+    }
+    std::vector<int8_t> encoded;
+    DataOutput out(&encoded);
+    for (auto *intervals : {&firsts, &lasts, &dests}) {
+      IndexEncoder::WriteExternalCompressedDelta(*Rows(*intervals), &out);
+    }
+    shift_data = builder.CreateVector(encoded);
+  }
+
+  flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<BarrageModColumnMetadata>>> mod_nodes;
+  if (update.modified_ != nullptr) {
+    std::vector<flatbuffers::Offset<BarrageModColumnMetadata>> nodes = {
+        CreateBarrageModColumnMetadata(builder, MaybeEncode(&builder, update.modified_))
+    };
+    mod_nodes = builder.CreateVector(nodes);
+  }
+
+  auto bmd = CreateBarrageUpdateMetadata(builder, 0, 0, update.is_snapshot_, viewport,
+      update.reverse_viewport_, {}, added, removed, shift_data, added_included, mod_nodes);
+  builder.Finish(bmd);
+
+  flatbuffers::FlatBufferBuilder wrapper_builder(1024);
+  const auto *payload_data = static_cast<const int8_t*>(static_cast<const void*>(
+      builder.GetBufferPointer()));
+  auto payload = wrapper_builder.CreateVector(payload_data, builder.GetSize());
+  auto wrapper = CreateBarrageMessageWrapper(wrapper_builder,
+      BarrageProcessor::kDeephavenMagicNumber,
+      BarrageMessageType::BarrageMessageType_BarrageUpdateMetadata, payload);
+  wrapper_builder.Finish(wrapper);
+  const auto *begin = wrapper_builder.GetBufferPointer();
+  return {begin, begin + wrapper_builder.GetSize()};
+}
+
+std::shared_ptr<ColumnSource> MakeSource(const std::vector<int64_t> &data) {
+  return NumericBufferColumnSource<int64_t>::Create(ElementType::Of(ElementTypeId::kInt64),
+      data.data(), data.size());
+}
+
+/**
+ * Feeds 'update' to 'processor' the way the server does: the added data comes with the metadata,
+ * and the modified data follows in a record batch of its own.
+ */
+TickingUpdate Process(BarrageProcessor *processor, const Update &update) {
+  auto metadata = MakeMetadata(update);
+  auto result = processor->ProcessNextChunk({MakeSource(update.added_data_)},
+      {update.added_data_.size()}, metadata.data(), metadata.size());
+  if (!result.has_value()) {
+    result = processor->ProcessNextChunk({MakeSource(update.modified_data_)},
+        {update.modified_data_.size()}, nullptr, 0);
+  }
+  REQUIRE(result.has_value());
+  return std::move(*result);
+}
+
+/**
+ * The first message of a viewport subscription: the rows in 'viewport', numbered by their
+ * positions in it. Note there is no removed_rows, shift_data, or added_rows_included.
+ */
+Update ViewportSnapshot(rows_t viewport, bool reverse, std::vector<int64_t> data) {
+  Update result;
+  result.is_snapshot_ = true;
+  result.viewport_ = std::move(viewport);
+  result.reverse_viewport_ = reverse;
+  result.added_ = RowSequence::CreateSequential(0, data.size());
+  result.added_data_ = std::move(data);
+  return result;
+}
+}  // namespace
+
+TEST_CASE("BarrageProcessor applies viewport updates as positions", "[barrageprocessor]") {
+  BarrageProcessor processor(MakeSchema());
+  auto snapshot = Process(&processor,
+      ViewportSnapshot(Rows({{0, 5}}), false, {10, 11, 12, 13, 14}));
+  CHECK(Values(*snapshot.Current()) == std::vector<int64_t>{10, 11, 12, 13, 14});
+
+  // The row at position 2 goes away, and a new row comes in at the bottom. The removed rows are
+  // positions before the update and the added rows are positions after it.
+  Update tick;
+  tick.removed_ = Rows({{2, 3}});
+  tick.added_ = Rows({{4, 5}});
+  tick.added_data_ = {15};
+  auto update = Process(&processor, tick);
+  CHECK(Expand(*update.RemovedRows()) == std::vector<uint64_t>{2});
+  CHECK(Expand(*update.AddedRows()) == std::vector<uint64_t>{4});
+  CHECK(Values(*update.AfterRemoves()) == std::vector<int64_t>{10, 11, 13, 14});
+  CHECK(Values(*update.Current()) == std::vector<int64_t>{10, 11, 13, 14, 15});
+
+  // Modified rows are positions too.
+  Update modify;
+  modify.modified_ = Rows({{0, 1}, {3, 4}});
+  modify.modified_data_ = {100, 103};
+  update = Process(&processor, modify);
+  REQUIRE(update.ModifiedRows().size() == 1);
+  CHECK(Expand(*update.ModifiedRows()[0]) == std::vector<uint64_t>{0, 3});
+  CHECK(Values(*update.Current()) == std::vector<int64_t>{100, 11, 13, 103, 15});
+}
+
+TEST_CASE("BarrageProcessor treats absent index fields as empty", "[barrageprocessor]") {
+  BarrageProcessor processor(MakeSchema());
+  (void)Process(&processor, ViewportSnapshot(Rows({{0, 3}}), false, {1, 2, 3}));
+
+  // No removed_rows, shift_data, added_rows, or mod_column_nodes at all.
+  auto update = Process(&processor, Update());
+  CHECK(update.RemovedRows()->Empty());
+  CHECK(update.AddedRows()->Empty());
+  for (const auto &modified : update.ModifiedRows()) {
+    CHECK(modified->Empty());
+  }
+  CHECK(Values(*update.Current()) == std::vector<int64_t>{1, 2, 3});
+}
+
+TEST_CASE("BarrageProcessor handles a growing viewport", "[barrageprocessor]") {
+  BarrageProcessor processor(MakeSchema());
+  (void)Process(&processor, ViewportSnapshot(Rows({{0, 3}}), false, {0, 1, 2}));
+
+  Update grow;
+  grow.is_snapshot_ = true;
+  grow.viewport_ = Rows({{0, 6}});
+  grow.added_ = Rows({{3, 6}});
+  grow.added_data_ = {3, 4, 5};
+  auto update = Process(&processor, grow);
+  CHECK(update.RemovedRows()->Empty());
+  CHECK(Expand(*update.AddedRows()) == std::vector<uint64_t>{3, 4, 5});
+  CHECK(Values(*update.Current()) == std::vector<int64_t>{0, 1, 2, 3, 4, 5});
+}
+
+TEST_CASE("BarrageProcessor handles a shrinking or moving viewport", "[barrageprocessor]") {
+  BarrageProcessor processor(MakeSchema());
+  (void)Process(&processor, ViewportSnapshot(Rows({{0, 6}}), false, {0, 1, 2, 3, 4, 5}));
+
+  Update shrink;
+  shrink.is_snapshot_ = true;
+  shrink.viewport_ = Rows({{0, 4}});
+  shrink.removed_ = Rows({{4, 6}});
+  auto update = Process(&processor, shrink);
+  CHECK(Expand(*update.RemovedRows()) == std::vector<uint64_t>{4, 5});
+  CHECK(Values(*update.Current()) == std::vector<int64_t>{0, 1, 2, 3});
+
+  // Scroll down by two rows: the top two leave and two new ones arrive at the bottom.
+  Update move;
+  move.is_snapshot_ = true;
+  move.viewport_ = Rows({{2, 6}});
+  move.removed_ = Rows({{0, 2}});
+  move.added_ = Rows({{2, 4}});
+  move.added_data_ = {4, 5};
+  update = Process(&processor, move);
+  CHECK(Expand(*update.RemovedRows()) == std::vector<uint64_t>{0, 1});
+  CHECK(Expand(*update.AddedRows()) == std::vector<uint64_t>{2, 3});
+  CHECK(Values(*update.Current()) == std::vector<int64_t>{2, 3, 4, 5});
+}
+
+TEST_CASE("BarrageProcessor handles a reverse viewport", "[barrageprocessor]") {
+  // The last three rows of a ten-row table. The positions are still in table order.
+  BarrageProcessor processor(MakeSchema());
+  auto snapshot = Process(&processor, ViewportSnapshot(Rows({{0, 3}}), true, {7, 8, 9}));
+  CHECK(Values(*snapshot.Current()) == std::vector<int64_t>{7, 8, 9});
+
+  // A row is appended to the table, so the oldest row in the viewport leaves.
+  Update tick;
+  tick.removed_ = Rows({{0, 1}});
+  tick.added_ = Rows({{2, 3}});
+  tick.added_data_ = {10};
+  auto update = Process(&processor, tick);
+  CHECK(Values(*update.Current()) == std::vector<int64_t>{8, 9, 10});
+}
+
+TEST_CASE("BarrageProcessor rejects a change of subscription mode", "[barrageprocessor]") {
+  BarrageProcessor processor(MakeSchema());
+  (void)Process(&processor, ViewportSnapshot(Rows({{0, 2}}), false, {0, 1}));
+
+  Update whole_table;
+  whole_table.is_snapshot_ = true;
+  auto metadata = MakeMetadata(whole_table);
+  std::vector<int64_t> no_data;
+  CHECK_THROWS(processor.ProcessNextChunk({MakeSource(no_data)}, {0}, metadata.data(),
+      metadata.size()));
+}
+
+TEST_CASE("BarrageProcessor applies whole-table updates by key", "[barrageprocessor]") {
+  BarrageProcessor processor(MakeSchema());
+  Update snapshot;
+  snapshot.is_snapshot_ = true;
+  snapshot.added_ = Rows({{100, 101}, {200, 201}, {300, 301}});
+  snapshot.added_data_ = {1, 2, 3};
+  (void)Process(&processor, snapshot);
+
+  // Remove key 200, move key 300 to 400, then add key 350 between them.
+  Update tick;
+  tick.removed_ = Rows({{200, 201}});
+  tick.shifts_ = {{300, 300, 400}};
+  tick.added_ = Rows({{350, 351}});
+  tick.added_data_ = {4};
+  tick.modified_ = Rows({{400, 401}});
+  tick.modified_data_ = {30};
+  auto update = Process(&processor, tick);
+  CHECK(Expand(*update.RemovedRows()) == std::vector<uint64_t>{1});
+  CHECK(Expand(*update.AddedRows()) == std::vector<uint64_t>{1});
+  CHECK(Expand(*update.ModifiedRows()[0]) == std::vector<uint64_t>{2});
+  CHECK(Values(*update.Current()) == std::vector<int64_t>{1, 4, 30});
+}
+
+TEST_CASE("BarrageProcessor follows added_rows_included in a snapshot reply", "[barrageprocessor]") {
+  // The reply to a BarrageSnapshotRequest for positions [3, 5) of a ten-row table.
+  auto processor = BarrageProcessor::ForSnapshot(MakeSchema());
+  Update reply;
+  reply.is_snapshot_ = true;
+  reply.viewport_ = Rows({{3, 5}});
+  reply.added_ = Rows({{0, 10}});
+  reply.added_included_ = Rows({{3, 5}});
+  reply.added_data_ = {3, 4};
+  auto update = Process(&processor, reply);
+  CHECK(Values(*update.Current()) == std::vector<int64_t>{3, 4});
+}
+
+TEST_CASE("BarrageProcessor passes deltas on by key in a deltas-only subscription", "[barrageprocessor]") {
+  BarrageProcessor processor(MakeSchema(), SubscriptionOptions().SetDeltasOnly(true));
+  Update snapshot;
+  snapshot.is_snapshot_ = true;
+  snapshot.added_ = Rows({{100, 101}, {200, 201}, {300, 301}});
+  snapshot.added_data_ = {1, 2, 3};
+  auto update = Process(&processor, snapshot);
+  CHECK(update.DeltasOnly());
+  CHECK(update.Prev() == nullptr);
+  CHECK(update.Current() == nullptr);
+  CHECK(Expand(*update.AddedRows()) == std::vector<uint64_t>{100, 200, 300});
+  CHECK(Values(*update.Added()) == std::vector<int64_t>{1, 2, 3});
+
+  // There is no table, so the keys are passed on as they are: nothing is removed from or added to
+  // anything, and the shift is not applied.
+  Update tick;
+  tick.removed_ = Rows({{200, 201}});
+  tick.shifts_ = {{300, 300, 400}};
+  tick.added_ = Rows({{350, 352}});
+  tick.added_data_ = {4, 5};
+  tick.modified_ = Rows({{100, 101}, {400, 401}});
+  tick.modified_data_ = {10, 30};
+  update = Process(&processor, tick);
+  CHECK(update.Current() == nullptr);
+  CHECK(Expand(*update.RemovedRows()) == std::vector<uint64_t>{200});
+  CHECK(Expand(*update.AddedRows()) == std::vector<uint64_t>{350, 351});
+  CHECK(Values(*update.Added()) == std::vector<int64_t>{4, 5});
+  REQUIRE(update.ModifiedRows().size() == 1);
+  CHECK(Expand(*update.ModifiedRows()[0]) == std::vector<uint64_t>{100, 400});
+  REQUIRE(update.ModifiedColumns().size() == 1);
+  CHECK(Values(*update.ModifiedColumns()[0], 2) == std::vector<int64_t>{10, 30});
+
+  // A tick with only removes.
+  Update remove;
+  remove.removed_ = Rows({{100, 101}, {350, 352}});
+  update = Process(&processor, remove);
+  CHECK(Expand(*update.RemovedRows()) == std::vector<uint64_t>{100, 350, 351});
+  CHECK(update.AddedRows()->Empty());
+  CHECK(update.Added()->NumRows() == 0);
+  CHECK(update.ModifiedColumns().empty());
+}
+
+TEST_CASE("BarrageProcessor delivers an empty deltas-only tick", "[barrageprocessor]") {
+  BarrageProcessor processor(MakeSchema(), SubscriptionOptions().SetDeltasOnly(true));
+  Update snapshot;
+  snapshot.is_snapshot_ = true;
+  snapshot.added_ = Rows({{0, 2}});
+  snapshot.added_data_ = {1, 2};
+  (void)Process(&processor, snapshot);
+
+  // No removed_rows, shift_data, added_rows, or mod_column_nodes at all.
+  auto update = Process(&processor, Update());
+  CHECK(update.DeltasOnly());
+  CHECK(update.RemovedRows()->Empty());
+  CHECK(update.AddedRows()->Empty());
+  CHECK(update.Added()->NumRows() == 0);
+  for (const auto &modified : update.ModifiedRows()) {
+    CHECK(modified->Empty());
+  }
+  CHECK(update.ModifiedColumns().empty());
+}
+
+TEST_CASE("DeltaTableState stitches together the data of one update", "[barrageprocessor]") {
+  DeltaTableState state(MakeSchema());
+  std::vector<int64_t> first = {0, 1, 2, 3};
+  std::vector<int64_t> second = {4, 5, 6};
+  state.AddData({MakeSource(first)}, {1}, {4});
+  state.AddData({MakeSource(second)}, {0}, {2});
+  state.ModifyData(0, MakeSource(second), 2, 3);
+  state.ModifyData(0, MakeSource(first), 0, 1);
+  auto added = state.TakeAdded();
+  CHECK(Values(*added) == std::vector<int64_t>{1, 2, 3, 4, 5});
+  auto modified = state.TakeModified(true);
+  REQUIRE(modified.size() == 1);
+  CHECK(Values(*modified[0], 2) == std::vector<int64_t>{6, 0});
+
+  // Taking the data forgets it, so the next update starts from nothing.
+  state.AddData({MakeSource(second)}, {0}, {3});
+  CHECK(Values(*state.TakeAdded()) == std::vector<int64_t>{4, 5, 6});
+  CHECK(state.TakeModified(false).empty());
+}
+
+TEST_CASE("CreateSnapshotRequest sends the given options", "[barrageprocessor]") {
+  std::vector<int8_t> ticket = {1, 2, 3, 4};
+  auto options = SubscriptionOptions().SetBatchSize(100).SetMaxMessageSize(1 << 20)
+      .SetColumnConversionMode(ColumnConversionMode::kJavaSerialization);
+  auto bytes = BarrageProcessor::CreateSnapshotRequest(ticket.data(), ticket.size(), nullptr,
+      nullptr, false, options);
+  const auto *wrapper = flatbuffers::GetRoot<BarrageMessageWrapper>(bytes.data());
+  REQUIRE(wrapper->msg_type() == BarrageMessageType::BarrageMessageType_BarrageSnapshotRequest);
+  const auto *request = flatbuffers::GetRoot<BarrageSnapshotRequest>(wrapper->msg_payload()->data());
+  const auto *sent = request->snapshot_options();
+  REQUIRE(sent != nullptr);
+  CHECK(sent->batch_size() == 100);
+  CHECK(sent->max_message_size() == 1 << 20);
+  CHECK(sent->column_conversion_mode() ==
+      io::deephaven::barrage::flatbuf::ColumnConversionMode_JavaSerialization);
+}
+}  // namespace deephaven::client::tests
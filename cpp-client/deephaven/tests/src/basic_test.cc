@@ -2,11 +2,13 @@
  * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
  */
 #include <iostream>
+#include <vector>
 #include "deephaven/third_party/catch.hpp"
 #include "deephaven/tests/test_util.h"
 #include "deephaven/client/client.h"
 
 using deephaven::client::Client;
+using deephaven::client::TableHandle;
 
 namespace deephaven::client::tests {
 TEST_CASE("Close plays nice with destructor", "[simple]") {
@@ -16,4 +18,22 @@ TEST_CASE("Close plays nice with destructor", "[simple]") {
   std::cout << updated.Stream(true) << '\n';
   tm.Client().Close();
 }
+
+TEST_CASE("Dropping many handles, then Close", "[simple]") {
+  auto tm = TableMakerForTests::Create();
+  auto table = tm.Table();
+  std::vector<TableHandle> handles;
+  for (int i = 0; i != 500; ++i) {
+    handles.push_back(table.Head(i));
+  }
+  // The releases are queued for the release thread, so the client keeps working meanwhile.
+  handles.clear();
+  CHECK(table.Head(3).NumRows() == 3);
+  // These are still outstanding at Close(), which releases them itself.
+  for (int i = 0; i != 500; ++i) {
+    handles.push_back(table.Tail(i));
+  }
+  tm.Client().Close();
+  handles.clear();
+}
 }  // namespace deephaven::client::tests
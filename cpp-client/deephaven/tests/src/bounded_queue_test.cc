@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/client/subscription/bounded_queue.h"
+
+using deephaven::client::subscription::BoundedQueue;
+
+namespace deephaven::client::tests {
+namespace {
+std::string Concat(const std::string &lhs, const std::string &rhs) {
+  return lhs + rhs;
+}
+}  // namespace
+
+TEST_CASE("BoundedQueue folds when full", "[boundedqueue]") {
+  BoundedQueue<std::string> queue(2);
+  size_t num_folded = 0;
+  CHECK(queue.PushOrFold("a", Concat, &num_folded));
+  CHECK(num_folded == 0);
+  CHECK(queue.PushOrFold("b", Concat, &num_folded));
+  CHECK(num_folded == 0);
+  CHECK(queue.PushOrFold("c", Concat, &num_folded));
+  CHECK(num_folded == 2);
+  CHECK(queue.Size() == 1);
+  CHECK(queue.HighWater() == 2);
+
+  CHECK(queue.PushOrFold("d", Concat, &num_folded));
+  CHECK(num_folded == 0);
+  CHECK(queue.Pop() == "abc");
+  CHECK(queue.Pop() == "d");
+  queue.Close(nullptr);
+  CHECK(!queue.Pop().has_value());
+}
+
+TEST_CASE("BoundedQueue drops the taken items if the fold throws", "[boundedqueue]") {
+  BoundedQueue<std::string> queue(2);
+  size_t num_folded = 0;
+  CHECK(queue.PushOrFold("a", Concat, &num_folded));
+  CHECK(queue.PushOrFold("b", Concat, &num_folded));
+  auto throwing_fold = [](const std::string &, const std::string &) -> std::string {
+    throw std::runtime_error("fold failed");
+  };
+  CHECK_THROWS_AS(queue.PushOrFold("c", throwing_fold, &num_folded), std::runtime_error);
+  CHECK(num_folded == 0);
+  CHECK(queue.Size() == 0);
+
+  // The queue still works, and the consumer never sees the items that were being folded.
+  CHECK(queue.PushOrFold("d", Concat, &num_folded));
+  queue.Close(nullptr);
+  CHECK(queue.Pop() == "d");
+  CHECK(!queue.Pop().has_value());
+}
+
+TEST_CASE("BoundedQueue refuses items once closed", "[boundedqueue]") {
+  BoundedQueue<std::string> queue(1);
+  size_t num_folded = 0;
+  CHECK(queue.Push("a"));
+  queue.Close(nullptr);
+  CHECK(!queue.Push("b"));
+  CHECK(!queue.PushOrFold("c", Concat, &num_folded));
+  CHECK(queue.Pop() == "a");
+  CHECK(!queue.Pop().has_value());
+}
+}  // namespace deephaven::client::tests
@@ -30,4 +30,19 @@ TEST_CASE("Simple BufferColumnSource", "[columnsource]") {
   std::vector<int64_t> actual(data.begin(), data.end());
   CHECK(expected == actual);
 }
+
+TEST_CASE("BufferColumnSource exposes contiguous data", "[columnsource]") {
+  std::vector<int64_t> chunk{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+  auto cs = NumericBufferColumnSource<int64_t>::Create(
+      ElementType::Of(ElementTypeId::kInt64), chunk.data(), chunk.size());
+
+  size_t available = 0;
+  const auto *data = cs->ContiguousData(3, 7, &available);
+  REQUIRE(data != nullptr);
+  CHECK(available == 4);
+  std::vector<int64_t> expected{3, 4, 5, 6};
+  std::vector<int64_t> actual(data, data + available);
+  CHECK(expected == actual);
+}
 }  // namespace deephaven::client::tests
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/dhcore/ticking/column_worker_pool.h"
+
+using deephaven::dhcore::ticking::ColumnWorkerPool;
+
+namespace deephaven::client::tests {
+namespace {
+/**
+ * Runs ForEach over 'count' indices and checks that each index was visited exactly once.
+ * Returns the threads that did the work.
+ */
+std::set<std::thread::id> CheckVisitsEachIndexOnce(ColumnWorkerPool *pool, size_t count) {
+  std::vector<std::atomic<size_t>> visits(count);
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  pool->ForEach(count, [&](size_t i) {
+    ++visits[i];
+    std::unique_lock guard(mutex);
+    threads.insert(std::this_thread::get_id());
+  });
+  for (size_t i = 0; i != count; ++i) {
+    INFO("Index " << i);
+    CHECK(visits[i] == 1);
+  }
+  return threads;
+}
+}  // namespace
+
+TEST_CASE("ColumnWorkerPool with a parallelism of 0 or 1 runs on the caller", "[columnworkerpool]") {
+  auto parallelism = GENERATE(0, 1);
+  INFO("Parallelism " << parallelism);
+  auto pool = ColumnWorkerPool::Create(parallelism);
+  for (size_t count : {0, 1, 2, 100}) {
+    INFO("Count " << count);
+    auto threads = CheckVisitsEachIndexOnce(pool.get(), count);
+    if (count != 0) {
+      CHECK(threads == std::set<std::thread::id>{std::this_thread::get_id()});
+    }
+  }
+}
+
+TEST_CASE("ColumnWorkerPool runs the work on all its threads", "[columnworkerpool]") {
+  const size_t parallelism = 4;
+  auto pool = ColumnWorkerPool::Create(parallelism);
+
+  // Each invocation waits until 'parallelism' of them are running at once, which can only happen
+  // if every thread of the pool, the caller included, has taken one index. The wait is bounded so
+  // that a pool that runs fewer threads fails instead of hanging.
+  std::mutex mutex;
+  std::condition_variable cond;
+  size_t arrived = 0;
+  std::set<std::thread::id> threads;
+  bool all_arrived = true;
+  pool->ForEach(parallelism, [&](size_t) {
+    std::unique_lock guard(mutex);
+    threads.insert(std::this_thread::get_id());
+    ++arrived;
+    cond.notify_all();
+    if (!cond.wait_for(guard, std::chrono::seconds(10), [&] { return arrived == parallelism; })) {
+      all_arrived = false;
+    }
+  });
+  CHECK(all_arrived);
+  CHECK(threads.size() == parallelism);
+  CHECK(threads.count(std::this_thread::get_id()) == 1);
+}
+
+TEST_CASE("ColumnWorkerPool can be reused for many generations of work", "[columnworkerpool]") {
+  auto pool = ColumnWorkerPool::Create(4);
+  for (size_t generation = 0; generation != 200; ++generation) {
+    INFO("Generation " << generation);
+    // A mix of counts below, at and above the number of threads, including the serial cases.
+    auto count = generation % 11;
+    auto threads = CheckVisitsEachIndexOnce(pool.get(), count);
+    CHECK(threads.size() <= 4);
+  }
+}
+
+TEST_CASE("ColumnWorkerPool rethrows the exception from the lowest index", "[columnworkerpool]") {
+  auto parallelism = GENERATE(1, 4);
+  INFO("Parallelism " << parallelism);
+  auto pool = ColumnWorkerPool::Create(parallelism);
+  const size_t count = 20;
+  std::vector<std::atomic<size_t>> visits(count);
+  // The serial pool stops at the first throw; the parallel one finishes all the work first.
+  auto throwing = [&visits](size_t i) {
+    ++visits[i];
+    if (i == 3 || i == 7 || i == 12) {
+      throw std::runtime_error(std::to_string(i));
+    }
+  };
+  CHECK_THROWS_WITH(pool->ForEach(count, throwing), "3");
+  if (parallelism > 1) {
+    for (size_t i = 0; i != count; ++i) {
+      INFO("Index " << i);
+      CHECK(visits[i] == 1);
+    }
+  }
+
+  // The pool is still usable afterwards.
+  CheckVisitsEachIndexOnce(pool.get(), count);
+}
+}  // namespace deephaven::client::tests
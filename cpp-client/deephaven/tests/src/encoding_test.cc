@@ -1,12 +1,20 @@
 /*
  * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
  */
+#include <memory>
 #include <string>
 #include <vector>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
+#include <arrow/type.h>
 #include "deephaven/third_party/catch.hpp"
 #include "deephaven/tests/test_util.h"
+#include "deephaven/client/utility/arrow_util.h"
+#include "deephaven/dhcore/utility/utility.h"
 
+using deephaven::client::utility::OkOrThrow;
 using deephaven::client::utility::TableMaker;
+using deephaven::client::utility::ValueOrThrow;
 
 namespace deephaven::client::tests {
 
@@ -111,4 +119,72 @@ TEST_CASE("Run-end + dictionary encoded table is fetched and decoded correctly",
   TableComparerForTests::Compare(expected, t);
 }
 
+
+namespace {
+bool IsEncoded(const arrow::Schema &schema) {
+  for (const auto &field : schema.fields()) {
+    auto id = field->type()->id();
+    if (id == arrow::Type::DICTIONARY || id == arrow::Type::RUN_END_ENCODED) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<arrow::Table> ReadAll(arrow::RecordBatchReader *reader) {
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  while (true) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    OkOrThrow(DEEPHAVEN_LOCATION_EXPR(reader->ReadNext(&batch)));
+    if (batch == nullptr) {
+      break;
+    }
+    batches.push_back(std::move(batch));
+  }
+  return ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
+      arrow::Table::FromRecordBatches(reader->schema(), std::move(batches))));
+}
+
+/**
+ * Checks that reading 't' a batch at a time, cooked or raw, gives the same table as
+ * ToArrowTable() does, and that only the raw batches have encoded columns.
+ */
+void CheckBatchesMatchTable(const TableHandle &t) {
+  auto raw_reader = t.GetRecordBatchReader(false);
+  // Otherwise there is nothing for the cooked reader to decode.
+  REQUIRE(IsEncoded(*raw_reader->schema()));
+  CHECK(ReadAll(raw_reader.get())->Equals(*t.ToArrowTable(false)));
+
+  auto cooked_reader = t.GetRecordBatchReader(true);
+  CHECK(!IsEncoded(*cooked_reader->schema()));
+  auto cooked = ReadAll(cooked_reader.get());
+  CHECK(!IsEncoded(*cooked->schema()));
+  auto expected = t.ToArrowTable(true);
+  CHECK(cooked->Equals(*expected));
+
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  t.ForEachBatch([&batches](const std::shared_ptr<arrow::RecordBatch> &batch) {
+    CHECK(!IsEncoded(*batch->schema()));
+    batches.push_back(batch);
+  });
+  REQUIRE(!batches.empty());
+  auto for_each = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
+      arrow::Table::FromRecordBatches(batches.front()->schema(), std::move(batches))));
+  CHECK(for_each->Equals(*expected));
+
+  // Each stream decodes its own slice.
+  CHECK(t.ToArrowTableParallel(2, true)->Equals(*expected));
+}
+}  // namespace
+
+TEST_CASE("Encoded tables read a batch at a time match ToArrowTable", "[encoding]") {
+  auto client = TableMakerForTests::CreateClient();
+  auto thm = client.GetManager();
+
+  thm.RunScript(kEncodingSetupScript);
+  for (const auto *name : {"ree_table", "dict_table", "reedict_table"}) {
+    INFO(name);
+    CheckBatchesMatchTable(thm.FetchTable(name));
+  }
+}
 }  // namespace deephaven::client::tests
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/client/utility/executor.h"
+
+using deephaven::client::utility::Executor;
+
+namespace deephaven::client::tests {
+namespace {
+/**
+ * Counts down to zero. Wait() is bounded, so that a test whose tasks never run fails instead of
+ * hanging.
+ */
+class Latch {
+public:
+  explicit Latch(size_t count) : count_(count) {}
+
+  void CountDown() {
+    std::unique_lock guard(mutex_);
+    --count_;
+    cond_.notify_all();
+  }
+
+  [[nodiscard]]
+  bool Wait() {
+    std::unique_lock guard(mutex_);
+    return cond_.wait_for(guard, std::chrono::seconds(10), [this] { return count_ == 0; });
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  size_t count_ = 0;
+};
+
+/**
+ * Invokes a task on 'executor' that blocks until 'release' is set, and waits until it is running.
+ * Returns the thread it runs on.
+ */
+std::thread::id Block(Executor *executor, std::shared_future<void> release) {
+  auto started = std::make_shared<std::promise<std::thread::id>>();
+  auto started_future = started->get_future();
+  executor->Invoke([started, release = std::move(release)] {
+    started->set_value(std::this_thread::get_id());
+    release.wait();
+  });
+  return started_future.get();
+}
+}  // namespace
+
+TEST_CASE("Executor runs high priority tasks before normal ones", "[executor]") {
+  auto executor = Executor::Create("test", 1);
+  std::promise<void> release;
+  (void)Block(executor.get(), release.get_future().share());
+
+  // The only thread is busy, so these all queue up behind the blocking task.
+  std::mutex mutex;
+  std::vector<std::string> order;
+  Latch latch(4);
+  auto task = [&](std::string name) {
+    return [&, name = std::move(name)] {
+      {
+        std::unique_lock guard(mutex);
+        order.push_back(name);
+      }
+      latch.CountDown();
+    };
+  };
+  executor->Invoke(task("normal 1"));
+  executor->Invoke(task("high 1"), Executor::Priority::kHigh);
+  executor->Invoke(task("normal 2"));
+  executor->Invoke(task("high 2"), Executor::Priority::kHigh);
+  release.set_value();
+
+  REQUIRE(latch.Wait());
+  std::vector<std::string> expected = {"high 1", "high 2", "normal 1", "normal 2"};
+  CHECK(order == expected);
+  executor->Shutdown();
+}
+
+TEST_CASE("Executor threads steal tasks from busy ones", "[executor]") {
+  const size_t num_tasks = 10;
+  auto executor = Executor::Create("test", 2);
+  std::promise<void> release;
+  auto blocked_thread = Block(executor.get(), release.get_future().share());
+
+  // Invoke() deals these out to both threads' queues, but one thread is blocked until they are all
+  // done, so the other has to steal the ones dealt to it.
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  Latch latch(num_tasks);
+  for (size_t i = 0; i != num_tasks; ++i) {
+    executor->Invoke([&] {
+      {
+        std::unique_lock guard(mutex);
+        threads.insert(std::this_thread::get_id());
+      }
+      latch.CountDown();
+    });
+  }
+  auto all_ran = latch.Wait();
+  release.set_value();
+
+  REQUIRE(all_ran);
+  CHECK(threads.size() == 1);
+  CHECK(threads.count(blocked_thread) == 0);
+  auto metrics = executor->Metrics();
+  CHECK(metrics.tasks_stolen >= num_tasks / 2);
+  executor->Shutdown();
+  CHECK(executor->Metrics().tasks_run == num_tasks + 1);
+}
+
+TEST_CASE("Executor rejects Invoke after Shutdown", "[executor]") {
+  auto executor = Executor::Create("test", 2);
+  executor->Shutdown();
+  CHECK_THROWS_AS(executor->Invoke([] {}), std::runtime_error);
+}
+
+TEST_CASE("Executor destroys the tasks still queued at Shutdown", "[executor]") {
+  auto executor = Executor::Create("test", 1);
+  // Keep the only thread busy until Shutdown has begun, which is when Invoke() starts to throw.
+  // The probe tasks pile up behind this one and are discarded too.
+  auto *raw_executor = executor.get();
+  executor->Invoke([raw_executor] {
+    while (true) {
+      try {
+        raw_executor->Invoke([] {});
+      } catch (const std::runtime_error &) {
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+
+  auto captured = std::make_shared<int>(0);
+  std::weak_ptr<int> weak_captured = captured;
+  bool ran = false;
+  executor->Invoke([&ran, captured = std::move(captured)] { ran = true; });
+
+  executor->Shutdown();
+  CHECK(!ran);
+  CHECK(weak_captured.expired());
+  CHECK(executor->Metrics().queue_size == 0);
+}
+}  // namespace deephaven::client::tests
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <arrow/buffer.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/slice.h>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/client/subscription/flight_data.h"
+#include "deephaven/dhcore/ticking/barrage_processor.h"
+
+using deephaven::client::subscription::FlightData;
+using deephaven::client::subscription::MakeFlightData;
+using deephaven::client::subscription::ParseFlightData;
+using deephaven::dhcore::ticking::BarrageProcessor;
+using google::protobuf::internal::WireFormatLite;
+
+// The SubscriptionScheduler encodes and decodes FlightData by hand. These tests check that
+// encoding against the parser, and check the parser against messages laid out the way the server
+// sends them.
+namespace deephaven::client::tests {
+namespace {
+// Field numbers from Arrow's Flight.proto.
+constexpr int kFlightDescriptor = 1;
+constexpr int kDataHeader = 2;
+constexpr int kAppMetadata = 3;
+constexpr int kDataBody = 1000;
+
+std::vector<uint8_t> MakeBytes(size_t size, uint8_t seed) {
+  std::vector<uint8_t> result;
+  for (size_t i = 0; i != size; ++i) {
+    result.push_back(static_cast<uint8_t>(seed + i * 7));
+  }
+  return result;
+}
+
+std::vector<uint8_t> ToVector(const std::shared_ptr<arrow::Buffer> &buffer) {
+  REQUIRE(buffer != nullptr);
+  return {buffer->data(), buffer->data() + buffer->size()};
+}
+
+std::string ToString(const grpc::ByteBuffer &buffer) {
+  std::vector<grpc::Slice> slices;
+  REQUIRE(buffer.Dump(&slices).ok());
+  std::string result;
+  for (const auto &slice : slices) {
+    result.append(reinterpret_cast<const char *>(slice.begin()), slice.size());
+  }
+  return result;
+}
+
+/**
+ * Makes a ByteBuffer of 'bytes' split into slices of at most 'slice_size' bytes, as gRPC hands
+ * over a large message.
+ */
+grpc::ByteBuffer ToByteBuffer(const std::string &bytes, size_t slice_size) {
+  std::vector<grpc::Slice> slices;
+  for (size_t offset = 0; offset < bytes.size(); offset += slice_size) {
+    slices.emplace_back(bytes.substr(offset, slice_size));
+  }
+  return {slices.data(), slices.size()};
+}
+
+/**
+ * Encodes a FlightData message the way the server does, with an unknown field in front.
+ */
+std::string EncodeServerMessage(const std::vector<uint8_t> &header,
+    const std::vector<uint8_t> &metadata, const std::vector<uint8_t> &body) {
+  std::string result;
+  {
+    google::protobuf::io::StringOutputStream stream(&result);
+    google::protobuf::io::CodedOutputStream output(&stream);
+    WireFormatLite::WriteInt64(99, 12345, &output);
+    WireFormatLite::WriteBytes(kDataHeader, std::string(header.begin(), header.end()), &output);
+    WireFormatLite::WriteBytes(kAppMetadata, std::string(metadata.begin(), metadata.end()),
+        &output);
+    WireFormatLite::WriteBytes(kDataBody, std::string(body.begin(), body.end()), &output);
+  }
+  return result;
+}
+}  // namespace
+
+TEST_CASE("MakeFlightData round-trips through ParseFlightData", "[flightdata]") {
+  for (size_t size : {0, 1, 127, 128, 70000}) {
+    auto metadata = MakeBytes(size, 3);
+    auto buffer = MakeFlightData(false, metadata);
+    auto data = ParseFlightData(&buffer);
+    CHECK(data.dataHeader_ == nullptr);
+    CHECK(data.dataBody_ == nullptr);
+    CHECK(ToVector(data.appMetadata_) == metadata);
+  }
+}
+
+TEST_CASE("MakeFlightData with a descriptor carries the Barrage magic number", "[flightdata]") {
+  auto metadata = MakeBytes(300, 11);
+  auto buffer = MakeFlightData(true, metadata);
+
+  // The parser skips the descriptor.
+  auto data = ParseFlightData(&buffer);
+  CHECK(data.dataHeader_ == nullptr);
+  CHECK(data.dataBody_ == nullptr);
+  CHECK(ToVector(data.appMetadata_) == metadata);
+
+  // The descriptor is a CMD descriptor whose command is the magic number.
+  auto bytes = ToString(buffer);
+  google::protobuf::io::CodedInputStream input(reinterpret_cast<const uint8_t *>(bytes.data()),
+      static_cast<int>(bytes.size()));
+  auto tag = input.ReadTag();
+  REQUIRE(WireFormatLite::GetTagFieldNumber(tag) == kFlightDescriptor);
+  std::string descriptor;
+  REQUIRE(WireFormatLite::ReadBytes(&input, &descriptor));
+
+  google::protobuf::io::CodedInputStream dinput(
+      reinterpret_cast<const uint8_t *>(descriptor.data()), static_cast<int>(descriptor.size()));
+  CHECK(dinput.ReadTag() == WireFormatLite::MakeTag(1, WireFormatLite::WIRETYPE_VARINT));
+  uint32_t type;
+  REQUIRE(dinput.ReadVarint32(&type));
+  CHECK(type == 2);
+  CHECK(dinput.ReadTag() == WireFormatLite::MakeTag(2, WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+  std::string cmd;
+  REQUIRE(WireFormatLite::ReadBytes(&dinput, &cmd));
+  REQUIRE(cmd.size() == sizeof(BarrageProcessor::kDeephavenMagicNumber));
+  auto magic = BarrageProcessor::kDeephavenMagicNumber;
+  CHECK(std::memcmp(cmd.data(), &magic, cmd.size()) == 0);
+  CHECK(dinput.ReadTag() == 0);
+}
+
+TEST_CASE("ParseFlightData reads every field across slice boundaries", "[flightdata]") {
+  auto header = MakeBytes(200, 1);
+  auto metadata = MakeBytes(50, 2);
+  auto body = MakeBytes(100000, 3);
+  auto bytes = EncodeServerMessage(header, metadata, body);
+  for (size_t slice_size : {size_t(7), size_t(4096), bytes.size()}) {
+    auto buffer = ToByteBuffer(bytes, slice_size);
+    auto data = ParseFlightData(&buffer);
+    CHECK(ToVector(data.dataHeader_) == header);
+    CHECK(ToVector(data.appMetadata_) == metadata);
+    CHECK(ToVector(data.dataBody_) == body);
+  }
+}
+
+TEST_CASE("ParseFlightData rejects a truncated message", "[flightdata]") {
+  auto bytes = EncodeServerMessage(MakeBytes(20, 1), MakeBytes(20, 2), MakeBytes(1000, 3));
+  bytes.resize(bytes.size() - 10);
+  auto buffer = ToByteBuffer(bytes, 64);
+  CHECK_THROWS_AS(ParseFlightData(&buffer), std::runtime_error);
+}
+}  // namespace deephaven::client::tests
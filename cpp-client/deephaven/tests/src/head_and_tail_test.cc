@@ -30,4 +30,18 @@ TEST_CASE("Head and Tail", "[headtail]") {
   expected_tail.AddColumn<std::int64_t>("Volume", {46123, 48300});
   TableComparerForTests::Compare(expected_tail, tt);
 }
+
+TEST_CASE("Slice", "[headtail]") {
+  auto tm = TableMakerForTests::Create();
+  auto table = tm.Client().GetManager().EmptyTable(10).Update("X = ii");
+
+  TableMaker expected_middle;
+  expected_middle.AddColumn<int64_t>("X", {3, 4, 5});
+  TableComparerForTests::Compare(expected_middle, table.Slice(3, 6));
+
+  // Negative positions count from the end.
+  TableMaker expected_end;
+  expected_end.AddColumn<int64_t>("X", {8, 9});
+  TableComparerForTests::Compare(expected_end, table.Slice(-2, 10));
+}
 }  // namespace deephaven::client::tests
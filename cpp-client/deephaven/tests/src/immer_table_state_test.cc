@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/clienttable/client_table.h"
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/array_column_source.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/immer_table_state.h"
+#include "deephaven/dhcore/types.h"
+
+using deephaven::dhcore::ElementType;
+using deephaven::dhcore::ElementTypeId;
+using deephaven::dhcore::chunk::BooleanChunk;
+using deephaven::dhcore::chunk::Int64Chunk;
+using deephaven::dhcore::chunk::StringChunk;
+using deephaven::dhcore::clienttable::ClientTable;
+using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::column::ColumnSource;
+using deephaven::dhcore::column::Int64ArrayColumnSource;
+using deephaven::dhcore::column::StringArrayColumnSource;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::ticking::ImmerTableState;
+
+// These tests check that the ways ImmerTableState can apply a RowSequence to its columns, splicing
+// per interval and rebuilding each column in one pass, give the same tables. They drive one table
+// per SpliceMode with the same random adds, erases and modifies, scattered over many intervals,
+// and check each table against a std::map from key to value after every step. The table has an
+// int64 column "I" and a string column "S" holding the same values as text, or null for every
+// fifth value, so the null flags are spliced too.
+namespace deephaven::client::tests {
+namespace {
+using SpliceMode = ImmerTableState::SpliceMode;
+
+constexpr uint64_t kKeySpace = 20'000;
+
+std::optional<std::string> StringOf(int64_t value) {
+  if (value % 5 == 0) {
+    return {};
+  }
+  return std::to_string(value);
+}
+
+/**
+ * The two columns holding 'values', in order.
+ */
+std::vector<std::shared_ptr<ColumnSource>> MakeSources(const std::vector<int64_t> &values) {
+  auto size = values.size();
+  auto ints = std::make_unique<int64_t[]>(size);
+  auto int_nulls = std::make_unique<bool[]>(size);
+  auto strings = std::make_unique<std::string[]>(size);
+  auto string_nulls = std::make_unique<bool[]>(size);
+  for (size_t i = 0; i != size; ++i) {
+    ints[i] = values[i];
+    int_nulls[i] = false;
+    auto s = StringOf(values[i]);
+    string_nulls[i] = !s.has_value();
+    strings[i] = s.value_or("");
+  }
+  return {
+      Int64ArrayColumnSource::CreateFromArrays(ElementType::Of(ElementTypeId::kInt64),
+          std::move(ints), std::move(int_nulls), size),
+      StringArrayColumnSource::CreateFromArrays(ElementType::Of(ElementTypeId::kString),
+          std::move(strings), std::move(string_nulls), size)};
+}
+
+std::shared_ptr<RowSequence> Build(const std::vector<uint64_t> &keys) {
+  RowSequenceBuilder builder;
+  for (auto key : keys) {
+    builder.Add(key);
+  }
+  return builder.Build();
+}
+
+class Checker {
+public:
+  explicit Checker(uint64_t seed) : rng_(seed) {
+    auto schema = Schema::Create({"I", "S"},
+        {ElementType::Of(ElementTypeId::kInt64), ElementType::Of(ElementTypeId::kString)});
+    for (auto mode : {SpliceMode::kPerInterval, SpliceMode::kRebuild, SpliceMode::kAuto}) {
+      auto state = std::make_unique<ImmerTableState>(schema);
+      state->SetSpliceMode(mode);
+      states_.push_back(std::move(state));
+    }
+  }
+
+  void Step() {
+    switch (Random(3)) {
+      case 0: Add(); break;
+      case 1: Erase(); break;
+      default: Modify(); break;
+    }
+    for (const auto &state : states_) {
+      CheckTable(*state->Snapshot());
+    }
+  }
+
+  void Add() {
+    // Runs of new keys, some of a single row and some of many.
+    std::vector<uint64_t> keys;
+    auto num_runs = 1 + Random(40);
+    for (size_t i = 0; i != num_runs; ++i) {
+      auto begin = Random(kKeySpace);
+      auto size = Random(4) == 0 ? 1 + Random(300) : 1;
+      for (auto key = begin; key != begin + size && key != kKeySpace; ++key) {
+        if (model_.find(key) == model_.end()) {
+          keys.push_back(key);
+          model_[key] = 0;
+        }
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+    auto values = NewValues(keys);
+    auto sources = MakeSources(values);
+    std::vector<size_t> begins(2, 0);
+    std::vector<size_t> ends(2, values.size());
+    auto key_rows = Build(keys);
+    for (const auto &state : states_) {
+      auto indices = state->AddKeys(*key_rows);
+      state->AddData(sources, begins, ends, *indices);
+    }
+  }
+
+  void Erase() {
+    auto keys = SomePresentKeys();
+    auto key_rows = Build(keys);
+    for (const auto &state : states_) {
+      auto indices = state->Erase(*key_rows);
+      CHECK(indices->Size() == keys.size());
+    }
+    for (auto key : keys) {
+      model_.erase(key);
+    }
+  }
+
+  void Modify() {
+    auto keys = SomePresentKeys();
+    auto values = NewValues(keys);
+    auto sources = MakeSources(values);
+    auto key_rows = Build(keys);
+    for (const auto &state : states_) {
+      auto indices = state->ConvertKeysToIndices(*key_rows);
+      for (size_t col = 0; col != sources.size(); ++col) {
+        state->ModifyData(col, *sources[col], 0, values.size(), *indices);
+      }
+    }
+  }
+
+private:
+  uint64_t Random(uint64_t end) {
+    return std::uniform_int_distribution<uint64_t>(0, end - 1)(rng_);
+  }
+
+  /**
+   * Each key that is present with some probability, which varies from call to call, so that the
+   * rows come in anything from a few intervals to many.
+   */
+  std::vector<uint64_t> SomePresentKeys() {
+    auto one_in = 1 + Random(20);
+    std::vector<uint64_t> result;
+    for (const auto &[key, value] : model_) {
+      if (Random(one_in) == 0) {
+        result.push_back(key);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * New values for 'keys', which are also recorded in the model.
+   */
+  std::vector<int64_t> NewValues(const std::vector<uint64_t> &keys) {
+    std::vector<int64_t> result;
+    for (auto key : keys) {
+      auto value = nextValue_++;
+      model_[key] = value;
+      result.push_back(value);
+    }
+    return result;
+  }
+
+  void CheckTable(const ClientTable &table) const {
+    REQUIRE(table.NumRows() == model_.size());
+    auto rows = table.GetRowSequence();
+    auto ints = Int64Chunk::Create(rows->Size());
+    auto strings = StringChunk::Create(rows->Size());
+    auto string_nulls = BooleanChunk::Create(rows->Size());
+    table.GetColumn(0)->FillChunk(*rows, &ints, nullptr);
+    table.GetColumn(1)->FillChunk(*rows, &strings, &string_nulls);
+
+    std::vector<int64_t> expected_ints;
+    std::vector<std::optional<std::string>> expected_strings;
+    for (const auto &[key, value] : model_) {
+      expected_ints.push_back(value);
+      expected_strings.push_back(StringOf(value));
+    }
+    std::vector<int64_t> actual_ints(ints.begin(), ints.end());
+    REQUIRE(actual_ints == expected_ints);
+    std::vector<std::optional<std::string>> actual_strings;
+    for (size_t i = 0; i != rows->Size(); ++i) {
+      actual_strings.push_back(string_nulls[i] ? std::optional<std::string>() : strings[i]);
+    }
+    REQUIRE(actual_strings == expected_strings);
+  }
+
+  std::mt19937_64 rng_;
+  std::vector<std::unique_ptr<ImmerTableState>> states_;
+  std::map<uint64_t, int64_t> model_;
+  int64_t nextValue_ = 1;
+};
+}  // namespace
+
+TEST_CASE("Splicing per interval and rebuilding give the same tables", "[immertablestate]") {
+  for (uint64_t seed = 0; seed != 4; ++seed) {
+    Checker checker(seed);
+    // Start with a table big enough that kAuto splices small updates and rebuilds large ones.
+    checker.Add();
+    checker.Add();
+    for (size_t i = 0; i != 60; ++i) {
+      checker.Step();
+    }
+  }
+}
+}  // namespace deephaven::client::tests
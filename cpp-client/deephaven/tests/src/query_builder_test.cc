@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/tests/test_util.h"
+#include "deephaven/client/query_builder.h"
+
+using deephaven::client::QueryBuilder;
+using deephaven::client::QueryTable;
+using deephaven::client::TableHandle;
+using deephaven::client::utility::TableMaker;
+
+namespace deephaven::client::tests {
+TEST_CASE("QueryBuilder exports only the requested tables", "[querybuilder]") {
+  auto tm = TableMakerForTests::Create();
+  auto qb = tm.Client().GetManager().CreateQueryBuilder();
+
+  auto table = qb.FromTableHandle(tm.Table()).Where("ImportDate == `2017-11-01`");
+  auto aapl = table.Where("Ticker == `AAPL`").Select("Ticker", "Close", "Volume");
+  auto ibm = table.Where("Ticker == `IBM`").Select("Ticker", "Volume");
+
+  auto results = qb.Submit({aapl, ibm});
+  REQUIRE(results.size() == 2);
+
+  TableMaker expected_aapl;
+  expected_aapl.AddColumn<std::string>("Ticker", {"AAPL", "AAPL", "AAPL"});
+  expected_aapl.AddColumn<double>("Close", {23.5, 24.2, 26.7});
+  expected_aapl.AddColumn<int64_t>("Volume", {100000, 250000, 19000});
+  TableComparerForTests::Compare(expected_aapl, results[0]);
+
+  TableMaker expected_ibm;
+  expected_ibm.AddColumn<std::string>("Ticker", {"IBM"});
+  expected_ibm.AddColumn<int64_t>("Volume", {138000});
+  TableComparerForTests::Compare(expected_ibm, results[1]);
+}
+
+TEST_CASE("QueryBuilder join", "[querybuilder]") {
+  auto tm = TableMakerForTests::Create();
+  auto qb = tm.Client().GetManager().CreateQueryBuilder();
+
+  auto left = qb.EmptyTable(3).Update("X = ii");
+  auto right = qb.EmptyTable(3).Update("X = ii", "Y = X * 10");
+  auto joined = qb.Submit(left.NaturalJoin(right, {"X"}, {"Y"}));
+
+  TableMaker expected;
+  expected.AddColumn<int64_t>("X", {0, 1, 2});
+  expected.AddColumn<int64_t>("Y", {0, 10, 20});
+  TableComparerForTests::Compare(expected, joined);
+}
+
+TEST_CASE("QueryBuilder errors", "[querybuilder]") {
+  auto tm = TableMakerForTests::Create();
+  auto manager = tm.Client().GetManager();
+  auto qb = manager.CreateQueryBuilder();
+
+  auto bad = qb.EmptyTable(3).Where(")))))");
+  CHECK_THROWS(qb.Submit(bad));
+
+  // A table from another builder can't take part.
+  auto other = manager.CreateQueryBuilder().EmptyTable(3);
+  CHECK_THROWS(qb.Submit(other));
+  CHECK_THROWS(qb.EmptyTable(3).NaturalJoin(other, {"X"}, {}));
+
+  // Nor can an empty one.
+  QueryTable empty;
+  CHECK_THROWS(empty.Where("X > 0"));
+  CHECK_THROWS(qb.Submit(empty));
+  CHECK_THROWS(qb.EmptyTable(3).NaturalJoin(empty, {"X"}, {}));
+  CHECK_THROWS(empty.NaturalJoin(qb.EmptyTable(3), {"X"}, {}));
+  CHECK_THROWS(QueryBuilder().EmptyTable(3));
+  CHECK_THROWS(QueryBuilder().Submit(qb.EmptyTable(3)));
+}
+}  // namespace deephaven::client::tests
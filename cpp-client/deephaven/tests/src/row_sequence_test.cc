@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/dhcore/container/row_sequence.h"
+
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+
+namespace deephaven::client::tests {
+namespace {
+std::vector<std::pair<uint64_t, uint64_t>> Intervals(const RowSequence &rows) {
+  std::vector<std::pair<uint64_t, uint64_t>> result;
+  rows.ForEachInterval([&result](uint64_t begin, uint64_t end) {
+    result.emplace_back(begin, end);
+  });
+  return result;
+}
+}  // namespace
+
+TEST_CASE("RowSequence from intervals", "[rowsequence]") {
+  auto rows = RowSequence::CreateFromIntervals({{10, 13}, {20, 21}, {30, 35}});
+  CHECK(rows->Size() == 9);
+
+  std::vector<std::pair<uint64_t, uint64_t>> expected = {{10, 13}, {20, 21}, {30, 35}};
+  CHECK(Intervals(*rows) == expected);
+
+  expected = {{10, 13}, {20, 21}, {30, 31}};
+  CHECK(Intervals(*rows->Take(5)) == expected);
+
+  expected = {{12, 13}, {20, 21}, {30, 35}};
+  CHECK(Intervals(*rows->Drop(2)) == expected);
+
+  expected = {{30, 35}};
+  CHECK(Intervals(*rows->Drop(4)) == expected);
+
+  expected = {{31, 33}};
+  CHECK(Intervals(*rows->Drop(5)->Take(2)) == expected);
+
+  CHECK(rows->Drop(100)->Empty());
+
+  // Agrees with RowSequenceBuilder.
+  RowSequenceBuilder builder;
+  builder.AddInterval(30, 35);
+  builder.AddInterval(10, 13);
+  builder.Add(20);
+  CHECK(Intervals(*builder.Build()) == Intervals(*rows));
+
+  auto iter = rows->Drop(2)->GetRowSequenceIterator();
+  std::vector<uint64_t> keys;
+  uint64_t key;
+  while (iter.TryGetNext(&key)) {
+    keys.push_back(key);
+  }
+  CHECK(keys == std::vector<uint64_t>{12, 20, 30, 31, 32, 33, 34});
+}
+
+TEST_CASE("RowSequenceBuilder merges out-of-order and overlapping intervals", "[rowsequence]") {
+  RowSequenceBuilder builder;
+  builder.AddInterval(50, 60);
+  builder.AddInterval(10, 20);
+  builder.AddInterval(15, 30);
+  builder.Add(30);
+  builder.AddInterval(55, 70);
+  builder.Add(5);
+  builder.AddInterval(40, 40);
+  auto rows = builder.Build();
+
+  std::vector<std::pair<uint64_t, uint64_t>> expected = {{5, 6}, {10, 31}, {50, 70}};
+  CHECK(Intervals(*rows) == expected);
+  CHECK(rows->Size() == 42);
+
+  // The builder is empty afterwards and can be reused.
+  CHECK(builder.Build()->Empty());
+  builder.AddInterval(3, 4);
+  expected = {{3, 4}};
+  CHECK(Intervals(*builder.Build()) == expected);
+}
+
+TEST_CASE("RowSequence Take and Drop agree with the individual keys", "[rowsequence]") {
+  RowSequenceBuilder builder;
+  std::vector<uint64_t> keys;
+  for (uint64_t begin = 0; begin < 200; begin += 7) {
+    auto end = begin + 1 + begin % 5;
+    builder.AddInterval(begin, end);
+    for (auto key = begin; key != end; ++key) {
+      keys.push_back(key);
+    }
+  }
+  auto rows = builder.Build();
+  REQUIRE(rows->Size() == keys.size());
+
+  auto flatten = [](const RowSequence &rs) {
+    std::vector<uint64_t> result;
+    rs.ForEachIntervalInline([&result](uint64_t begin, uint64_t end) {
+      for (auto key = begin; key != end; ++key) {
+        result.push_back(key);
+      }
+    });
+    return result;
+  };
+
+  for (size_t drop = 0; drop <= keys.size(); drop += 3) {
+    for (size_t take = 0; take <= keys.size() - drop; take += 5) {
+      auto slice = rows->Drop(drop)->Take(take);
+      std::vector<uint64_t> expected(keys.begin() + drop, keys.begin() + drop + take);
+      CHECK(slice->Size() == take);
+      CHECK(flatten(*slice) == expected);
+      // Dropping again from a slice composes.
+      auto expected_tail = rows->Drop(drop + 1)->Take(take == 0 ? 0 : take - 1);
+      CHECK(flatten(*slice->Drop(1)) == flatten(*expected_tail));
+    }
+  }
+}
+
+TEST_CASE("RowSequence from intervals rejects bad input", "[rowsequence]") {
+  CHECK(RowSequence::CreateFromIntervals({})->Empty());
+  CHECK_THROWS(RowSequence::CreateFromIntervals({{5, 5}}));
+  CHECK_THROWS(RowSequence::CreateFromIntervals({{10, 20}, {0, 5}}));
+  CHECK_THROWS(RowSequence::CreateFromIntervals({{10, 20}, {15, 25}}));
+}
+}  // namespace deephaven::client::tests
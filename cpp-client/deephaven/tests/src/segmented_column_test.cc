@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/client/arrowutil/arrow_array_converter.h"
+#include "deephaven/client/utility/arrow_util.h"
+#include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/clienttable/client_table.h"
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/column_source.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/immer_table_state.h"
+#include "deephaven/dhcore/ticking/segmented_column.h"
+#include "deephaven/dhcore/types.h"
+
+using deephaven::client::arrowutil::ArrowArrayConverter;
+using deephaven::client::utility::OkOrThrow;
+using deephaven::client::utility::ValueOrThrow;
+using deephaven::dhcore::ElementType;
+using deephaven::dhcore::ElementTypeId;
+using deephaven::dhcore::chunk::Int64Chunk;
+using deephaven::dhcore::chunk::StringChunk;
+using deephaven::dhcore::clienttable::ClientTable;
+using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::column::ColumnSource;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::ticking::ImmerTableState;
+using deephaven::dhcore::ticking::SegmentedColumn;
+
+// These tests check the zero-copy mode of ImmerTableState, in which appended ColumnSources are
+// kept by reference in SegmentedColumns. The sources are made from Arrow arrays, as they are for a
+// real subscription, and each batch is either large enough to be kept as a segment of its own or
+// small enough to be copied into the tail. The table has an int64 column "I" and a string column
+// "S" holding the same values as text, and is checked against a std::vector of the values.
+namespace deephaven::client::tests {
+namespace {
+constexpr size_t kLarge = SegmentedColumn::kMinZeroCopyRows;
+// The source arrays have this many extra rows in front of the data, so that the segments
+// don't start at row 0 of their sources.
+constexpr size_t kSourceOffset = 3;
+
+std::shared_ptr<ColumnSource> MakeInt64Source(const std::vector<int64_t> &values) {
+  arrow::Int64Builder builder;
+  for (size_t i = 0; i != kSourceOffset; ++i) {
+    OkOrThrow(DEEPHAVEN_LOCATION_EXPR(builder.Append(-1)));
+  }
+  OkOrThrow(DEEPHAVEN_LOCATION_EXPR(builder.AppendValues(values)));
+  auto array = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(builder.Finish()));
+  return ArrowArrayConverter::ArrayToColumnSource(std::move(array));
+}
+
+std::shared_ptr<ColumnSource> MakeStringSource(const std::vector<int64_t> &values) {
+  arrow::StringBuilder builder;
+  for (size_t i = 0; i != kSourceOffset; ++i) {
+    OkOrThrow(DEEPHAVEN_LOCATION_EXPR(builder.Append("junk")));
+  }
+  for (auto value : values) {
+    OkOrThrow(DEEPHAVEN_LOCATION_EXPR(builder.Append(std::to_string(value))));
+  }
+  auto array = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(builder.Finish()));
+  return ArrowArrayConverter::ArrayToColumnSource(std::move(array));
+}
+
+/**
+ * An ImmerTableState in zero-copy mode, alongside the values it ought to hold. Row keys are
+ * handed out in increasing order, so every AddRows is an append.
+ */
+class Fixture {
+public:
+  Fixture() {
+    auto schema = Schema::Create({"I", "S"},
+        {ElementType::Of(ElementTypeId::kInt64), ElementType::Of(ElementTypeId::kString)});
+    state_ = std::make_unique<ImmerTableState>(std::move(schema));
+    state_->SetZeroCopyAppends(true);
+  }
+
+  /**
+   * Appends 'count' rows with new values.
+   */
+  void AddRows(size_t count) {
+    auto values = NewValues(count);
+    auto keys = RowSequence::CreateSequential(nextKey_, nextKey_ + count);
+    for (size_t i = 0; i != count; ++i) {
+      keys_.push_back(nextKey_++);
+    }
+    auto indices = state_->AddKeys(*keys);
+    std::vector<std::shared_ptr<ColumnSource>> sources = {MakeInt64Source(values),
+        MakeStringSource(values)};
+    std::vector<size_t> begins(2, kSourceOffset);
+    std::vector<size_t> ends(2, kSourceOffset + count);
+    state_->AddData(sources, begins, ends, *indices);
+    expected_.insert(expected_.end(), values.begin(), values.end());
+  }
+
+  /**
+   * Removes the rows at positions [begin, end).
+   */
+  void RemoveRows(size_t begin, size_t end) {
+    auto indices = state_->Erase(*KeysAt(begin, end));
+    CHECK(indices->Size() == end - begin);
+    expected_.erase(expected_.begin() + static_cast<ptrdiff_t>(begin),
+        expected_.begin() + static_cast<ptrdiff_t>(end));
+    keys_.erase(keys_.begin() + static_cast<ptrdiff_t>(begin),
+        keys_.begin() + static_cast<ptrdiff_t>(end));
+  }
+
+  /**
+   * Gives the rows at positions [begin, end) new values.
+   */
+  void ModifyRows(size_t begin, size_t end) {
+    auto count = end - begin;
+    auto values = NewValues(count);
+    auto indices = state_->ConvertKeysToIndices(*KeysAt(begin, end));
+    state_->ModifyData(0, *MakeInt64Source(values), kSourceOffset, kSourceOffset + count,
+        *indices);
+    state_->ModifyData(1, *MakeStringSource(values), kSourceOffset, kSourceOffset + count,
+        *indices);
+    std::copy(values.begin(), values.end(), expected_.begin() + static_cast<ptrdiff_t>(begin));
+  }
+
+  /**
+   * Checks that a snapshot of the table holds the expected values, and returns it.
+   */
+  std::shared_ptr<ClientTable> Check() const {
+    auto table = state_->Snapshot();
+    CheckTable(*table, expected_);
+    return table;
+  }
+
+  static void CheckTable(const ClientTable &table, const std::vector<int64_t> &expected) {
+    REQUIRE(table.NumRows() == expected.size());
+    auto rows = table.GetRowSequence();
+    auto ints = Int64Chunk::Create(rows->Size());
+    auto strings = StringChunk::Create(rows->Size());
+    table.GetColumn(0)->FillChunk(*rows, &ints, nullptr);
+    table.GetColumn(1)->FillChunk(*rows, &strings, nullptr);
+    std::vector<int64_t> actual_ints(ints.begin(), ints.end());
+    CHECK(actual_ints == expected);
+    std::vector<std::string> expected_strings;
+    for (auto value : expected) {
+      expected_strings.push_back(std::to_string(value));
+    }
+    std::vector<std::string> actual_strings(strings.begin(), strings.end());
+    CHECK(actual_strings == expected_strings);
+
+    // Also check a fragmented read that crosses every segment.
+    if (expected.size() < 3) {
+      return;
+    }
+    RowSequenceBuilder builder;
+    for (size_t i = 0; i < expected.size(); i += 7) {
+      builder.Add(i);
+    }
+    auto sparse = builder.Build();
+    auto sparse_ints = Int64Chunk::Create(sparse->Size());
+    table.GetColumn(0)->FillChunk(*sparse, &sparse_ints, nullptr);
+    for (size_t i = 0; i != sparse->Size(); ++i) {
+      CHECK(sparse_ints[i] == expected[i * 7]);
+    }
+  }
+
+  const std::vector<int64_t> &Expected() const {
+    return expected_;
+  }
+
+private:
+  std::shared_ptr<RowSequence> KeysAt(size_t begin, size_t end) const {
+    RowSequenceBuilder builder;
+    for (auto i = begin; i != end; ++i) {
+      builder.Add(keys_[i]);
+    }
+    return builder.Build();
+  }
+
+  std::vector<int64_t> NewValues(size_t count) {
+    std::vector<int64_t> result;
+    for (size_t i = 0; i != count; ++i) {
+      result.push_back(nextValue_++);
+    }
+    return result;
+  }
+
+  std::unique_ptr<ImmerTableState> state_;
+  std::vector<int64_t> expected_;
+  // The row keys of the rows in expected_.
+  std::vector<uint64_t> keys_;
+  uint64_t nextKey_ = 100;
+  int64_t nextValue_ = 1000;
+};
+}  // namespace
+
+TEST_CASE("Zero-copy appends mix referenced segments with copied ones", "[segmentedcolumn]") {
+  Fixture fixture;
+  fixture.AddRows(2 * kLarge);
+  auto first = fixture.Check();
+  auto first_expected = fixture.Expected();
+
+  // Small batches go to the tail; a large one freezes it and becomes a segment of its own.
+  fixture.AddRows(10);
+  fixture.AddRows(20);
+  fixture.Check();
+  fixture.AddRows(kLarge + 500);
+  fixture.AddRows(5);
+  fixture.AddRows(kLarge);
+  fixture.AddRows(1);
+  fixture.Check();
+
+  // Earlier snapshots are unaffected by later appends.
+  Fixture::CheckTable(*first, first_expected);
+}
+
+TEST_CASE("Zero-copy columns erase from the front across segments", "[segmentedcolumn]") {
+  Fixture fixture;
+  fixture.AddRows(kLarge);
+  fixture.AddRows(10);
+  fixture.AddRows(20);
+  fixture.AddRows(kLarge);
+  fixture.AddRows(7);
+  auto before = fixture.Check();
+  auto before_expected = fixture.Expected();
+
+  // Part way into the first segment, then into the tail, then past it into the next segment.
+  fixture.RemoveRows(0, 100);
+  fixture.Check();
+  fixture.RemoveRows(0, kLarge - 100 + 15);
+  fixture.Check();
+  fixture.RemoveRows(0, 15 + 10);
+  fixture.Check();
+  // Everything but part of the last tail, then append again.
+  fixture.RemoveRows(0, fixture.Expected().size() - 3);
+  fixture.Check();
+  fixture.AddRows(4);
+  fixture.AddRows(kLarge);
+  fixture.Check();
+
+  Fixture::CheckTable(*before, before_expected);
+}
+
+TEST_CASE("Modifying across a segment boundary leaves zero-copy mode", "[segmentedcolumn]") {
+  Fixture fixture;
+  fixture.AddRows(kLarge);
+  fixture.AddRows(10);
+  fixture.AddRows(kLarge);
+  auto before = fixture.Check();
+  auto before_expected = fixture.Expected();
+
+  // From the end of the first segment, through the tail, into the last segment.
+  fixture.ModifyRows(kLarge - 5, kLarge + 10 + 5);
+  fixture.Check();
+  // The table now lives in flex vectors, and appends still work.
+  fixture.AddRows(kLarge);
+  fixture.AddRows(3);
+  fixture.Check();
+
+  Fixture::CheckTable(*before, before_expected);
+}
+
+TEST_CASE("Removing from the middle leaves zero-copy mode", "[segmentedcolumn]") {
+  Fixture fixture;
+  fixture.AddRows(kLarge);
+  fixture.AddRows(10);
+  fixture.AddRows(kLarge);
+  auto before = fixture.Check();
+  auto before_expected = fixture.Expected();
+
+  fixture.RemoveRows(kLarge - 20, kLarge + 30);
+  fixture.Check();
+  fixture.AddRows(kLarge);
+  fixture.AddRows(10);
+  fixture.RemoveRows(0, 50);
+  fixture.Check();
+
+  Fixture::CheckTable(*before, before_expected);
+}
+}  // namespace deephaven::client::tests
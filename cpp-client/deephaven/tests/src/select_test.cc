@@ -2,6 +2,8 @@
  * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
  */
 #include <iostream>
+#include <vector>
+#include <arrow/table.h>
 #include "deephaven/third_party/catch.hpp"
 #include "deephaven/tests/test_util.h"
 #include "deephaven/dhcore/types.h"
@@ -9,6 +11,8 @@
 #include "deephaven/third_party/fmt/format.h"
 
 using deephaven::client::Client;
+using deephaven::client::ClientOptions;
+using deephaven::client::SortPair;
 using deephaven::client::TableHandle;
 using deephaven::client::utility::TableMaker;
 using deephaven::dhcore::DateTime;
@@ -255,4 +259,76 @@ TEST_CASE("SelectDistinct", "[select]") {
   expected.AddColumn<std::string>("A", {"apple", "orange", "plum", "grape"});
   TableComparerForTests::Compare(expected, result);
 }
+
+TEST_CASE("Asynchronous operations", "[select]") {
+  auto tm = TableMakerForTests::Create();
+  auto table = tm.Table();
+
+  // All four requests are sent without waiting; the second of each pair depends on the first.
+  auto aapl = table.WhereAsync("ImportDate == `2017-11-01` && Ticker == `AAPL`")
+      .SelectAsync({"Ticker", "Close", "Volume"});
+  auto ibm = table.WhereAsync("ImportDate == `2017-11-01` && Ticker == `IBM`")
+      .SelectAsync({"Ticker", "Volume"});
+
+  TableMaker expected_aapl;
+  expected_aapl.AddColumn<std::string>("Ticker", {"AAPL", "AAPL", "AAPL"});
+  expected_aapl.AddColumn<double>("Close", {23.5, 24.2, 26.7});
+  expected_aapl.AddColumn<int64_t>("Volume", {100000, 250000, 19000});
+  TableComparerForTests::Compare(expected_aapl, aapl);
+
+  TableMaker expected_ibm;
+  expected_ibm.AddColumn<std::string>("Ticker", {"IBM"});
+  expected_ibm.AddColumn<int64_t>("Volume", {138000});
+  TableComparerForTests::Compare(expected_ibm, ibm);
+
+  // A longer chain, mixing in a synchronous operation on a table that may still be pending.
+  auto chained = tm.Client().GetManager().EmptyTable(10).UpdateAsync({"II = ii"})
+      .WhereAsync("II >= 2").SortAsync({SortPair::Descending("II")}).HeadAsync(3).View({"II"});
+  TableMaker expected_chained;
+  expected_chained.AddColumn<int64_t>("II", {9, 8, 7});
+  TableComparerForTests::Compare(expected_chained, chained);
+  CHECK(chained.NumRows() == 3);
+
+  // A pending table can be read over several streams, which waits for it to be created.
+  auto pending = tm.Client().GetManager().EmptyTable(1000).UpdateAsync({"X = ii"});
+  auto parallel = pending.ToArrowTableParallel(4);
+  CHECK(parallel->num_rows() == 1000);
+  CHECK(parallel->Equals(*pending.ToArrowTable()));
+
+  // Tables dropped before the server replies are released once it has.
+  for (int i = 0; i != 20; ++i) {
+    (void)pending.UpdateAsync({"Y = X * 2"});
+  }
+  CHECK(pending.UpdateAsync({"Y = X * 2"}).NumRows() == 1000);
+
+  // A failure is reported through the handle, and by the operations that depend on it.
+  auto bad = table.WhereAsync(")))))");
+  auto bad_child = bad.SelectAsync({"Ticker"});
+  CHECK_THROWS(bad.Await());
+  CHECK_THROWS(bad.NumRows());
+  CHECK_THROWS(bad_child.Await());
+}
+
+TEST_CASE("Asynchronous operations on a multithreaded executor", "[select]") {
+  auto client = TableMakerForTests::CreateClient(ClientOptions().SetExecutorThreads(4));
+  auto manager = client.GetManager();
+  auto table = manager.EmptyTable(10).UpdateAsync({"X = ii"});
+
+  std::vector<TableHandle> tables;
+  for (int64_t i = 0; i != 50; ++i) {
+    tables.push_back(table.WhereAsync(fmt::format("X >= {}", i % 10)));
+  }
+  for (size_t i = 0; i != tables.size(); ++i) {
+    CHECK(tables[i].NumRows() == 10 - static_cast<int64_t>(i % 10));
+  }
+
+  auto metrics = manager.GetExecutorMetrics();
+  REQUIRE(metrics.size() == 2);
+  CHECK(metrics[0].num_threads == 4);
+  CHECK(metrics[0].tasks_stolen <= metrics[0].tasks_run);
+  CHECK(metrics[0].max_queue_time <= metrics[0].total_queue_time);
+  CHECK(metrics[0].max_run_time <= metrics[0].total_run_time);
+
+  CHECK_THROWS(ClientOptions().SetExecutorThreads(0));
+}
 }  // namespace deephaven::client::tests
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/tests/test_util.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+
+using deephaven::client::utility::TableMaker;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+
+namespace deephaven::client::tests {
+TEST_CASE("Snapshot of a range of rows", "[snapshot]") {
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+  auto table = tm.EmptyTable(1000).Update({"II = ii", "JJ = ii * 2"});
+
+  auto ct = table.Snapshot(*RowSequence::CreateSequential(10, 15));
+
+  TableMaker expected;
+  expected.AddColumn<int64_t>("II", {10, 11, 12, 13, 14});
+  expected.AddColumn<int64_t>("JJ", {20, 22, 24, 26, 28});
+  TableComparerForTests::Compare(expected, *ct);
+}
+
+TEST_CASE("Snapshot of a column subset from the end of the table", "[snapshot]") {
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+  auto table = tm.EmptyTable(1000).Update({"II = ii", "JJ = ii * 2"});
+
+  auto ct = table.Snapshot(*RowSequence::CreateSequential(0, 3), {"II"}, true);
+
+  // Columns that were not requested are present, but null.
+  TableMaker expected;
+  expected.AddColumn<int64_t>("II", {997, 998, 999});
+  expected.AddColumn<std::optional<int64_t>>("JJ", {{}, {}, {}});
+  TableComparerForTests::Compare(expected, *ct);
+}
+
+TEST_CASE("Snapshot of a filtered table whose row keys are not contiguous", "[snapshot]") {
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+  // Where() keeps the row keys of its source, so this table's keys are 0, 3, 6, ..., and position
+  // p holds row key 3p.
+  auto table = tm.EmptyTable(1000).Update({"II = ii", "JJ = ii * 2"}).Where("II % 3 == 0");
+
+  auto ct = table.Snapshot(*RowSequence::CreateSequential(10, 15));
+
+  TableMaker expected;
+  expected.AddColumn<int64_t>("II", {30, 33, 36, 39, 42});
+  expected.AddColumn<int64_t>("JJ", {60, 66, 72, 78, 84});
+  TableComparerForTests::Compare(expected, *ct);
+}
+
+TEST_CASE("Snapshot of scattered positions in a sorted table", "[snapshot]") {
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+  auto table = tm.EmptyTable(1000).Update({"II = ii", "JJ = ii * 2"})
+      .Where("II % 2 == 0")
+      .Sort(SortPair::Descending("II"));
+
+  RowSequenceBuilder builder;
+  builder.AddInterval(0, 2);
+  builder.AddInterval(100, 102);
+  builder.Add(499);
+  auto ct = table.Snapshot(*builder.Build());
+
+  TableMaker expected;
+  expected.AddColumn<int64_t>("II", {998, 996, 798, 796, 0});
+  expected.AddColumn<int64_t>("JJ", {1996, 1992, 1596, 1592, 0});
+  TableComparerForTests::Compare(expected, *ct);
+}
+}  // namespace deephaven::client::tests
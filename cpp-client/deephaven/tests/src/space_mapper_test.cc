@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/space_mapper.h"
+
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::ticking::SpaceMapper;
+
+namespace deephaven::client::tests {
+namespace {
+// SpaceMapper keeps its keys in buckets of this many consecutive keys. The random keys span a few
+// buckets so that operations straddle bucket boundaries and sometimes cover whole buckets.
+constexpr uint64_t kBucketSize = uint64_t(1) << 16;
+constexpr uint64_t kKeySpace = 6 * kBucketSize;
+
+std::vector<uint64_t> Flatten(const RowSequence &rows) {
+  std::vector<uint64_t> result;
+  rows.ForEachInterval([&result](uint64_t begin, uint64_t end) {
+    for (auto key = begin; key != end; ++key) {
+      result.push_back(key);
+    }
+  });
+  return result;
+}
+
+std::shared_ptr<RowSequence> Build(const std::set<uint64_t> &keys) {
+  RowSequenceBuilder builder;
+  for (auto key : keys) {
+    builder.Add(key);
+  }
+  return builder.Build();
+}
+
+uint64_t Rank(const std::set<uint64_t> &reference, uint64_t value) {
+  return std::distance(reference.begin(), reference.lower_bound(value));
+}
+
+/**
+ * Drives a SpaceMapper and a std::set<uint64_t> with the same random operations and checks that
+ * they agree after each one.
+ */
+class Checker {
+public:
+  explicit Checker(uint64_t seed) : rng_(seed) {}
+
+  void Step();
+
+private:
+  uint64_t Random(uint64_t end) {
+    return std::uniform_int_distribution<uint64_t>(0, end - 1)(rng_);
+  }
+
+  /**
+   * A random half-open range in the key space, sometimes short, sometimes bucket-sized, and
+   * sometimes aligned to a bucket.
+   */
+  std::pair<uint64_t, uint64_t> RandomRange();
+  /**
+   * Some random keys from [0, kKeySpace), in runs, that are (if 'present') or are not in the set.
+   */
+  std::set<uint64_t> RandomKeys(bool present);
+
+  void AddRange();
+  void EraseRange();
+  void AddKeys();
+  void EraseKeys();
+  void ApplyShift();
+  void CheckSame();
+
+  std::mt19937_64 rng_;
+  SpaceMapper mapper_;
+  std::set<uint64_t> reference_;
+};
+
+void Checker::Step() {
+  switch (Random(5)) {
+    case 0: AddRange(); break;
+    case 1: EraseRange(); break;
+    case 2: AddKeys(); break;
+    case 3: EraseKeys(); break;
+    default: ApplyShift(); break;
+  }
+  CheckSame();
+}
+
+std::pair<uint64_t, uint64_t> Checker::RandomRange() {
+  uint64_t begin;
+  uint64_t size;
+  switch (Random(3)) {
+    case 0:
+      begin = Random(kKeySpace);
+      size = 1 + Random(100);
+      break;
+    case 1:
+      begin = Random(kKeySpace);
+      size = 1 + Random(2 * kBucketSize);
+      break;
+    default:
+      begin = Random(kKeySpace / kBucketSize) * kBucketSize;
+      size = (1 + Random(2)) * kBucketSize;
+      break;
+  }
+  return {begin, std::min(begin + size, kKeySpace)};
+}
+
+std::set<uint64_t> Checker::RandomKeys(bool present) {
+  std::set<uint64_t> result;
+  auto num_runs = 1 + Random(20);
+  for (size_t i = 0; i != num_runs; ++i) {
+    auto begin = Random(kKeySpace);
+    auto end = std::min(begin + 1 + Random(500), kKeySpace);
+    for (auto key = begin; key != end; ++key) {
+      if ((reference_.find(key) != reference_.end()) == present) {
+        result.insert(key);
+      }
+    }
+  }
+  return result;
+}
+
+void Checker::AddRange() {
+  auto [begin, end] = RandomRange();
+  if (reference_.lower_bound(begin) != reference_.lower_bound(end)) {
+    // AddRange requires the keys to be new.
+    CHECK_THROWS((void)mapper_.AddRange(begin, end));
+    return;
+  }
+  auto rank = mapper_.AddRange(begin, end);
+  for (auto key = begin; key != end; ++key) {
+    reference_.insert(key);
+  }
+  CHECK(rank == Rank(reference_, begin));
+}
+
+void Checker::EraseRange() {
+  auto [begin, end] = RandomRange();
+  auto expected_rank = Rank(reference_, begin);
+  CHECK(mapper_.EraseRange(begin, end) == expected_rank);
+  reference_.erase(reference_.lower_bound(begin), reference_.lower_bound(end));
+}
+
+void Checker::AddKeys() {
+  auto keys = RandomKeys(false);
+  if (keys.empty()) {
+    return;
+  }
+  auto indices = mapper_.AddKeys(*Build(keys));
+  reference_.insert(keys.begin(), keys.end());
+  std::vector<uint64_t> expected;
+  uint64_t position = 0;
+  for (auto key : reference_) {
+    if (keys.find(key) != keys.end()) {
+      expected.push_back(position);
+    }
+    ++position;
+  }
+  CHECK(Flatten(*indices) == expected);
+}
+
+void Checker::EraseKeys() {
+  // Mostly keys that are present, plus some that aren't, which EraseKeys ignores.
+  auto keys = RandomKeys(true);
+  auto absent = RandomKeys(false);
+  keys.insert(absent.begin(), std::next(absent.begin(), std::min<size_t>(absent.size(), 10)));
+  if (keys.empty()) {
+    return;
+  }
+  mapper_.EraseKeys(*Build(keys));
+  for (auto key : keys) {
+    reference_.erase(key);
+  }
+}
+
+void Checker::ApplyShift() {
+  auto [begin, end] = RandomRange();
+  uint64_t dest;
+  if (Random(2) == 0) {
+    // An offset that is a multiple of the bucket size, so whole buckets can move as they are.
+    auto buckets = Random(5);
+    dest = Random(2) == 0 && begin >= buckets * kBucketSize ? begin - buckets * kBucketSize :
+        begin + buckets * kBucketSize;
+  } else {
+    dest = Random(kKeySpace);
+  }
+  auto dest_end = dest + (end - begin);
+  // The shifted keys must not land on keys outside the range, which stay where they are.
+  for (auto it = reference_.lower_bound(dest); it != reference_.end() && *it < dest_end; ++it) {
+    if (*it < begin || *it >= end) {
+      return;
+    }
+  }
+
+  mapper_.ApplyShift(begin, end, dest);
+  std::vector<uint64_t> moved(reference_.lower_bound(begin), reference_.lower_bound(end));
+  reference_.erase(reference_.lower_bound(begin), reference_.lower_bound(end));
+  for (auto key : moved) {
+    reference_.insert(key - begin + dest);
+  }
+}
+
+void Checker::CheckSame() {
+  REQUIRE(mapper_.Cardinality() == reference_.size());
+  std::vector<uint64_t> expected(reference_.begin(), reference_.end());
+  REQUIRE(Flatten(*mapper_.Keys()) == expected);
+
+  for (size_t i = 0; i != 5; ++i) {
+    auto value = Random(kKeySpace + kBucketSize);
+    REQUIRE(mapper_.ZeroBasedRank(value) == Rank(reference_, value));
+  }
+
+  if (reference_.empty()) {
+    return;
+  }
+  // Look up a random run of the keys that are present.
+  auto first = Random(reference_.size());
+  auto count = 1 + Random(std::min<uint64_t>(reference_.size() - first, 1000));
+  auto begin = std::next(reference_.begin(), first);
+  std::set<uint64_t> keys(begin, std::next(begin, count));
+  std::vector<uint64_t> expected_indices;
+  for (size_t i = 0; i != count; ++i) {
+    expected_indices.push_back(first + i);
+  }
+  REQUIRE(Flatten(*mapper_.ConvertKeysToIndices(*Build(keys))) == expected_indices);
+}
+}  // namespace
+
+TEST_CASE("SpaceMapper agrees with a std::set under random operations", "[spacemapper]") {
+  for (uint64_t seed = 0; seed != 4; ++seed) {
+    Checker checker(seed);
+    for (size_t i = 0; i != 250; ++i) {
+      checker.Step();
+    }
+  }
+}
+
+TEST_CASE("SpaceMapper ranks after shifting whole buckets", "[spacemapper]") {
+  SpaceMapper mapper;
+  (void)mapper.AddRange(10, 20);
+  (void)mapper.AddRange(kBucketSize + 5, kBucketSize + 8);
+  (void)mapper.AddRange(3 * kBucketSize, 3 * kBucketSize + 2);
+
+  // Move the second and third groups up by two buckets.
+  mapper.ApplyShift(kBucketSize, 4 * kBucketSize, 3 * kBucketSize);
+
+  std::vector<uint64_t> expected = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+      3 * kBucketSize + 5, 3 * kBucketSize + 6, 3 * kBucketSize + 7,
+      5 * kBucketSize, 5 * kBucketSize + 1};
+  CHECK(Flatten(*mapper.Keys()) == expected);
+  CHECK(mapper.Cardinality() == 15);
+  CHECK(mapper.ZeroBasedRank(3 * kBucketSize + 6) == 11);
+  CHECK(mapper.ZeroBasedRank(5 * kBucketSize) == 13);
+  CHECK(mapper.ZeroBasedRank(6 * kBucketSize) == 15);
+}
+}  // namespace deephaven::client::tests
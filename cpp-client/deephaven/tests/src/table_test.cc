@@ -2,9 +2,17 @@
  * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
  */
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <arrow/buffer.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/table.h>
 #include "deephaven/third_party/catch.hpp"
 #include "deephaven/tests/test_util.h"
 #include "deephaven/client/client.h"
+#include "deephaven/client/utility/arrow_util.h"
 #include "deephaven/dhcore/chunk/chunk.h"
 #include "deephaven/dhcore/container/row_sequence.h"
 #include "deephaven/dhcore/types.h"
@@ -13,12 +21,17 @@
 
 using deephaven::client::Client;
 using deephaven::client::TableHandle;
+using deephaven::client::utility::ArrowUtil;
+using deephaven::client::utility::OkOrThrow;
+using deephaven::client::utility::ValueOrThrow;
 using deephaven::client::utility::TableMaker;
 using deephaven::dhcore::chunk::BooleanChunk;
 using deephaven::dhcore::chunk::Int32Chunk;
 using deephaven::dhcore::chunk::Int64Chunk;
 using deephaven::dhcore::container::RowSequence;
 using deephaven::dhcore::DateTime;
+using deephaven::dhcore::ElementType;
+using deephaven::dhcore::ElementTypeId;
 using deephaven::dhcore::LocalDate;
 using deephaven::dhcore::LocalTime;
 using deephaven::dhcore::DeephavenConstants;
@@ -109,4 +122,123 @@ TEST_CASE("Fetch the entire table (small)", "[client_table]") {
   expected.AddColumn("LocalTimes", local_times);
   TableComparerForTests::Compare(expected, *arrow_table);
 }
+
+TEST_CASE("Schema agrees with the data", "[client_table]") {
+  auto tm = TableMakerForTests::Create();
+  auto thm = tm.Client().GetManager();
+  auto th = thm.EmptyTable(3)
+      .Update({
+        "Chars = (char)('a' + ii)",
+        "Ints = (int)ii",
+        "Doubles = (double)ii",
+        "Bools = (ii % 2) == 0",
+        "Strings = `hello ` + i",
+        "DateTimes = '2001-03-01T12:34:56Z' + ii"
+      });
+
+  // The handle's schema comes from the response that created the table; the other one is read
+  // from the data itself.
+  auto schema = th.Schema();
+  auto arrow_table = th.ToArrowTable();
+  auto data_schema = ArrowUtil::MakeDeephavenSchema(*arrow_table->schema());
+
+  CHECK(schema->Names() == data_schema->Names());
+  CHECK(schema->ElementTypes() == data_schema->ElementTypes());
+  // Repeated calls share the first result.
+  CHECK(th.Schema() == schema);
+}
+
+TEST_CASE("Decode a schema header", "[client_table]") {
+  // The server sends the schema as a serialized Arrow IPC Schema message. No server is needed to
+  // check that we can read one back.
+  auto arrow_schema = arrow::schema({
+      arrow::field("Ints", arrow::int32()),
+      arrow::field("Doubles", arrow::float64()),
+      arrow::field("Strings", arrow::utf8()),
+      arrow::field("DateTimes", arrow::timestamp(arrow::TimeUnit::NANO, "UTC"))
+  });
+  auto serialized = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(arrow::ipc::SerializeSchema(*arrow_schema)));
+  auto decoded = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
+      ArrowUtil::ReadSchemaMessage(serialized->ToString())));
+  CHECK(decoded->Equals(*arrow_schema));
+
+  auto schema = ArrowUtil::MakeDeephavenSchema(*decoded);
+  std::vector<std::string> expected_names = {"Ints", "Doubles", "Strings", "DateTimes"};
+  std::vector<ElementType> expected_types = {
+      ElementType::Of(ElementTypeId::kInt32),
+      ElementType::Of(ElementTypeId::kDouble),
+      ElementType::Of(ElementTypeId::kString),
+      ElementType::Of(ElementTypeId::kTimestamp)
+  };
+  CHECK(schema->Names() == expected_names);
+  CHECK(schema->ElementTypes() == expected_types);
+
+  // A header that isn't a Schema message is reported, so the caller can fall back to asking the
+  // server.
+  CHECK(!ArrowUtil::ReadSchemaMessage("not a schema").ok());
+  CHECK(!ArrowUtil::ReadSchemaMessage("").ok());
+}
+
+TEST_CASE("Read the table a batch at a time", "[client_table]") {
+  int64_t target = 200'000;
+  auto tm = TableMakerForTests::Create();
+  auto th = tm.Client().GetManager().EmptyTable(target)
+      .Update({"Longs = ii", "Strings = `hello ` + (ii % 7)"});
+
+  int64_t num_rows = 0;
+  int64_t num_batches = 0;
+  // Tables with encoded columns are checked in encoding_test.cc.
+  th.ForEachBatch([&](const std::shared_ptr<arrow::RecordBatch> &batch) {
+    num_rows += batch->num_rows();
+    ++num_batches;
+  });
+  CHECK(num_rows == target);
+  CHECK(num_batches > 0);
+
+  // Reassembled, the batches are the same table that ToArrowTable() reads in one go.
+  for (auto cooked : {false, true}) {
+    auto reader = th.GetRecordBatchReader(cooked);
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    while (true) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      OkOrThrow(DEEPHAVEN_LOCATION_EXPR(reader->ReadNext(&batch)));
+      if (batch == nullptr) {
+        break;
+      }
+      batches.push_back(std::move(batch));
+    }
+    auto streamed = ValueOrThrow(DEEPHAVEN_LOCATION_EXPR(
+        arrow::Table::FromRecordBatches(reader->schema(), std::move(batches))));
+    CHECK(streamed->Equals(*th.ToArrowTable(cooked)));
+  }
+}
+
+TEST_CASE("Read the table over several streams", "[client_table]") {
+  int64_t target = 100'003;
+  auto tm = TableMakerForTests::Create();
+  auto th = tm.Client().GetManager().EmptyTable(target)
+      .Update({"Longs = ii", "Strings = `hello ` + (ii % 7)"});
+
+  // The slices are stitched back together in order.
+  auto parallel = th.ToArrowTableParallel(4, false);
+  CHECK(parallel->num_rows() == target);
+  CHECK(parallel->Equals(*th.ToArrowTable(false)));
+  auto parallel_cooked = th.ToArrowTableParallel(4, true);
+  CHECK(parallel_cooked->num_rows() == target);
+  CHECK(parallel_cooked->Equals(*th.ToArrowTable(true)));
+
+  // More slices than connections, so each connection reads several of them in turn.
+  auto many = th.ToArrowTableParallel(50, true);
+  CHECK(many->Equals(*th.ToArrowTable(true)));
+
+  // More streams than rows, and a table with no rows at all.
+  auto tiny = tm.Client().GetManager().EmptyTable(2).Update("X = ii");
+  CHECK(tiny.ToArrowTableParallel(8)->num_rows() == 2);
+  auto empty = tm.Client().GetManager().EmptyTable(0).Update("X = ii");
+  auto empty_result = empty.ToArrowTableParallel(3);
+  CHECK(empty_result->num_rows() == 0);
+  CHECK(empty_result->num_columns() == 1);
+
+  CHECK_THROWS(th.ToArrowTableParallel(0));
+}
 }  // namespace deephaven::client::tests
@@ -4,11 +4,14 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "deephaven/third_party/catch.hpp"
@@ -21,7 +24,10 @@
 #include "deephaven/dhcore/utility/utility.h"
 
 using deephaven::client::Client;
+using deephaven::client::ClientOptions;
 using deephaven::client::TableHandle;
+using deephaven::client::TableHandleManager;
+using deephaven::client::subscription::SubscriptionHandle;
 using deephaven::client::utility::TableMaker;
 using deephaven::dhcore::DateTime;
 using deephaven::dhcore::LocalDate;
@@ -38,6 +44,8 @@ using deephaven::dhcore::chunk::Int64Chunk;
 using deephaven::dhcore::chunk::StringChunk;
 using deephaven::dhcore::clienttable::ClientTable;
 using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::ticking::ConflationPolicy;
+using deephaven::dhcore::ticking::SubscriptionOptions;
 using deephaven::dhcore::utility::MakeReservedVector;
 
 namespace deephaven::client::tests {
@@ -59,6 +67,21 @@ public:
     }
   }
 
+  /**
+   * Waits until the callback is done, rethrowing the failure if it fails first.
+   */
+  void WaitUntilDone() {
+    while (true) {
+      auto [done, eptr] = WaitForUpdate();
+      if (done) {
+        return;
+      }
+      if (eptr != nullptr) {
+        std::rethrow_exception(eptr);
+      }
+    }
+  }
+
 protected:
   void NotifyDone() {
     std::unique_lock guard(mutex_);
@@ -72,6 +95,24 @@ protected:
   std::exception_ptr exception_ptr_;
 };
 
+namespace {
+/**
+ * Subscribes 'callback' to 'table' with 'options' and waits until the callback is done. Then
+ * calls 'check', if given, with the subscription, for instance to look at its metrics, and
+ * unsubscribes.
+ */
+void RunUntilDone(TableHandle &table, std::shared_ptr<CommonBase> callback,
+    const SubscriptionOptions &options = SubscriptionOptions(),
+    const std::function<void(const std::shared_ptr<SubscriptionHandle> &)> &check = {}) {
+  auto cookie = table.Subscribe(callback, options);
+  callback->WaitUntilDone();
+  if (check) {
+    check(cookie);
+  }
+  table.Unsubscribe(std::move(cookie));
+}
+}  // namespace
+
 class ReachesNRowsCallback final : public CommonBase {
 public:
   explicit ReachesNRowsCallback(size_t target_rows) : target_rows_(target_rows) {}
@@ -97,19 +138,7 @@ TEST_CASE("Ticking Table: eventually reaches 10 rows", "[ticking]") {
   auto table = tm.TimeTable(std::chrono::milliseconds(500)).Update("II = ii");
   table.BindToVariable("ticking");
   auto callback = std::make_shared<ReachesNRowsCallback>(max_rows);
-  auto cookie = table.Subscribe(callback);
-
-  while (true) {
-    auto [done, eptr] = callback->WaitForUpdate();
-    if (done) {
-      break;
-    }
-    if (eptr != nullptr) {
-      std::rethrow_exception(eptr);
-    }
-  }
-
-  table.Unsubscribe(std::move(cookie));
+  RunUntilDone(table, callback);
 }
 
 class AllValuesGreaterThanNCallback final : public CommonBase {
@@ -153,19 +182,7 @@ TEST_CASE("Ticking Table: modified rows are eventually all greater than 10", "[t
       .View({"Key = (long)(ii % 10)", "Value = ii"})
       .LastBy("Key");
   auto callback = std::make_shared<AllValuesGreaterThanNCallback>(target);
-  auto cookie = table.Subscribe(callback);
-
-  while (true) {
-    auto [done, eptr] = callback->WaitForUpdate();
-    if (done) {
-      break;
-    }
-    if (eptr != nullptr) {
-      std::rethrow_exception(eptr);
-    }
-  }
-
-  table.Unsubscribe(std::move(cookie));
+  RunUntilDone(table, callback);
 }
 
 class WaitForPopulatedTableCallback final : public CommonBase {
@@ -262,12 +279,9 @@ private:
   int64_t target_ = 0;
 };
 
-TEST_CASE("Ticking Table: all the data is eventually present", "[ticking]") {
-  const int64_t target = 10;
-  auto client = TableMakerForTests::CreateClient();
-  auto tm = client.GetManager();
-
-  auto table = tm.TimeTable("PT0:00:0.5")
+namespace {
+TableHandle MakeAllTypesTickingTable(const TableHandleManager &tm) {
+  return tm.TimeTable("PT0:00:0.5")
       .Update({"II = (int)((ii * 7) % 10)",
           "Chars = II == 5 ? null : (char)(II + 'a')",
           "Bytes = II == 5 ? null : (byte)II",
@@ -285,21 +299,294 @@ TEST_CASE("Ticking Table: all the data is eventually present", "[ticking]") {
       .LastBy("II")
       .Sort(SortPair::Ascending("II"))
       .DropColumns({"II", "Timestamp"});
+}
+}  // namespace
+
+TEST_CASE("Ticking Table: all the data is eventually present", "[ticking]") {
+  // Zero-copy appends are asked for here, but this table modifies and shifts rows, so the
+  // subscription has to fall back to copying.
+  const auto [description, options] = GENERATE(
+      std::pair("default options", SubscriptionOptions()),
+      std::pair("parallel columns", SubscriptionOptions().SetColumnParallelism(4)),
+      std::pair("a pipelined subscription", SubscriptionOptions().SetPipelineDepth(4)),
+      std::pair("zero-copy appends", SubscriptionOptions().SetZeroCopyAppends(true))
+      );
+  INFO("With " << description);
+  const int64_t target = 10;
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+
+  auto table = MakeAllTypesTickingTable(tm);
 
   auto callback = std::make_shared<WaitForPopulatedTableCallback>(target);
-  auto cookie = table.Subscribe(callback);
+  RunUntilDone(table, callback, options, [&table, &options = options](const auto &cookie) {
+    auto metrics = table.GetSubscriptionMetrics(cookie);
+    // A subscription on its own thread only has a queue when it is pipelined.
+    CHECK(metrics.queue_capacity == static_cast<size_t>(options.PipelineDepth()));
+    CHECK(metrics.updates_conflated == 0);
+    CHECK(metrics.updates_delivered <= metrics.updates_decoded);
+    CHECK(metrics.updates_decoded <= metrics.messages_read);
+  });
+}
+
+TEST_CASE("Ticking Table: many subscriptions share a few threads", "[ticking]") {
+  const int64_t target = 10;
+  const size_t num_subscriptions = 6;
+  auto client = TableMakerForTests::CreateClient(ClientOptions().SetSubscriptionThreads(2));
+  auto tm = client.GetManager();
+
+  auto table = MakeAllTypesTickingTable(tm);
+
+  std::vector<std::shared_ptr<WaitForPopulatedTableCallback>> callbacks;
+  std::vector<std::shared_ptr<SubscriptionHandle>> cookies;
+  for (size_t i = 0; i != num_subscriptions; ++i) {
+    auto callback = std::make_shared<WaitForPopulatedTableCallback>(target);
+    // Give half of them a read-ahead of more than one message.
+    auto options = SubscriptionOptions().SetPipelineDepth(i % 2 == 0 ? 0 : 4);
+    cookies.push_back(table.Subscribe(callback, options));
+    callbacks.push_back(std::move(callback));
+  }
+
+  for (const auto &callback : callbacks) {
+    callback->WaitUntilDone();
+  }
+
+  for (size_t i = 0; i != num_subscriptions; ++i) {
+    auto metrics = table.GetSubscriptionMetrics(cookies[i]);
+    CHECK(metrics.queue_capacity == (i % 2 == 0 ? 1 : 4));
+    CHECK(metrics.message_queue_high_water <= metrics.queue_capacity);
+    CHECK(metrics.updates_delivered <= metrics.updates_decoded);
+    CHECK(metrics.updates_decoded <= metrics.messages_read);
+    table.Unsubscribe(std::move(cookies[i]));
+  }
+}
+
+class SlowCallback final : public CommonBase {
+public:
+  explicit SlowCallback(size_t target_rows) : target_rows_(target_rows) {}
 
-  while (true) {
-    auto [done, eptr] = callback->WaitForUpdate();
-    if (done) {
-      break;
+  void OnTick(deephaven::dhcore::ticking::TickingUpdate update) final {
+    // However many updates were conflated, each one must pick up where the last one left off.
+    auto prev_rows = update.Prev()->NumRows();
+    if (num_ticks_ != 0 && prev_rows != last_rows_) {
+      auto message = fmt::format("Expected Prev() to have {} rows, got {}", last_rows_, prev_rows);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
     }
-    if (eptr != nullptr) {
-      std::rethrow_exception(eptr);
+    last_rows_ = update.Current()->NumRows();
+    ++num_ticks_;
+    if (last_rows_ >= target_rows_) {
+      NotifyDone();
+      return;
     }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
   }
 
-  table.Unsubscribe(std::move(cookie));
+private:
+  size_t target_rows_ = 0;
+  size_t num_ticks_ = 0;
+  size_t last_rows_ = 0;
+};
+
+TEST_CASE("Ticking Table: pipelined subscription conflates updates for a slow callback", "[ticking]") {
+  const size_t target = 50;
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+
+  auto table = tm.TimeTable(std::chrono::milliseconds(10)).Update("II = ii");
+
+  auto callback = std::make_shared<SlowCallback>(target);
+  auto options = SubscriptionOptions()
+      .SetMinUpdateIntervalMs(10)
+      .SetPipelineDepth(1)
+      .SetConflationPolicy(ConflationPolicy::kReplace);
+  RunUntilDone(table, callback, options, [&table](const auto &cookie) {
+    auto metrics = table.GetSubscriptionMetrics(cookie);
+    CHECK(metrics.queue_capacity == 1);
+    CHECK(metrics.update_queue_high_water <= 1);
+    CHECK(metrics.updates_delivered + metrics.updates_conflated <= metrics.updates_decoded);
+  });
+}
+
+class MergedAppendsCallback final : public CommonBase {
+public:
+  explicit MergedAppendsCallback(size_t target_rows) : target_rows_(target_rows) {}
+
+  void OnTick(deephaven::dhcore::ticking::TickingUpdate update) final {
+    // The table only grows at the end, so however many updates were merged, the result must be
+    // one append of the rows in between, with nothing removed or modified.
+    auto prev_rows = update.Prev()->NumRows();
+    auto current_rows = update.Current()->NumRows();
+    if (!update.RemovedRows()->Empty() || !update.AllModifiedRows()->Empty()) {
+      const char *message = "Expected a merged append to have no removes or modifies";
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    const auto &added = update.AddedRows();
+    auto expected = RowSequence::CreateSequential(prev_rows, current_rows);
+    if (fmt::format("{}", *added) != fmt::format("{}", *expected)) {
+      auto message = fmt::format("Expected added rows {}, got {}", *expected, *added);
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    if (update.AfterAdds()->NumRows() != current_rows) {
+      auto message = fmt::format("Expected AfterAdds() to have {} rows, got {}", current_rows,
+          update.AfterAdds()->NumRows());
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    if (current_rows >= target_rows_) {
+      NotifyDone();
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
+
+private:
+  size_t target_rows_ = 0;
+};
+
+TEST_CASE("Ticking Table: pipelined subscription merges updates for a slow callback", "[ticking]") {
+  const size_t target = 50;
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+
+  auto table = tm.TimeTable(std::chrono::milliseconds(10)).Update("II = ii");
+
+  auto callback = std::make_shared<MergedAppendsCallback>(target);
+  auto options = SubscriptionOptions()
+      .SetMinUpdateIntervalMs(10)
+      .SetPipelineDepth(1)
+      .SetConflationPolicy(ConflationPolicy::kMerge);
+  RunUntilDone(table, callback, options, [&table](const auto &cookie) {
+    auto metrics = table.GetSubscriptionMetrics(cookie);
+    CHECK(metrics.update_queue_high_water <= 1);
+    CHECK(metrics.updates_delivered + metrics.updates_conflated <= metrics.updates_decoded);
+  });
+}
+
+class AppendOnlyCallback final : public CommonBase {
+public:
+  explicit AppendOnlyCallback(size_t target_rows) : target_rows_(target_rows) {}
+
+  void OnTick(deephaven::dhcore::ticking::TickingUpdate update) final {
+    const auto &current = update.Current();
+    auto num_rows = current->NumRows();
+    auto col = current->GetColumn("II", true);
+    auto rs = current->GetRowSequence();
+    auto data = Int64Chunk::Create(num_rows);
+    col->FillChunk(*rs, &data, nullptr);
+    for (size_t i = 0; i != num_rows; ++i) {
+      if (data.data()[i] != static_cast<int64_t>(i)) {
+        auto message = fmt::format("Expected II[{}] == {}, got {}", i, i, data.data()[i]);
+        throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+      }
+    }
+    if (num_rows >= target_rows_) {
+      NotifyDone();
+    }
+  }
+
+private:
+  size_t target_rows_ = 0;
+};
+
+TEST_CASE("Ticking Table: append-only table with zero-copy appends", "[ticking]") {
+  const size_t target = 10;
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+
+  auto table = tm.TimeTable(std::chrono::milliseconds(100)).Update("II = ii");
+
+  auto callback = std::make_shared<AppendOnlyCallback>(target);
+  RunUntilDone(table, callback, SubscriptionOptions().SetZeroCopyAppends(true));
+}
+
+class DeltasOnlyCallback final : public CommonBase {
+public:
+  explicit DeltasOnlyCallback(size_t target_rows) : target_rows_(target_rows) {}
+
+  void OnTick(deephaven::dhcore::ticking::TickingUpdate update) final {
+    if (!update.DeltasOnly() || update.Current() != nullptr) {
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR("Expected a deltas-only update"));
+    }
+    // The table only appends, so each update's added rows continue where the last one left off.
+    const auto &added = update.Added();
+    auto num_rows = added->NumRows();
+    if (update.AddedRows()->Size() != num_rows) {
+      auto message = fmt::format("Expected {} added keys, got {}", num_rows,
+          update.AddedRows()->Size());
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    auto col = added->GetColumn("II", true);
+    auto data = Int64Chunk::Create(num_rows);
+    col->FillChunk(*added->GetRowSequence(), &data, nullptr);
+    for (size_t i = 0; i != num_rows; ++i) {
+      auto expected = static_cast<int64_t>(rows_seen_ + i);
+      if (data.data()[i] != expected) {
+        auto message = fmt::format("Expected II == {}, got {}", expected, data.data()[i]);
+        throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+      }
+    }
+    rows_seen_ += num_rows;
+    if (rows_seen_ >= target_rows_) {
+      NotifyDone();
+    }
+  }
+
+private:
+  size_t target_rows_ = 0;
+  size_t rows_seen_ = 0;
+};
+
+TEST_CASE("Ticking Table: deltas-only subscription", "[ticking]") {
+  const size_t target = 10;
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+
+  auto table = tm.TimeTable(std::chrono::milliseconds(100)).Update("II = ii");
+
+  auto callback = std::make_shared<DeltasOnlyCallback>(target);
+  RunUntilDone(table, callback, SubscriptionOptions().SetDeltasOnly(true));
+}
+
+class UnchangedSnapshotsCallback final : public CommonBase {
+public:
+  explicit UnchangedSnapshotsCallback(size_t target_rows) : target_rows_(target_rows) {}
+
+  void OnTick(deephaven::dhcore::ticking::TickingUpdate update) final {
+    // The snapshots are built on demand, but a phase that changed nothing must still give back
+    // the very same table as the phase before it.
+    if (update.RemovedRows()->Empty() && update.AfterRemoves() != update.BeforeRemoves()) {
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR("Expected AfterRemoves() == BeforeRemoves()"));
+    }
+    if (update.AddedRows()->Empty() && update.AfterAdds() != update.BeforeAdds()) {
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR("Expected AfterAdds() == BeforeAdds()"));
+    }
+    if (update.AllModifiedRows()->Empty() && update.AfterModifies() != update.BeforeModifies()) {
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR("Expected AfterModifies() == BeforeModifies()"));
+    }
+    auto expected_prev_rows = update.Current()->NumRows() - update.AddedRows()->Size() +
+        update.RemovedRows()->Size();
+    if (update.Prev()->NumRows() != expected_prev_rows) {
+      auto message = fmt::format("Expected Prev() to have {} rows, got {}", expected_prev_rows,
+          update.Prev()->NumRows());
+      throw std::runtime_error(DEEPHAVEN_LOCATION_STR(message));
+    }
+    if (update.Current()->NumRows() >= target_rows_) {
+      NotifyDone();
+    }
+  }
+
+private:
+  size_t target_rows_ = 0;
+};
+
+TEST_CASE("Ticking Table: unchanged snapshots are the same table", "[ticking]") {
+  const size_t target = 10;
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+
+  auto table = tm.TimeTable(std::chrono::milliseconds(100)).Update("II = ii");
+
+  auto callback = std::make_shared<UnchangedSnapshotsCallback>(target);
+  RunUntilDone(table, callback);
 }
 
 class WaitForGroupedTableCallback final : public CommonBase {
@@ -415,18 +702,112 @@ TEST_CASE("Ticking Table: Ticking grouped data", "[ticking]") {
   constexpr const int kNumTicks = 1;
 
   auto callback = std::make_shared<WaitForGroupedTableCallback>(kNumTicks);
-  auto cookie = table.Subscribe(callback);
+  RunUntilDone(table, callback);
+}
+
+class ViewportCallback final : public CommonBase {
+public:
+  ViewportCallback(int64_t expected_first, size_t expected_size) :
+      expected_first_(expected_first), expected_size_(expected_size) {}
+
+  void Expect(int64_t expected_first, size_t expected_size) {
+    std::unique_lock guard(mutex_);
+    expected_first_ = expected_first;
+    expected_size_ = expected_size;
+    done_ = false;
+  }
 
-  while (true) {
-    auto [done, eptr] = callback->WaitForUpdate();
-    if (done) {
-      break;
+  void OnTick(deephaven::dhcore::ticking::TickingUpdate update) final {
+    const auto &current = update.Current();
+    std::cout << "=== The Viewport ===\n"
+        << current->Stream(true, true)
+        << '\n';
+
+    std::unique_lock guard(mutex_);
+    if (current->NumRows() != expected_size_) {
+      return;
     }
-    if (eptr != nullptr) {
-      std::rethrow_exception(eptr);
+    auto col = current->GetColumn("II", true);
+    auto rs = current->GetRowSequence();
+    auto data = Int64Chunk::Create(rs->Size());
+    col->FillChunk(*rs, &data, nullptr);
+    for (size_t i = 0; i != expected_size_; ++i) {
+      if (data.data()[i] != expected_first_ + static_cast<int64_t>(i)) {
+        return;
+      }
     }
+    guard.unlock();
+    NotifyDone();
   }
 
+private:
+  int64_t expected_first_ = 0;
+  size_t expected_size_ = 0;
+};
+
+TEST_CASE("Ticking Table: viewport subscription follows the viewport", "[ticking]") {
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+
+  auto table = tm.EmptyTable(1000).Update("II = ii");
+  auto callback = std::make_shared<ViewportCallback>(10, 10);
+  auto cookie = table.Subscribe(callback, *RowSequence::CreateSequential(10, 20));
+
+  callback->WaitUntilDone();
+
+  // Move the viewport to the last five rows, counting from the end.
+  callback->Expect(995, 5);
+  table.SetViewport(cookie, *RowSequence::CreateSequential(0, 5), true);
+  callback->WaitUntilDone();
+
+  table.Unsubscribe(std::move(cookie));
+}
+
+class ColumnSubsetCallback final : public CommonBase {
+public:
+  explicit ColumnSubsetCallback(size_t expected_size) : expected_size_(expected_size) {}
+
+  void OnTick(deephaven::dhcore::ticking::TickingUpdate update) final {
+    const auto &current = update.Current();
+    if (current->NumRows() != expected_size_) {
+      return;
+    }
+    auto rs = current->GetRowSequence();
+    auto subscribed = current->GetColumn("II", true);
+    auto data = Int64Chunk::Create(expected_size_);
+    subscribed->FillChunk(*rs, &data, nullptr);
+    for (size_t i = 0; i != expected_size_; ++i) {
+      if (data.data()[i] != static_cast<int64_t>(i)) {
+        return;
+      }
+    }
+
+    // The unsubscribed column is still in the schema, but it is all null.
+    auto unsubscribed = current->GetColumn("Doubled", true);
+    auto nulls = BooleanChunk::Create(expected_size_);
+    unsubscribed->FillChunk(*rs, &data, &nulls);
+    for (size_t i = 0; i != expected_size_; ++i) {
+      if (!nulls.data()[i]) {
+        auto message = fmt::format("Expected row {} of unsubscribed column to be null", i);
+        OnFailure(std::make_exception_ptr(std::runtime_error(message)));
+        return;
+      }
+    }
+    NotifyDone();
+  }
+
+private:
+  size_t expected_size_ = 0;
+};
+
+TEST_CASE("Ticking Table: column subset subscription", "[ticking]") {
+  auto client = TableMakerForTests::CreateClient();
+  auto tm = client.GetManager();
+
+  auto table = tm.EmptyTable(100).Update({"II = ii", "Doubled = ii * 2"});
+  auto callback = std::make_shared<ColumnSubsetCallback>(100);
+  auto cookie = table.Subscribe(callback, std::vector<std::string>{"II"});
+  callback->WaitUntilDone();
   table.Unsubscribe(std::move(cookie));
 }
 }  // namespace deephaven::client::tests
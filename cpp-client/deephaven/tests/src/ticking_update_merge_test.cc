@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include "deephaven/third_party/catch.hpp"
+#include "deephaven/dhcore/chunk/chunk.h"
+#include "deephaven/dhcore/clienttable/client_table.h"
+#include "deephaven/dhcore/clienttable/schema.h"
+#include "deephaven/dhcore/column/buffer_column_source.h"
+#include "deephaven/dhcore/container/row_sequence.h"
+#include "deephaven/dhcore/ticking/immer_table_state.h"
+#include "deephaven/dhcore/ticking/ticking.h"
+#include "deephaven/dhcore/types.h"
+
+using deephaven::dhcore::ElementType;
+using deephaven::dhcore::ElementTypeId;
+using deephaven::dhcore::chunk::Int64Chunk;
+using deephaven::dhcore::clienttable::ClientTable;
+using deephaven::dhcore::clienttable::Schema;
+using deephaven::dhcore::column::NumericBufferColumnSource;
+using deephaven::dhcore::container::RowSequence;
+using deephaven::dhcore::container::RowSequenceBuilder;
+using deephaven::dhcore::ticking::TickingUpdate;
+using deephaven::dhcore::ticking::internal::MakeClientTable;
+
+// These tests check TickingUpdate::Merge (and the Layout arithmetic behind it) against a simple
+// model that applies the same updates one at a time, keeping track of which row is which, and
+// check TickingUpdate::Replace against the same model. They don't need a server. The table has a
+// single int64 column.
+namespace deephaven::client::tests {
+namespace {
+using rows_t = std::shared_ptr<RowSequence>;
+
+rows_t Rows(const std::vector<std::pair<uint64_t, uint64_t>> &intervals) {
+  RowSequenceBuilder builder;
+  for (const auto &[begin, end] : intervals) {
+    builder.AddInterval(begin, end);
+  }
+  return builder.Build();
+}
+
+std::vector<uint64_t> Expand(const RowSequence &rows) {
+  std::vector<uint64_t> result;
+  rows.ForEachInterval([&result](uint64_t begin, uint64_t end) {
+    for (auto i = begin; i != end; ++i) {
+      result.push_back(i);
+    }
+  });
+  return result;
+}
+
+std::vector<int64_t> Values(const ClientTable &table) {
+  auto rows = table.GetRowSequence();
+  auto data = Int64Chunk::Create(rows->Size());
+  table.GetColumn(0)->FillChunk(*rows, &data, nullptr);
+  return {data.begin(), data.end()};
+}
+
+/**
+ * One update, in positions: 'removed_' are positions before it, 'added_' and 'modified_'
+ * positions after it. 'modified_' must not overlap 'added_'.
+ */
+struct Step {
+  rows_t removed_;
+  rows_t added_;
+  rows_t modified_;
+};
+
+/**
+ * A row of the model. 'id_' says which row it is; 'value_' is what the table holds.
+ */
+struct Row {
+  int64_t id_ = 0;
+  int64_t value_ = 0;
+};
+
+/**
+ * Applies Steps to a model table, producing the TickingUpdate for each and remembering every
+ * state the table was in along the way.
+ */
+class History {
+public:
+  explicit History(size_t initial_size) {
+    std::vector<Row> initial;
+    for (size_t i = 0; i != initial_size; ++i) {
+      initial.push_back(NewRow());
+    }
+    states_.push_back(std::move(initial));
+  }
+
+  TickingUpdate Apply(const Step &step) {
+    const auto &before = states_.back();
+    auto prev = MakeTable(before);
+
+    std::vector<Row> after_removes;
+    auto removed = Expand(*step.removed_);
+    for (size_t i = 0; i != before.size(); ++i) {
+      if (!std::binary_search(removed.begin(), removed.end(), i)) {
+        after_removes.push_back(before[i]);
+      }
+    }
+
+    auto after_adds = after_removes;
+    for (auto position : Expand(*step.added_)) {
+      after_adds.insert(after_adds.begin() + static_cast<ptrdiff_t>(position), NewRow());
+    }
+
+    auto after_modifies = after_adds;
+    std::set<int64_t> modified_ids;
+    for (auto position : Expand(*step.modified_)) {
+      auto &row = after_modifies[position];
+      row.value_ = nextValue_++;
+      modified_ids.insert(row.id_);
+    }
+
+    auto after_removes_table = step.removed_->Empty() ? prev : MakeTable(after_removes);
+    auto after_adds_table = step.added_->Empty() ? after_removes_table : MakeTable(after_adds);
+    auto current = step.modified_->Empty() ? after_adds_table : MakeTable(after_modifies);
+    // One entry per column, even if it is empty, as BarrageProcessor delivers them.
+    std::vector<rows_t> modified_rows = {step.modified_};
+
+    states_.push_back(std::move(after_modifies));
+    modifiedIds_.push_back(std::move(modified_ids));
+    return {std::move(prev), step.removed_, std::move(after_removes_table), step.added_,
+        std::move(after_adds_table), std::move(modified_rows), std::move(current)};
+  }
+
+  /**
+   * Checks that 'merged' has the same effect as steps [from, to) applied one after the other.
+   */
+  void CheckMerged(const TickingUpdate &merged, size_t from, size_t to) const {
+    const auto &initial = states_[from];
+    const auto &final = states_[to];
+    std::set<int64_t> initial_ids;
+    for (const auto &row : initial) {
+      initial_ids.insert(row.id_);
+    }
+    std::set<int64_t> final_ids;
+    for (const auto &row : final) {
+      final_ids.insert(row.id_);
+    }
+    std::set<int64_t> modified_ids;
+    for (auto i = from; i != to; ++i) {
+      modified_ids.insert(modifiedIds_[i].begin(), modifiedIds_[i].end());
+    }
+
+    std::vector<uint64_t> expected_removed;
+    std::vector<int64_t> expected_after_removes;
+    for (size_t i = 0; i != initial.size(); ++i) {
+      if (final_ids.count(initial[i].id_) == 0) {
+        expected_removed.push_back(i);
+      } else {
+        expected_after_removes.push_back(initial[i].value_);
+      }
+    }
+
+    // Rows carried over still have their original values until the modifies are applied.
+    std::vector<uint64_t> expected_added;
+    std::vector<uint64_t> expected_modified;
+    std::vector<int64_t> expected_after_adds;
+    size_t carried = 0;
+    for (size_t i = 0; i != final.size(); ++i) {
+      if (initial_ids.count(final[i].id_) == 0) {
+        expected_added.push_back(i);
+        expected_after_adds.push_back(final[i].value_);
+        continue;
+      }
+      if (modified_ids.count(final[i].id_) != 0) {
+        expected_modified.push_back(i);
+      }
+      expected_after_adds.push_back(expected_after_removes[carried++]);
+    }
+
+    CHECK(Expand(*merged.RemovedRows()) == expected_removed);
+    CHECK(Expand(*merged.AddedRows()) == expected_added);
+    CHECK(Expand(*merged.AllModifiedRows()) == expected_modified);
+    REQUIRE(merged.ModifiedRows().size() == 1);
+    CHECK(Expand(*merged.ModifiedRows()[0]) == expected_modified);
+    CHECK(Values(*merged.Prev()) == ValuesOf(initial));
+    CHECK(Values(*merged.AfterRemoves()) == expected_after_removes);
+    CHECK(Values(*merged.AfterAdds()) == expected_after_adds);
+    CHECK(Values(*merged.Current()) == ValuesOf(final));
+  }
+
+private:
+  Row NewRow() {
+    return Row{nextId_++, nextValue_++};
+  }
+
+  static std::vector<int64_t> ValuesOf(const std::vector<Row> &rows) {
+    std::vector<int64_t> result;
+    for (const auto &row : rows) {
+      result.push_back(row.value_);
+    }
+    return result;
+  }
+
+  std::shared_ptr<ClientTable> MakeTable(const std::vector<Row> &rows) {
+    // The column source doesn't own its data, so keep it here.
+    const auto &data = storage_.emplace_back(ValuesOf(rows));
+    auto source = NumericBufferColumnSource<int64_t>::Create(
+        ElementType::Of(ElementTypeId::kInt64), data.data(), data.size());
+    return MakeClientTable(schema_, {std::move(source)}, data.size());
+  }
+
+  std::shared_ptr<Schema> schema_ =
+      Schema::Create({"Value"}, {ElementType::Of(ElementTypeId::kInt64)});
+  int64_t nextId_ = 0;
+  int64_t nextValue_ = 100;
+  // states_[i] is the table before step i (and after step i - 1).
+  std::vector<std::vector<Row>> states_;
+  // modifiedIds_[i] is the ids of the rows that step i modified.
+  std::vector<std::set<int64_t>> modifiedIds_;
+  std::deque<std::vector<int64_t>> storage_;
+};
+
+/**
+ * Removes, adds and modifies in every step but the last, with later steps removing and
+ * modifying rows that earlier steps added.
+ */
+std::vector<Step> MakeSteps() {
+  return {
+      // 10 rows -> 10.
+      Step{Rows({{1, 3}, {5, 6}}), Rows({{0, 1}, {4, 6}}), Rows({{8, 9}})},
+      // 10 -> 11. Removes the row that step 0 added at the top, and modifies one it added at 4.
+      Step{Rows({{0, 1}, {9, 10}}), Rows({{2, 3}, {8, 10}}), Rows({{0, 1}, {3, 4}})},
+      // 11 -> 11. Removes one of the rows step 1 added, and modifies the one step 0 modified.
+      Step{Rows({{3, 5}}), Rows({{9, 11}}), Rows({{1, 2}, {5, 6}})},
+      // 11 -> 7. No adds.
+      Step{Rows({{0, 4}}), Rows({}), Rows({{2, 4}})},
+  };
+}
+}  // namespace
+
+TEST_CASE("Merging chained updates matches applying them in sequence", "[tickingupdate]") {
+  History history(10);
+  std::vector<TickingUpdate> updates;
+  for (const auto &step : MakeSteps()) {
+    updates.push_back(history.Apply(step));
+  }
+
+  // Each update on its own is trivially consistent with the model.
+  for (size_t i = 0; i != updates.size(); ++i) {
+    history.CheckMerged(updates[i], i, i + 1);
+  }
+
+  // Merge from the left, as conflation does, checking each prefix.
+  auto merged = updates[0];
+  for (size_t i = 1; i != updates.size(); ++i) {
+    merged = TickingUpdate::Merge(merged, updates[i]);
+    history.CheckMerged(merged, 0, i + 1);
+  }
+
+  // Merging from the right has to come out the same.
+  auto right = updates.back();
+  for (size_t i = updates.size() - 1; i != 0; --i) {
+    right = TickingUpdate::Merge(updates[i - 1], right);
+    history.CheckMerged(right, i - 1, updates.size());
+  }
+}
+
+TEST_CASE("Merging drops rows added then removed, and modifies of added rows",
+    "[tickingupdate]") {
+  History history(4);
+  // Adds two rows, then modifies one of them and one original row, then removes the other
+  // added row. The merged update should add just one row, and modify just the original one.
+  auto first = history.Apply(Step{Rows({}), Rows({{1, 3}}), Rows({})});
+  auto second = history.Apply(Step{Rows({}), Rows({}), Rows({{1, 2}, {4, 5}})});
+  auto third = history.Apply(Step{Rows({{2, 3}}), Rows({}), Rows({})});
+  auto merged = TickingUpdate::Merge(TickingUpdate::Merge(first, second), third);
+  history.CheckMerged(merged, 0, 3);
+  CHECK(merged.RemovedRows()->Empty());
+  CHECK(Expand(*merged.AddedRows()) == std::vector<uint64_t>{1});
+  CHECK(Expand(*merged.AllModifiedRows()) == std::vector<uint64_t>{3});
+}
+
+TEST_CASE("Replacing a run of updates removes every row and adds every row", "[tickingupdate]") {
+  History history(10);
+  std::vector<TickingUpdate> updates;
+  for (const auto &step : MakeSteps()) {
+    updates.push_back(history.Apply(step));
+  }
+  const auto &prev = updates.front().Prev();
+  const auto &current = updates.back().Current();
+
+  auto replaced = TickingUpdate::Replace(updates.front(), updates[1]);
+  replaced = TickingUpdate::Replace(replaced, updates.back());
+  CHECK(replaced.Prev() == prev);
+  CHECK(replaced.Current() == current);
+  CHECK(Expand(*replaced.RemovedRows()) == Expand(*RowSequence::CreateSequential(0, 10)));
+  CHECK(Expand(*replaced.AddedRows()) == Expand(*RowSequence::CreateSequential(0, 7)));
+  CHECK(replaced.AfterRemoves()->NumRows() == 0);
+  CHECK(replaced.AfterAdds() == current);
+  // Nothing is modified, but there is still an entry for each column.
+  REQUIRE(replaced.ModifiedRows().size() == 1);
+  CHECK(replaced.ModifiedRows()[0]->Empty());
+  CHECK(replaced.AllModifiedRows()->Empty());
+  CHECK(Values(*replaced.AfterModifies()) == Values(*current));
+}
+
+TEST_CASE("Replacing from or to an empty table reuses the empty snapshot", "[tickingupdate]") {
+  History history(0);
+  auto fill = history.Apply(Step{Rows({}), Rows({{0, 4}}), Rows({})});
+  auto modify = history.Apply(Step{Rows({}), Rows({}), Rows({{1, 3}})});
+  auto empty = history.Apply(Step{Rows({{0, 4}}), Rows({}), Rows({})});
+
+  auto from_empty = TickingUpdate::Replace(fill, modify);
+  CHECK(from_empty.RemovedRows()->Empty());
+  CHECK(Expand(*from_empty.AddedRows()) == std::vector<uint64_t>{0, 1, 2, 3});
+  CHECK(from_empty.AfterRemoves() == from_empty.Prev());
+  REQUIRE(from_empty.ModifiedRows().size() == 1);
+  CHECK(from_empty.ModifiedRows()[0]->Empty());
+
+  auto to_empty = TickingUpdate::Replace(modify, empty);
+  CHECK(Expand(*to_empty.RemovedRows()) == std::vector<uint64_t>{0, 1, 2, 3});
+  CHECK(to_empty.AddedRows()->Empty());
+  CHECK(to_empty.AfterRemoves() == to_empty.Current());
+  CHECK(to_empty.AfterAdds() == to_empty.Current());
+  REQUIRE(to_empty.ModifiedRows().size() == 1);
+  CHECK(to_empty.ModifiedRows()[0]->Empty());
+}
+
+TEST_CASE("Merging updates that change nothing keeps the snapshots shared", "[tickingupdate]") {
+  History history(3);
+  auto first = history.Apply(Step{Rows({}), Rows({}), Rows({})});
+  auto second = history.Apply(Step{Rows({}), Rows({}), Rows({})});
+  auto merged = TickingUpdate::Merge(first, second);
+  history.CheckMerged(merged, 0, 2);
+  CHECK(merged.AfterRemoves() == merged.Prev());
+  CHECK(merged.AfterAdds() == merged.AfterRemoves());
+}
+}  // namespace deephaven::client::tests
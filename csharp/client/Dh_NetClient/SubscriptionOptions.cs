@@ -0,0 +1,61 @@
+﻿//
+// Copyright (c) 2016-2026 Deephaven Data Labs and Patent Pending
+//
+using io.deephaven.barrage.flatbuf;
+
+namespace Deephaven.Dh_NetClient;
+
+/// <summary>
+/// Tuning parameters for a subscription, sent to the server as the BarrageSubscriptionOptions
+/// of the BarrageSubscriptionRequest.
+/// </summary>
+public class SubscriptionOptions {
+  public const int DefaultBatchSize = 4096;
+
+  /// <summary>
+  /// The maximum number of rows the server puts in each record batch. Must be positive.
+  /// </summary>
+  public int BatchSize {
+    get => _batchSize;
+    set => _batchSize = CheckPositive(nameof(BatchSize), value);
+  }
+  private int _batchSize = DefaultBatchSize;
+
+  /// <summary>
+  /// The maximum size in bytes of each message the server sends, or 0 for the server's default.
+  /// </summary>
+  public int MaxMessageSize {
+    get => _maxMessageSize;
+    set => _maxMessageSize = CheckNotNegative(nameof(MaxMessageSize), value);
+  }
+  private int _maxMessageSize = 0;
+
+  /// <summary>
+  /// The minimum interval between updates, or 0 for the server's default. The server coalesces
+  /// the changes that happen within an interval into a single update.
+  /// </summary>
+  public int MinUpdateIntervalMs {
+    get => _minUpdateIntervalMs;
+    set => _minUpdateIntervalMs = CheckNotNegative(nameof(MinUpdateIntervalMs), value);
+  }
+  private int _minUpdateIntervalMs = 0;
+
+  /// <summary>
+  /// How the server sends columns whose types cannot be represented directly in Arrow.
+  /// </summary>
+  public ColumnConversionMode ColumnConversionMode { get; set; } = ColumnConversionMode.Stringify;
+
+  private static int CheckPositive(string what, int value) {
+    if (value <= 0) {
+      throw new ArgumentOutOfRangeException(what, $"{what} must be positive, got {value}");
+    }
+    return value;
+  }
+
+  private static int CheckNotNegative(string what, int value) {
+    if (value < 0) {
+      throw new ArgumentOutOfRangeException(what, $"{what} must be non-negative, got {value}");
+    }
+    return value;
+  }
+}
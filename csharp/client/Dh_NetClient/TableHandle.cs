@@ -674,7 +674,18 @@ public class TableHandle : IDisposable {
   }
 
   public IDisposable Subscribe(IObserver<TickingUpdate> observer) {
-    var disposer = SubscriptionThread.Start(Server, Schema, Ticket, observer);
+    return Subscribe(observer, new SubscriptionOptions());
+  }
+
+  /// <summary>
+  /// Subscribes to a ticking table, with tuning options such as the batch size and the
+  /// minimum update interval.
+  /// </summary>
+  /// <param name="observer">The observer that receives the TickingUpdates</param>
+  /// <param name="options">The subscription options</param>
+  /// <returns>An IDisposable that cancels the subscription when disposed</returns>
+  public IDisposable Subscribe(IObserver<TickingUpdate> observer, SubscriptionOptions options) {
+    var disposer = SubscriptionThread.Start(Server, Schema, Ticket, options, observer);
     // TODO(kosak): Add this subscription to a set of things that the TableHandleManager
     // will dispose when it is disposed.
     return disposer;
@@ -12,21 +12,22 @@ using Io.Deephaven.Proto.Backplane.Grpc;
 namespace Deephaven.Dh_NetClient;
 
 internal class SubscriptionThread {
-  public static IDisposable Start(Server server, Schema schema, Ticket ticket, IObserver<TickingUpdate> observer) {
+  public static IDisposable Start(Server server, Schema schema, Ticket ticket,
+    SubscriptionOptions options, IObserver<TickingUpdate> observer) {
     var metadata = new Metadata();
     server.ForEachHeaderNameAndValue(metadata.Add);
     var fcw = server.FlightClient;
     var command = "dphn"u8.ToArray();
     var fd = FlightDescriptor.CreateCommandDescriptor(command);
     var exchange = fcw.DoExchange(fd, metadata);
-    var result = UpdateProcessor.Start(exchange, schema, ticket, observer);
+    var result = UpdateProcessor.Start(exchange, schema, ticket, options, observer);
     return result;
   }
 
   private class UpdateProcessor : IDisposable {
     public static UpdateProcessor Start(FlightRecordBatchExchangeCall exchange, Schema schema,
-      Ticket ticket, IObserver<TickingUpdate> observer) {
-      var result = new UpdateProcessor(exchange, schema, ticket, observer);
+      Ticket ticket, SubscriptionOptions options, IObserver<TickingUpdate> observer) {
+      var result = new UpdateProcessor(exchange, schema, ticket, options, observer);
       // TODO(kosak): This could be a Task rather than a thread.
       Task.Run(result.RunForever).Forget();
       return result;
@@ -35,14 +36,16 @@ internal class SubscriptionThread {
     private readonly FlightRecordBatchExchangeCall _exchange;
     private readonly Schema _schema;
     private readonly Ticket _ticket;
+    private readonly SubscriptionOptions _options;
     private readonly IObserver<TickingUpdate> _observer;
     private InterlockedLong _cancelled;
 
     private UpdateProcessor(FlightRecordBatchExchangeCall exchange, Schema schema, Ticket ticket,
-      IObserver<TickingUpdate> observer) {
+      SubscriptionOptions options, IObserver<TickingUpdate> observer) {
       _exchange = exchange;
       _schema = schema;
       _ticket = ticket;
+      _options = options;
       _observer = observer;
     }
 
@@ -82,7 +85,7 @@ internal class SubscriptionThread {
       batchBuilder.Append("Dummy", true, arrayBuilder.Build());
       var uselessMessage = batchBuilder.Build();
 
-      var subReq = BarrageProcessor.CreateSubscriptionRequest(_ticket.Ticket_.ToByteArray());
+      var subReq = BarrageProcessor.CreateSubscriptionRequest(_ticket.Ticket_.ToByteArray(), _options);
       var subReqAsByteString = ByteString.CopyFrom(subReq);
       await _exchange.RequestStream.WriteAsync(uselessMessage, subReqAsByteString);
 
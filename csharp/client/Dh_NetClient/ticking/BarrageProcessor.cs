@@ -25,10 +25,15 @@ public class BarrageProcessor {
   public const UInt32 DeephavenMagicNumber = 0x6E687064U;
 
   public static byte[] CreateSubscriptionRequest(byte[] ticketBytes) {
+    return CreateSubscriptionRequest(ticketBytes, new SubscriptionOptions());
+  }
+
+  public static byte[] CreateSubscriptionRequest(byte[] ticketBytes, SubscriptionOptions options) {
     var payloadBuilder = new FlatBufferBuilder(4096);
 
     var subOptions = BarrageSubscriptionOptions.CreateBarrageSubscriptionOptions(
-      payloadBuilder, ColumnConversionMode.Stringify, true, 0, 4096, 0, true);
+      payloadBuilder, options.ColumnConversionMode, true, options.MinUpdateIntervalMs,
+      options.BatchSize, options.MaxMessageSize, true);
 
     // add ticket
     payloadBuilder.StartVector(1, ticketBytes.Length, 1);
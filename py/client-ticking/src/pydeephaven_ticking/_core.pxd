@@ -119,6 +119,9 @@ cdef extern from "deephaven/dhcore/ticking/ticking.h" namespace "deephaven::dhco
         shared_ptr[CClientTable] AfterModifies()
         shared_ptr[CClientTable] Current()
 
+        @staticmethod
+        CTickingUpdate Merge(const CTickingUpdate &first, const CTickingUpdate &second) except +
+
 cdef extern from "deephaven/dhcore/column/buffer_column_source.h" namespace "deephaven::dhcore::column":
     cdef cppclass CNumericBufferColumnSource "deephaven::dhcore::column::NumericBufferColumnSource" [T]:
         @staticmethod
@@ -211,10 +214,26 @@ cdef extern from "deephaven/dhcore/utility/cython_support.h" namespace "deephave
         @staticmethod
         string WhatADump(const CColumnSource &data, size_t size)
 
+cdef extern from "deephaven/dhcore/ticking/subscription_options.h" namespace "deephaven::dhcore::ticking":
+    ctypedef enum CColumnConversionMode "deephaven::dhcore::ticking::ColumnConversionMode":
+        kStringify "deephaven::dhcore::ticking::ColumnConversionMode::kStringify"
+        kJavaSerialization "deephaven::dhcore::ticking::ColumnConversionMode::kJavaSerialization"
+        kThrowError "deephaven::dhcore::ticking::ColumnConversionMode::kThrowError"
+
+    cdef cppclass CSubscriptionOptions "deephaven::dhcore::ticking::SubscriptionOptions":
+        CSubscriptionOptions()
+        CSubscriptionOptions &SetBatchSize(int32_t batch_size) except +
+        CSubscriptionOptions &SetMaxMessageSize(int32_t max_message_size) except +
+        CSubscriptionOptions &SetMinUpdateIntervalMs(int32_t min_update_interval_ms) except +
+        CSubscriptionOptions &SetColumnConversionMode(CColumnConversionMode column_conversion_mode) except +
+
 cdef extern from "deephaven/dhcore/ticking/barrage_processor.h" namespace "deephaven::dhcore::ticking":
     cdef cppclass CBarrageProcessor "deephaven::dhcore::ticking::BarrageProcessor":
         @staticmethod
         string CreateSubscriptionRequestCython(const void *ticket_bytes, size_t size)
+        @staticmethod
+        string CreateSubscriptionRequestCython(const void *ticket_bytes, size_t size,
+            const CSubscriptionOptions &options)
 
         CBarrageProcessor()
         CBarrageProcessor(shared_ptr[CSchema] schema)
@@ -14,6 +14,7 @@ from pydeephaven_ticking._core cimport CColumnSource, CContainerBase, CGenericCh
 from pydeephaven_ticking._core cimport CHumanReadableElementTypeName, CHumanReadableStaticTypeName
 from pydeephaven_ticking._core cimport CCythonSupport, ElementTypeId, CElementType, CDateTime
 from pydeephaven_ticking._core cimport CTickingUpdate, CBarrageProcessor, CNumericBufferColumnSource
+from pydeephaven_ticking._core cimport CColumnConversionMode, CSubscriptionOptions
 from libc.stdint cimport int8_t, int16_t, int32_t, int64_t, intptr_t, uint8_t, uint16_t, uint32_t, uint64_t
 from libcpp cimport bool
 from libcpp.memory cimport shared_ptr, unique_ptr
@@ -32,6 +33,12 @@ cdef class TickingUpdate:
         result.ticking_update = move(update)
         return result
 
+    @staticmethod
+    def merge(first: TickingUpdate, second: TickingUpdate) -> TickingUpdate:
+        """Combines two consecutive updates into one update with the same cumulative effect, going
+        from first.prev to second.current."""
+        return TickingUpdate.create(CTickingUpdate.Merge(first.ticking_update, second.ticking_update))
+
     @property
     def prev(self) -> ClientTable:
         return ClientTable.create(self.ticking_update.Prev())
@@ -566,10 +573,20 @@ cdef class BarrageProcessor:
     # BarrageSubscriptionRequest. However the Python code knows nothing about Barrage and the C++ code knows
     # nothing about Arrow. This method is used to format a BarrageSubscriptionRequest as an array of bytes and
     # give it to the Python code so that it can send it to the server over Arrow.
+    # The optional arguments are the fields of the BarrageSubscriptionOptions. column_conversion_mode takes the
+    # numeric values of the Barrage ColumnConversionMode enum (1 = Stringify, 2 = JavaSerialization,
+    # 3 = ThrowError).
     @staticmethod
-    def create_subscription_request(const unsigned char [::1] ticket_bytes) -> bytearray:
+    def create_subscription_request(const unsigned char [::1] ticket_bytes, int32_t batch_size = 4096,
+            int32_t max_message_size = 0, int32_t min_update_interval_ms = 0,
+            int32_t column_conversion_mode = 1) -> bytearray:
+        cdef CSubscriptionOptions options
+        options.SetBatchSize(batch_size)
+        options.SetMaxMessageSize(max_message_size)
+        options.SetMinUpdateIntervalMs(min_update_interval_ms)
+        options.SetColumnConversionMode(<CColumnConversionMode>column_conversion_mode)
         res = CBarrageProcessor.CreateSubscriptionRequestCython(&ticket_bytes[0],
-            ticket_bytes.shape[0])
+            ticket_bytes.shape[0], options)
         return res
 
     @staticmethod
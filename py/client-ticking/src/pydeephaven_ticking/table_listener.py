@@ -6,6 +6,8 @@
 
 import threading
 from abc import ABC, abstractmethod
+from dataclasses import dataclass
+from enum import IntEnum
 from inspect import signature
 from typing import Callable, Generator, Optional, Sequence, TypeVar, Union
 
@@ -248,6 +250,37 @@ class TableListener(ABC):
         print(f"Error happened during ticking processing: {error}")
 
 
+class ColumnConversionMode(IntEnum):
+    """How the server sends columns whose types cannot be represented directly in Arrow."""
+
+    STRINGIFY = 1
+    """Send the column as strings."""
+    JAVA_SERIALIZATION = 2
+    """Send the column as Java-serialized bytes."""
+    THROW_ERROR = 3
+    """Refuse to send the column and fail the subscription."""
+
+
+@dataclass
+class SubscriptionOptions:
+    """Tuning parameters for a subscription, sent to the server with the subscription request.
+
+    Attributes:
+        batch_size (int): the maximum number of rows the server puts in each record batch, defaults to 4096
+        max_message_size (int): the maximum size in bytes of each message the server sends, defaults to 0,
+            meaning the server's default
+        min_update_interval_ms (int): the minimum interval between updates; the server coalesces the changes that
+            happen within an interval into a single update. Defaults to 0, meaning the server's default
+        column_conversion_mode (ColumnConversionMode): how the server sends columns whose types cannot be
+            represented directly in Arrow, defaults to ColumnConversionMode.STRINGIFY
+    """
+
+    batch_size: int = 4096
+    max_message_size: int = 0
+    min_update_interval_ms: int = 0
+    column_conversion_mode: ColumnConversionMode = ColumnConversionMode.STRINGIFY
+
+
 class TableListenerHandle:
     """An object for managing the ticking callback state.
 
@@ -260,6 +293,7 @@ class TableListenerHandle:
 
     _table: Table
     _listener: TableListener
+    _options: SubscriptionOptions
     # Set when the user calls stop()
     _cancelled: bool
     # Tracks Whether we've called cancel on the FlightStreamReader
@@ -269,17 +303,25 @@ class TableListenerHandle:
     _reader: flight.FlightStreamReader
     _thread: threading.Thread
 
-    def __init__(self, table: Table, listener: TableListener):
+    def __init__(
+        self,
+        table: Table,
+        listener: TableListener,
+        options: Optional[SubscriptionOptions] = None,
+    ):
         """Constructor.
 
         Args:
             table (Table): the Table that is being listened to.
             listener (TableListener): the TableListener callback that will receive TableUpdate messages as the table
             changes.
+            options (Optional[SubscriptionOptions]): tuning parameters for the subscription, defaults to None,
+            meaning the default SubscriptionOptions.
         """
 
         self._table = table
         self._listener = listener
+        self._options = options if options is not None else SubscriptionOptions()
         self._cancelled = False
         self._reader_cancelled = False
 
@@ -291,7 +333,11 @@ class TableListenerHandle:
         self._writer, self._reader = fls.do_exchange()
         self._bp = dhc.BarrageProcessor.create(self._table.schema)
         subreq = dhc.BarrageProcessor.create_subscription_request(
-            self._table.ticket._ticket_bytes
+            self._table.ticket._ticket_bytes,
+            self._options.batch_size,
+            self._options.max_message_size,
+            self._options.min_update_interval_ms,
+            int(self._options.column_conversion_mode),
         )
         self._writer.write_metadata(subreq)
 
@@ -344,6 +390,7 @@ def listen(
     table: Table,
     listener: Union[Callable, TableListener],
     on_error: Optional[Callable[[Exception], None]] = None,
+    options: Optional[SubscriptionOptions] = None,
 ) -> TableListenerHandle:
     """A convenience method to create a TableListenerHandle. This method can be called in one of three ways:
 
@@ -357,6 +404,8 @@ def listen(
             as the table changes.
         on_error (Optional[Callable[[Exception], None]]) : the callback that will be invoked when an error occurs,
             defaults to None
+        options (Optional[SubscriptionOptions]) : tuning parameters for the subscription, such as the batch size
+            and the minimum update interval, defaults to None, meaning the default SubscriptionOptions
 
      Raises:
          ValueError
@@ -386,7 +435,7 @@ def listen(
         listener_to_use = listener
     else:
         raise ValueError("listener is neither callable nor TableListener object")
-    return TableListenerHandle(table, listener_to_use)
+    return TableListenerHandle(table, listener_to_use, options)
 
 
 class _CallableAsListener(TableListener):